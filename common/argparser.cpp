@@ -199,6 +199,8 @@ auto ym::ArgParser::parseLonghand(
 
    if (arg_Ptr)
    { // found arg
+      result = ParseResult_T::Success;
+
       if (arg_Ptr->isFlag())
       { // enable argument - no explicit value
          arg_Ptr->enbl(!IsNeg);
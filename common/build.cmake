@@ -19,9 +19,18 @@ function(srcbuild-ym.common Ctx_JSON)
 
    set(Srcs
       argparser.cpp
+      csvreader.cpp
       datalogger.cpp
+      distributions.cpp
       fileio.cpp
+      latencyhistogram.cpp
       logger.cpp
+      ops.cpp
+      profiler.cpp
+      rng.cpp
+      rngbattery.cpp
+      shmdatalogger.cpp
+      shmdatareader.cpp
       textlogger.cpp
       timer.cpp
       ymassert.cpp
@@ -29,8 +38,29 @@ function(srcbuild-ym.common Ctx_JSON)
    list(TRANSFORM Srcs PREPEND ${CMAKE_CURRENT_FUNCTION_LIST_DIR}/)
    target_sources(${Target} PRIVATE ${Srcs})
 
+   # fused multiply-adds round differently - keep variates the same on every platform
+   set_source_files_properties(${CMAKE_CURRENT_FUNCTION_LIST_DIR}/distributions.cpp
+      TARGET_DIRECTORY ${Target}
+      PROPERTIES COMPILE_OPTIONS -ffp-contract=off)
+
    if (YM_COMMON_DEBUG)
       target_compile_definitions(${Target} PRIVATE YM_DEBUG=1)
    endif()
 
+   if (YM_COMMON_PROFILE)
+      target_compile_definitions(${Target} PUBLIC YM_PROFILE=1)
+   endif()
+
+   # command line reader for shared memory blackboxes
+   set(ToolTarget ${Target}.shmdatareader)
+   add_executable(${ToolTarget})
+   target_sources(${ToolTarget} PRIVATE ${CMAKE_CURRENT_FUNCTION_LIST_DIR}/tools/shmdatareader.cpp)
+   target_link_libraries(${ToolTarget} PRIVATE ${Target})
+
+   # statistical test battery for the random number generators
+   set(ToolTarget ${Target}.rngbattery)
+   add_executable(${ToolTarget})
+   target_sources(${ToolTarget} PRIVATE ${CMAKE_CURRENT_FUNCTION_LIST_DIR}/tools/rngbattery.cpp)
+   target_link_libraries(${ToolTarget} PRIVATE ${Target})
+
 endfunction()
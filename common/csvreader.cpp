@@ -0,0 +1,656 @@
+/**
+ * @file    csvreader.cpp
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#include "csvreader.h"
+
+#include "fileio.h"
+#include "ops.h"
+#include "textlogger.h"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <thread>
+
+#if defined(__x86_64__)
+   #include <immintrin.h>
+#endif
+
+namespace
+{
+
+using namespace ym;
+
+using ColumnType_T = CsvReader::ColumnType_T;
+using Column_T     = CsvReader::Column_T;
+
+/// @brief Bytes scanned per delimiter mask.
+constexpr auto BlockSize = 64uz;
+
+#if defined(__x86_64__)
+
+/** getMask_sse2
+ *
+ * @brief Finds the delimiters and newlines in a block (16 bytes at a time).
+ *
+ * @note SSE2 is part of the x86-64 baseline.
+ *
+ * @param Block_Ptr -- Start of block (BlockSize bytes).
+ * @param Delim     -- Delimiter.
+ *
+ * @returns uint64 -- Bit i set if byte i is a delimiter or newline.
+ */
+uint64 getMask_sse2(
+   char const * const Block_Ptr,
+   char         const Delim)
+{
+   auto const Delims   = _mm_set1_epi8(Delim);
+   auto const Newlines = _mm_set1_epi8('\n');
+
+   auto mask = 0_u64;
+   for (auto i = 0uz; i < BlockSize; i += 16uz)
+   { // quarter block
+      auto const Bytes = _mm_loadu_si128(reinterpret_cast<__m128i const *>(Block_Ptr + i));
+      auto const Hits  = _mm_or_si128(_mm_cmpeq_epi8(Bytes, Delims), _mm_cmpeq_epi8(Bytes, Newlines));
+      mask |= static_cast<uint64>(static_cast<uint32>(_mm_movemask_epi8(Hits))) << i;
+   }
+   return mask;
+}
+
+/** getMask_avx2
+ *
+ * @brief Finds the delimiters and newlines in a block (32 bytes at a time).
+ *
+ * @note Compiled for AVX2 regardless of build flags - only called if the CPU has it.
+ *
+ * @param Block_Ptr -- Start of block (BlockSize bytes).
+ * @param Delim     -- Delimiter.
+ *
+ * @returns uint64 -- Bit i set if byte i is a delimiter or newline.
+ */
+__attribute__((target("avx2")))
+uint64 getMask_avx2(
+   char const * const Block_Ptr,
+   char         const Delim)
+{
+   auto const Delims   = _mm256_set1_epi8(Delim);
+   auto const Newlines = _mm256_set1_epi8('\n');
+
+   auto const Lo = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(Block_Ptr      ));
+   auto const Hi = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(Block_Ptr + 32));
+
+   auto const LoHits = _mm256_or_si256(_mm256_cmpeq_epi8(Lo, Delims), _mm256_cmpeq_epi8(Lo, Newlines));
+   auto const HiHits = _mm256_or_si256(_mm256_cmpeq_epi8(Hi, Delims), _mm256_cmpeq_epi8(Hi, Newlines));
+
+   return  static_cast<uint64>(static_cast<uint32>(_mm256_movemask_epi8(LoHits))) |
+          (static_cast<uint64>(static_cast<uint32>(_mm256_movemask_epi8(HiHits))) << 32_u64);
+}
+
+#else
+
+/** getMask_scalar
+ *
+ * @brief Finds the delimiters and newlines in a block (one byte at a time).
+ *
+ * @param Block_Ptr -- Start of block (BlockSize bytes).
+ * @param Delim     -- Delimiter.
+ *
+ * @returns uint64 -- Bit i set if byte i is a delimiter or newline.
+ */
+uint64 getMask_scalar(
+   char const * const Block_Ptr,
+   char         const Delim)
+{
+   auto mask = 0_u64;
+   for (auto i = 0uz; i < BlockSize; ++i)
+   { // each byte
+      auto const C = Block_Ptr[i];
+      mask |= static_cast<uint64>(C == Delim || C == '\n') << i;
+   }
+   return mask;
+}
+
+#endif // __x86_64__
+
+/** getMask
+ *
+ * @brief Finds the delimiters and newlines in a block, with the best the CPU has.
+ *
+ * @param Block_Ptr -- Start of block (BlockSize bytes).
+ * @param Delim     -- Delimiter.
+ *
+ * @returns uint64 -- Bit i set if byte i is a delimiter or newline.
+ */
+uint64 getMask(
+   char const * const Block_Ptr,
+   char         const Delim)
+{
+#if defined(__x86_64__)
+   static auto const s_GetMask_Ptr = __builtin_cpu_supports("avx2") ? getMask_avx2 : getMask_sse2;
+#else
+   static auto const s_GetMask_Ptr = getMask_scalar;
+#endif
+
+   return s_GetMask_Ptr(Block_Ptr, Delim);
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** join
+ *
+ * @brief Narrowest type holding the values of both types.
+ *
+ * @param A -- Type.
+ * @param B -- Type.
+ *
+ * @returns ColumnType_T -- Joined type.
+ */
+constexpr ColumnType_T join(
+   ColumnType_T const A,
+   ColumnType_T const B)
+{
+   using enum ColumnType_T;
+
+   if (A == B    ) { return A; }
+   if (A == Empty) { return B; }
+   if (B == Empty) { return A; }
+
+   auto const IsNumber = [](ColumnType_T const T) { return T == Int64 || T == Float64; };
+   return (IsNumber(A) && IsNumber(B)) ? Float64 : Text;
+}
+
+/** parseBool
+ *
+ * @brief Casts field to bool.
+ *
+ * @param Field -- Field.
+ *
+ * @returns std::optional<uint8> -- 1 or 0, or nothing if not "true" or "false".
+ */
+std::optional<uint8> parseBool(std::string_view const Field)
+{
+   if (Field == "true" ) { return uint8{1}; }
+   if (Field == "false") { return uint8{0}; }
+   return std::nullopt;
+}
+
+/** parseFloat
+ *
+ * @brief Casts field to float64.
+ *
+ * @note Ops rejects subnormals as out of range - std::from_chars keeps them.
+ *
+ * @param Field -- Field.
+ *
+ * @returns std::optional<float64> -- Value (NaN if empty), or nothing if not a number.
+ */
+std::optional<float64> parseFloat(std::string_view const Field)
+{
+   if (Field.empty())
+   { // missing
+      return std::numeric_limits<float64>::quiet_NaN();
+   }
+
+   auto const Result = Ops::tryCastTo<float64>(Field);
+
+   if (Result)
+   { // common case
+      return *Result;
+   }
+
+   if (Result.error() == std::errc::result_out_of_range)
+   { // maybe subnormal
+      auto       val          = 0.0_f64;
+      auto const [Ptr, Error] = std::from_chars(Field.data(), Field.data() + Field.size(), val);
+      if (Error == std::errc() && Ptr == Field.data() + Field.size()) { return val; }
+   }
+
+   return std::nullopt;
+}
+
+/** classify
+ *
+ * @brief Narrowest type holding the field.
+ *
+ * @param Field -- Field.
+ *
+ * @returns ColumnType_T -- Type.
+ */
+ColumnType_T classify(std::string_view const Field)
+{
+   if (parseBool(Field)                ) { return ColumnType_T::Bool;    }
+   if (Ops::tryCastTo<int64>(Field)    ) { return ColumnType_T::Int64;   }
+   if (parseFloat(Field)               ) { return ColumnType_T::Float64; }
+   return ColumnType_T::Text;
+}
+
+/** store
+ *
+ * @brief Appends field to column.
+ *
+ * @note A column holding integers is widened to float64 in place. Any other widening
+ *       (to text, or away from bool) needs the chunk parsed again - the type is updated
+ *       and false returned.
+ *
+ * @param col   -- Column.
+ * @param Field -- Field.
+ *
+ * @returns bool -- True if stored, false if the chunk needs to be parsed again.
+ */
+bool store(
+   Column_T &             col,
+   std::string_view const Field)
+{
+   switch (col._type)
+   {
+      case ColumnType_T::Bool:
+      {
+         if (auto const Val = parseBool(Field)) { col._bools.push_back(*Val); return true; }
+         break;
+      }
+      case ColumnType_T::Int64:
+      {
+         if (auto const Val = Ops::tryCastTo<int64>(Field)) { col._ints.push_back(*Val); return true; }
+         break;
+      }
+      case ColumnType_T::Float64:
+      {
+         if (auto const Val = parseFloat(Field)) { col._floats.push_back(*Val); return true; }
+         break;
+      }
+      case ColumnType_T::Text:
+      {
+         col._texts.emplace_back(Field);
+         return true;
+      }
+      case ColumnType_T::Empty:
+      default:
+      {
+         break;
+      }
+   }
+
+   auto const Wider = join(col._type, classify(Field));
+
+   if (col._type == ColumnType_T::Int64 && Wider == ColumnType_T::Float64)
+   { // exact - the same rounding as casting the text
+      col._floats.assign(col._ints.begin(), col._ints.end());
+      col._ints.clear();
+   }
+   else if (col._type != ColumnType_T::Empty)
+   { // values already stored can't be converted
+      col._type = Wider;
+      return false;
+   }
+
+   col._type = Wider;
+   return store(col, Field);
+}
+
+/** Chunk_T
+ *
+ * @brief Run of whole lines, parsed on its own thread.
+ */
+struct Chunk_T
+{
+   std::string_view      _text     {                            };
+   std::vector<Column_T> _columns  {                            }; // only types and values
+   sizet                 _nRows    {0uz                         };
+   sizet                 _badOffset{std::string_view::npos      }; // of the malformed line's end
+   sizet                 _nFields  {0uz                         }; // on the malformed line
+};
+
+/** parseChunk
+ *
+ * @brief Parses the lines of a chunk into its columns.
+ *
+ * @note Columns start out with the types they have - the values are cleared.
+ *
+ * @param chunk -- Chunk.
+ * @param Delim -- Delimiter.
+ *
+ * @returns bool -- False if a column was widened and the chunk needs to be parsed again.
+ */
+bool parseChunk(
+   Chunk_T &  chunk,
+   char const Delim)
+{
+   for (auto & col : chunk._columns)
+   { // keep the types
+      col._bools .clear();
+      col._ints  .clear();
+      col._floats.clear();
+      col._texts .clear();
+   }
+
+   chunk._nRows = 0uz;
+
+   auto const         NCols     = chunk._columns.size();
+   auto const * const Begin_Ptr = chunk._text.data();
+   auto const * const End_Ptr   = Begin_Ptr + chunk._text.size();
+
+   auto const * fieldBegin_ptr = Begin_Ptr;
+   auto         col            = 0uz;
+
+   enum class Step_T { Next, Again, Bad };
+
+   // ends the field at Pos_Ptr, a delimiter or the end of a line
+   auto const EndField = [&](char const * const Pos_Ptr, bool const IsEol) {
+      auto field = std::string_view(fieldBegin_ptr, Pos_Ptr);
+      fieldBegin_ptr = Pos_Ptr + 1;
+
+      if (IsEol)
+      { // end of line
+         if (field.ends_with('\r')) { field.remove_suffix(1uz); }
+
+         if (col == 0uz && field.empty())
+         { // blank line
+            return Step_T::Next;
+         }
+
+         if (col + 1uz != NCols)
+         { // too few fields
+            chunk._badOffset = static_cast<sizet>(Pos_Ptr - Begin_Ptr);
+            chunk._nFields   = col + 1uz;
+            return Step_T::Bad;
+         }
+      }
+      else if (col + 1uz == NCols)
+      { // too many fields
+         auto const * const Eol_Ptr = FileIO::findDelim(Pos_Ptr, End_Ptr, '\n');
+         chunk._badOffset = static_cast<sizet>(Eol_Ptr - Begin_Ptr);
+         chunk._nFields   = NCols + 1uz + static_cast<sizet>(std::count(Pos_Ptr + 1, Eol_Ptr, Delim));
+         return Step_T::Bad;
+      }
+
+      if (!store(chunk._columns[col], field))
+      { // widened
+         return Step_T::Again;
+      }
+
+      if (IsEol) { col = 0uz; ++chunk._nRows; }
+      else       { ++col;                     }
+
+      return Step_T::Next;
+   };
+
+   for (auto const * block_ptr = Begin_Ptr; block_ptr < End_Ptr; block_ptr += BlockSize)
+   { // block at a time
+      auto mask = 0_u64;
+
+      if (static_cast<sizet>(End_Ptr - block_ptr) >= BlockSize)
+      { // full block
+         mask = getMask(block_ptr, Delim);
+      }
+      else
+      { // zero padded tail
+         char tail[BlockSize]{};
+         std::memcpy(tail, block_ptr, static_cast<sizet>(End_Ptr - block_ptr));
+         mask = getMask(tail, Delim);
+      }
+
+      for (; mask != 0_u64; mask &= mask - 1_u64)
+      { // each delimiter or newline
+         auto const * const Pos_Ptr = block_ptr + std::countr_zero(mask);
+
+         switch (EndField(Pos_Ptr, *Pos_Ptr == '\n'))
+         {
+            case Step_T::Next:  break;
+            case Step_T::Again: return false;
+            case Step_T::Bad:   return true;
+         }
+      }
+   }
+
+   if (fieldBegin_ptr < End_Ptr || col > 0uz)
+   { // last line has no newline
+      return EndField(End_Ptr, true) != Step_T::Again;
+   }
+
+   return true;
+}
+
+/** runChunks
+ *
+ * @brief Parses the chunks, each on its own thread (this thread takes the first).
+ *
+ * @param chunks -- Chunks.
+ * @param Delim  -- Delimiter.
+ */
+void runChunks(
+   std::vector<Chunk_T> & chunks,
+   char           const   Delim)
+{
+   auto const Run = [Delim](Chunk_T & chunk) {
+      while (!parseChunk(chunk, Delim))
+      { // a column was widened
+      }
+   };
+
+   std::vector<std::jthread> pool;
+   pool.reserve(chunks.size());
+
+   for (auto i = 1uz; i < chunks.size(); ++i)
+   { // helpers
+      pool.emplace_back(Run, std::ref(chunks[i]));
+   }
+
+   Run(chunks.front());
+}
+
+/** append
+ *
+ * @brief Appends the values of a chunk's column to the final column.
+ *
+ * @param col      -- Final column (of the final type).
+ * @param ChunkCol -- Column of chunk (same type, or integers for a float64 column).
+ */
+void append(
+   Column_T       & col,
+   Column_T const & ChunkCol)
+{
+   switch (col._type)
+   {
+      case ColumnType_T::Bool:    col._bools .insert(col._bools .end(), ChunkCol._bools .begin(), ChunkCol._bools .end()); break;
+      case ColumnType_T::Int64:   col._ints  .insert(col._ints  .end(), ChunkCol._ints  .begin(), ChunkCol._ints  .end()); break;
+      case ColumnType_T::Text:    col._texts .insert(col._texts .end(), ChunkCol._texts .begin(), ChunkCol._texts .end()); break;
+      case ColumnType_T::Float64:
+      {
+         col._floats.insert(col._floats.end(), ChunkCol._floats.begin(), ChunkCol._floats.end());
+         col._floats.insert(col._floats.end(), ChunkCol._ints  .begin(), ChunkCol._ints  .end());
+         break;
+      }
+      case ColumnType_T::Empty:
+      default:
+      {
+         break;
+      }
+   }
+}
+
+} // anonymous
+
+/** CsvReader
+ *
+ * @brief Constructor.
+ *
+ * @throws Error -- If the delimiter is a line ending or null.
+ *
+ * @param Options -- Knobs.
+ */
+ym::CsvReader::CsvReader(Options_T const & Options) :
+   _Options {Options}
+{
+   YMASSERT(_Options._delim != '\n' && _Options._delim != '\r' && _Options._delim != '\0', Error, YM_DAH,
+      "Delimiter {:#x} not allowed", static_cast<uint32>(static_cast<uint8>(_Options._delim)));
+}
+
+/** read
+ *
+ * @brief Maps the file and parses it (see parse()).
+ *
+ * @throws ParseError -- If a row doesn't have a field for every column.
+ *
+ * @param Filename -- Name of file to read.
+ *
+ * @returns bool -- If the file could be opened.
+ */
+bool ym::CsvReader::read(str const Filename)
+{
+   auto const File = FileIO::mapFile(Filename);
+
+   if (!File)
+   { // can't read
+      ymLog(VG::CsvReader, "Could not open '{}'", Filename);
+      return false;
+   }
+
+   parse(File->getView());
+   return true;
+}
+
+/** parse
+ *
+ * @brief Parses the text into columns, replacing the previous ones.
+ *
+ * @throws ParseError -- If a row doesn't have a field for every column.
+ *
+ * @param Text -- Header line followed by rows.
+ */
+void ym::CsvReader::parse(std::string_view const Text)
+{
+   _columns.clear();
+   _nRows   = 0uz;
+   _nChunks = 0uz;
+
+   if (Text.empty())
+   { // no header
+      return;
+   }
+
+   auto const * const HeaderEnd_Ptr = FileIO::findDelim(Text.data(), Text.data() + Text.size(), '\n');
+
+   auto       header = std::string_view(Text.data(), HeaderEnd_Ptr);
+   auto const Body   = Text.substr(std::min(header.size() + 1uz, Text.size()));
+
+   if (header.ends_with('\r')) { header.remove_suffix(1uz); }
+
+   for (auto rest = header; ; )
+   { // each name
+      auto const Pos = rest.find(_Options._delim);
+      _columns.emplace_back()._name = rest.substr(0uz, Pos);
+      if (Pos == std::string_view::npos) { break; }
+      rest = rest.substr(Pos + 1uz);
+   }
+
+   // one chunk per thread, but only if the chunks are big enough to be worth it
+   auto const MaxChunks = std::clamp<sizet>(std::min<sizet>(std::thread::hardware_concurrency(), _Options._maxThreads), 1uz, 64uz);
+   auto const NChunks   = std::clamp<sizet>(Body.size() / std::max(_Options._minChunk_bytes, 1uz), 1uz, MaxChunks);
+
+   auto chunks = std::vector<Chunk_T>(NChunks);
+   auto begin  = 0uz;
+
+   for (auto i = 0uz; i < NChunks; ++i)
+   { // split after a newline
+      auto end = Body.size();
+
+      if (i + 1uz < NChunks)
+      { // not the last chunk
+         auto const * const Split_Ptr = Body.data() + std::max(begin, ((i + 1uz) * Body.size()) / NChunks);
+         auto const * const Eol_Ptr   = FileIO::findDelim(Split_Ptr, Body.data() + Body.size(), '\n');
+         end = std::min(static_cast<sizet>(Eol_Ptr - Body.data()) + 1uz, Body.size());
+      }
+
+      chunks[i]._text    = Body.substr(begin, end - begin);
+      chunks[i]._columns = std::vector<Column_T>(_columns.size());
+      begin = end;
+   }
+
+   runChunks(chunks, _Options._delim);
+
+   auto offset = 0uz;
+   for (auto const & Chunk : chunks)
+   { // report the first malformed line
+      if (Chunk._badOffset != std::string_view::npos)
+      { // header is line 1
+         auto const NLine = 2uz + static_cast<sizet>(std::count(Body.data(), Body.data() + offset + Chunk._badOffset, '\n'));
+         YMASSERT(false, ParseError, YM_DAH,
+            "Line {} has {} fields, expected {}", NLine, Chunk._nFields, _columns.size());
+      }
+      offset += Chunk._text.size();
+   }
+
+   auto types = std::vector<ColumnType_T>(_columns.size(), ColumnType_T::Empty);
+   for (auto const & Chunk : chunks)
+   { // narrowest type for all chunks
+      for (auto c = 0uz; c < types.size(); ++c)
+      { // each column
+         types[c] = join(types[c], Chunk._columns[c]._type);
+      }
+   }
+
+   auto redo = std::vector<Chunk_T>();
+   auto redoIdxs = std::vector<sizet>();
+   for (auto i = 0uz; i < chunks.size(); ++i)
+   { // chunks whose values can't be converted to the final types
+      auto needsRedo = false;
+      for (auto c = 0uz; c < types.size(); ++c)
+      { // each column
+         auto const Type = chunks[i]._columns[c]._type;
+         needsRedo |= Type != types[c] && Type != ColumnType_T::Empty &&
+                      !(Type == ColumnType_T::Int64 && types[c] == ColumnType_T::Float64);
+      }
+
+      if (needsRedo)
+      { // parse again with the final types
+         for (auto c = 0uz; c < types.size(); ++c) { chunks[i]._columns[c]._type = types[c]; }
+         redo.push_back(std::move(chunks[i]));
+         redoIdxs.push_back(i);
+      }
+   }
+
+   if (!redo.empty())
+   { // rare - eg a text value in only some of the chunks
+      runChunks(redo, _Options._delim);
+      for (auto i = 0uz; i < redo.size(); ++i) { chunks[redoIdxs[i]] = std::move(redo[i]); }
+   }
+
+   for (auto c = 0uz; c < _columns.size(); ++c)
+   { // concatenate
+      auto & col = _columns[c];
+      col._type = types[c];
+
+      for (auto const & Chunk : chunks)
+      { // in order
+         append(col, Chunk._columns[c]);
+      }
+   }
+
+   for (auto const & Chunk : chunks)
+   { // total
+      _nRows += Chunk._nRows;
+   }
+
+   _nChunks = NChunks;
+}
+
+/** findColumn
+ *
+ * @brief Finds column by name.
+ *
+ * @param Name -- Name of column.
+ *
+ * @returns Column_T const * -- Column, or null if there is none of that name.
+ */
+auto ym::CsvReader::findColumn(std::string_view const Name) const -> Column_T const *
+{
+   auto const It = std::ranges::find(_columns, Name, &Column_T::_name);
+   return (It != _columns.end()) ? &*It : nullptr;
+}
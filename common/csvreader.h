@@ -0,0 +1,108 @@
+/**
+ * @file    csvreader.h
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#pragma once
+
+#include "ymglobals.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ym
+{
+
+/** CsvReader
+ *
+ * @brief Reads comma separated text, eg DataLogger text dumps, into typed columns.
+ *
+ * @note The first line names the columns. Every other line is a row with one field per
+ *       column. Blank lines are skipped, "\r\n" endings are fine, quoting is not supported.
+ *
+ * @note Each column gets the narrowest type that holds all of its values:
+ *          Bool    -- "true" or "false"
+ *          Int64   -- integers (that fit)
+ *          Float64 -- any other number, empty fields read as NaN
+ *          Text    -- anything else
+ *
+ * @note Fields are found 64 bytes at a time - SIMD compares (AVX2 if the CPU has it) give
+ *       a bitmask of every delimiter and newline in the block. Numbers are cast with Ops.
+ *
+ * @note Large texts are split at line boundaries and parsed on several threads, each
+ *       chunk into its own columns. The chunks are concatenated in order at the end.
+ */
+class CsvReader
+{
+public:
+   YM_DECL_YMASSERT(Error)
+   YM_DECL_YMASSERT(Error, ParseError)
+
+   /** ColumnType_T
+    *
+    * @brief Type of values in a column.
+    *
+    * @note Empty - the column has no rows.
+    */
+   enum class ColumnType_T : uint8
+   {
+      Empty,
+      Bool,
+      Int64,
+      Float64,
+      Text
+   };
+
+   /** Column_T
+    *
+    * @brief Values of one column - only the vector of its type is filled.
+    */
+   struct Column_T
+   {
+      std::string              _name  {                   };
+      ColumnType_T             _type  {ColumnType_T::Empty};
+      std::vector<uint8>       _bools {                   };
+      std::vector<int64>       _ints  {                   };
+      std::vector<float64>     _floats{                   };
+      std::vector<std::string> _texts {                   };
+   };
+
+   /** Options_T
+    *
+    * @brief Knobs for CsvReader.
+    */
+   struct Options_T
+   {
+      /// @brief Separator between fields.
+      char _delim{','};
+
+      /// @brief Upper bound on threads (capped by the hardware).
+      sizet _maxThreads{16uz};
+
+      /// @brief Texts are not split into chunks smaller than this.
+      sizet _minChunk_bytes{1uz << 20uz};
+   };
+
+   static constexpr Options_T getDefaultOptions(void) { return {}; }
+
+   explicit CsvReader(Options_T const & Options = getDefaultOptions());
+
+   bool read(str const Filename);
+   void parse(std::string_view const Text);
+
+   Column_T const * findColumn(std::string_view const Name) const;
+
+   inline auto const & getColumns(void) const { return _columns; }
+   inline auto         getNRows  (void) const { return _nRows;   }
+   inline auto         getNChunks(void) const { return _nChunks; }
+
+private:
+   std::vector<Column_T> _columns{   };
+   sizet                 _nRows  {0uz};
+   sizet                 _nChunks{0uz}; // of the last parse
+   Options_T const       _Options{   };
+};
+
+} // ym
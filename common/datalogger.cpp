@@ -9,24 +9,119 @@
 #include "textlogger.h"
 
 #include "fmt/format.h"
+#include "fmt/ranges.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
 #include <cstdio>
 #include <cstring>
+#include <limits>
 #include <numeric>
 
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+
+/** writeAll
+ * 
+ * @brief Writes the entire buffer to the file descriptor, retrying on partial writes.
+ * 
+ * @note Async-signal-safe.
+ * 
+ * @param FD         -- File descriptor to write to.
+ * @param Data_Ptr   -- Data to write.
+ * @param Size_bytes -- Number of bytes to write.
+ * 
+ * @returns bool -- True if everything was written, false otherwise.
+ */
+bool writeAll(
+   int               const FD,
+   void const *      const Data_Ptr,
+   ym::sizet         const Size_bytes) noexcept
+{
+   auto const * data_ptr  = static_cast<char const *>(Data_Ptr);
+   auto         remaining = Size_bytes;
+
+   while (remaining > 0uz)
+   { // keep writing until everything is out
+      auto const NWritten = ::write(FD, data_ptr, remaining);
+
+      if (NWritten < 0)
+      { // error
+         if (errno == EINTR)
+         { // interrupted before anything was written - try again
+            continue;
+         }
+         return false;
+      }
+
+      data_ptr  += NWritten;
+      remaining -= static_cast<ym::sizet>(NWritten);
+   }
+
+   return true;
+}
+
+/** loadAsFloat64
+ * 
+ * @brief Reads a tracked variable as a float64.
+ * 
+ * @param Type     -- Type of tracked variable.
+ * @param Data_Ptr -- Tracked variable.
+ * 
+ * @returns float64 -- Value of tracked variable.
+ */
+ym::float64 loadAsFloat64(
+   ym::DataLogger::DataType_T const Type,
+   void const *               const Data_Ptr)
+{
+   using namespace ym;
+   using DT = DataLogger::DataType_T;
+
+   switch (Type)
+   {
+      case DT::Bool:    return static_cast<float64>(*static_cast<bool    const *>(Data_Ptr));
+      case DT::Char:    return static_cast<float64>(*static_cast<char    const *>(Data_Ptr));
+      case DT::Int8:    return static_cast<float64>(*static_cast<int8    const *>(Data_Ptr));
+      case DT::Int16:   return static_cast<float64>(*static_cast<int16   const *>(Data_Ptr));
+      case DT::Int32:   return static_cast<float64>(*static_cast<int32   const *>(Data_Ptr));
+      case DT::Int64:   return static_cast<float64>(*static_cast<int64   const *>(Data_Ptr));
+      case DT::Uint8:   return static_cast<float64>(*static_cast<uint8   const *>(Data_Ptr));
+      case DT::Uint16:  return static_cast<float64>(*static_cast<uint16  const *>(Data_Ptr));
+      case DT::Uint32:  return static_cast<float64>(*static_cast<uint32  const *>(Data_Ptr));
+      case DT::Uint64:  return static_cast<float64>(*static_cast<uint64  const *>(Data_Ptr));
+      case DT::Float32: return static_cast<float64>(*static_cast<float32 const *>(Data_Ptr));
+      case DT::Float64: return                       *static_cast<float64 const *>(Data_Ptr);
+      case DT::Other:
+      default:          return 0.0_f64; // not allowed by trackStats()
+   }
+}
+
+} // anonymous
+
 /** DataLogger
  * 
  * @brief Constructor. See ready().
  * 
  * @throws Error -- If requested depth is 0.
  * 
- * @param MaxDepth -- Max number of entries to store per tracked variable.
+ * @note The blackbox buffer can be placed in caller supplied memory (eg shared memory).
+ * 
+ * @param MaxDepth           -- Max number of entries to store per tracked variable.
+ * @param NTrackedValsHint   -- Expected number of tracked variables.
+ * @param BlackBoxBuffer_Ptr -- Memory resource the blackbox buffer is allocated from.
  */
 ym::DataLogger::DataLogger(
-   sizet const MaxDepth,
-   sizet const NTrackedValsHint) :
-      _MaxDepth         {MaxDepth        },
-      _nTrackedValsHint {NTrackedValsHint}
+   sizet                       const MaxDepth,
+   sizet                       const NTrackedValsHint,
+   std::pmr::memory_resource * const BlackBoxBuffer_Ptr) :
+      _blackBoxBuffer   {BlackBoxBuffer_Ptr},
+      _MaxDepth         {MaxDepth          },
+      _nTrackedValsHint {NTrackedValsHint  }
 {
    YMASSERT(getMaxDepth() > 0uz, Error, YM_DAH, "Depth of data logger must be > 0");
 
@@ -37,6 +132,17 @@ ym::DataLogger::DataLogger(
    }
 }
 
+/** ~DataLogger
+ * 
+ * @brief Destructor.
+ * 
+ * @note A dead logger must not be visible to the crash handlers.
+ */
+ym::DataLogger::~DataLogger(void)
+{
+   disarmCrashDump();
+}
+
 /** ready
  * 
  * @brief Initializes the data logger.
@@ -72,6 +178,30 @@ bool ym::DataLogger::ready(void)
    return _initialized;
 }
 
+/** trackTimestamp
+ *
+ * @brief Adds a hidden column, stamped with getTimestamp_ns() on every acquire().
+ * 
+ * @note The column is named _s_TimestampName and is always the first of the row. Use it
+ *       to spot jitter in the calling loop or to merge dumps of separate loggers (see
+ *       ympyutils.py).
+ * 
+ * @throws Error -- If the logger is already initialized (the row layout is fixed).
+ */
+void ym::DataLogger::trackTimestamp(void)
+{
+   YMASSERT(!isInitialized(), Error, YM_DAH,
+      "Timestamps must be tracked before the data logger is ready")
+
+   if (!isTimestamped())
+   { // insert up front - shifting assigns (clones) the others, so construct it first
+      RawTrackedVal_T timestamp;
+      timestamp.construct<TrackedVal<int64>>(_s_TimestampName, bptr<void const>(&_timestamp_ns));
+      (void)_trackedVals.insert(_trackedVals.cbegin(), timestamp);
+      _timestamped = true;
+   }
+}
+
 /** acquire
  *
  * @brief Reads all registered variables and stores them in the latest slot in the buffer.
@@ -85,6 +215,16 @@ void ym::DataLogger::acquire(void)
       (void)ready();
    }
 
+   if (isTimestamped())
+   { // stamp the row
+      _timestamp_ns = getTimestamp_ns();
+   }
+
+   if (!_stats._names.empty())
+   { // opted-in to statistics
+      updateStats();
+   }
+
    for (auto const & Val : _trackedVals)
    { // iterate through all registered values and read the associate variables
       std::memcpy(
@@ -102,9 +242,200 @@ void ym::DataLogger::acquire(void)
    }
 }
 
+/** trackStats
+ *
+ * @brief Opts a tracked variable in to streaming statistics (see getStats()).
+ * 
+ * @throws Error -- If the histogram range is empty.
+ * @throws Error -- If the variable is not tracked, not numeric, or already opted-in.
+ * @throws Error -- If statistics have already been gathered (see resetStats()).
+ * 
+ * @param Name    -- Name of tracked variable.
+ * @param HistMin -- Lower edge of histogram.
+ * @param HistMax -- Upper edge of histogram.
+ */
+void ym::DataLogger::trackStats(
+   str     const Name,
+   float64 const HistMin,
+   float64 const HistMax)
+{
+   YMASSERT(HistMin < HistMax, Error, YM_DAH,
+      "Histogram range of '{}' is empty ([{}, {}])", Name, HistMin, HistMax)
+
+   YMASSERT(_stats._count == 0_u64, Error, YM_DAH,
+      "Statistics of '{}' must be tracked before the first acquire", Name)
+
+   YMASSERT(getStatsIdx(Name) == _stats._names.size(), Error, YM_DAH,
+      "Statistics of '{}' already tracked", Name)
+
+   auto const It = std::find_if(_trackedVals.cbegin(), _trackedVals.cend(),
+      [Name](RawTrackedVal_T const & RTV) {
+         return std::strcmp(RTV->getName().get(), Name.get()) == 0;
+      }
+   );
+
+   YMASSERT(It != _trackedVals.cend(), Error, YM_DAH, "'{}' is not tracked", Name)
+
+   auto const Type = (*It)->getDataType();
+
+   YMASSERT(Type != DataType_T::Other, Error, YM_DAH, "'{}' is not numeric", Name)
+
+   _stats._names   .push_back(Name);
+   _stats._srcs    .push_back((*It)->_Read_BPtr);
+   _stats._types   .push_back(Type);
+   _stats._samples .push_back(0.0_f64);
+   _stats._min     .push_back( std::numeric_limits<float64>::infinity());
+   _stats._max     .push_back(-std::numeric_limits<float64>::infinity());
+   _stats._mean    .push_back(0.0_f64);
+   _stats._m2      .push_back(0.0_f64);
+   _stats._histMin .push_back(HistMin);
+   _stats._histMax .push_back(HistMax);
+   _stats._binScale.push_back(static_cast<float64>(_s_NHistBins) / (HistMax - HistMin));
+   _stats._bins    .push_back(0_u32);
+   _stats._hist    .resize(_stats._hist.size() + _s_NHistBins, 0_u64);
+}
+
+/** getStats
+ *
+ * @brief Returns the statistics of a tracked variable.
+ * 
+ * @throws Error -- If the variable was not opted-in (see trackStats()).
+ * 
+ * @param Name -- Name of tracked variable.
+ * 
+ * @returns Stats_T -- Statistics over all acquisitions since the last resetStats().
+ */
+auto ym::DataLogger::getStats(str const Name) const -> Stats_T
+{
+   auto const Idx = getStatsIdx(Name);
+
+   YMASSERT(Idx < _stats._names.size(), Error, YM_DAH, "Statistics of '{}' not tracked", Name)
+
+   Stats_T stats{};
+   stats._count   = _stats._count;
+   stats._histMin = _stats._histMin[Idx];
+   stats._histMax = _stats._histMax[Idx];
+
+   if (stats._count > 0_u64)
+   { // something gathered
+      stats._min  = _stats._min [Idx];
+      stats._max  = _stats._max [Idx];
+      stats._mean = _stats._mean[Idx];
+   }
+
+   if (stats._count > 1_u64)
+   { // variance defined
+      stats._variance = _stats._m2[Idx] / static_cast<float64>(stats._count - 1_u64);
+   }
+
+   std::copy_n(_stats._hist.cbegin() + static_cast<std::ptrdiff_t>(Idx * _s_NHistBins),
+      _s_NHistBins, stats._hist.begin());
+
+   return stats;
+}
+
+/** resetStats
+ *
+ * @brief Clears the statistics of all opted-in variables (they stay opted-in).
+ */
+void ym::DataLogger::resetStats(void)
+{
+   std::ranges::fill(_stats._min,   std::numeric_limits<float64>::infinity());
+   std::ranges::fill(_stats._max,  -std::numeric_limits<float64>::infinity());
+   std::ranges::fill(_stats._mean, 0.0_f64);
+   std::ranges::fill(_stats._m2,   0.0_f64);
+   std::ranges::fill(_stats._hist, 0_u64  );
+   _stats._count = 0_u64;
+}
+
+/** updateStats
+ *
+ * @brief Folds the current value of every opted-in variable into its statistics.
+ * 
+ * @note Welford's algorithm. Apart from gathering the samples (and bumping the histogram
+ *       bins) the loops are branchless over contiguous arrays, so the compiler is free to
+ *       vectorize across columns.
+ */
+void ym::DataLogger::updateStats(void)
+{
+   auto const NCols = _stats._names.size();
+
+   for (auto i = 0uz; i < NCols; ++i)
+   { // gather
+      _stats._samples[i] = loadAsFloat64(_stats._types[i], _stats._srcs[i].get());
+   }
+
+   _stats._count++;
+
+   auto const     InvCount = 1.0_f64 / static_cast<float64>(_stats._count);
+   constexpr auto TopBin   = static_cast<float64>(_s_NHistBins - 1uz);
+
+   auto const * const Samples_Ptr  = _stats._samples .data();
+   auto const * const HistMin_Ptr  = _stats._histMin .data();
+   auto const * const BinScale_Ptr = _stats._binScale.data();
+   auto       * const min_Ptr      = _stats._min     .data();
+   auto       * const max_Ptr      = _stats._max     .data();
+   auto       * const mean_Ptr     = _stats._mean    .data();
+   auto       * const m2_Ptr       = _stats._m2      .data();
+   auto       * const bins_Ptr     = _stats._bins    .data();
+
+   for (auto i = 0uz; i < NCols; ++i)
+   { // update - vectorizable
+      auto const X     = Samples_Ptr[i];
+      auto const Delta = X - mean_Ptr[i];
+
+      min_Ptr [i]  = std::min(min_Ptr[i], X);
+      max_Ptr [i]  = std::max(max_Ptr[i], X);
+      mean_Ptr[i] += Delta * InvCount;
+      m2_Ptr  [i] += Delta * (X - mean_Ptr[i]);
+
+      // out of range samples go to the edge bins (NaNs to the first)
+      bins_Ptr[i] = static_cast<uint32>(
+         std::max(0.0_f64, std::min((X - HistMin_Ptr[i]) * BinScale_Ptr[i], TopBin)));
+   }
+
+   for (auto i = 0uz; i < NCols; ++i)
+   { // scatter
+      _stats._hist[(i * _s_NHistBins) + bins_Ptr[i]]++;
+   }
+}
+
+/** logStats
+ *
+ * @brief Logs a summary of the statistics of every opted-in variable.
+ */
+void ym::DataLogger::logStats(void) const
+{
+   for (auto const & Name : _stats._names)
+   { // summarize
+      auto const Stats = getStats(Name);
+      ymLog(VG::DataLogger, "{}: n {} min {} max {} mean {} stddev {} hist [{}, {}] {}",
+         Name, Stats._count, Stats._min, Stats._max, Stats._mean, std::sqrt(Stats._variance),
+         Stats._histMin, Stats._histMax, fmt::join(Stats._hist, " "));
+   }
+}
+
+/** getStatsIdx
+ *
+ * @brief Returns the index of the statistics of a tracked variable.
+ * 
+ * @param Name -- Name of tracked variable.
+ * 
+ * @returns sizet -- Index into the statistics arrays, or their size if not found.
+ */
+auto ym::DataLogger::getStatsIdx(str const Name) const -> sizet
+{
+   auto const It = std::ranges::find_if(_stats._names,
+      [Name](str const S) { return std::strcmp(S.get(), Name.get()) == 0; });
+
+   return static_cast<sizet>(It - _stats._names.cbegin());
+}
+
 /** reset
  *
  * @brief Resets black box buffer.
+ * 
+ * @note Statistics are kept (see resetStats()).
  */
 void ym::DataLogger::reset(void)
 {
@@ -132,6 +463,8 @@ bool ym::DataLogger::dump(
 
    if (Opened)
    { // file opened
+      logStats();
+
       for (auto i = 0uz; i < _trackedVals.size(); i++)
       { // print all the headers
          if (i > 0uz)
@@ -178,39 +511,256 @@ bool ym::DataLogger::dump(
       }
       else
       { // text format
-         char buffer[100uz]{'\0'};
+         // rows are formatted into a chunk, written out whenever the next value might not fit
+         constexpr auto MaxValSize = 100uz;
+
+         auto         chunk     = std::array<char, 16uz * 1024uz>{};
+         auto *       write_ptr = chunk.data();
+         auto * const End_Ptr   = chunk.data() + chunk.size();
+
+         auto const Flush = [&]() {
+            (void)std::fwrite(chunk.data(), 1uz, static_cast<sizet>(write_ptr - chunk.data()), _outfile_uptr.get());
+            write_ptr = chunk.data();
+         };
+
          for (auto i = 0uz; i < nRowsCaptured; i++)
          { // print data from oldest to newest
             for (auto j = 0uz; j < _trackedVals.size(); j++)
             { // print row
+               if (static_cast<sizet>(End_Ptr - write_ptr) < MaxValSize + 2uz)
+               { // room for comma, value and newline
+                  Flush();
+               }
+
                if (j > 0uz)
                { // prevent printing trailing comma
-                  fmt::print(_outfile_uptr.get(), ",");
+                  *write_ptr++ = ',';
                }
-               _trackedVals[j]->toStr(_blackBoxBuffer.data() + currEntry_idx, buffer);
+
+               write_ptr = _trackedVals[j]->toStr(
+                  _blackBoxBuffer.data() + currEntry_idx,
+                  std::span<char>(write_ptr, MaxValSize));
                currEntry_idx += _trackedVals[j]->_Size_bytes;
-               fmt::print(_outfile_uptr.get(), "{}", buffer);
             }
             currEntry_idx %= _blackBoxBuffer.size();
-            fmt::print(_outfile_uptr.get(), "\n");
+            *write_ptr++ = '\n';
          }
+
+         Flush();
       }
+
+      commitWrite();
    }
 
    return Opened;
 }
 
-void ym::DataLogger::TrackedValBase::toStr_Handler(
+/** armCrashDump
+ * 
+ * @brief Registers this logger to be dumped if the program dies.
+ * 
+ * @note The file is opened (and truncated) here so nothing but write(2) is needed when
+ *       the program is dying. The blackbox buffer is also readied here, so all tracked
+ *       variables must be registered before calling this.
+ * 
+ * @note The crash dump is in the binary format (see dump()).
+ * 
+ * @throws CrashDumpError -- If there is no room left in the crash registry.
+ * @throws Whatever ready() throws.
+ * 
+ * @param Filename -- Name of file to dump data to.
+ * 
+ * @returns bool -- If the logger is armed.
+ */
+bool ym::DataLogger::armCrashDump(str const Filename)
+{
+   if (!isCrashDumpArmed())
+   { // not yet registered
+
+      if (!isInitialized())
+      { // buffer must exist before we can dump it
+         (void)ready();
+      }
+
+      auto registered = false;
+      for (auto & slot_ref : _s_crashRegistry)
+      { // claim first free slot
+         DataLogger * expected = nullptr;
+         if (slot_ref.compare_exchange_strong(expected, this, std::memory_order_acq_rel))
+         { // slot claimed
+            registered = true;
+            break;
+         }
+      }
+
+      YMASSERT(registered, CrashDumpError, YM_DAH,
+         "No room for more than {} crash dump loggers", _s_MaxCrashDumpLoggers)
+
+      _crashDump_fd = ::open(Filename.get(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+      if (!isCrashDumpArmed())
+      { // failed to open - give the slot back
+         ymLog(VG::Warning, "WARNING: Could not open crash dump file '{}' (errno {})", Filename, errno);
+         disarmCrashDump();
+      }
+   }
+
+   return isCrashDumpArmed();
+}
+
+/** disarmCrashDump
+ * 
+ * @brief Removes this logger from the crash registry and closes the crash dump file.
+ */
+void ym::DataLogger::disarmCrashDump(void)
+{
+   for (auto & slot_ref : _s_crashRegistry)
+   { // release our slot (if we have one)
+      DataLogger * expected = this;
+      if (slot_ref.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel))
+      { // found it
+         break;
+      }
+   }
+
+   if (isCrashDumpArmed())
+   { // file opened
+      (void)::close(_crashDump_fd);
+      _crashDump_fd = -1;
+   }
+}
+
+/** crashDump
+ * 
+ * @brief Writes the blackbox to the preopened crash dump file.
+ * 
+ * @note Async-signal-safe. Output matches the binary mode of dump().
+ * 
+ * @note If the program died in the middle of acquire() the newest row may be torn.
+ * 
+ * @note Works between reset() and the next acquire() too - the buffer outlives the reset.
+ * 
+ * @returns bool -- If the dump was successful.
+ */
+bool ym::DataLogger::crashDump(void) const noexcept
+{
+   if (!isCrashDumpArmed() || _blackBoxBuffer.empty())
+   { // nothing to do
+      return false;
+   }
+
+   auto success = true;
+
+   for (auto i = 0uz; i < _trackedVals.size(); i++)
+   { // write all the headers
+      if (i > 0uz)
+      { // prevent writing trailing comma
+         success = success && writeAll(_crashDump_fd, ",", 1uz);
+      }
+      auto const Name = _trackedVals[i]->getName();
+      success = success && writeAll(_crashDump_fd, Name.get(), std::strlen(Name.get()));
+   }
+   success = success && writeAll(_crashDump_fd, "\n", 1uz);
+
+   auto const NextEntry_idx = _nextEntry_idx; // snapshot
+
+   if (_rollover)
+   { // data not contiguous - requires two write blocks
+      success = success && writeAll(
+         _crashDump_fd,
+         _blackBoxBuffer.data() + NextEntry_idx,
+         _blackBoxBuffer.size() - NextEntry_idx);
+   }
+
+   success = success && writeAll(_crashDump_fd, _blackBoxBuffer.data(), NextEntry_idx);
+
+   (void)::fsync(_crashDump_fd);
+
+   return success;
+}
+
+/** installCrashHandlers
+ * 
+ * @brief Installs signal handlers (and the fatal assert hook) that dump all armed loggers.
+ * 
+ * @note Opt-in. Handlers are one-shot (SA_RESETHAND) - after dumping, the signal is
+ *       re-raised with the default disposition so the program dies as it would have.
+ * 
+ * @note Handlers run on an alternate stack, but sigaltstack(2) is per thread - this only
+ *       gives one to the calling thread. A stack overflow on any other thread can't run
+ *       the handler (the kernel kills the process instead) unless that thread installs
+ *       its own alternate stack with sigaltstack(2).
+ */
+void ym::DataLogger::installCrashHandlers(void)
+{
+   static std::array<byte, 64uz * 1024uz> s_altStack{};
+
+   stack_t ss{};
+   ss.ss_sp    = s_altStack.data();
+   ss.ss_size  = s_altStack.size();
+   ss.ss_flags = 0;
+   (void)::sigaltstack(&ss, nullptr);
+
+   struct sigaction sa{};
+   sa.sa_handler = crashSignalHandler;
+   sa.sa_flags   = SA_RESETHAND | SA_ONSTACK;
+   (void)::sigemptyset(&sa.sa_mask);
+
+   for (auto const Signal : {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT, SIGTERM})
+   { // install handler for all fatal signals
+      (void)::sigaction(Signal, &sa, nullptr);
+   }
+
+   ymassert_Base::setFatalHook(crashDumpAll);
+}
+
+/** crashDumpAll
+ * 
+ * @brief Dumps all armed loggers.
+ * 
+ * @note Async-signal-safe. Only the first call does anything, so the assert hook and
+ *       the signal it raises don't dump twice.
+ */
+void ym::DataLogger::crashDumpAll(void) noexcept
+{
+   if (!_s_crashDumped.test_and_set(std::memory_order_acq_rel))
+   { // first one here
+      for (auto const & Slot : _s_crashRegistry)
+      { // dump all registered loggers
+         if (auto const * const Logger_Ptr = Slot.load(std::memory_order_acquire); Logger_Ptr)
+         { // slot in use
+            (void)Logger_Ptr->crashDump();
+         }
+      }
+   }
+}
+
+/** crashSignalHandler
+ * 
+ * @brief Dumps all armed loggers then lets the signal take its default course.
+ * 
+ * @param Signal -- Caught signal.
+ */
+void ym::DataLogger::crashSignalHandler(int const Signal)
+{
+   crashDumpAll();
+   (void)::raise(Signal); // disposition already reset to default (SA_RESETHAND)
+}
+
+/** toStr_Handler
+ * 
+ * @brief Formats a value of any type fmt knows, truncating to fit the buffer.
+ * 
+ * @note Does *not* write null terminator.
+ * 
+ * @param buffer -- Buffer to write to.
+ * @param args   -- Value to format.
+ * 
+ * @returns char * -- Where to continue writing into the buffer.
+ */
+char * ym::DataLogger::TrackedValBase::toStr_Handler(
    std::span<char>  buffer,
    fmt::format_args args) const
 {
-   if (!buffer.empty())
-   { // room to write
-      auto result = fmt::vformat_to_n(
-         buffer.data(),
-         buffer.size() - 1uz,
-         "{}",
-         args);
-      *result.out = '\0';
-   }
+   return fmt::vformat_to_n(buffer.data(), buffer.size(), "{}", args).out;
 }
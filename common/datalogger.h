@@ -10,11 +10,16 @@
 
 #include "logger.h"
 #include "nameable.h"
+#include "ops.h"
 
 #include "fmt/base.h"
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <memory_resource>
 #include <span>
+#include <type_traits>
 #include <vector>
 
 namespace ym
@@ -29,9 +34,21 @@ namespace ym
  *       these values are stored in a separate array for efficiency.
  * 
  * @note *Not* thread-safe.
+ * 
+ * @note Loggers can opt-in to be dumped when the program dies (see armCrashDump()). The
+ *       crash dump path is async-signal-safe - it only uses write(2) on a file descriptor
+ *       opened ahead of time. No formatting nor allocation happens.
+ * 
+ * @note Rows can opt-in to carry a timestamp (see trackTimestamp()). It is stored as the
+ *       first column, so every dump format exports it without special casing.
+ * 
+ * @note Numeric columns can opt-in to streaming statistics (see trackStats()). These cover
+ *       every acquire() of the run, not just what the blackbox currently holds.
  */
 class DataLogger : public Logger
 {
+   friend class ShmDataLogger; // lays out its segment from the tracked variables
+
 public:
    /** DumpMode_T
     * 
@@ -64,21 +81,69 @@ public:
       }
    };
 
+   /** DataType_T
+    * 
+    * @brief Tag describing the type of a tracked variable (for out-of-process readers).
+    */
+   enum class DataType_T : uint8
+   {
+      Other,
+      Bool,
+      Char,
+      Int8,  Int16,  Int32,  Int64,
+      Uint8, Uint16, Uint32, Uint64,
+      Float32,
+      Float64
+   };
+
+   template <typename T>
+   static constexpr DataType_T getDataType(void);
+
+   static constexpr auto _s_NHistBins = 16uz;
+
+   /** Stats_T
+    * 
+    * @brief Summary of a tracked variable over all acquisitions.
+    * 
+    * @note Samples outside of the histogram range are counted in the edge bins.
+    */
+   struct Stats_T
+   {
+      uint64                           _count   {0_u64  };
+      float64                          _min     {0.0_f64};
+      float64                          _max     {0.0_f64};
+      float64                          _mean    {0.0_f64};
+      float64                          _variance{0.0_f64}; // sample variance
+      float64                          _histMin {0.0_f64};
+      float64                          _histMax {0.0_f64};
+      std::array<uint64, _s_NHistBins> _hist    {       };
+   };
+
    static constexpr Options_T getDefaultOptions(void) { return {}; }
 
+   /// @brief Clock stamped on every row - CLOCK_MONOTONIC, so rows of separate loggers
+   ///        (even of separate processes on the same machine) share a timeline.
+   using TimestampClock_T = std::chrono::steady_clock;
+
+   static constexpr auto _s_TimestampName = "timestamp_ns";
+
    explicit DataLogger(
-      sizet const MaxDepth,
-      sizet const NTrackedValsHint = 0uz);
+      sizet                       const MaxDepth,
+      sizet                       const NTrackedValsHint   = 0uz,
+      std::pmr::memory_resource * const BlackBoxBuffer_Ptr = std::pmr::get_default_resource());
+   ~DataLogger(void);
 
    YM_NO_COPY  (DataLogger)
    YM_NO_ASSIGN(DataLogger)
 
    YM_DECL_YMASSERT(Error)
+   YM_DECL_YMASSERT(CrashDumpError)
 
    bool ready(void);
 
    inline auto getMaxDepth  (void) const { return _MaxDepth;    }
    inline auto isInitialized(void) const { return _initialized; }
+   inline auto isTimestamped(void) const { return _timestamped; }
 
    /// @brief Forwarding function.
    template <typename T>
@@ -91,13 +156,41 @@ public:
       str           const Name,
       bptr<T const> const Read_BPtr);
 
+   void trackTimestamp(void);
+
+   void trackStats(
+      str     const Name,
+      float64 const HistMin,
+      float64 const HistMax);
+
+   Stats_T getStats(str const Name) const;
+   void    resetStats(void);
+
+   static inline int64 getTimestamp_ns(void);
+
    void acquire(void);
    void reset(void);
    bool dump(
       str       const   Filename,
       Options_T const & Options = getDefaultOptions());
 
+   bool armCrashDump(str const Filename);
+   void disarmCrashDump(void);
+   bool crashDump(void) const noexcept;
+
+   inline auto isCrashDumpArmed(void) const { return _crashDump_fd >= 0; }
+
+   static void installCrashHandlers(void);
+   static void crashDumpAll(void) noexcept;
+
 private:
+   static void crashSignalHandler(int const Signal);
+
+   void  updateStats(void);
+   void  logStats   (void) const;
+   sizet getStatsIdx(str const Name) const;
+
+protected:
    /** TrackedValBase
     * 
     * @brief Meta data carrier.
@@ -132,15 +225,17 @@ private:
          bptr<void> const val_BPtr,
          sizet      const Size_bytes) const = 0;
 
-      virtual void toStr(
+      virtual char * toStr(
          bptr<void const> const Entry_BPtr,
          std::span<char>        buffer) const = 0;
 
+      virtual DataType_T getDataType(void) const = 0;
+
       bptr<void const> const _Read_BPtr;
       sizet            const _Size_bytes;
 
    protected:
-      void toStr_Handler(
+      char * toStr_Handler(
          std::span<char>  buffer,
          fmt::format_args args) const;
    };
@@ -161,13 +256,47 @@ private:
          bptr<void> const val_BPtr,
          sizet      const Size_bytes) const override;
 
-      virtual void toStr(
+      virtual char * toStr(
          bptr<void const> const Entry_BPtr,
          std::span<char>        buffer) const override;
+
+      virtual DataType_T getDataType(void) const override { return DataLogger::getDataType<T>(); }
    };
 
    using RawTrackedVal_T = PolyRaw<TrackedValBase, sizeof(TrackedVal<int>)>;
 
+   static constexpr auto _s_MaxCrashDumpLoggers = 16uz;
+
+   using CrashRegistry_T = std::array<std::atomic<DataLogger *>, _s_MaxCrashDumpLoggers>;
+
+   /** StatsCols_T
+    * 
+    * @brief Running statistics of all opted-in columns.
+    * 
+    * @note Structure of arrays (one entry per column) so the update loops in acquire()
+    *       vectorize across columns.
+    */
+   struct StatsCols_T
+   {
+      std::vector<str>              _names   {     };
+      std::vector<bptr<void const>> _srcs    {     }; // tracked variables
+      std::vector<DataType_T>       _types   {     };
+      std::vector<float64>          _samples {     }; // scratch - latest values
+      std::vector<float64>          _min     {     };
+      std::vector<float64>          _max     {     };
+      std::vector<float64>          _mean    {     };
+      std::vector<float64>          _m2      {     }; // sum of squared deviations
+      std::vector<float64>          _histMin {     };
+      std::vector<float64>          _histMax {     };
+      std::vector<float64>          _binScale{     }; // bins per unit
+      std::vector<uint32>           _bins    {     }; // scratch - bin of latest values
+      std::vector<uint64>           _hist    {     }; // _s_NHistBins per column
+      uint64                        _count   {0_u64}; // shared by all columns
+   };
+
+   static inline CrashRegistry_T  _s_crashRegistry{ /* default */ };
+   static inline std::atomic_flag _s_crashDumped  { /* default */ };
+
    std::pmr::vector<
       RawTrackedVal_T>    _trackedVals   {    };
    std::pmr::vector<byte> _blackBoxBuffer{    };
@@ -176,10 +305,54 @@ private:
       sizet               _nTrackedValsHint{0uz};
       sizet               _nextEntry_idx;
    };
-   bool                   _rollover   {false};
-   bool                   _initialized{false};
+   StatsCols_T            _stats       {     };
+   int64                  _timestamp_ns{0_i64}; // read by the timestamp column
+   int                    _crashDump_fd{-1   };
+   bool                   _rollover    {false};
+   bool                   _initialized {false};
+   bool                   _timestamped {false};
 };
 
+/** getDataType
+ * 
+ * @brief Maps a type to its tag.
+ * 
+ * @tparam T -- Type to map.
+ * 
+ * @returns DataType_T -- Tag of type, or Other if not a fundamental type.
+ */
+template <typename T>
+constexpr auto DataLogger::getDataType(void) -> DataType_T
+{
+   using U = std::remove_cv_t<T>;
+
+   if      constexpr (std::is_same_v<U, bool   >) { return DataType_T::Bool;    }
+   else if constexpr (std::is_same_v<U, char   >) { return DataType_T::Char;    }
+   else if constexpr (std::is_same_v<U, int8   >) { return DataType_T::Int8;    }
+   else if constexpr (std::is_same_v<U, int16  >) { return DataType_T::Int16;   }
+   else if constexpr (std::is_same_v<U, int32  >) { return DataType_T::Int32;   }
+   else if constexpr (std::is_same_v<U, int64  >) { return DataType_T::Int64;   }
+   else if constexpr (std::is_same_v<U, uint8  >) { return DataType_T::Uint8;   }
+   else if constexpr (std::is_same_v<U, uint16 >) { return DataType_T::Uint16;  }
+   else if constexpr (std::is_same_v<U, uint32 >) { return DataType_T::Uint32;  }
+   else if constexpr (std::is_same_v<U, uint64 >) { return DataType_T::Uint64;  }
+   else if constexpr (std::is_same_v<U, float32>) { return DataType_T::Float32; }
+   else if constexpr (std::is_same_v<U, float64>) { return DataType_T::Float64; }
+   else                                           { return DataType_T::Other;   }
+}
+
+/** getTimestamp_ns
+ * 
+ * @brief Returns the current time of the timestamp clock.
+ * 
+ * @returns int64 -- Nanoseconds since an unspecified (but system wide) epoch.
+ */
+inline int64 DataLogger::getTimestamp_ns(void)
+{
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      TimestampClock_T::now().time_since_epoch()).count();
+}
+
 /** track
  * 
  * @brief Adds a data variable to be tracked.
@@ -245,19 +418,34 @@ void DataLogger::TrackedVal<T>::cloneAt(
  * 
  * @brief Stringifies the given data type.
  * 
- * @note To accomodate types not supported by std::to_string() you can either
- *       specialize Stringify or specialize std::to_string().
+ * @note Does *not* write null terminator.
+ * 
+ * @note Numbers go through Ops' formatters when the buffer is big enough for any value,
+ *       everything else through fmt (so specialize fmt::formatter for your own types).
  * 
  * @tparam T -- Type of variable to convert to.
  * 
- * @param DataEntry_Ptr -- Pointer to data to stringify.
+ * @param Entry_BPtr -- Pointer to data to stringify.
+ * @param buffer     -- Buffer to write to.
+ * 
+ * @returns char * -- Where to continue writing into the buffer.
  */
 template <typename T>
-void DataLogger::TrackedVal<T>::toStr(
+char * DataLogger::TrackedVal<T>::toStr(
    bptr<void const> const Entry_BPtr,
    std::span<char>        buffer) const
 {
-   toStr_Handler(buffer, fmt::make_format_args(*static_cast<T const *>(Entry_BPtr.get())));
+   auto const & Val = *static_cast<T const *>(Entry_BPtr.get());
+
+   if constexpr (Formattable<T>)
+   { // fast path
+      if (buffer.size() >= Ops::_s_MaxFormattedSize)
+      { // room for any value
+         return Ops::formatTo(buffer.data(), Val);
+      }
+   }
+
+   return toStr_Handler(buffer, fmt::make_format_args(Val));
 }
 
 } // ym
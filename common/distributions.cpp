@@ -0,0 +1,208 @@
+/**
+ * @file    distributions.cpp
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#include "distributions.h"
+
+/// @brief Built at compile time - no static initialization order to worry about.
+constinit ym::Ziggurat::Tables_T<128uz> const ym::Ziggurat::_s_Normal      = makeNormalTables();
+constinit ym::Ziggurat::Tables_T<256uz> const ym::Ziggurat::_s_Exponential = makeExponentialTables();
+
+/** PrngBuffer
+ *
+ * @brief Constructor.
+ *
+ * @note Nothing is drawn until the first value is asked for.
+ *
+ * @param prng_ref -- Generator to draw from.
+ */
+ym::PrngBuffer::PrngBuffer(Prng & prng_ref) :
+   _prng_ref {prng_ref    },
+   _vals     {            },
+   _idx      {_vals.size()}
+{ }
+
+/** ~PrngBuffer
+ *
+ * @brief Destructor. Gives back the values not handed out.
+ */
+ym::PrngBuffer::~PrngBuffer(void)
+{
+   _prng_ref.jump(0_u64 - (_vals.size() - _idx)); // period is 2^64 - steps back
+}
+
+/** refill
+ *
+ * @brief Draws the next batch of values.
+ */
+void ym::PrngBuffer::refill(void)
+{
+   _prng_ref.fill(_vals);
+   _idx = 0uz;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** UniformIntDist
+ *
+ * @brief Constructor.
+ *
+ * @throws Error -- If the range is empty.
+ *
+ * @param Lo -- Smallest value (inclusive).
+ * @param Hi -- Largest value (inclusive).
+ */
+ym::UniformIntDist::UniformIntDist(
+   int64 const Lo,
+   int64 const Hi) :
+      _Lo        {Lo                                                          },
+      _Hi        {Hi                                                          },
+      _Range     {std::bit_cast<uint64>(Hi) - std::bit_cast<uint64>(Lo) + 1_u64},
+      _Threshold {(_Range > 0_u64) ? (0_u64 - _Range) % _Range : 0_u64        }
+{
+   YMASSERT(Lo <= Hi, Error, YM_DAH, "Empty range [{}..{}]", Lo, Hi);
+}
+
+/** fill
+ *
+ * @brief Fills the range with random values.
+ *
+ * @note Same values (and resulting state) as calling operator () vals.size() times.
+ *
+ * @param prng -- Generator to draw from.
+ * @param vals -- Range to fill.
+ */
+void ym::UniformIntDist::fill(
+   Prng &           prng,
+   std::span<int64> vals) const
+{
+   PrngBuffer buffer(prng);
+
+   for (auto & val : vals)
+   { // each value
+      val = (*this)(buffer);
+   }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** NormalDist
+ *
+ * @brief Constructor.
+ *
+ * @throws Error -- If the standard deviation is negative.
+ *
+ * @param Mean   -- Mean.
+ * @param StdDev -- Standard deviation.
+ */
+ym::NormalDist::NormalDist(
+   float64 const Mean,
+   float64 const StdDev) :
+      _Mean   {Mean  },
+      _StdDev {StdDev}
+{
+   YMASSERT(StdDev >= 0.0_f64, Error, YM_DAH, "Standard deviation must be >= 0, got {}", StdDev);
+}
+
+/** fill
+ *
+ * @brief Fills the range with random values.
+ *
+ * @note Same values (and resulting state) as calling operator () vals.size() times.
+ *
+ * @param prng -- Generator to draw from.
+ * @param vals -- Range to fill.
+ */
+void ym::NormalDist::fill(
+   Prng &             prng,
+   std::span<float64> vals) const
+{
+   PrngBuffer buffer(prng);
+
+   for (auto & val : vals)
+   { // each value
+      val = (*this)(buffer);
+   }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** ExponentialDist
+ *
+ * @brief Constructor.
+ *
+ * @throws Error -- If the rate is not positive.
+ *
+ * @param Rate -- Rate (1 / mean).
+ */
+ym::ExponentialDist::ExponentialDist(float64 const Rate) :
+   _Rate {Rate}
+{
+   YMASSERT(Rate > 0.0_f64, Error, YM_DAH, "Rate must be > 0, got {}", Rate);
+}
+
+/** fill
+ *
+ * @brief Fills the range with random values.
+ *
+ * @note Same values (and resulting state) as calling operator () vals.size() times.
+ *
+ * @param prng -- Generator to draw from.
+ * @param vals -- Range to fill.
+ */
+void ym::ExponentialDist::fill(
+   Prng &             prng,
+   std::span<float64> vals) const
+{
+   PrngBuffer buffer(prng);
+
+   for (auto & val : vals)
+   { // each value
+      val = (*this)(buffer);
+   }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** BernoulliDist
+ *
+ * @brief Constructor.
+ *
+ * @throws Error -- If P is outside of [0..1].
+ *
+ * @param P -- Probability of true.
+ */
+ym::BernoulliDist::BernoulliDist(float64 const P) :
+   _P         {P                                                                  },
+   _Threshold {(P > 0.0_f64 && P < 1.0_f64) ? static_cast<uint64>(P * 0x1p64) : 0_u64},
+   _Always    {P >= 1.0_f64                                                       }
+{
+   YMASSERT(P >= 0.0_f64 && P <= 1.0_f64, Error, YM_DAH, "Probability must be in [0..1], got {}", P);
+}
+
+/** fill
+ *
+ * @brief Fills the range with random values.
+ *
+ * @note Same values (and resulting state) as calling operator () vals.size() times.
+ *
+ * @param prng -- Generator to draw from.
+ * @param vals -- Range to fill.
+ */
+void ym::BernoulliDist::fill(
+   Prng &          prng,
+   std::span<bool> vals) const
+{
+   PrngBuffer buffer(prng);
+
+   for (auto & val : vals)
+   { // each value
+      val = (*this)(buffer);
+   }
+}
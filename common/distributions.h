@@ -0,0 +1,577 @@
+/**
+ * @file    distributions.h
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#pragma once
+
+#include "ymglobals.h"
+
+#include "rng.h"
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <span>
+
+namespace ym
+{
+
+/** RandomSource
+ *
+ * @brief Anything that hands out uniform 64-bit values (Prng, Trng, PrngBuffer).
+ *
+ * @tparam T -- Type of source.
+ */
+template <typename T>
+concept RandomSource = requires(T source) {
+   { source() } -> std::same_as<uint64>;
+};
+
+/** PrngBuffer
+ *
+ * @brief Draws from a Prng in bulk (see Prng::fill()) and hands the values out one at a time.
+ *
+ * @note Values not handed out are given back on destruction (the Prng is stepped back),
+ *       so the Prng ends up exactly where drawing one at a time would have left it.
+ */
+class PrngBuffer
+{
+public:
+   explicit PrngBuffer(Prng & prng_ref);
+   ~PrngBuffer(void);
+
+   YM_NO_COPY  (PrngBuffer)
+   YM_NO_ASSIGN(PrngBuffer)
+
+   inline uint64 operator () (void);
+
+private:
+   void refill(void);
+
+   Prng &                    _prng_ref;
+   std::array<uint64, 256uz> _vals;
+   sizet                     _idx;
+};
+
+/** operator ()
+ *
+ * @brief Hands out the next value.
+ *
+ * @returns uint64 -- Random number in [0..2^64).
+ */
+inline uint64 PrngBuffer::operator () (void)
+{
+   if (_idx == _vals.size())
+   { // used up
+      refill();
+   }
+
+   return _vals[_idx++];
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** UniformIntDist
+ *
+ * @brief Uniform integers in the range [Lo..Hi] - Lemire's nearly divisionless method.
+ *
+ * @note The one division is done up front, so drawing never divides. A value is only
+ *       redrawn with probability (2^64 mod n) / 2^64.
+ *
+ * @ref <https://arxiv.org/abs/1805.10941>
+ */
+class UniformIntDist
+{
+public:
+   explicit UniformIntDist(
+      int64 const Lo,
+      int64 const Hi);
+
+   YM_DECL_YMASSERT(Error)
+
+   inline auto getLo(void) const { return _Lo; }
+   inline auto getHi(void) const { return _Hi; }
+
+   template <RandomSource Source_T>
+   inline int64 operator () (Source_T & source) const;
+
+   void fill(
+      Prng &           prng,
+      std::span<int64> vals) const;
+
+private:
+   int64  const _Lo;
+   int64  const _Hi;
+   uint64 const _Range;     // # of values (0 means all 2^64)
+   uint64 const _Threshold; // 2^64 mod _Range
+};
+
+/** operator ()
+ *
+ * @brief Draws a value.
+ *
+ * @tparam Source_T -- Type of random source.
+ *
+ * @param source -- Random source.
+ *
+ * @returns int64 -- Random number in range.
+ */
+template <RandomSource Source_T>
+inline int64 UniformIntDist::operator () (Source_T & source) const
+{
+   auto const X = source();
+
+   if (_Range == 0_u64)
+   { // every value
+      return std::bit_cast<int64>(X);
+   }
+
+   auto m = static_cast<uint128>(X) * _Range;
+
+   while (static_cast<uint64>(m) < _Threshold)
+   { // would be biased - redraw
+      m = static_cast<uint128>(source()) * _Range;
+   }
+
+   return std::bit_cast<int64>(std::bit_cast<uint64>(_Lo) + static_cast<uint64>(m >> 64));
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** Ziggurat
+ *
+ * @brief Standard normal and exponential variates with the ziggurat method.
+ *
+ * @note One 64-bit draw picks the layer (low bits) and the value (high 53 bits) - no
+ *       bits are shared between the two. About 99% of draws take the fast path, a table
+ *       lookup, an integer compare, and a multiply.
+ *
+ * @note Tables are built at compile time and the rare slow path uses exp()/log() built
+ *       from basic arithmetic only. Sequences are thus the same on any platform with
+ *       IEEE doubles, as long as the compiler doesn't fuse multiply-adds. The fill()
+ *       paths are built with -ffp-contract=off (see build.cmake). Code drawing through
+ *       operator() inlines these functions, so it needs the same flag on targets with
+ *       FMA (eg aarch64, or x86-64 with -mfma).
+ *
+ * @ref <https://www.jstatsoft.org/article/view/v005i08>
+ */
+class Ziggurat
+{
+public:
+   template <RandomSource Source_T>
+   static inline float64 normal(Source_T & source);
+
+   template <RandomSource Source_T>
+   static inline float64 exponential(Source_T & source);
+
+   static constexpr float64 exp(float64 const X);
+   static constexpr float64 log(float64 const X);
+
+private:
+   static constexpr float64 sqrt(float64 const X);
+
+   template <RandomSource Source_T>
+   static inline float64 uniform(Source_T & source);
+
+   template <RandomSource Source_T>
+   static inline float64 uniformNonZero(Source_T & source);
+
+   /** Tables_T
+    *
+    * @brief Per layer: fast path bound, value scale, and density at the layer edge.
+    *
+    * @tparam N -- Number of layers.
+    */
+   template <sizet N>
+   struct Tables_T
+   {
+      std::array<uint64,  N> _k{};
+      std::array<float64, N> _w{};
+      std::array<float64, N> _f{};
+   };
+
+   static constexpr Tables_T<128uz> makeNormalTables(void);
+   static constexpr Tables_T<256uz> makeExponentialTables(void);
+
+   static constexpr auto _s_NormalR      = 3.442619855899_f64;       // start of tail
+   static constexpr auto _s_NormalV      = 9.91256303526217e-3_f64;  // area of each layer
+   static constexpr auto _s_ExponentialR = 7.697117470131487_f64;
+   static constexpr auto _s_ExponentialV = 3.949659822581572e-3_f64;
+
+   static const Tables_T<128uz> _s_Normal;
+   static const Tables_T<256uz> _s_Exponential;
+};
+
+/** exp
+ *
+ * @brief e^X, from basic arithmetic only (reproducible everywhere).
+ *
+ * @note Accurate to a few ulp. Underflows to 0 below -708.
+ *
+ * @param X -- Exponent (<= 709).
+ *
+ * @returns float64 -- e^X.
+ */
+constexpr float64 Ziggurat::exp(float64 const X)
+{
+   constexpr auto Ln2Hi  = 6.93147180369123816490e-01_f64;
+   constexpr auto Ln2Lo  = 1.90821492927058770002e-10_f64;
+   constexpr auto InvLn2 = 1.44269504088896338700e+00_f64;
+
+   if (X < -708.0_f64)
+   { // beyond the normal range
+      return 0.0_f64;
+   }
+
+   // e^X = 2^k * e^r, |r| <= ln(2)/2
+   auto const K = static_cast<int64>((X * InvLn2) + ((X < 0.0_f64) ? -0.5_f64 : 0.5_f64));
+   auto const R = (X - (static_cast<float64>(K) * Ln2Hi)) - (static_cast<float64>(K) * Ln2Lo);
+
+   auto p = 1.0_f64;
+   for (auto n = 13; n >= 1; --n)
+   { // taylor series (horner form)
+      p = 1.0_f64 + ((p * R) / static_cast<float64>(n));
+   }
+
+   return p * std::bit_cast<float64>(static_cast<uint64>(K + 1023_i64) << 52_u64);
+}
+
+/** log
+ *
+ * @brief Natural log of X, from basic arithmetic only (reproducible everywhere).
+ *
+ * @note Accurate to a few ulp.
+ *
+ * @param X -- Value (positive, normal).
+ *
+ * @returns float64 -- ln(X).
+ */
+constexpr float64 Ziggurat::log(float64 const X)
+{
+   constexpr auto Ln2Hi = 6.93147180369123816490e-01_f64;
+   constexpr auto Ln2Lo = 1.90821492927058770002e-10_f64;
+   constexpr auto Sqrt2 = 1.41421356237309504880_f64;
+
+   // X = 2^e * m
+   auto const Bits = std::bit_cast<uint64>(X);
+   auto       e    = static_cast<int64>((Bits >> 52_u64) & 0x7ff_u64) - 1023_i64;
+   auto       m    = std::bit_cast<float64>((Bits & 0x000f'ffff'ffff'ffff_u64) | (1023_u64 << 52_u64));
+
+   if (m > Sqrt2)
+   { // keeps m close to 1
+      m *= 0.5_f64;
+      ++e;
+   }
+
+   // ln(m) = 2 atanh(s), s = (m - 1) / (m + 1), |s| < 0.172
+   auto const S  = (m - 1.0_f64) / (m + 1.0_f64);
+   auto const S2 = S * S;
+
+   auto p = 1.0_f64 / 21.0_f64;
+   for (auto k = 9; k >= 0; --k)
+   { // odd power series (horner form)
+      p = (1.0_f64 / static_cast<float64>((2 * k) + 1)) + (S2 * p);
+   }
+
+   auto const E = static_cast<float64>(e);
+   return (E * Ln2Hi) + ((E * Ln2Lo) + (2.0_f64 * S * p));
+}
+
+/** sqrt
+ *
+ * @brief Square root - only used to build tables at compile time.
+ *
+ * @param X -- Value (non-negative).
+ *
+ * @returns float64 -- Square root of X.
+ */
+constexpr float64 Ziggurat::sqrt(float64 const X)
+{
+   auto y = (X > 1.0_f64) ? X : 1.0_f64;
+   for (auto i = 0; i < 64; ++i)
+   { // newton - converges long before
+      y = 0.5_f64 * (y + (X / y));
+   }
+   return y;
+}
+
+/** uniform
+ *
+ * @brief Uniform real value in [0..1).
+ *
+ * @tparam Source_T -- Type of random source.
+ *
+ * @param source -- Random source.
+ *
+ * @returns float64 -- Random number in range.
+ */
+template <RandomSource Source_T>
+inline float64 Ziggurat::uniform(Source_T & source)
+{
+   return Prng::convertToFloat64(source());
+}
+
+/** uniformNonZero
+ *
+ * @brief Uniform real value in (0..1] - safe to take the log of.
+ *
+ * @tparam Source_T -- Type of random source.
+ *
+ * @param source -- Random source.
+ *
+ * @returns float64 -- Random number in range.
+ */
+template <RandomSource Source_T>
+inline float64 Ziggurat::uniformNonZero(Source_T & source)
+{
+   return 1.0_f64 - uniform(source);
+}
+
+/** makeNormalTables
+ *
+ * @brief Builds the 128 layers of the normal ziggurat.
+ *
+ * @note Values are 53-bit signed, so bounds are scaled by 2^52.
+ *
+ * @returns Tables_T<128uz> -- Tables.
+ */
+constexpr auto Ziggurat::makeNormalTables(void) -> Tables_T<128uz>
+{
+   constexpr auto M = 4503599627370496.0_f64; // 2^52
+
+   auto t  = Tables_T<128uz>{};
+   auto dn = _s_NormalR;
+   auto tn = dn;
+
+   auto const Q = _s_NormalV / exp(-0.5_f64 * dn * dn);
+
+   t._k[0]   = static_cast<uint64>((dn / Q) * M);
+   t._k[1]   = 0_u64;
+   t._w[0]   = Q  / M;
+   t._w[127] = dn / M;
+   t._f[0]   = 1.0_f64;
+   t._f[127] = exp(-0.5_f64 * dn * dn);
+
+   for (auto i = 126uz; i >= 1uz; --i)
+   { // layers of equal area, top down
+      dn          = sqrt(-2.0_f64 * log((_s_NormalV / dn) + exp(-0.5_f64 * dn * dn)));
+      t._k[i + 1] = static_cast<uint64>((dn / tn) * M);
+      tn          = dn;
+      t._f[i]     = exp(-0.5_f64 * dn * dn);
+      t._w[i]     = dn / M;
+   }
+
+   return t;
+}
+
+/** makeExponentialTables
+ *
+ * @brief Builds the 256 layers of the exponential ziggurat.
+ *
+ * @note Values are 53-bit unsigned, so bounds are scaled by 2^53.
+ *
+ * @returns Tables_T<256uz> -- Tables.
+ */
+constexpr auto Ziggurat::makeExponentialTables(void) -> Tables_T<256uz>
+{
+   constexpr auto M = 9007199254740992.0_f64; // 2^53
+
+   auto t  = Tables_T<256uz>{};
+   auto de = _s_ExponentialR;
+   auto te = de;
+
+   auto const Q = _s_ExponentialV / exp(-de);
+
+   t._k[0]   = static_cast<uint64>((de / Q) * M);
+   t._k[1]   = 0_u64;
+   t._w[0]   = Q  / M;
+   t._w[255] = de / M;
+   t._f[0]   = 1.0_f64;
+   t._f[255] = exp(-de);
+
+   for (auto i = 254uz; i >= 1uz; --i)
+   { // layers of equal area, top down
+      de          = -log((_s_ExponentialV / de) + exp(-de));
+      t._k[i + 1] = static_cast<uint64>((de / te) * M);
+      te          = de;
+      t._f[i]     = exp(-de);
+      t._w[i]     = de / M;
+   }
+
+   return t;
+}
+
+/** normal
+ *
+ * @brief Draws from the standard normal distribution (mean 0, standard deviation 1).
+ *
+ * @tparam Source_T -- Type of random source.
+ *
+ * @param source -- Random source.
+ *
+ * @returns float64 -- Random number.
+ */
+template <RandomSource Source_T>
+inline float64 Ziggurat::normal(Source_T & source)
+{
+   auto const & T = _s_Normal;
+
+   while (true)
+   { // until accepted
+      auto const U   = source();
+      auto const Idx = static_cast<sizet>(U & 127_u64);
+      auto const Hz  = std::bit_cast<int64>(U) >> 11; // signed 53-bit
+      auto const X   = static_cast<float64>(Hz) * T._w[Idx];
+
+      if (static_cast<uint64>((Hz < 0_i64) ? -Hz : Hz) < T._k[Idx])
+      { // inside the layer's rectangle
+         return X;
+      }
+
+      if (Idx == 0uz)
+      { // tail
+         auto x = 0.0_f64;
+         auto y = 0.0_f64;
+         do
+         { // Marsaglia's tail method
+            x = -log(uniformNonZero(source)) / _s_NormalR;
+            y = -log(uniformNonZero(source));
+         } while (y + y < x * x);
+
+         return (Hz > 0_i64) ? _s_NormalR + x : -_s_NormalR - x;
+      }
+
+      if (T._f[Idx] + (uniform(source) * (T._f[Idx - 1uz] - T._f[Idx])) < exp(-0.5_f64 * X * X))
+      { // under the curve in the wedge
+         return X;
+      }
+   }
+}
+
+/** exponential
+ *
+ * @brief Draws from the standard exponential distribution (rate 1).
+ *
+ * @tparam Source_T -- Type of random source.
+ *
+ * @param source -- Random source.
+ *
+ * @returns float64 -- Random number.
+ */
+template <RandomSource Source_T>
+inline float64 Ziggurat::exponential(Source_T & source)
+{
+   auto const & T = _s_Exponential;
+
+   while (true)
+   { // until accepted
+      auto const U   = source();
+      auto const Idx = static_cast<sizet>(U & 255_u64);
+      auto const Jz  = U >> 11_u64; // unsigned 53-bit
+      auto const X   = static_cast<float64>(Jz) * T._w[Idx];
+
+      if (Jz < T._k[Idx])
+      { // inside the layer's rectangle
+         return X;
+      }
+
+      if (Idx == 0uz)
+      { // tail - memoryless, so just shift
+         return _s_ExponentialR - log(uniformNonZero(source));
+      }
+
+      if (T._f[Idx] + (uniform(source) * (T._f[Idx - 1uz] - T._f[Idx])) < exp(-X))
+      { // under the curve in the wedge
+         return X;
+      }
+   }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** NormalDist
+ *
+ * @brief Normal (gaussian) distribution. See Ziggurat.
+ */
+class NormalDist
+{
+public:
+   explicit NormalDist(
+      float64 const Mean   = 0.0_f64,
+      float64 const StdDev = 1.0_f64);
+
+   YM_DECL_YMASSERT(Error)
+
+   inline auto getMean  (void) const { return _Mean;   }
+   inline auto getStdDev(void) const { return _StdDev; }
+
+   template <RandomSource Source_T>
+   inline float64 operator () (Source_T & source) const { return _Mean + (_StdDev * Ziggurat::normal(source)); }
+
+   void fill(
+      Prng &             prng,
+      std::span<float64> vals) const;
+
+private:
+   float64 const _Mean;
+   float64 const _StdDev;
+};
+
+/** ExponentialDist
+ *
+ * @brief Exponential distribution. See Ziggurat.
+ */
+class ExponentialDist
+{
+public:
+   explicit ExponentialDist(float64 const Rate = 1.0_f64);
+
+   YM_DECL_YMASSERT(Error)
+
+   inline auto getRate(void) const { return _Rate; }
+
+   template <RandomSource Source_T>
+   inline float64 operator () (Source_T & source) const { return Ziggurat::exponential(source) / _Rate; }
+
+   void fill(
+      Prng &             prng,
+      std::span<float64> vals) const;
+
+private:
+   float64 const _Rate;
+};
+
+/** BernoulliDist
+ *
+ * @brief True with probability P.
+ *
+ * @note One draw and one integer compare. P is resolved to 2^-64.
+ */
+class BernoulliDist
+{
+public:
+   explicit BernoulliDist(float64 const P);
+
+   YM_DECL_YMASSERT(Error)
+
+   inline auto getP(void) const { return _P; }
+
+   template <RandomSource Source_T>
+   inline bool operator () (Source_T & source) const { return source() < _Threshold || _Always; }
+
+   void fill(
+      Prng &          prng,
+      std::span<bool> vals) const;
+
+private:
+   float64 const _P;
+   uint64  const _Threshold; // P * 2^64
+   bool    const _Always;    // P == 1 (threshold would be 2^64)
+};
+
+} // ym
@@ -8,42 +8,773 @@
 
 #include "textlogger.h"
 
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
-#include <iterator>
 #include <system_error>
+#include <thread>
 #include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__x86_64__)
+   #include <immintrin.h>
+#endif
+
+#if __has_include(<linux/io_uring.h>)
+   #include <linux/io_uring.h>
+   #include <sys/syscall.h>
+   #define YM_FILEIO_URING 1
+#else
+   #define YM_FILEIO_URING 0
+#endif
+
+namespace
+{
+
+/** findDelim_scalar
+ * 
+ * @brief Returns the first occurrence of the delimiter (one byte at a time).
+ * 
+ * @param First -- Start of range.
+ * @param Last  -- End of range.
+ * @param Delim -- Delimiter to search for.
+ * 
+ * @returns char const * -- Delimiter, or Last if not found.
+ */
+char const * findDelim_scalar(
+   char const *       first_ptr,
+   char const * const Last,
+   char         const Delim)
+{
+   while (first_ptr != Last && *first_ptr != Delim)
+   { // not yet found
+      ++first_ptr;
+   }
+   return first_ptr;
+}
+
+#if defined(__x86_64__)
+
+/** findDelim_sse2
+ * 
+ * @brief Returns the first occurrence of the delimiter (16 bytes at a time).
+ * 
+ * @note SSE2 is part of the x86-64 baseline.
+ * 
+ * @param First -- Start of range.
+ * @param Last  -- End of range.
+ * @param Delim -- Delimiter to search for.
+ * 
+ * @returns char const * -- Delimiter, or Last if not found.
+ */
+char const * findDelim_sse2(
+   char const *       first_ptr,
+   char const * const Last,
+   char         const Delim)
+{
+   auto const Needle = _mm_set1_epi8(Delim);
+
+   for (; Last - first_ptr >= 16; first_ptr += 16)
+   { // full blocks
+      auto const Block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(first_ptr));
+      auto const Mask  = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(Block, Needle)));
+      if (Mask)
+      { // found
+         return first_ptr + std::countr_zero(Mask);
+      }
+   }
+
+   return findDelim_scalar(first_ptr, Last, Delim);
+}
+
+/** findDelim_avx2
+ * 
+ * @brief Returns the first occurrence of the delimiter (32 bytes at a time).
+ * 
+ * @note Compiled for AVX2 regardless of build flags - only called if the CPU has it.
+ * 
+ * @param First -- Start of range.
+ * @param Last  -- End of range.
+ * @param Delim -- Delimiter to search for.
+ * 
+ * @returns char const * -- Delimiter, or Last if not found.
+ */
+__attribute__((target("avx2")))
+char const * findDelim_avx2(
+   char const *       first_ptr,
+   char const * const Last,
+   char         const Delim)
+{
+   auto const Needle = _mm256_set1_epi8(Delim);
+
+   for (; Last - first_ptr >= 32; first_ptr += 32)
+   { // full blocks
+      auto const Block = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(first_ptr));
+      auto const Mask  = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(Block, Needle)));
+      if (Mask)
+      { // found
+         return first_ptr + std::countr_zero(Mask);
+      }
+   }
+
+   return findDelim_sse2(first_ptr, Last, Delim);
+}
+
+#endif // __x86_64__
+
+/** readUnknownSize
+ * 
+ * @brief Reads the rest of a file of unknown size into the arena.
+ * 
+ * @note The block doubles whenever it fills up.
+ * 
+ * @param FD        -- File to read.
+ * @param Arena_Ptr -- Memory resource to allocate the contents from.
+ * 
+ * @returns Loaded_T -- Contents, or the error.
+ */
+ym::FileIO::Loaded_T readUnknownSize(
+   int                         const FD,
+   std::pmr::memory_resource * const Arena_Ptr)
+{
+   using namespace ym;
+
+   auto   cap_bytes  = 4uz * 1024uz;
+   auto   size_bytes = 0uz;
+   auto * data_ptr   = static_cast<char *>(Arena_Ptr->allocate(cap_bytes, 1uz));
+
+   while (true)
+   { // until EOF
+      auto const N = ::read(FD, data_ptr + size_bytes, cap_bytes - size_bytes);
+
+      if (N > 0)
+      { // got some
+         size_bytes += static_cast<sizet>(N);
+         if (size_bytes == cap_bytes)
+         { // full - double
+            auto * const grown_Ptr = static_cast<char *>(Arena_Ptr->allocate(2uz * cap_bytes, 1uz));
+            std::memcpy(grown_Ptr, data_ptr, size_bytes);
+            Arena_Ptr->deallocate(data_ptr, cap_bytes, 1uz);
+            data_ptr   = grown_Ptr;
+            cap_bytes *= 2uz;
+         }
+      }
+      else if (N == 0)
+      { // EOF
+         return {std::string_view(data_ptr, size_bytes), 0};
+      }
+      else if (errno != EINTR)
+      { // error - give the block back
+         auto const Errno = errno;
+         Arena_Ptr->deallocate(data_ptr, cap_bytes, 1uz);
+         return {{}, Errno};
+      }
+   }
+}
+
+/** parallelFor
+ * 
+ * @brief Runs the function for every index on a small pool of threads.
+ * 
+ * @param N     -- Number of indices.
+ * @param func  -- Function taking an index.
+ */
+template <typename Func_T>
+void parallelFor(
+   ym::sizet const N,
+   Func_T  &&      func_uref)
+{
+   auto const NThreads = std::clamp<ym::sizet>(std::thread::hardware_concurrency(), 1uz, 16uz);
+   std::atomic<ym::sizet> next{0uz};
+
+   auto const Work = [&next, &func_uref, N](void) {
+      for (auto i = next.fetch_add(1uz); i < N; i = next.fetch_add(1uz))
+      { // claim indices until none left
+         func_uref(i);
+      }
+   };
+
+   std::vector<std::jthread> pool;
+   pool.reserve(std::min(NThreads, N) - 1uz);
+   for (auto t = 1uz; t < std::min(NThreads, N); ++t)
+   { // helpers
+      pool.emplace_back(Work);
+   }
+
+   Work(); // and this thread
+}
+
+#if (YM_FILEIO_URING)
+
+/** Uring
+ * 
+ * @brief Minimal io_uring (raw syscalls - no liburing dependency).
+ * 
+ * @note Single submitter. If the kernel (or seccomp) refuses io_uring, or the kernel
+ *       predates the opcodes we need (OPENAT/STATX/READ/CLOSE, linux 5.6), isReady() is false.
+ */
+class Uring
+{
+public:
+   explicit Uring(unsigned const Entries);
+   ~Uring(void);
+
+   YM_NO_COPY  (Uring)
+   YM_NO_ASSIGN(Uring)
+
+   inline auto isReady(void) const { return _sqes_ptr != nullptr; }
+
+   template <typename Prep_T>
+   bool run(
+      ym::sizet      const N,
+      Prep_T      &&       prep_uref,
+      std::span<int>       results);
+
+private:
+   bool hasOps(void) const;
+   void unmap (void);
+
+   io_uring_sqe *       _sqes_ptr    {nullptr};
+   io_uring_cqe const * _cqes_ptr    {nullptr};
+   void *               _sqRing_ptr  {nullptr};
+   void *               _cqRing_ptr  {nullptr};
+   ym::sizet            _sqRing_bytes{0uz    };
+   ym::sizet            _cqRing_bytes{0uz    };
+   ym::sizet            _sqes_bytes  {0uz    };
+   unsigned *           _sqTail_ptr  {nullptr};
+   unsigned *           _sqArray_ptr {nullptr};
+   unsigned             _sqMask      {0u     };
+   unsigned *           _cqHead_ptr  {nullptr};
+   unsigned *           _cqTail_ptr  {nullptr};
+   unsigned             _cqMask      {0u     };
+   unsigned             _entries     {0u     };
+   int                  _fd          {-1     };
+};
+
+/** Uring
+ * 
+ * @brief Constructor - sets up and maps the rings.
+ * 
+ * @param Entries -- Requested submission queue size.
+ */
+Uring::Uring(unsigned const Entries)
+{
+   io_uring_params params{};
+   _fd = static_cast<int>(::syscall(__NR_io_uring_setup, Entries, &params));
+
+   if (_fd < 0)
+   { // not available
+      return;
+   }
+
+   auto const SingleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0u;
+
+   _sqRing_bytes = params.sq_off.array + (params.sq_entries * sizeof(unsigned));
+   _cqRing_bytes = params.cq_off.cqes  + (params.cq_entries * sizeof(io_uring_cqe));
+   _sqes_bytes   = params.sq_entries * sizeof(io_uring_sqe);
+
+   if (SingleMap)
+   { // one mapping serves both rings
+      _sqRing_bytes = _cqRing_bytes = std::max(_sqRing_bytes, _cqRing_bytes);
+   }
+
+   auto * const sqRing_Ptr = ::mmap(nullptr, _sqRing_bytes, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+   auto * const cqRing_Ptr = SingleMap ? sqRing_Ptr : ::mmap(nullptr, _cqRing_bytes, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+   auto * const sqes_Ptr   = ::mmap(nullptr, _sqes_bytes, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES);
+
+   _sqRing_ptr = (sqRing_Ptr == MAP_FAILED) ? nullptr : sqRing_Ptr;
+   _cqRing_ptr = (cqRing_Ptr == MAP_FAILED) ? nullptr : cqRing_Ptr;
+
+   if (!_sqRing_ptr || !_cqRing_ptr || sqes_Ptr == MAP_FAILED || !hasOps())
+   { // give up (unmap what we got)
+      if (sqes_Ptr != MAP_FAILED) { (void)::munmap(sqes_Ptr, _sqes_bytes); }
+      unmap();
+      return;
+   }
+
+   auto * const Sq_Ptr = static_cast<ym::byte *>(_sqRing_ptr);
+   auto * const Cq_Ptr = static_cast<ym::byte *>(_cqRing_ptr);
+
+   _sqTail_ptr  = ym::ymCastPtrTo<unsigned>(Sq_Ptr + params.sq_off.tail );
+   _sqArray_ptr = ym::ymCastPtrTo<unsigned>(Sq_Ptr + params.sq_off.array);
+   _sqMask      = *ym::ymCastPtrTo<unsigned>(Sq_Ptr + params.sq_off.ring_mask);
+   _cqHead_ptr  = ym::ymCastPtrTo<unsigned>(Cq_Ptr + params.cq_off.head );
+   _cqTail_ptr  = ym::ymCastPtrTo<unsigned>(Cq_Ptr + params.cq_off.tail );
+   _cqMask      = *ym::ymCastPtrTo<unsigned>(Cq_Ptr + params.cq_off.ring_mask);
+   _cqes_ptr    = ym::ymCastPtrTo<io_uring_cqe const>(Cq_Ptr + params.cq_off.cqes);
+   _entries     = params.sq_entries;
+   _sqes_ptr    = static_cast<io_uring_sqe *>(sqes_Ptr); // ready
+}
+
+/** ~Uring
+ * 
+ * @brief Destructor.
+ */
+Uring::~Uring(void)
+{
+   if (isReady())
+   { // mapped
+      (void)::munmap(_sqes_ptr, _sqes_bytes);
+   }
+   unmap();
+}
+
+/** hasOps
+ * 
+ * @brief Asks the kernel if it knows every opcode loadMany_uring() submits.
+ * 
+ * @note Kernels before 5.6 accept io_uring_setup() but fail OPENAT/STATX with -EINVAL.
+ *       They don't know IORING_REGISTER_PROBE either, so a failed probe means no.
+ * 
+ * @returns bool -- True if the opcodes are supported.
+ */
+bool Uring::hasOps(void) const
+{
+   constexpr auto NOps = 256u;
+
+   alignas(io_uring_probe) std::array<ym::byte, sizeof(io_uring_probe) + (NOps * sizeof(io_uring_probe_op))> buffer{};
+   auto * const probe_Ptr = ym::ymCastPtrTo<io_uring_probe>(buffer.data());
+
+   if (::syscall(__NR_io_uring_register, _fd, IORING_REGISTER_PROBE, probe_Ptr, NOps) < 0)
+   { // too old (or filtered)
+      return false;
+   }
+
+   auto const Supported = [probe_Ptr](unsigned const Op) {
+      return Op < probe_Ptr->ops_len && (probe_Ptr->ops[Op].flags & IO_URING_OP_SUPPORTED) != 0u;
+   };
+
+   return Supported(IORING_OP_OPENAT) && Supported(IORING_OP_STATX) &&
+          Supported(IORING_OP_READ  ) && Supported(IORING_OP_CLOSE);
+}
+
+/** unmap
+ * 
+ * @brief Unmaps the rings and closes the ring.
+ */
+void Uring::unmap(void)
+{
+   if (_cqRing_ptr && _cqRing_ptr != _sqRing_ptr) { (void)::munmap(_cqRing_ptr, _cqRing_bytes); }
+   if (_sqRing_ptr                              ) { (void)::munmap(_sqRing_ptr, _sqRing_bytes); }
+   if (_fd >= 0                                 ) { (void)::close(_fd);                         }
+
+   _sqRing_ptr = _cqRing_ptr = nullptr;
+   _sqes_ptr   = nullptr;
+   _fd         = -1;
+}
+
+/** run
+ * 
+ * @brief Submits N operations and waits for all of them to complete.
+ * 
+ * @note At most one queue's worth of operations are in flight at a time, so the
+ *       completion queue (twice as large) never overflows.
+ * 
+ * @param N         -- Number of operations.
+ * @param prep_uref -- Fills in the (zeroed) sqe of operation i.
+ * @param results   -- Result (cqe res) of operation i.
+ * 
+ * @returns bool -- False if io_uring_enter() failed (results are incomplete).
+ */
+template <typename Prep_T>
+bool Uring::run(
+   ym::sizet      const N,
+   Prep_T      &&       prep_uref,
+   std::span<int>       results)
+{
+   auto next        = 0uz;
+   auto done        = 0uz;
+   auto inflight    = 0uz;
+   auto unsubmitted = 0u;
+
+   while (done < N)
+   { // until everything completed
+
+      auto tail = std::atomic_ref(*_sqTail_ptr).load(std::memory_order_relaxed); // only we write it
+
+      for (; next < N && inflight < _entries; ++next, ++inflight, ++tail, ++unsubmitted)
+      { // queue as many as fit
+         auto const Idx   = tail & _sqMask;
+         auto &     sqe   = _sqes_ptr[Idx];
+         sqe              = io_uring_sqe{};
+         prep_uref(next, sqe);
+         sqe.user_data    = next;
+         _sqArray_ptr[Idx] = Idx;
+      }
+
+      std::atomic_ref(*_sqTail_ptr).store(tail, std::memory_order_release);
+
+      auto ret = 0;
+      do
+      { // submit and wait for at least one
+         ret = static_cast<int>(::syscall(__NR_io_uring_enter, _fd, unsubmitted, 1u, IORING_ENTER_GETEVENTS, nullptr, 0uz));
+      } while (ret < 0 && errno == EINTR);
+
+      if (ret < 0)
+      { // ring broken
+         return false;
+      }
+
+      unsubmitted -= static_cast<unsigned>(ret);
+
+      auto       head = std::atomic_ref(*_cqHead_ptr).load(std::memory_order_relaxed);
+      auto const Tail = std::atomic_ref(*_cqTail_ptr).load(std::memory_order_acquire);
+
+      for (; head != Tail; ++head, ++done, --inflight)
+      { // reap
+         auto const & Cqe = _cqes_ptr[head & _cqMask];
+         results[Cqe.user_data] = Cqe.res;
+      }
+
+      std::atomic_ref(*_cqHead_ptr).store(head, std::memory_order_release);
+   }
+
+   return true;
+}
+
+/** loadMany_uring
+ * 
+ * @brief Loads the files in three batches - open+statx, read, close.
+ * 
+ * @param Filenames -- Files to load.
+ * @param Arena_Ptr -- Memory resource to allocate the contents from.
+ * @param loaded    -- Result of each file.
+ * 
+ * @returns bool -- False if io_uring (or one of its opcodes we need) is not available, or
+ *                  the ring broke before anything was read.
+ */
+bool loadMany_uring(
+   std::span<ym::str const>                const Filenames,
+   std::pmr::memory_resource *             const Arena_Ptr,
+   std::pmr::vector<ym::FileIO::Loaded_T> &      loaded_ref)
+{
+   using namespace ym;
+
+   auto const N = Filenames.size();
+
+   Uring ring(static_cast<unsigned>(std::min(std::bit_ceil(2uz * N), 256uz)));
+
+   if (!ring.isReady())
+   { // kernel says no
+      return false;
+   }
+
+   auto res   = std::vector<int>(2uz * N, -ECANCELED);
+   auto stats = std::vector<struct statx>(N);
+
+   auto const Opened = ring.run(2uz * N,
+      [&Filenames, &stats, N](sizet const I, io_uring_sqe & sqe_ref) {
+         if (I < N)
+         { // open
+            sqe_ref.opcode     = IORING_OP_OPENAT;
+            sqe_ref.fd         = AT_FDCWD;
+            sqe_ref.addr       = reinterpret_cast<uint64>(Filenames[I].get());
+            sqe_ref.open_flags = O_RDONLY | O_CLOEXEC;
+         }
+         else
+         { // stat (by path - no need to wait for the open)
+            sqe_ref.opcode = IORING_OP_STATX;
+            sqe_ref.fd     = AT_FDCWD;
+            sqe_ref.addr   = reinterpret_cast<uint64>(Filenames[I - N].get());
+            sqe_ref.len    = STATX_TYPE | STATX_SIZE;
+            sqe_ref.off    = reinterpret_cast<uint64>(&stats[I - N]);
+         }
+      }, res);
+
+   if (!Opened)
+   { // ring broke - close what did open and let the caller fall back
+      for (auto i = 0uz; i < N; ++i) { if (res[i] >= 0) { (void)::close(res[i]); } }
+      return false;
+   }
+
+   auto fds     = std::vector<int  >(N, -1 );
+   auto got     = std::vector<sizet>(N, 0uz);
+   auto todo    = std::vector<sizet>();
+   auto special = std::vector<sizet>();
+
+   for (auto i = 0uz; i < N; ++i)
+   { // allocate room for every regular file
+      fds[i] = res[i] >= 0 ? res[i] : -1;
+
+      if (fds[i] < 0)
+      { // couldn't open
+         loaded_ref[i]._error = -res[i];
+      }
+      else if (res[N + i] < 0 || !S_ISREG(stats[i].stx_mode) || stats[i].stx_size == 0_u64)
+      { // pipe, device, /proc file, ... - read in afterwards
+         special.push_back(i);
+      }
+      else
+      { // regular file
+         auto const Size_bytes = static_cast<sizet>(stats[i].stx_size);
+         loaded_ref[i]._contents = std::string_view(static_cast<char *>(Arena_Ptr->allocate(Size_bytes, 1uz)), Size_bytes);
+         todo.push_back(i);
+      }
+   }
+
+   auto readOk = true;
+
+   while (readOk && !todo.empty())
+   { // read (again, for short reads)
+      auto rr = std::vector<int>(todo.size(), -ECANCELED);
+
+      readOk = ring.run(todo.size(),
+         [&todo, &fds, &got, &loaded_ref](sizet const K, io_uring_sqe & sqe_ref) {
+            auto const I = todo[K];
+            sqe_ref.opcode = IORING_OP_READ;
+            sqe_ref.fd     = fds[I];
+            sqe_ref.addr   = reinterpret_cast<uint64>(loaded_ref[I]._contents.data() + got[I]);
+            sqe_ref.len    = static_cast<uint32>(std::min(loaded_ref[I]._contents.size() - got[I], 1uz << 30uz));
+            sqe_ref.off    = got[I];
+         }, rr);
+
+      auto again = std::vector<sizet>();
+      for (auto k = 0uz; readOk && k < todo.size(); ++k)
+      { // tally
+         auto const I = todo[k];
+         if (rr[k] > 0)
+         { // progress
+            got[I] += static_cast<sizet>(rr[k]);
+            if (got[I] < loaded_ref[I]._contents.size()) { again.push_back(I); }
+         }
+         else if (rr[k] == 0)
+         { // file shrank under us
+            loaded_ref[I]._contents = loaded_ref[I]._contents.substr(0uz, got[I]);
+         }
+         else if (rr[k] == -EINTR || rr[k] == -EAGAIN)
+         { // try again
+            again.push_back(I);
+         }
+         else
+         { // error
+            loaded_ref[I]._error = -rr[k];
+         }
+      }
+      todo = std::move(again);
+   }
+
+   for (auto const I : todo)
+   { // ring broke while reading
+      loaded_ref[I]._error = EIO;
+   }
+
+   for (auto const I : special)
+   { // rare - read synchronously
+      loaded_ref[I] = readUnknownSize(fds[I], Arena_Ptr);
+   }
+
+   auto cr = std::vector<int>(N);
+   if (!ring.run(N, [&fds](sizet const I, io_uring_sqe & sqe_ref) {
+         sqe_ref.opcode = fds[I] >= 0 ? IORING_OP_CLOSE : IORING_OP_NOP;
+         sqe_ref.fd     = fds[I];
+      }, cr))
+   { // close the slow way
+      for (auto const FD : fds) { if (FD >= 0) { (void)::close(FD); } }
+   }
+
+   return true;
+}
+
+#endif // YM_FILEIO_URING
+
+/** loadMany_threadPool
+ * 
+ * @brief Loads the files on a pool of threads - open+fstat, (allocate), read.
+ * 
+ * @param Filenames -- Files to load.
+ * @param Arena_Ptr -- Memory resource to allocate the contents from.
+ * @param loaded    -- Result of each file.
+ */
+void loadMany_threadPool(
+   std::span<ym::str const>                const Filenames,
+   std::pmr::memory_resource *             const Arena_Ptr,
+   std::pmr::vector<ym::FileIO::Loaded_T> &      loaded_ref)
+{
+   using namespace ym;
+
+   auto const N = Filenames.size();
+
+   auto fds   = std::vector<int  >(N, -1 );
+   auto sizes = std::vector<sizet>(N, 0uz); // 0 if special
+
+   parallelFor(N, [&](sizet const I) {
+      fds[I] = ::open(Filenames[I].get(), O_RDONLY | O_CLOEXEC);
+      if (fds[I] < 0)
+      { // couldn't open
+         loaded_ref[I]._error = errno;
+      }
+      else if (struct stat st{}; ::fstat(fds[I], &st) == 0 && S_ISREG(st.st_mode))
+      { // regular (size 0 is treated as special)
+         sizes[I] = static_cast<sizet>(st.st_size);
+      }
+   });
+
+   for (auto i = 0uz; i < N; ++i)
+   { // memory resources aren't thread-safe - allocate here
+      if (sizes[i] > 0uz)
+      { // regular file
+         loaded_ref[i]._contents = std::string_view(static_cast<char *>(Arena_Ptr->allocate(sizes[i], 1uz)), sizes[i]);
+      }
+   }
+
+   parallelFor(N, [&](sizet const I) {
+      if (sizes[I] > 0uz)
+      { // read everything
+         auto * const data_Ptr = const_cast<char *>(loaded_ref[I]._contents.data());
+         auto         got      = 0uz;
+         while (got < sizes[I])
+         { // until full
+            auto const R = ::pread(fds[I], data_Ptr + got, sizes[I] - got, static_cast<off_t>(got));
+            if      (R > 0)            { got += static_cast<sizet>(R);    }
+            else if (R == 0)           { break;                           } // file shrank
+            else if (errno != EINTR)   { loaded_ref[I]._error = errno; break; }
+         }
+         loaded_ref[I]._contents = loaded_ref[I]._contents.substr(0uz, got);
+      }
+   });
+
+   for (auto i = 0uz; i < N; ++i)
+   { // special files and clean up
+      if (fds[i] >= 0)
+      { // opened
+         if (sizes[i] == 0uz)
+         { // rare - read synchronously
+            loaded_ref[i] = readUnknownSize(fds[i], Arena_Ptr);
+         }
+         (void)::close(fds[i]);
+      }
+   }
+}
+
+/** writeAll
+ * 
+ * @brief Writes every byte described by the io vector, retrying short writes.
+ * 
+ * @param FD  -- File to write to.
+ * @param iov -- Pieces to write (consumed).
+ * 
+ * @returns bool -- If everything was written.
+ */
+bool writeAll(
+   int                     const FD,
+   std::span<struct iovec>       iov)
+{
+   while (!iov.empty())
+   { // until everything is out
+      auto const N = ::writev(FD, iov.data(), static_cast<int>(iov.size()));
+
+      if (N < 0)
+      { // interrupted or failed
+         if (errno == EINTR) { continue; }
+         return false;
+      }
+
+      auto left = static_cast<ym::sizet>(N);
+      while (!iov.empty() && left >= iov.front().iov_len)
+      { // drop pieces written in full
+         left -= iov.front().iov_len;
+         iov   = iov.subspan(1uz);
+      }
+
+      if (!iov.empty())
+      { // piece written in part
+         iov.front().iov_base  = static_cast<char *>(iov.front().iov_base) + left;
+         iov.front().iov_len  -= left;
+      }
+   }
+
+   return true;
+}
+
+} // anonymous
 
 /** createFileBuffer
  * 
- * @brief Reads in file contents into an std::pmr::string.
+ * @brief Reads in file contents into an std::pmr::string (default memory resource).
  * 
  * @param Filename -- Name of file to read from.
  * 
  * @returns std::optional<std::pmr::string> -- File contents, or null if an error occured.
  */
 std::optional<std::pmr::string> ym::FileIO::createFileBuffer(str const Filename)
+{
+   return createFileBuffer(Filename, std::pmr::get_default_resource());
+}
+
+/** createFileBuffer
+ * 
+ * @brief Reads in file contents into an std::pmr::string.
+ * 
+ * @note If the size of the file is unknown it is read in chunks that double in size, so
+ *       the number of reads (and reallocations) is logarithmic in the size of the file.
+ * 
+ * @param Filename     -- Name of file to read from.
+ * @param Resource_Ptr -- Memory resource to allocate the contents from (eg an arena).
+ * 
+ * @returns std::optional<std::pmr::string> -- File contents, or null if an error occured.
+ */
+std::optional<std::pmr::string> ym::FileIO::createFileBuffer(
+   str                         const Filename,
+   std::pmr::memory_resource * const Resource_Ptr)
 {
    std::optional<std::pmr::string> buffer; // default is nullopt
 
-   if (std::ifstream infile(Filename.get()); infile.is_open())
+   if (std::ifstream infile(Filename.get(), std::ios::binary); infile.is_open())
    { // file opened
 
       std::error_code ec;
       auto const Size_bytes = std::filesystem::file_size(Filename.get(), ec);
 
-      if (ec)
-      { // failed to get size - read file in like a peasant
-         std::istreambuf_iterator<char> it(infile);
-         std::istreambuf_iterator<char> end;
-         buffer = {it, end};
+      std::pmr::string contents(Resource_Ptr);
+
+      if (ec || Size_bytes == 0uz)
+      { // failed to get size (or special file reporting 0) - read file in chunks
+
+         constexpr auto MaxChunk_bytes = 64uz * 1024uz * 1024uz;
+         auto           chunk_bytes    = 4uz * 1024uz;
+
+         while (infile)
+         { // until EOF (or error)
+            auto const Old_bytes = contents.size();
+            contents.resize_and_overwrite(Old_bytes + chunk_bytes,
+               [&infile, Old_bytes](char * const buf_Ptr, sizet const N) {
+                  (void)infile.read(buf_Ptr + Old_bytes, static_cast<std::streamsize>(N - Old_bytes));
+                  return Old_bytes + static_cast<sizet>(infile.gcount());
+               }
+            );
+            chunk_bytes = std::min(chunk_bytes * 2uz, MaxChunk_bytes);
+         }
+
+         if (!infile.bad())
+         { // hitting EOF is the expected way out
+            buffer = std::move(contents);
+         }
+         else
+         { // error reading file
+            ymLog(VG::Warning, "Got error {} while attempting to read from {}", "BAD"_str, Filename);
+         }
       }
       else
       { // read in everything all at once
 
-         std::pmr::string contents;
          contents.resize_and_overwrite(Size_bytes, [&infile](char * const buf_Ptr, sizet const N) {
-            (void)infile.read(buf_Ptr, N);
+            (void)infile.read(buf_Ptr, static_cast<std::streamsize>(N));
             return N;
          });
 
@@ -64,3 +795,665 @@ std::optional<std::pmr::string> ym::FileIO::createFileBuffer(str const Filename)
 
    return buffer;
 }
+
+/** mapFile
+ * 
+ * @brief Maps the file read-only.
+ * 
+ * @note Falls back to buffered reads if the file can't be mapped (see MappedFile).
+ * 
+ * @param Filename -- Name of file to map.
+ * @param Options  -- Access hints.
+ * 
+ * @returns std::optional<MappedFile> -- View of file contents, or null if an error occured.
+ */
+auto ym::FileIO::mapFile(
+   str          const   Filename,
+   MapOptions_T const & Options) -> std::optional<MappedFile>
+{
+   std::optional<MappedFile> file; // default is nullopt
+
+   auto const FD = ::open(Filename.get(), O_RDONLY | O_CLOEXEC);
+
+   if (FD < 0)
+   { // can't open
+      ymLog(VG::Warning, "Could not open {} (errno {})", Filename, errno);
+      return file;
+   }
+
+   struct stat st{};
+   auto const Mappable = ::fstat(FD, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0;
+
+   if (Mappable)
+   { // regular file - map it
+      auto const   Size_bytes = static_cast<sizet>(st.st_size);
+      auto * const map_Ptr    = ::mmap(nullptr, Size_bytes, PROT_READ, MAP_PRIVATE, FD, 0);
+
+      if (map_Ptr != MAP_FAILED)
+      { // mapped
+         if (Options._sequential) { (void)::madvise(map_Ptr, Size_bytes, MADV_SEQUENTIAL); }
+         if (Options._willNeed  ) { (void)::madvise(map_Ptr, Size_bytes, MADV_WILLNEED  ); }
+         if (Options._hugePage  ) { (void)::madvise(map_Ptr, Size_bytes, MADV_HUGEPAGE  ); }
+
+         file.emplace();
+         file->_map_ptr      = static_cast<char const *>(map_Ptr);
+         file->_mapped_bytes = Size_bytes;
+      }
+   }
+
+   if (!file)
+   { // pipe, special file, or mapping failed - read it in
+      std::pmr::string contents;
+      std::array<char, 64uz * 1024uz> chunk;
+      auto ok = true;
+
+      while (true)
+      { // until EOF
+         auto const NRead = ::read(FD, chunk.data(), chunk.size());
+
+         if (NRead > 0)
+         { // got some
+            contents.append(chunk.data(), static_cast<sizet>(NRead));
+         }
+         else if (NRead == 0)
+         { // EOF
+            break;
+         }
+         else if (errno != EINTR)
+         { // error
+            ok = false;
+            break;
+         }
+      }
+
+      if (ok)
+      { // file read into memory successful
+         file.emplace();
+         file->_buffer = std::move(contents);
+      }
+      else
+      { // error reading file
+         ymLog(VG::Warning, "Got error {} while attempting to read from {}", errno, Filename);
+      }
+   }
+
+   (void)::close(FD); // mapping keeps the file alive
+
+   return file;
+}
+
+/** ~MappedFile
+ * 
+ * @brief Destructor.
+ */
+ym::FileIO::MappedFile::~MappedFile(void)
+{
+   unmap();
+}
+
+/** MappedFile
+ * 
+ * @brief Move constructor.
+ * 
+ * @param other_uref -- File to take over (left empty).
+ */
+ym::FileIO::MappedFile::MappedFile(MappedFile && other_uref) noexcept :
+   _map_ptr      {std::exchange(other_uref._map_ptr,      nullptr)},
+   _mapped_bytes {std::exchange(other_uref._mapped_bytes, 0uz    )},
+   _buffer       {std::move(other_uref._buffer)                   }
+{ }
+
+/** operator=
+ * 
+ * @brief Move assignment.
+ * 
+ * @param other_uref -- File to take over (left empty).
+ * 
+ * @returns MappedFile & -- This.
+ */
+auto ym::FileIO::MappedFile::operator = (MappedFile && other_uref) noexcept -> MappedFile &
+{
+   if (this != &other_uref)
+   { // prevent self assign
+      unmap();
+      _map_ptr      = std::exchange(other_uref._map_ptr,      nullptr);
+      _mapped_bytes = std::exchange(other_uref._mapped_bytes, 0uz    );
+      _buffer       = std::move(other_uref._buffer);
+   }
+   return *this;
+}
+
+/** unmap
+ * 
+ * @brief Releases the mapping (if any).
+ */
+void ym::FileIO::MappedFile::unmap(void)
+{
+   if (isMapped())
+   { // mapped
+      (void)::munmap(const_cast<char *>(_map_ptr), _mapped_bytes);
+      _map_ptr      = nullptr;
+      _mapped_bytes = 0uz;
+   }
+}
+
+/** findDelim
+ * 
+ * @brief Returns the first occurrence of the delimiter.
+ * 
+ * @note Dispatches (once) to the widest implementation the CPU supports.
+ * 
+ * @param First -- Start of range.
+ * @param Last  -- End of range.
+ * @param Delim -- Delimiter to search for.
+ * 
+ * @returns char const * -- Delimiter, or Last if not found.
+ */
+auto ym::FileIO::findDelim(
+   char const * const First,
+   char const * const Last,
+   char         const Delim) -> char const *
+{
+#if defined(__x86_64__)
+   static auto const s_Find_Ptr = __builtin_cpu_supports("avx2") ? findDelim_avx2 : findDelim_sse2;
+#else
+   static auto const s_Find_Ptr = findDelim_scalar;
+#endif
+
+   return s_Find_Ptr(First, Last, Delim);
+}
+
+/** ChunkReader
+ * 
+ * @brief Constructor. See open().
+ * 
+ * @throws Error -- If the chunk size is 0.
+ * 
+ * @param Chunk_bytes -- Size of chunks returned by next().
+ */
+ym::FileIO::ChunkReader::ChunkReader(sizet const Chunk_bytes) :
+   _Chunk_bytes {Chunk_bytes}
+{
+   YMASSERT(getChunk_bytes() > 0uz, Error, YM_DAH, "Chunk size must be > 0");
+}
+
+/** ~ChunkReader
+ * 
+ * @brief Destructor.
+ */
+ym::FileIO::ChunkReader::~ChunkReader(void)
+{
+   close();
+}
+
+/** open
+ * 
+ * @brief Opens the file for streaming.
+ * 
+ * @param Filename -- Name of file to stream.
+ * 
+ * @returns bool -- If the file was opened.
+ */
+bool ym::FileIO::ChunkReader::open(str const Filename)
+{
+   close();
+
+   _fd = ::open(Filename.get(), O_RDONLY | O_CLOEXEC);
+
+   if (isOpen())
+   { // kernel may double its read-ahead window (fails harmlessly on pipes)
+      (void)::posix_fadvise(_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+      readAhead();
+   }
+   else
+   { // can't open
+      ymLog(VG::Warning, "Could not open {} (errno {})", Filename, errno);
+   }
+
+   return isOpen();
+}
+
+/** close
+ * 
+ * @brief Closes the file.
+ */
+void ym::FileIO::ChunkReader::close(void)
+{
+   if (isOpen())
+   { // opened
+      (void)::close(_fd);
+      _fd = -1;
+   }
+
+   _offset        = 0_u64;
+   _advisedOffset = 0_u64;
+   _eof           = false;
+   _error         = false;
+}
+
+/** next
+ * 
+ * @brief Reads the next chunk.
+ * 
+ * @returns std::span<char const> -- Chunk (valid until the next call), empty at EOF or on error.
+ */
+auto ym::FileIO::ChunkReader::next(void) -> std::span<char const>
+{
+   _chunk.resize(getChunk_bytes());
+   return std::span<char const>(_chunk.data(), read(_chunk));
+}
+
+/** read
+ * 
+ * @brief Fills the buffer from the file.
+ * 
+ * @note Only comes up short at EOF or on error.
+ * 
+ * @param buffer -- Buffer to fill.
+ * 
+ * @returns sizet -- Number of bytes read.
+ */
+auto ym::FileIO::ChunkReader::read(std::span<char> buffer) -> sizet
+{
+   auto nRead = 0uz;
+
+   while (isOpen() && !_eof && !_error && nRead < buffer.size())
+   { // keep reading until full
+      auto const N = ::read(_fd, buffer.data() + nRead, buffer.size() - nRead);
+
+      if (N > 0)
+      { // got some
+         nRead += static_cast<sizet>(N);
+      }
+      else if (N == 0)
+      { // end of file
+         _eof = true;
+      }
+      else if (errno != EINTR)
+      { // error
+         ymLog(VG::Warning, "Got error {} while streaming", errno);
+         _error = true;
+      }
+   }
+
+   _offset += nRead;
+   readAhead();
+
+   return nRead;
+}
+
+/** readAhead
+ * 
+ * @brief Keeps the next few chunks advised as will-need.
+ */
+void ym::FileIO::ChunkReader::readAhead(void)
+{
+   auto const Window_bytes = _s_NReadAheadChunks * getChunk_bytes();
+
+   if (isOpen() && !_eof && _advisedOffset < _offset + (Window_bytes / 2uz))
+   { // window running low - advise the next one
+      auto const Start = std::max(_advisedOffset, _offset);
+      (void)::posix_fadvise(_fd, static_cast<off_t>(Start), static_cast<off_t>(Window_bytes), POSIX_FADV_WILLNEED);
+      _advisedOffset = Start + Window_bytes;
+   }
+}
+
+/** LineReader
+ * 
+ * @brief Constructor.
+ * 
+ * @param reader_ref -- Opened chunk reader (must outlive this).
+ * @param Delim      -- Delimiter separating lines.
+ */
+ym::FileIO::LineReader::LineReader(
+   ChunkReader & reader_ref,
+   char    const Delim) :
+      _reader_ref {reader_ref                         },
+      _window     (2uz * reader_ref.getChunk_bytes()),
+      _Delim      {Delim                              }
+{ }
+
+/** next
+ * 
+ * @brief Returns the next line (without its delimiter).
+ * 
+ * @note The last line doesn't need a trailing delimiter.
+ * 
+ * @returns std::optional<std::string_view> -- Line (valid until the next call), null when done.
+ */
+auto ym::FileIO::LineReader::next(void) -> std::optional<std::string_view>
+{
+   while (true)
+   { // until a line is found or the stream is exhausted
+
+      auto const * const Data_Ptr  = _window.data();
+      auto const * const Delim_Ptr = findDelim(Data_Ptr + _scan, Data_Ptr + _end, _Delim);
+
+      if (Delim_Ptr != Data_Ptr + _end)
+      { // complete line
+         auto const Line = std::string_view(Data_Ptr + _begin, Delim_Ptr);
+         _begin = _scan = static_cast<sizet>(Delim_Ptr - Data_Ptr) + 1uz;
+         return Line;
+      }
+
+      if (_eof)
+      { // flush unterminated last line
+         if (_begin < _end)
+         { // something left
+            auto const Line = std::string_view(Data_Ptr + _begin, Data_Ptr + _end);
+            _begin = _scan = _end;
+            return Line;
+         }
+         return std::nullopt;
+      }
+
+      // move the partial line to the front and read the next chunk behind it
+      auto const Tail_bytes = _end - _begin;
+      if (_begin > 0uz)
+      { // something consumed
+         std::memmove(_window.data(), _window.data() + _begin, Tail_bytes);
+      }
+      _begin = 0uz;
+      _scan  = Tail_bytes;
+      _end   = Tail_bytes;
+
+      if (_window.size() - _end < _reader_ref.getChunk_bytes())
+      { // line outgrew the window
+         _window.resize(std::max(2uz * _window.size(), _end + _reader_ref.getChunk_bytes()));
+      }
+
+      auto const NRead = _reader_ref.read(std::span(_window).subspan(_end, _reader_ref.getChunk_bytes()));
+      _end += NRead;
+      _eof  = (NRead == 0uz);
+   }
+}
+
+/** Writer
+ * 
+ * @brief Constructor. See open().
+ * 
+ * @param Options -- Buffer size, O_DIRECT, and durability.
+ */
+ym::FileIO::Writer::Writer(WriteOptions_T const & Options) :
+   _Buffer_bytes {std::max((Options._buffer_bytes + _s_Alignment_bytes - 1uz) & ~(_s_Alignment_bytes - 1uz),
+                           _s_Alignment_bytes)},
+   _WantDirect   {Options._direct },
+   _Durable      {Options._durable}
+{ }
+
+/** ~Writer
+ * 
+ * @brief Destructor. Anything not committed is thrown away.
+ */
+ym::FileIO::Writer::~Writer(void)
+{
+   abort();
+}
+
+/** open
+ * 
+ * @brief Starts writing a new version of the file.
+ * 
+ * @note The target is untouched until commit().
+ * 
+ * @param Filename -- Name of file to (over)write.
+ * 
+ * @returns bool -- If the temporary file was created.
+ */
+bool ym::FileIO::Writer::open(str const Filename)
+{
+   abort();
+
+   static std::atomic<uint32> s_nTmpFiles{0_u32}; // unique per writer in this process
+
+   _filename    = Filename.get();
+   _tmpFilename = fmt::format("{}.{}.{}.tmp", _filename, ::getpid(), s_nTmpFiles.fetch_add(1_u32));
+   _offset      = 0_u64;
+   _error       = false;
+   _direct      = false;
+
+   _fd = ::open(_tmpFilename.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+
+   if (!isOpen())
+   { // can't create
+      ymLog(VG::Warning, "Could not open {} (errno {})", _tmpFilename, errno);
+      return false;
+   }
+
+   if (_WantDirect)
+   { // set afterwards so an unsupported filesystem (eg tmpfs) just stays buffered
+      auto const Flags = ::fcntl(_fd, F_GETFL);
+      _direct = Flags >= 0 && ::fcntl(_fd, F_SETFL, Flags | O_DIRECT) == 0;
+   }
+
+   if (!_buffer_uptr)
+   { // first use
+      _buffer_uptr.reset(static_cast<char *>(::operator new[](_Buffer_bytes, std::align_val_t(_s_Alignment_bytes))));
+   }
+
+   return true;
+}
+
+/** write
+ * 
+ * @brief Appends data to the file.
+ * 
+ * @param Data_Ptr   -- Data to write.
+ * @param Size_bytes -- Size of data.
+ * 
+ * @returns bool -- False if the writer is not open or a previous write failed.
+ */
+bool ym::FileIO::Writer::write(
+   void const * const Data_Ptr,
+   sizet        const Size_bytes)
+{
+   if (!isOpen() || hasError())
+   { // nowhere to write
+      return false;
+   }
+
+   auto const * data_ptr = static_cast<char const *>(Data_Ptr);
+   auto         left     = Size_bytes;
+
+   if (!_direct && left >= _Buffer_bytes)
+   { // big - send staged bytes and the data together, no copy
+      auto iov = std::array{
+         iovec{_buffer_uptr.get(),            _used},
+         iovec{const_cast<char *>(data_ptr), left }
+      };
+
+      if (!writeAll(_fd, iov))
+      { // disk full, ...
+         ymLog(VG::Warning, "Got error {} while writing {}", errno, _tmpFilename);
+         _error = true;
+         return false;
+      }
+
+      _offset += _used + left;
+      _used    = 0uz;
+      return true;
+   }
+
+   while (left > 0uz)
+   { // stage, sending out full buffers
+      auto const N = std::min(left, _Buffer_bytes - _used);
+      std::memcpy(_buffer_uptr.get() + _used, data_ptr, N);
+
+      _used    += N;
+      data_ptr += N;
+      left     -= N;
+
+      if (_used == _Buffer_bytes && !flush(_used))
+      { // flush() logged it
+         return false;
+      }
+   }
+
+   return true;
+}
+
+/** commit
+ * 
+ * @brief Writes out what is staged and atomically replaces the target.
+ * 
+ * @note With durability on, the data is on disk before the rename, and the rename is on
+ *       disk before we return.
+ * 
+ * @note A replaced target keeps its permissions (an executable stays executable, a 0600
+ *       secret stays private). A new one gets 0644 (less the umask).
+ * 
+ * @returns bool -- If the target now holds everything written. On failure the target is
+ *                  left as it was.
+ */
+bool ym::FileIO::Writer::commit(void)
+{
+   if (!isOpen())
+   { // nothing to commit
+      return false;
+   }
+
+   auto ok  = !hasError();
+   auto err = 0; // errno of the first failing call
+
+   auto const Check = [&err](bool const Ok) {
+      if (!Ok && err == 0) { err = errno; }
+      return Ok;
+   };
+
+   if (ok && _direct)
+   { // O_DIRECT only takes whole blocks - finish the tail buffered
+      auto const Aligned_bytes = _used & ~(_s_Alignment_bytes - 1uz);
+      ok = Aligned_bytes == 0uz || flush(Aligned_bytes);
+
+      auto const Flags = ::fcntl(_fd, F_GETFL);
+      _direct = !Check(Flags >= 0 && ::fcntl(_fd, F_SETFL, Flags & ~O_DIRECT) == 0);
+      ok      = ok && !_direct;
+   }
+
+   ok = ok && Check(_used == 0uz || flush(_used));
+
+   if (struct stat target{}; ok && ::stat(_filename.c_str(), &target) == 0)
+   { // replacing - keep its permissions
+      ok = Check(::fchmod(_fd, target.st_mode & 07777) == 0);
+   }
+
+   ok = ok && Check(!_Durable || ::fdatasync(_fd) == 0);
+   ok = Check(::close(_fd) == 0) && ok;
+   _fd = -1;
+   ok = ok && Check(::rename(_tmpFilename.c_str(), _filename.c_str()) == 0);
+
+   if (!ok)
+   { // leave the target alone
+      ymLog(VG::Warning, "Could not commit {} (errno {})", _filename, err);
+      (void)::unlink(_tmpFilename.c_str());
+      _error = true;
+   }
+   else if (_Durable)
+   { // make the rename itself durable
+      auto const Dir   = std::filesystem::path(_filename).parent_path();
+      auto const DirFD = ::open(Dir.empty() ? "." : Dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+      if (DirFD >= 0)
+      { // best effort
+         (void)::fsync(DirFD);
+         (void)::close(DirFD);
+      }
+   }
+
+   _used = 0uz;
+
+   return ok;
+}
+
+/** abort
+ * 
+ * @brief Throws away everything written since open(). The target is untouched.
+ */
+void ym::FileIO::Writer::abort(void)
+{
+   if (isOpen())
+   { // discard
+      (void)::close(_fd);
+      (void)::unlink(_tmpFilename.c_str());
+      _fd = -1;
+   }
+
+   _used = 0uz;
+}
+
+/** flush
+ * 
+ * @brief Writes out the front of the staging buffer.
+ * 
+ * @param NBytes -- Number of staged bytes to write (a multiple of the alignment with O_DIRECT).
+ * 
+ * @returns bool -- If the bytes were written.
+ */
+bool ym::FileIO::Writer::flush(sizet const NBytes)
+{
+   auto iov = std::array{iovec{_buffer_uptr.get(), NBytes}};
+
+   if (!writeAll(_fd, iov))
+   { // disk full, ...
+      ymLog(VG::Warning, "Got error {} while writing {}", errno, _tmpFilename);
+      _error = true;
+      return false;
+   }
+
+   _offset += NBytes;
+   _used   -= NBytes;
+
+   if (_used > 0uz)
+   { // keep the rest
+      std::memmove(_buffer_uptr.get(), _buffer_uptr.get() + NBytes, _used);
+   }
+
+   return true;
+}
+
+/** loadMany
+ * 
+ * @brief Loads many (small) files at once.
+ * 
+ * @note With io_uring every open and stat is submitted in one batch, then every read,
+ *       then every close - a handful of syscalls in total. Otherwise a small thread
+ *       pool overlaps the blocking calls.
+ * 
+ * @param Filenames -- Files to load.
+ * @param Arena_Ptr -- Memory resource to allocate the contents (and results) from.
+ * @param Mode      -- Mechanism to load with.
+ * 
+ * @returns std::pmr::vector<Loaded_T> -- Contents or error of each file, in order.
+ */
+auto ym::FileIO::loadMany(
+   std::span<str const>        const Filenames,
+   std::pmr::memory_resource * const Arena_Ptr,
+   LoadMode_T                  const Mode) -> std::pmr::vector<Loaded_T>
+{
+   auto loaded = std::pmr::vector<Loaded_T>(Filenames.size(), Arena_Ptr);
+
+   if (Filenames.empty())
+   { // nothing to do
+      return loaded;
+   }
+
+   auto done = false;
+
+#if (YM_FILEIO_URING)
+   if (Mode != LoadMode_T::ThreadPool)
+   { // preferred
+      done = loadMany_uring(Filenames, Arena_Ptr, loaded);
+   }
+#endif
+
+   if (!done && Mode == LoadMode_T::Uring)
+   { // not allowed to fall back
+      ymLog(VG::Warning, "io_uring not available");
+      std::ranges::fill(loaded, Loaded_T{{}, ENOSYS});
+   }
+   else if (!done)
+   { // fall back
+      loadMany_threadPool(Filenames, Arena_Ptr, loaded);
+   }
+
+   return loaded;
+}
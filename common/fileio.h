@@ -8,8 +8,14 @@
 
 #include "ymglobals.h"
 
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace ym
 {
@@ -23,7 +29,270 @@ class FileIO
 public:
    YM_NO_DEFAULT(FileIO)
 
+   YM_DECL_YMASSERT(Error)
+
+   /** MapOptions_T
+    * 
+    * @brief Access hints passed to madvise() for mapped files.
+    */
+   struct MapOptions_T
+   {
+      /// @brief File will be read front to back (aggressive read-ahead).
+      bool _sequential{true};
+
+      /// @brief Start paging the file in right away.
+      bool _willNeed{true};
+
+      /// @brief Back the view with huge pages where the filesystem allows it.
+      bool _hugePage{false};
+   };
+
+   static constexpr MapOptions_T getDefaultMapOptions(void) { return {}; }
+
+   /** MappedFile
+    * 
+    * @brief RAII read-only view of a file's contents.
+    * 
+    * @note Regular files are mapped (zero copy). Pipes, character devices, and files that
+    *       report a size of 0 (eg /proc) are read into an owned buffer instead - the view
+    *       looks the same either way.
+    */
+   class MappedFile
+   {
+   public:
+      explicit MappedFile(void) = default;
+      ~MappedFile(void);
+
+      MappedFile(MappedFile && other_uref) noexcept;
+      MappedFile & operator = (MappedFile && other_uref) noexcept;
+
+      YM_NO_COPY  (MappedFile)
+      YM_NO_ASSIGN(MappedFile)
+
+      inline auto isMapped(void) const { return _map_ptr != nullptr; }
+
+      inline std::string_view      getView(void) const;
+      inline std::span<char const> getSpan(void) const { return getView(); }
+
+   private:
+      friend FileIO;
+
+      void unmap(void);
+
+      char const *     _map_ptr     {nullptr};
+      sizet            _mapped_bytes{0uz    };
+      std::pmr::string _buffer      {       }; // fallback
+   };
+
+   /** ChunkReader
+    * 
+    * @brief Streams a file in fixed size chunks.
+    * 
+    * @note Read-ahead is left to the kernel - the whole file is advised sequential and the
+    *       window ahead of the current position is advised as will-need as we go. Pipes
+    *       and special files work too (without read-ahead).
+    */
+   class ChunkReader
+   {
+   public:
+      explicit ChunkReader(sizet const Chunk_bytes = _s_DefaultChunk_bytes);
+      ~ChunkReader(void);
+
+      YM_NO_COPY  (ChunkReader)
+      YM_NO_ASSIGN(ChunkReader)
+
+      static constexpr auto _s_DefaultChunk_bytes = 1uz << 20uz;
+      static constexpr auto _s_NReadAheadChunks   = 4uz;
+
+      bool open(str const Filename);
+      void close(void);
+
+      inline auto isOpen        (void) const { return _fd >= 0;     }
+      inline auto isEOF         (void) const { return _eof;         }
+      inline auto hasError      (void) const { return _error;       }
+      inline auto getChunk_bytes(void) const { return _Chunk_bytes; }
+
+      std::span<char const> next(void);
+      sizet                 read(std::span<char> buffer);
+
+   private:
+      void readAhead(void);
+
+      std::vector<char> _chunk        {     }; // only allocated if next() is used
+      sizet const       _Chunk_bytes  {     };
+      uint64            _offset       {0_u64}; // bytes read so far
+      uint64            _advisedOffset{0_u64}; // end of will-need window
+      int               _fd           {-1   };
+      bool              _eof          {false};
+      bool              _error        {false};
+   };
+
+   /** LineReader
+    * 
+    * @brief Splits the stream of a ChunkReader into lines (or any delimiter).
+    * 
+    * @note Lines are returned as views into an internal window - valid until the next call
+    *       to next(). A line straddling a chunk boundary is completed by moving its head
+    *       to the front of the window and reading the next chunk behind it, so no line is
+    *       ever allocated. The window only grows if a single line outgrows it.
+    */
+   class LineReader
+   {
+   public:
+      explicit LineReader(
+         ChunkReader & reader_ref,
+         char    const Delim = '\n');
+
+      YM_NO_COPY  (LineReader)
+      YM_NO_ASSIGN(LineReader)
+
+      std::optional<std::string_view> next(void);
+
+   private:
+      ChunkReader &     _reader_ref;
+      std::vector<char> _window  {     };
+      sizet             _begin   {0uz  }; // start of unconsumed bytes
+      sizet             _scan    {0uz  }; // no delimiter in [_begin, _scan)
+      sizet             _end     {0uz  }; // end of valid bytes
+      char const        _Delim   {     };
+      bool              _eof     {false};
+   };
+
+   /** WriteOptions_T
+    * 
+    * @brief Knobs for Writer.
+    */
+   struct WriteOptions_T
+   {
+      /// @brief Size of the staging buffer (rounded up to a multiple of the alignment).
+      sizet _buffer_bytes{4uz << 20uz};
+
+      /// @brief Bypass the page cache (O_DIRECT). Falls back to buffered IO where unsupported.
+      bool _direct{false};
+
+      /// @brief fsync() the file and its directory on commit.
+      bool _durable{true};
+   };
+
+   static constexpr WriteOptions_T getDefaultWriteOptions(void) { return {}; }
+
+   /** Writer
+    * 
+    * @brief Writes a file all-or-nothing.
+    * 
+    * @note Everything goes to a temporary file next to the target, which is renamed over
+    *       the target on commit(). Readers see either the old file or the complete new
+    *       one, never a partial write. If the writer is destroyed before commit() the
+    *       temporary file is removed.
+    * 
+    * @note Small writes are gathered in one aligned buffer. A write larger than the buffer
+    *       is sent together with the buffered bytes in one writev() - it is never copied
+    *       (unless O_DIRECT is in effect, which needs aligned memory).
+    */
+   class Writer
+   {
+   public:
+      explicit Writer(WriteOptions_T const & Options = getDefaultWriteOptions());
+      ~Writer(void);
+
+      YM_NO_COPY  (Writer)
+      YM_NO_ASSIGN(Writer)
+
+      static constexpr auto _s_Alignment_bytes = 4096uz;
+
+      bool open(str const Filename);
+      bool write(void const * const Data_Ptr, sizet const Size_bytes);
+      bool commit(void);
+      void abort(void);
+
+      inline bool write(std::string_view const Data) { return write(Data.data(), Data.size()); }
+
+      inline auto isOpen         (void) const { return _fd >= 0;        }
+      inline auto isDirect       (void) const { return _direct;         }
+      inline auto hasError       (void) const { return _error;          }
+      inline auto getBytesWritten(void) const { return _offset + _used; }
+
+   private:
+      /** AlignedDeleter_T
+       * 
+       * @brief Frees the staging buffer.
+       */
+      struct AlignedDeleter_T
+      {
+         void operator () (char * const data_Ptr) const
+         {
+            ::operator delete[](data_Ptr, std::align_val_t(_s_Alignment_bytes));
+         }
+      };
+
+      bool flush(sizet const NBytes);
+
+      std::unique_ptr<char[], AlignedDeleter_T> _buffer_uptr {       };
+      std::string                               _filename    {       };
+      std::string                               _tmpFilename {       };
+      sizet const                               _Buffer_bytes{       };
+      sizet                                     _used        {0uz    }; // bytes staged
+      uint64                                    _offset      {0_u64  }; // bytes in the file
+      int                                       _fd          {-1     };
+      bool const                                _WantDirect  {false  };
+      bool const                                _Durable     {true   };
+      bool                                      _direct      {false  };
+      bool                                      _error       {false  };
+   };
+
+   /** Loaded_T
+    * 
+    * @brief Result of loading one file (see loadMany()).
+    */
+   struct Loaded_T
+   {
+      std::string_view _contents{ }; // points into the arena
+      int              _error   {0}; // errno, 0 on success
+
+      inline auto isOk(void) const { return _error == 0; }
+   };
+
+   /** LoadMode_T
+    * 
+    * @brief Mechanism used to load many files at once.
+    */
+   enum class LoadMode_T
+   {
+      Auto,      // io_uring if the kernel allows it, thread pool otherwise
+      Uring,     // io_uring only (every file fails with ENOSYS if unavailable)
+      ThreadPool
+   };
+
+   static std::pmr::vector<Loaded_T> loadMany(
+      std::span<str const>        const Filenames,
+      std::pmr::memory_resource * const Arena_Ptr,
+      LoadMode_T                  const Mode = LoadMode_T::Auto);
+
+   static char const * findDelim(
+      char const * const First,
+      char const * const Last,
+      char         const Delim);
+
    static std::optional<std::pmr::string> createFileBuffer(str const Filename);
+
+   static std::optional<std::pmr::string> createFileBuffer(
+      str                         const Filename,
+      std::pmr::memory_resource * const Resource_Ptr);
+
+   static std::optional<MappedFile> mapFile(
+      str          const   Filename,
+      MapOptions_T const & Options = getDefaultMapOptions());
 };
 
+/** getView
+ * 
+ * @brief Returns the contents of the file.
+ * 
+ * @returns std::string_view -- Contents of file (valid as long as this object is).
+ */
+inline std::string_view FileIO::MappedFile::getView(void) const
+{
+   return isMapped() ? std::string_view(_map_ptr, _mapped_bytes) : std::string_view(_buffer);
+}
+
 } // ym
@@ -0,0 +1,308 @@
+/**
+ * @file    latencyhistogram.cpp
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#include "latencyhistogram.h"
+
+#include "fileio.h"
+#include "textlogger.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+/// @brief First line of a saved histogram.
+constexpr auto SaveHeader = std::string_view("# ym latency histogram v1");
+
+/** parseUint
+ *
+ * @brief Parses the next whitespace separated unsigned integer.
+ *
+ * @param text -- Text to parse from (consumed).
+ * @param val  -- Parsed value.
+ *
+ * @returns bool -- If a number was parsed.
+ */
+bool parseUint(
+   std::string_view & text,
+   ym::uint64       & val)
+{
+   auto const Start = text.find_first_not_of(" \t");
+   if (Start == std::string_view::npos)
+   { // nothing left
+      return false;
+   }
+
+   auto const Result = std::from_chars(text.data() + Start, text.data() + text.size(), val);
+   text.remove_prefix(static_cast<ym::sizet>(Result.ptr - text.data()));
+
+   return Result.ec == std::errc();
+}
+
+} // anonymous
+
+/** merge
+ *
+ * @brief Adds the contents of another histogram (eg of another thread) to this one.
+ *
+ * @note Single writer - this histogram must not be recorded into at the same time.
+ *
+ * @param Other -- Histogram to add.
+ */
+void ym::LatencyHistogram::merge(LatencyHistogram const & Other)
+{
+   for (auto i = 0uz; i < _s_NBuckets; ++i)
+   { // each bucket
+      if (auto const N = Other.getBucketCount(i); N > 0_u64)
+      { // skip the (many) empty ones
+         bump(_counts[i], N);
+      }
+   }
+
+   bump(_count, Other._count.load(std::memory_order_relaxed));
+   bump(_sum,   Other._sum  .load(std::memory_order_relaxed));
+
+   _min.store(std::min(_min.load(std::memory_order_relaxed), Other._min.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+   _max.store(std::max(_max.load(std::memory_order_relaxed), Other._max.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+}
+
+/** reset
+ *
+ * @brief Forgets all recorded values.
+ */
+void ym::LatencyHistogram::reset(void)
+{
+   for (auto & count : _counts)
+   { // each bucket
+      count.store(0_u64, std::memory_order_relaxed);
+   }
+
+   _count.store(0_u64,                               std::memory_order_relaxed);
+   _sum  .store(0_u64,                               std::memory_order_relaxed);
+   _min  .store(std::numeric_limits<uint64>::max(), std::memory_order_relaxed);
+   _max  .store(0_u64,                               std::memory_order_relaxed);
+}
+
+/** getMin
+ *
+ * @brief Returns the smallest value recorded.
+ *
+ * @returns uint64 -- Smallest value, 0 if nothing was recorded.
+ */
+auto ym::LatencyHistogram::getMin(void) const -> uint64
+{
+   return getCount() > 0_u64 ? _min.load(std::memory_order_relaxed) : 0_u64;
+}
+
+/** getMean
+ *
+ * @brief Returns the mean of the values recorded (exact, not bucketed).
+ *
+ * @returns float64 -- Mean, 0 if nothing was recorded.
+ */
+auto ym::LatencyHistogram::getMean(void) const -> float64
+{
+   auto const Count = getCount();
+
+   return Count > 0_u64 ?
+      static_cast<float64>(_sum.load(std::memory_order_relaxed)) / static_cast<float64>(Count) : 0.0_f64;
+}
+
+/** getValueAtPercentile
+ *
+ * @brief Returns the value at or below which the given percent of values fall.
+ *
+ * @note Reported as the largest value of the bucket the percentile lands in (capped at
+ *       the max recorded), so it never under-reports.
+ *
+ * @param Percentile -- Percentile in [0, 100].
+ *
+ * @returns uint64 -- Value, 0 if nothing was recorded.
+ */
+auto ym::LatencyHistogram::getValueAtPercentile(float64 const Percentile) const -> uint64
+{
+   auto total = 0_u64;
+   for (auto const & Count : _counts)
+   { // consistent with the buckets we walk even if a writer is active
+      total += Count.load(std::memory_order_relaxed);
+   }
+
+   if (total == 0_u64)
+   { // nothing recorded
+      return 0_u64;
+   }
+
+   auto const Clamped = std::clamp(Percentile, 0.0_f64, 100.0_f64);
+   auto const Rank    = std::max(1_u64, static_cast<uint64>(std::ceil((Clamped / 100.0_f64) * static_cast<float64>(total))));
+
+   auto seen = 0_u64;
+   for (auto i = 0uz; i < _s_NBuckets; ++i)
+   { // walk up to the rank
+      seen += getBucketCount(i);
+      if (seen >= Rank)
+      { // landed
+         return std::min(getBucketUpper(i), getMax());
+      }
+   }
+
+   return getMax();
+}
+
+/** getPercentileTable
+ *
+ * @brief Formats the usual percentiles as a table.
+ *
+ * @returns std::string -- Table.
+ */
+auto ym::LatencyHistogram::getPercentileTable(void) const -> std::string
+{
+   constexpr auto Percentiles = std::array{50.0_f64, 90.0_f64, 99.0_f64, 99.9_f64, 99.99_f64, 100.0_f64};
+
+   auto out = fmt::memory_buffer();
+
+   fmt::format_to(std::back_inserter(out), "count {} min {} mean {:.1f} max {}\n",
+      getCount(), getMin(), getMean(), getMax());
+
+   for (auto const P : Percentiles)
+   { // one row each
+      fmt::format_to(std::back_inserter(out), "p{:<6} {:>14}\n", P, getValueAtPercentile(P));
+   }
+
+   return fmt::to_string(out);
+}
+
+/** save
+ *
+ * @brief Writes the histogram to a text file (non-empty buckets only).
+ *
+ * @param Filename -- Name of file.
+ *
+ * @returns bool -- If the file was written.
+ */
+bool ym::LatencyHistogram::save(str const Filename) const
+{
+   auto out = fmt::memory_buffer();
+
+   fmt::format_to(std::back_inserter(out), "{}\nsub_bucket_bits {}\ncount {}\nsum {}\nmin {}\nmax {}\n",
+      SaveHeader,
+      _s_SubBucketBits,
+      getCount(),
+      _sum.load(std::memory_order_relaxed),
+      _min.load(std::memory_order_relaxed),
+      getMax());
+
+   for (auto i = 0uz; i < _s_NBuckets; ++i)
+   { // bucket index and count
+      if (auto const N = getBucketCount(i); N > 0_u64)
+      { // non-empty
+         fmt::format_to(std::back_inserter(out), "{} {}\n", i, N);
+      }
+   }
+
+   auto writer = FileIO::Writer();
+
+   auto const Saved = writer.open(Filename) && writer.write(std::string_view(out.data(), out.size())) && writer.commit();
+
+   ymLog(VG::Latency, "{} {} samples to {}", Saved ? "Saved" : "Could not save", getCount(), Filename);
+
+   return Saved;
+}
+
+/** load
+ *
+ * @brief Replaces the contents with a histogram written by save().
+ *
+ * @param Filename -- Name of file.
+ *
+ * @returns bool -- If the file was read (contents are unchanged otherwise).
+ */
+bool ym::LatencyHistogram::load(str const Filename)
+{
+   auto const Buffer = FileIO::createFileBuffer(Filename);
+
+   if (!Buffer)
+   { // no such file
+      ymLog(VG::Latency, "Could not read latency histogram {}", Filename);
+      return false;
+   }
+
+   auto text = std::string_view(*Buffer);
+
+   auto const NextLine = [&text](void) {
+      auto const End  = text.find('\n');
+      auto const Line = text.substr(0uz, End);
+      text.remove_prefix(End == std::string_view::npos ? text.size() : End + 1uz);
+      return Line;
+   };
+
+   auto const ReadField = [&NextLine](std::string_view const Name, uint64 & val) {
+      auto line = NextLine();
+      if (!line.starts_with(Name))
+      { // wrong field
+         return false;
+      }
+      line.remove_prefix(Name.size());
+      return parseUint(line, val);
+   };
+
+   auto subBucketBits = 0_u64;
+   auto count         = 0_u64;
+   auto sum           = 0_u64;
+   auto min           = 0_u64;
+   auto max           = 0_u64;
+
+   auto const Valid =
+      NextLine() == SaveHeader                    &&
+      ReadField("sub_bucket_bits", subBucketBits) &&
+      subBucketBits == _s_SubBucketBits           &&
+      ReadField("count",           count        ) &&
+      ReadField("sum",             sum          ) &&
+      ReadField("min",             min          ) &&
+      ReadField("max",             max          );
+
+   if (!Valid)
+   { // not ours, or a different layout
+      ymLog(VG::Latency, "{} is not a latency histogram", Filename);
+      return false;
+   }
+
+   auto counts = std::vector<uint64>(_s_NBuckets, 0_u64);
+   while (!text.empty())
+   { // bucket lines
+      auto line = NextLine();
+      auto idx  = 0_u64;
+      auto n    = 0_u64;
+
+      if (!line.empty() && (!parseUint(line, idx) || !parseUint(line, n) || idx >= _s_NBuckets))
+      { // corrupt
+         ymLog(VG::Latency, "Bad bucket in latency histogram {}", Filename);
+         return false;
+      }
+
+      counts[idx] += n;
+   }
+
+   for (auto i = 0uz; i < _s_NBuckets; ++i)
+   { // publish
+      _counts[i].store(counts[i], std::memory_order_relaxed);
+   }
+
+   _count.store(count, std::memory_order_relaxed);
+   _sum  .store(sum,   std::memory_order_relaxed);
+   _min  .store(min,   std::memory_order_relaxed);
+   _max  .store(max,   std::memory_order_relaxed);
+
+   ymLog(VG::Latency, "Loaded {} samples from {}", count, Filename);
+
+   return true;
+}
@@ -0,0 +1,205 @@
+/**
+ * @file    latencyhistogram.h
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#pragma once
+
+#include "ymglobals.h"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <limits>
+#include <string>
+
+namespace ym
+{
+
+/** LatencyHistogram
+ *
+ * @brief Fixed memory, log-linear histogram of latencies (in the spirit of HdrHistogram).
+ *
+ * @note Values below 2^(_s_SubBucketBits+1) get a bucket each. Above that every power of
+ *       two is split into 2^_s_SubBucketBits equal buckets, so any recorded value is known
+ *       to within 1 part in 2^_s_SubBucketBits (< 0.8%) over the whole uint64 range.
+ *
+ * @note record() is O(1) and lock free - one bucket index computation (a count leading
+ *       zeros and a shift) and a few relaxed atomic updates. It assumes one writer per
+ *       histogram (eg one per thread, merged afterwards). Use recordConcurrent() if
+ *       several threads share a histogram. Readers may query at any time.
+ *
+ * @note About 60KB - prefer static or heap storage over the stack.
+ */
+class LatencyHistogram
+{
+public:
+   explicit LatencyHistogram(void) = default;
+
+   YM_NO_COPY  (LatencyHistogram)
+   YM_NO_ASSIGN(LatencyHistogram)
+
+   static constexpr auto _s_SubBucketBits = 7_u32;
+   static constexpr auto _s_NSubBuckets   = 1uz << _s_SubBucketBits;
+   static constexpr auto _s_NBuckets      = (65uz - _s_SubBucketBits) * _s_NSubBuckets;
+
+   static constexpr sizet  getBucketIdx  (uint64 const Value);
+   static constexpr uint64 getBucketLower(sizet  const Idx  );
+   static constexpr uint64 getBucketUpper(sizet  const Idx  );
+
+   inline void record          (uint64 const Value);
+   inline void recordConcurrent(uint64 const Value);
+
+   template <typename Rep_T, typename Period_T>
+   inline void record(std::chrono::duration<Rep_T, Period_T> const Duration);
+
+   void merge(LatencyHistogram const & Other);
+   void reset(void);
+
+   inline auto getCount(void) const { return _count.load(std::memory_order_relaxed); }
+   inline auto getMax  (void) const { return _max  .load(std::memory_order_relaxed); }
+
+   uint64  getMin (void) const;
+   float64 getMean(void) const;
+
+   inline auto getBucketCount(sizet const Idx) const { return _counts[Idx].load(std::memory_order_relaxed); }
+
+   uint64      getValueAtPercentile(float64 const Percentile) const;
+   std::string getPercentileTable  (void) const;
+
+   bool save(str const Filename) const;
+   bool load(str const Filename);
+
+private:
+   static inline void bump(std::atomic<uint64> & count_ref, uint64 const N);
+
+   std::array<std::atomic<uint64>, _s_NBuckets> _counts{ /* default */ };
+   std::atomic<uint64>                          _count {0_u64};
+   std::atomic<uint64>                          _sum   {0_u64};
+   std::atomic<uint64>                          _min   {std::numeric_limits<uint64>::max()};
+   std::atomic<uint64>                          _max   {0_u64};
+};
+
+/** getBucketIdx
+ *
+ * @brief Returns the bucket a value falls into.
+ *
+ * @param Value -- Value.
+ *
+ * @returns sizet -- Bucket index.
+ */
+constexpr auto LatencyHistogram::getBucketIdx(uint64 const Value) -> sizet
+{
+   if (Value < (2_u64 << _s_SubBucketBits))
+   { // linear region
+      return static_cast<sizet>(Value);
+   }
+
+   auto const Shift = static_cast<uint32>(std::bit_width(Value)) - 1_u32 - _s_SubBucketBits;
+
+   return (static_cast<sizet>(Shift) << _s_SubBucketBits) + static_cast<sizet>(Value >> Shift);
+}
+
+/** getBucketLower
+ *
+ * @brief Returns the smallest value of a bucket.
+ *
+ * @param Idx -- Bucket index.
+ *
+ * @returns uint64 -- Smallest value.
+ */
+constexpr auto LatencyHistogram::getBucketLower(sizet const Idx) -> uint64
+{
+   if (Idx < (2uz << _s_SubBucketBits))
+   { // linear region
+      return static_cast<uint64>(Idx);
+   }
+
+   auto const Shift = (Idx >> _s_SubBucketBits) - 1uz;
+
+   return static_cast<uint64>(Idx - (Shift << _s_SubBucketBits)) << Shift;
+}
+
+/** getBucketUpper
+ *
+ * @brief Returns the largest value of a bucket.
+ *
+ * @param Idx -- Bucket index.
+ *
+ * @returns uint64 -- Largest value.
+ */
+constexpr auto LatencyHistogram::getBucketUpper(sizet const Idx) -> uint64
+{
+   return (Idx + 1uz < _s_NBuckets) ? getBucketLower(Idx + 1uz) - 1_u64 : std::numeric_limits<uint64>::max();
+}
+
+/** bump
+ *
+ * @brief Adds to a counter only this thread writes - no locked instruction needed.
+ *
+ * @param count_ref -- Counter.
+ * @param N         -- Amount to add.
+ */
+inline void LatencyHistogram::bump(
+   std::atomic<uint64> & count_ref,
+   uint64        const   N)
+{
+   count_ref.store(count_ref.load(std::memory_order_relaxed) + N, std::memory_order_relaxed);
+}
+
+/** record
+ *
+ * @brief Records a value (single writer).
+ *
+ * @param Value -- Value (eg latency in ns).
+ */
+inline void LatencyHistogram::record(uint64 const Value)
+{
+   bump(_counts[getBucketIdx(Value)], 1_u64);
+   bump(_count, 1_u64);
+   bump(_sum,   Value);
+
+   if (Value < _min.load(std::memory_order_relaxed)) { _min.store(Value, std::memory_order_relaxed); }
+   if (Value > _max.load(std::memory_order_relaxed)) { _max.store(Value, std::memory_order_relaxed); }
+}
+
+/** recordConcurrent
+ *
+ * @brief Records a value (any number of writers).
+ *
+ * @param Value -- Value (eg latency in ns).
+ */
+inline void LatencyHistogram::recordConcurrent(uint64 const Value)
+{
+   _counts[getBucketIdx(Value)].fetch_add(1_u64, std::memory_order_relaxed);
+   _count.fetch_add(1_u64, std::memory_order_relaxed);
+   _sum  .fetch_add(Value, std::memory_order_relaxed);
+
+   for (auto min = _min.load(std::memory_order_relaxed);
+        Value < min && !_min.compare_exchange_weak(min, Value, std::memory_order_relaxed);)
+   { } // lost a race - retry with the new min
+
+   for (auto max = _max.load(std::memory_order_relaxed);
+        Value > max && !_max.compare_exchange_weak(max, Value, std::memory_order_relaxed);)
+   { } // lost a race - retry with the new max
+}
+
+/** record
+ *
+ * @brief Records a duration in nanoseconds (single writer). Negative durations count as 0.
+ *
+ * @tparam Rep_T    -- Representation of duration.
+ * @tparam Period_T -- Period of duration.
+ *
+ * @param Duration -- Duration (eg from Timer::getElapsedTime()).
+ */
+template <typename Rep_T, typename Period_T>
+inline void LatencyHistogram::record(std::chrono::duration<Rep_T, Period_T> const Duration)
+{
+   auto const NS = std::chrono::duration_cast<std::chrono::duration<int64, std::nano>>(Duration).count();
+   record(NS > 0_i64 ? static_cast<uint64>(NS) : 0_u64);
+}
+
+} // ym
@@ -7,17 +7,20 @@
 #include "logger.h"
 
 #include "textlogger.h"
-#include "timer.h"
 
 #include "fmt/chrono.h"
 #include "fmt/format.h"
 
 #include <array>
+#include <cerrno>
 #include <exception>
-#include <filesystem>
 #include <memory_resource>
+#include <new>
 #include <string>
-#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 /** Logger
  *
@@ -26,6 +29,7 @@
  * @note _outfile_uptr is set to null to serve as a flag that the logger is uninitialized.
  */
 ym::Logger::Logger(void) :
+   _buffer_uptr  {nullptr, BufferDeleter_T{0uz}},
    _outfile_uptr {nullptr,
       [] (std::FILE * const file_Ptr) {
          if (file_Ptr != stdout &&
@@ -75,6 +79,9 @@ bool ym::Logger::openOutfile(
  *
  * @brief Attempts to open a write-file.
  * 
+ * @note If overwriting is disallowed the file is created with O_EXCL, so checking for
+ *       and creating the file is a single (race free) syscall.
+ * 
  * @param Filename -- Name of file.
  * @param Options  -- List of optional opening modes.
  */
@@ -82,19 +89,131 @@ void ym::Logger::openOutfile_core(
    std::string_view const   Filename,
    OpeningOptions_T const & Options)
 {
-   std::error_code ec;
-   if (Options == OverwriteMode_T::Disallow &&
-      std::filesystem::exists(Filename, ec))
-   { // file we are attempting to create already exists
-      ymLog(VG::Warning, "WARNING: File (or directory) '{}' already exists", Filename);
-   }
-   else if (ec)
-   { // filesystem failure
-      ymLog(VG::Warning, "WARNING: Filesystem error when attempting to open '{}' with error code {}", Filename, ec.value());
+   auto const Flags = O_WRONLY | O_CREAT | O_CLOEXEC |
+      ((Options == OverwriteMode_T::Disallow) ? O_EXCL : O_TRUNC);
+
+   auto const FD = ::open(Filename.data(), Flags, 0644);
+
+   if (FD < 0)
+   { // status of failure handled at call site
+      if (errno == EEXIST)
+      { // file we are attempting to create already exists
+         ymLog(VG::Warning, "WARNING: File (or directory) '{}' already exists", Filename);
+      }
+      else
+      { // filesystem failure
+         ymLog(VG::Warning, "WARNING: Filesystem error when attempting to open '{}' with error code {}", Filename, errno);
+      }
    }
    else
-   { // open!
-      _outfile_uptr.reset(std::fopen(Filename.data(), "w")); // status of failure handled at call site
+   { // wrap in a stream
+      _outfile_uptr.reset(::fdopen(FD, "w"));
+
+      if (isOutfileOpened())
+      { // open!
+         setupBuffer(Options);
+         _durabilityMode = Options._durabilityMode;
+         _syncPeriod     = Options._syncPeriod;
+         _lastSync       = SyncClock_T::now();
+      }
+      else
+      { // status of failure handled at call site
+         (void)::close(FD);
+      }
+   }
+}
+
+/** setupBuffer
+ *
+ * @brief Replaces the stdio buffer of the freshly opened file.
+ * 
+ * @note Huge pages are tried first from the reserved pool (MAP_HUGETLB), then as
+ *       transparent huge pages. If neither can be mapped the heap is used.
+ * 
+ * @note Must be called before anything is written to the file.
+ * 
+ * @param Options -- List of optional opening modes.
+ */
+void ym::Logger::setupBuffer(OpeningOptions_T const & Options)
+{
+   auto const Size_bytes = Options._bufferSize_bytes;
+
+   if (Size_bytes == 0uz)
+   { // keep stdio default
+      return;
+   }
+
+   if (Options == BufferMode_T::HugePages)
+   { // try to map
+      constexpr auto HugePage_bytes = 2uz * 1024uz * 1024uz;
+      auto const     Mapped_bytes   = (Size_bytes + HugePage_bytes - 1uz) & ~(HugePage_bytes - 1uz);
+
+      auto * map_ptr = ::mmap(nullptr, Mapped_bytes, PROT_READ | PROT_WRITE,
+         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+      if (map_ptr == MAP_FAILED)
+      { // no reserved huge pages - ask for transparent ones
+         map_ptr = ::mmap(nullptr, Mapped_bytes, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+         if (map_ptr != MAP_FAILED)
+         { // hint only
+            (void)::madvise(map_ptr, Mapped_bytes, MADV_HUGEPAGE);
+         }
+      }
+
+      if (map_ptr != MAP_FAILED)
+      { // mapped
+         _buffer_uptr = decltype(_buffer_uptr)(static_cast<byte *>(map_ptr), BufferDeleter_T{Mapped_bytes});
+      }
+      else
+      { // fall back to the heap
+         ymLog(VG::Warning, "WARNING: Could not map {} byte huge page buffer (errno {})", Mapped_bytes, errno);
+      }
+   }
+
+   if (!_buffer_uptr)
+   { // from the heap
+      _buffer_uptr = decltype(_buffer_uptr)(new byte[Size_bytes], BufferDeleter_T{0uz});
+   }
+
+   if (std::setvbuf(_outfile_uptr.get(), ymCastPtrTo<char>(_buffer_uptr.get()), _IOFBF, Size_bytes) != 0)
+   { // stdio keeps its own buffer
+      ymLog(VG::Warning, "WARNING: Could not set {} byte buffer", Size_bytes);
+      _buffer_uptr.reset();
+   }
+}
+
+/** commitWrite
+ *
+ * @brief Enforces the durability mode. Derived classes call this after every write.
+ */
+void ym::Logger::commitWrite(void)
+{
+   if (_durabilityMode == DurabilityMode_T::EveryWrite)
+   { // always
+      sync();
+   }
+   else if (_durabilityMode == DurabilityMode_T::Periodic)
+   { // only if enough time has passed
+      if (auto const Now = SyncClock_T::now(); Now - _lastSync >= _syncPeriod)
+      { // due
+         sync();
+         _lastSync = Now;
+      }
+   }
+}
+
+/** sync
+ *
+ * @brief Flushes stdio and forces the written data to disk.
+ */
+void ym::Logger::sync(void)
+{
+   if (isOutfileOpened())
+   { // something to sync
+      (void)std::fflush(_outfile_uptr.get());
+      (void)::fdatasync(::fileno(_outfile_uptr.get()));
    }
 }
 
@@ -147,7 +266,7 @@ void ym::Logger::openOutfile_appendTimeStamp(
       result.out,
       TimeStamp.size(),
       "_{:%Y_%m_%d_%H_%M_%S}",
-      Timer::Clock_T::now());
+      std::chrono::system_clock::now());
 
    // write extension
    result = fmt::format_to_n(
@@ -165,8 +284,35 @@ void ym::Logger::openOutfile_appendTimeStamp(
 /** closeOutfile
  *
  * @brief Closes the file and disassociates the file handle.
+ * 
+ * @note Unless the durability mode is None, written data is forced to disk first.
  */
 void ym::Logger::closeOutfile(void)
 {
+   if (_durabilityMode != DurabilityMode_T::None)
+   { // last chance
+      sync();
+   }
+
    _outfile_uptr.reset(nullptr);
+   _buffer_uptr .reset(nullptr); // only after the file is closed (flushed from the buffer)
+   _durabilityMode = DurabilityMode_T::None;
+}
+
+/** operator()
+ *
+ * @brief Frees the buffer.
+ * 
+ * @param buffer_Ptr -- Buffer to free.
+ */
+void ym::Logger::BufferDeleter_T::operator () (byte * const buffer_Ptr) const
+{
+   if (_mapped_bytes > 0uz)
+   { // mapped
+      (void)::munmap(buffer_Ptr, _mapped_bytes);
+   }
+   else
+   { // heap
+      delete[] buffer_Ptr;
+   }
 }
@@ -8,6 +8,7 @@
 
 #include "ymglobals.h"
 
+#include <chrono>
 #include <cstdio>
 #include <memory>
 #include <string_view>
@@ -46,6 +47,27 @@ public:
       Disallow
    };
 
+   /** DurabilityMode_T
+    * 
+    * @brief Mode to indicate how often written data is forced to disk.
+    */
+   enum class DurabilityMode_T
+   {
+      None,       // leave it to stdio and the OS
+      Periodic,   // fdatasync() at most once per sync period
+      EveryWrite  // fdatasync() after every write
+   };
+
+   /** BufferMode_T
+    * 
+    * @brief Mode to indicate what backs the stdio buffer (if a size is given).
+    */
+   enum class BufferMode_T
+   {
+      Heap,
+      HugePages // falls back to transparent huge pages, then to regular pages
+   };
+
    /** OpeningOptions_T
     * 
     * @brief Options surrounding opening a file.
@@ -58,6 +80,18 @@ public:
       /// @brief Mode to determine if to overwrite file while opening or not.
       OverwriteMode_T _overwriteMode{OverwriteMode_T::Disallow};
 
+      /// @brief Mode to determine how often to force data to disk.
+      DurabilityMode_T _durabilityMode{DurabilityMode_T::None};
+
+      /// @brief Mode to determine what backs the stdio buffer.
+      BufferMode_T _bufferMode{BufferMode_T::Heap};
+
+      /// @brief Size of stdio buffer (0 keeps the stdio default of BUFSIZ).
+      sizet _bufferSize_bytes{0uz};
+
+      /// @brief Min time between syncs (see DurabilityMode_T::Periodic).
+      std::chrono::milliseconds _syncPeriod{1000};
+
       /// @brief Allows direct comparison between OpeningOptions_T and specified field type.
       constexpr friend bool operator == (OpeningOptions_T const & Opts, FilenameMode_T const Mode) {
          return Opts._filenameMode == Mode;
@@ -67,6 +101,16 @@ public:
       constexpr friend bool operator == (OpeningOptions_T const & Opts, OverwriteMode_T const Mode) {
          return Opts._overwriteMode == Mode;
       }
+
+      /// @brief Allows direct comparison between OpeningOptions_T and specified field type.
+      constexpr friend bool operator == (OpeningOptions_T const & Opts, DurabilityMode_T const Mode) {
+         return Opts._durabilityMode == Mode;
+      }
+
+      /// @brief Allows direct comparison between OpeningOptions_T and specified field type.
+      constexpr friend bool operator == (OpeningOptions_T const & Opts, BufferMode_T const Mode) {
+         return Opts._bufferMode == Mode;
+      }
    };
 
    static constexpr OpeningOptions_T getDefaultOpeningOptions(void) { return {}; }
@@ -87,13 +131,40 @@ protected:
 
    bool openOutfile(std::string_view const Filename, OpeningOptions_T const & Options);
    void closeOutfile(void);
-   
+
+   void commitWrite(void);
+
+private:
+   /** BufferDeleter_T
+    * 
+    * @brief Frees a stdio buffer (heap or mapped).
+    */
+   struct BufferDeleter_T
+   {
+      sizet _mapped_bytes; // 0 if from the heap
+
+      void operator () (byte * const buffer_Ptr) const;
+   };
+
+   // declared before the file so it outlives it (stdio flushes from it on close)
+   std::unique_ptr<byte[], BufferDeleter_T> _buffer_uptr;
+
+protected:
    using FileDeleter_T = void(*)(std::FILE * const);
    std::unique_ptr<std::FILE, FileDeleter_T> _outfile_uptr;
 
 private:
    void openOutfile_core           (std::string_view const Filename, OpeningOptions_T const & Options);
    void openOutfile_appendTimeStamp(std::string_view const Filename, OpeningOptions_T const & Options);
+
+   void setupBuffer(OpeningOptions_T const & Options);
+   void sync(void);
+
+   using SyncClock_T = std::chrono::steady_clock;
+
+   DurabilityMode_T          _durabilityMode{DurabilityMode_T::None};
+   std::chrono::milliseconds _syncPeriod    {                      };
+   SyncClock_T::time_point   _lastSync      {                      };
 };
 
 } // ym
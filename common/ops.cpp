@@ -1,446 +1,1607 @@
-// /**
-//  * @file    ops.cpp
-//  * @version 1.0.0
-//  * @author  Forrest Jablonski
-//  */
-
-// #include "ops.h"
-
-// #include <limits>
-// #include <stdexcept>
-
-// /** castToChar
-//  *
-//  * @brief Casts string to char.
-//  * 
-//  * @throws OpsError_BadCastToChar -- If string is not a valid char.
-//  * 
-//  * @param S -- String to cast.
-//  * 
-//  * @returns char -- String as char.
-//  */
-// char ym::Ops::castToChar(str const S)
-// {
-//    OpsError_BadCast::check(S && S[0_u32] && !S[1_u32], "String '%s' not a valid char", S.get());
-//    return S[0_u32];
-// }
-
-// /** castTo
-//  *
-//  * @brief Casts string to int8.
-//  * 
-//  * @note std::strtoi doesn't flag an error if conversion is invalid.
-//  * 
-//  * @note Most strings will likely be small enough for small string
-//  *       optimization to take effect.
-//  * 
-//  * @throws OpsError_BadCast -- If string is not a valid or out of range int32.
-//  * @throws OpsError_BadCast -- If string is not in range of int8.
-//  * 
-//  * @param S    -- String to cast.
-//  * @param Base -- Radix of int8.
-//  * 
-//  * @returns int8 -- String as int8.
-//  */
-// template <>
-// auto ym::Ops::castTo<ym::int8>(std::string const & S,
-//                                uint32      const   Base) -> int8
-// {
-//    auto val_int32 = 0_i32;
-
-//    try
-//    {
-//       auto const Val = std::stoi(S, nullptr, Base);
-//       static_assert(std::is_same_v<decltype(Val), int32 const>, "Unexpected type");
-//       val_int32 = Val;
-//    }
-//    catch (std::exception const & E)
-//    {
-//       OpsError_BadCast::check(false, "String '%s' invalid or out of range int32 (%s)", S.c_str(), E.what());
-//    }
-
-//    OpsError_BadCast::check(
-//       val_int32 >= static_cast<int32>(std::numeric_limits<int8>::min()) &&
-//       val_int32 <= static_cast<int32>(std::numeric_limits<int8>::max()),
-//       "String '%s' out of int8 range", S.c_str());
-
-//    return static_cast<int8>(val_int32);
-// }
-
-// /** castTo
-//  *
-//  * @brief Casts string to int16.
-//  * 
-//  * @note std::strtoi doesn't flag an error if conversion is invalid.
-//  * 
-//  * @note Most strings will likely be small enough for small string
-//  *       optimization to take effect.
-//  * 
-//  * @throws OpsError_BadCast -- If string is not a valid or out of range int32.
-//  * @throws OpsError_BadCast -- If string is not in range of int16.
-//  * 
-//  * @param S    -- String to cast.
-//  * @param Base -- Radix of int16.
-//  * 
-//  * @returns int16 -- String as int16.
-//  */
-// template <>
-// auto ym::Ops::castTo<ym::int16>(std::string const & S,
-//                                 uint32      const   Base) -> int16
-// {
-//    auto val_int32 = 0_i32;
-
-//    try
-//    {
-//       auto const Val = std::stoi(S, nullptr, Base);
-//       static_assert(std::is_same_v<decltype(Val), int32 const>, "Unexpected type");
-//       val_int32 = Val;
-//    }
-//    catch (std::exception const & E)
-//    {
-//       OpsError_BadCast::check(false, "String '%s' invalid or out of range int32 (%s)", S.c_str(), E.what());
-//    }
-
-//    OpsError_BadCast::check(
-//       val_int32 >= static_cast<int32>(std::numeric_limits<int16>::min()) &&
-//       val_int32 <= static_cast<int32>(std::numeric_limits<int16>::max()),
-//       "String '%s' out of int16 range", S.c_str());
-
-//    return static_cast<int16>(val_int32);
-// }
-
-// /** castTo
-//  *
-//  * @brief Casts string to int32.
-//  * 
-//  * @note std::strtoi doesn't flag an error if conversion is invalid.
-//  * 
-//  * @note Most strings will likely be small enough for small string
-//  *       optimization to take effect.
-//  * 
-//  * @throws OpsError_BadCast -- If string is not a valid or out of range int32.
-//  * 
-//  * @param S    -- String to cast.
-//  * @param Base -- Radix of int32.
-//  * 
-//  * @returns int32 -- String as int32.
-//  */
-// template <>
-// auto ym::Ops::castTo<ym::int32>(std::string const & S,
-//                                 uint32      const   Base) -> int32
-// {
-//    auto val_int32 = 0_i32;
-
-//    try
-//    {
-//       auto const Val = std::stoi(S, nullptr, Base);
-//       static_assert(std::is_same_v<decltype(Val), int32 const>, "Unexpected type");
-//       val_int32 = Val;
-//    }
-//    catch (std::exception const & E)
-//    {
-//       OpsError_BadCast::check(false, "String '%s' invalid or out of range int32 (%s)", S.c_str(), E.what());
-//    }
-
-//    return val_int32;
-// }
-
-// /** castTo
-//  *
-//  * @brief Casts string to int64.
-//  * 
-//  * @note std::strtol doesn't flag an error if conversion is invalid.
-//  * 
-//  * @note Most strings will likely be small enough for small string
-//  *       optimization to take effect.
-//  * 
-//  * @throws OpsError_BadCast -- If string is not a valid or out of range int64.
-//  * 
-//  * @param S    -- String to cast.
-//  * @param Base -- Radix of int64.
-//  * 
-//  * @returns int64 -- String as int64.
-//  */
-// template <>
-// auto ym::Ops::castTo<ym::int64>(std::string const & S,
-//                                 uint32      const   Base) -> int64
-// {
-//    auto val_int64 = 0_i64;
-
-//    try
-//    {
-//       auto const Val = std::stol(S, nullptr, Base);
-//       static_assert(std::is_same_v<decltype(Val), int64 const>, "Unexpected type");
-//       val_int64 = Val;
-//    }
-//    catch (std::exception const & E)
-//    {
-//       OpsError_BadCast::check(false, "String '%s' invalid or out of range int64 (%s)", S.c_str(), E.what());
-//    }
-
-//    return val_int64;
-// }
-
-// /** castTo
-//  *
-//  * @brief Casts string to uint8.
-//  * 
-//  * @note std::strtoul doesn't flag an error if conversion is invalid.
-//  * 
-//  * @note Most strings will likely be small enough for small string
-//  *       optimization to take effect.
-//  * 
-//  * @throws OpsError_BadCast -- If string is not a valid or out of range uint64.
-//  * @throws OpsError_BadCast -- If string is not in range of uint8.
-//  * 
-//  * @param S    -- String to cast.
-//  * @param Base -- Radix of uint8.
-//  * 
-//  * @returns uint8 -- String as uint8.
-//  */
-// template <>
-// auto ym::Ops::castTo<ym::uint8>(std::string const & S,
-//                                 uint32      const   Base) -> uint8
-// {
-//    auto val_uint64 = 0_u64;
-
-//    try
-//    {
-//       auto const Val = std::stoul(S, nullptr, Base);
-//       static_assert(std::is_same_v<decltype(Val), uint64 const>, "Unexpected type");
-//       val_uint64 = Val;
-//    }
-//    catch (std::exception const & E)
-//    {
-//       OpsError_BadCast::check(false, "String '%s' invalid or out of range uint64 (%s)", S.c_str(), E.what());
-//    }
-
-//    OpsError_BadCast::check(
-//       val_uint64 >= static_cast<uint64>(std::numeric_limits<uint8>::min()) &&
-//       val_uint64 <= static_cast<uint64>(std::numeric_limits<uint8>::max()),
-//       "String '%s' out of uint8 range", S.c_str());
-
-//    return static_cast<uint8>(val_uint64);
-// }
-
-// /** castTo
-//  *
-//  * @brief Casts string to uint16.
-//  * 
-//  * @note std::strtoul doesn't flag an error if conversion is invalid.
-//  * 
-//  * @note Most strings will likely be small enough for small string
-//  *       optimization to take effect.
-//  * 
-//  * @throws OpsError_BadCast -- If string is not a valid or out of range uint64.
-//  * @throws OpsError_BadCast -- If string is not in range of uint16.
-//  * 
-//  * @param S    -- String to cast.
-//  * @param Base -- Radix of uint16.
-//  * 
-//  * @returns uint16 -- String as uint16.
-//  */
-// template <>
-// auto ym::Ops::castTo<ym::uint16>(std::string const & S,
-//                                  uint32      const   Base) -> uint16
-// {
-//    auto val_uint64 = 0_u64;
-
-//    try
-//    {
-//       auto const Val = std::stoul(S, nullptr, Base);
-//       static_assert(std::is_same_v<decltype(Val), uint64 const>, "Unexpected type");
-//       val_uint64 = Val;
-//    }
-//    catch (std::exception const & E)
-//    {
-//       OpsError_BadCast::check(false, "String '%s' invalid or out of range uint64 (%s)", S.c_str(), E.what());
-//    }
-
-//    OpsError_BadCast::check(
-//       val_uint64 >= static_cast<uint64>(std::numeric_limits<uint16>::min()) &&
-//       val_uint64 <= static_cast<uint64>(std::numeric_limits<uint16>::max()),
-//       "String '%s' out of uint16 range", S.c_str());
-
-//    return static_cast<uint16>(val_uint64);
-// }
-
-// /** castTo
-//  *
-//  * @brief Casts string to uint32.
-//  * 
-//  * @note std::strtoul doesn't flag an error if conversion is invalid.
-//  * 
-//  * @note Most strings will likely be small enough for small string
-//  *       optimization to take effect.
-//  * 
-//  * @throws OpsError_BadCast -- If string is not a valid or out of range uint64.
-//  * @throws OpsError_BadCast -- If string is not in range of uint32.
-//  * 
-//  * @param S    -- String to cast.
-//  * @param Base -- Radix of uint32.
-//  * 
-//  * @returns uint32 -- String as uint32.
-//  */
-// template <>
-// auto ym::Ops::castTo<ym::uint32>(std::string const & S,
-//                                  uint32      const   Base) -> uint32
-// {
-//    auto val_uint64 = 0_u64;
-
-//    try
-//    {
-//       auto const Val = std::stoul(S, nullptr, Base);
-//       static_assert(std::is_same_v<decltype(Val), uint64 const>, "Unexpected type");
-//       val_uint64 = Val;
-//    }
-//    catch (std::exception const & E)
-//    {
-//       OpsError_BadCast::check(false, "String '%s' invalid or out of range uint64 (%s)", S.c_str(), E.what());
-//    }
-
-//    OpsError_BadCast::check(
-//       val_uint64 >= static_cast<uint64>(std::numeric_limits<uint32>::min()) &&
-//       val_uint64 <= static_cast<uint64>(std::numeric_limits<uint32>::max()),
-//       "String '%s' out of uint32 range", S.c_str());
-
-//    return static_cast<uint32>(val_uint64);
-// }
-
-// /** castTo
-//  *
-//  * @brief Casts string to uint64.
-//  * 
-//  * @note std::strtoul doesn't flag an error if conversion is invalid.
-//  * 
-//  * @note Most strings will likely be small enough for small string
-//  *       optimization to take effect.
-//  * 
-//  * @throws OpsError_BadCast -- If string is not a valid or out of range uint64.
-//  * 
-//  * @param S    -- String to cast.
-//  * @param Base -- Radix of uint64.
-//  * 
-//  * @returns uint64 -- String as uint64.
-//  */
-// template <>
-// auto ym::Ops::castTo<ym::uint64>(std::string const & S,
-//                                  uint32      const   Base) -> uint64
-// {
-//    auto val_uint64 = 0_u64;
-
-//    try
-//    {
-//       auto const Val = std::stoul(S, nullptr, Base);
-//       static_assert(std::is_same_v<decltype(Val), uint64 const>, "Unexpected type");
-//       val_uint64 = Val;
-//    }
-//    catch (std::exception const & E)
-//    {
-//       OpsError_BadCast::check(false, "String '%s' invalid or out of range uint64 (%s)", S.c_str(), E.what());
-//    }
-
-//    return val_uint64;
-// }
-
-// /** castTo
-//  *
-//  * @brief Casts string to float32.
-//  * 
-//  * @note std::strtof doesn't flag an error if conversion is invalid.
-//  * 
-//  * @note Most strings will likely be small enough for small string
-//  *       optimization to take effect.
-//  * 
-//  * @throws OpsError_BadCast -- If string is not a valid or out of range float32.
-//  * 
-//  * @param S -- String to cast.
-//  * 
-//  * @returns float32 -- String as float32.
-//  */
-// template <>
-// auto ym::Ops::castTo<ym::float32>(std::string const & S) -> float32
-// {
-//    auto val_float32 = 0_f32;
-
-//    try
-//    {
-//       auto const Val = std::stof(S, nullptr);
-//       static_assert(std::is_same_v<decltype(Val), float32 const>, "Unexpected type");
-//       val_float32 = Val;
-//    }
-//    catch (std::exception const & E)
-//    {
-//       OpsError_BadCast::check(false, "String '%s' invalid or out of range float32 (%s)", S.c_str(), E.what());
-//    }
-
-//    return val_float32;
-// }
-
-// /** castTo
-//  *
-//  * @brief Casts string to float64.
-//  * 
-//  * @note std::strtof doesn't flag an error if conversion is invalid.
-//  * 
-//  * @note Most strings will likely be small enough for small string
-//  *       optimization to take effect.
-//  * 
-//  * @throws OpsError_BadCast -- If string is not a valid or out of range float64.
-//  * 
-//  * @param S -- String to cast.
-//  * 
-//  * @returns float64 -- String as float64.
-//  */
-// template <>
-// auto ym::Ops::castTo<ym::float64>(std::string const & S) -> float64
-// {
-//    auto val_float64 = 0_f64;
-
-//    try
-//    {
-//       auto const Val = std::stod(S, nullptr);
-//       static_assert(std::is_same_v<decltype(Val), float64 const>, "Unexpected type");
-//       val_float64 = Val;
-//    }
-//    catch (std::exception const & E)
-//    {
-//       OpsError_BadCast::check(false, "String '%s' invalid or out of range float64 (%s)", S.c_str(), E.what());
-//    }
-
-//    return val_float64;
-// }
-
-// /** castTo
-//  *
-//  * @brief Casts string to floatext.
-//  * 
-//  * @note std::strtof doesn't flag an error if conversion is invalid.
-//  * 
-//  * @note Most strings will likely be small enough for small string
-//  *       optimization to take effect.
-//  * 
-//  * @throws OpsError_BadCast -- If string is not a valid or out of range floatext.
-//  * 
-//  * @param S -- String to cast.
-//  * 
-//  * @returns floatext -- String as floatext.
-//  */
-// template <>
-// auto ym::Ops::castTo<ym::floatext>(std::string const & S) -> floatext
-// {
-//    auto val_floatext = 0_fext;
-
-//    try
-//    {
-//       auto const Val = std::stold(S, nullptr);
-//       static_assert(std::is_same_v<decltype(Val), floatext const>, "Unexpected type");
-//       val_floatext = Val;
-//    }
-//    catch (std::exception const & E)
-//    {
-//       OpsError_BadCast::check(false, "String '%s' invalid or out of range floatext (%s)", S.c_str(), E.what());
-//    }
-
-//    return val_floatext;
-// }
+/**
+ * @file    ops.cpp
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#include "ops.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace
+{
+
+using namespace ym;
+
+/** isEightDigits
+ *
+ * @brief Checks if the next 8 chars are all decimal digits.
+ *
+ * @note A digit is 0x3N with N <= 9. Adding 6 carries into the high nibble exactly
+ *       when N > 9, so both nibble tests come out 3 only for digits.
+ *
+ * @param Chunk -- 8 chars, first char in the low byte.
+ *
+ * @returns bool -- True if all 8 chars are digits, false otherwise.
+ */
+constexpr bool isEightDigits(uint64 const Chunk)
+{
+   auto const Hi      =  Chunk                            & 0xf0f0'f0f0'f0f0'f0f0_u64;
+   auto const Carried = (Chunk + 0x0606'0606'0606'0606_u64) & 0xf0f0'f0f0'f0f0'f0f0_u64;
+   return (Hi | (Carried >> 4_u64)) == 0x3333'3333'3333'3333_u64;
+}
+
+/** parseEightDigits
+ *
+ * @brief Converts 8 digits to their value with 3 multiplies (SWAR).
+ *
+ * @note Each step merges neighbouring lanes - 8 1-digit lanes into 4 2-digit lanes,
+ *       into 2 4-digit lanes, into the 8-digit value.
+ *
+ * @param Chunk -- 8 digits, first (most significant) digit in the low byte.
+ *
+ * @returns uint64 -- Value of digits.
+ */
+constexpr uint64 parseEightDigits(uint64 const Chunk)
+{
+   auto val = Chunk & 0x0f0f'0f0f'0f0f'0f0f_u64;
+   val = (val * ((10_u64 << 8_u64) + 1_u64)) >> 8_u64;
+   val = ((val & 0x00ff'00ff'00ff'00ff_u64) * ((100_u64 << 16_u64) + 1_u64)) >> 16_u64;
+   val = ((val & 0x0000'ffff'0000'ffff_u64) * ((10'000_u64 << 32_u64) + 1_u64)) >> 32_u64;
+   return val;
+}
+
+/** parseDecimal
+ *
+ * @brief Fast path for decimal magnitudes - 8 digits at a time.
+ *
+ * @note Up to 19 digits can't overflow a uint64. Longer strings (or big endian
+ *       targets) are left to std::from_chars.
+ *
+ * @param Digits -- Digits, no sign.
+ *
+ * @returns std::expected<uint64, std::errc> -- Magnitude, invalid_argument if a char isn't
+ *                                              a digit, or value_too_large if there are
+ *                                              too many digits for the fast path.
+ */
+std::expected<uint64, std::errc> parseDecimal(std::string_view const Digits)
+{
+   if (Digits.empty())
+   { // nothing to parse
+      return std::unexpected(std::errc::invalid_argument);
+   }
+
+   if (Digits.size() > 19uz || std::endian::native != std::endian::little)
+   { // let the slow path decide
+      return std::unexpected(std::errc::value_too_large);
+   }
+
+   if (Digits.size() < 8uz)
+   { // too short for a chunk
+      auto val = 0_u64;
+
+      for (auto const C : Digits)
+      { // each digit
+         auto const Digit = static_cast<uint64>(C) - static_cast<uint64>('0');
+
+         if (Digit > 9_u64)
+         { // stray char
+            return std::unexpected(std::errc::invalid_argument);
+         }
+
+         val = (val * 10_u64) + Digit;
+      }
+
+      return val;
+   }
+
+   auto const NHead = Digits.size() % 8uz;
+   auto       chunk = 0_u64;
+   auto       pos   = sizeof(chunk);
+   std::memcpy(&chunk, Digits.data(), sizeof(chunk));
+
+   if (NHead > 0uz)
+   { // leading digits padded with '0's, so the rest are whole chunks
+      auto const PadBits = (8_u64 - NHead) * 8_u64;
+      chunk = (chunk << PadBits) | (0x3030'3030'3030'3030_u64 >> (64_u64 - PadBits));
+      pos   = NHead;
+   }
+
+   auto val = 0_u64;
+
+   while (true)
+   { // 8 at a time
+      if (!isEightDigits(chunk))
+      { // stray char
+         return std::unexpected(std::errc::invalid_argument);
+      }
+
+      val = (val * 100'000'000_u64) + parseEightDigits(chunk);
+
+      if (pos == Digits.size())
+      { // all digits read
+         break;
+      }
+
+      std::memcpy(&chunk, Digits.data() + pos, sizeof(chunk));
+      pos += sizeof(chunk);
+   }
+
+   return val;
+}
+
+/** stripPlus
+ *
+ * @brief Drops a leading '+' which std::from_chars doesn't accept.
+ *
+ * @param S -- String.
+ *
+ * @returns std::string_view -- String without the '+', or S if there is none.
+ */
+constexpr std::string_view stripPlus(std::string_view const S)
+{
+   return (!S.empty() && S.front() == '+') ? S.substr(1uz) : S;
+}
+
+/** getTypeName
+ *
+ * @brief Name of type for error messages.
+ *
+ * @tparam T -- Type.
+ *
+ * @returns strlit -- Name of type.
+ */
+template <typename T>
+constexpr strlit getTypeName(void)
+{
+   if      constexpr (std::is_same_v<T, int8    >) { return "int8";     }
+   else if constexpr (std::is_same_v<T, int16   >) { return "int16";    }
+   else if constexpr (std::is_same_v<T, int32   >) { return "int32";    }
+   else if constexpr (std::is_same_v<T, int64   >) { return "int64";    }
+   else if constexpr (std::is_same_v<T, uint8   >) { return "uint8";    }
+   else if constexpr (std::is_same_v<T, uint16  >) { return "uint16";   }
+   else if constexpr (std::is_same_v<T, uint32  >) { return "uint32";   }
+   else if constexpr (std::is_same_v<T, uint64  >) { return "uint64";   }
+   else if constexpr (std::is_same_v<T, float32 >) { return "float32";  }
+   else if constexpr (std::is_same_v<T, float64 >) { return "float64";  }
+   else if constexpr (std::is_same_v<T, floatext>) { return "floatext"; }
+   else                                            { return "?";        }
+}
+
+/** getErrorName
+ *
+ * @brief Reason of failure for error messages.
+ *
+ * @param Error -- Error code.
+ *
+ * @returns strlit -- Reason.
+ */
+constexpr strlit getErrorName(std::errc const Error)
+{
+   return (Error == std::errc::result_out_of_range) ? "out of range" : "invalid";
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/// @brief Decimal exponents covered by the table of powers of five.
+constexpr auto SmallestPowerOfTen = -342_i32;
+constexpr auto LargestPowerOfTen  =  308_i32;
+
+/// @brief Leading 128 bits of 5^q, for every q in [SmallestPowerOfTen..LargestPowerOfTen].
+using PowersOfFive_T = std::array<uint128, static_cast<sizet>(LargestPowerOfTen - SmallestPowerOfTen + 1)>;
+
+/// @brief Just enough arbitrary precision to build the table. Little endian limbs.
+using BigUint_T = std::vector<uint64>;
+
+/** getBitLength
+ *
+ * @brief Number of significant bits.
+ *
+ * @param X -- Value (no leading zero limbs).
+ *
+ * @returns sizet -- Number of bits.
+ */
+sizet getBitLength(BigUint_T const & X)
+{
+   return (X.size() * 64uz) - static_cast<sizet>(std::countl_zero(X.back()));
+}
+
+/** getBits128
+ *
+ * @brief Extracts 128 bits.
+ *
+ * @param X  -- Value.
+ * @param Lo -- Lowest bit to extract.
+ *
+ * @returns uint128 -- Bits [Lo..Lo+128) of X.
+ */
+uint128 getBits128(
+   BigUint_T const & X,
+   sizet     const   Lo)
+{
+   auto bits = static_cast<uint128>(0_u64);
+
+   for (auto i = 0uz; i < 128uz; i += 64uz)
+   { // gather a limb's worth, straddling two limbs if unaligned
+      auto const Bit   = Lo + i;
+      auto const Limb  = Bit / 64uz;
+      auto const Shift = Bit % 64uz;
+
+      auto word = (Limb < X.size()) ? X[Limb] >> Shift : 0_u64;
+      if (Shift > 0uz && Limb + 1uz < X.size())
+      { // upper part
+         word |= X[Limb + 1uz] << (64uz - Shift);
+      }
+
+      bits |= static_cast<uint128>(word) << i;
+   }
+
+   return bits;
+}
+
+/** multiplyBy5
+ *
+ * @brief Multiplies in place.
+ *
+ * @param x -- Value.
+ */
+void multiplyBy5(BigUint_T & x)
+{
+   auto carry = 0_u64;
+
+   for (auto & limb : x)
+   { // schoolbook
+      auto const Product = (static_cast<uint128>(limb) * 5_u64) + carry;
+      limb  = static_cast<uint64>(Product);
+      carry = static_cast<uint64>(Product >> 64_u32);
+   }
+
+   if (carry > 0_u64)
+   { // grew
+      x.push_back(carry);
+   }
+}
+
+/** divide2PowBy
+ *
+ * @brief Computes floor(2^B / P) one bit at a time.
+ *
+ * @note Only runs while building the table - simplicity over speed.
+ *
+ * @param B -- Power of two of dividend.
+ * @param P -- Divisor, not a power of two, with bit length <= B.
+ *
+ * @returns BigUint_T -- Quotient.
+ */
+BigUint_T divide2PowBy(
+   sizet     const   B,
+   BigUint_T const & P)
+{
+   auto const NBits = getBitLength(P);
+
+   // every quotient bit above B - NBits is zero, leaving a remainder of 2^(NBits - 1) < P
+   auto r = BigUint_T(P.size() + 1uz, 0_u64);
+   r[(NBits - 1uz) / 64uz] = 1_u64 << ((NBits - 1uz) % 64uz);
+
+   auto q = BigUint_T(((B - NBits) / 64uz) + 1uz, 0_u64);
+
+   auto const IsAtLeastP = [&P](BigUint_T const & R) {
+      if (R.back() > 0_u64) { return true; }
+      for (auto i = P.size(); i-- > 0uz; )
+      { // most significant first
+         if (R[i] != P[i]) { return R[i] > P[i]; }
+      }
+      return true;
+   };
+
+   for (auto bit = B - NBits + 1uz; bit-- > 0uz; )
+   { // bring down a zero
+      for (auto i = r.size(); i-- > 1uz; )
+      { // shift left by one
+         r[i] = (r[i] << 1_u64) | (r[i - 1uz] >> 63_u64);
+      }
+      r[0uz] <<= 1_u64;
+
+      if (IsAtLeastP(r))
+      { // subtract
+         auto borrow = 0_u64;
+         for (auto i = 0uz; i < r.size(); ++i)
+         { // with borrow
+            auto const Sub  = (i < P.size()) ? P[i] : 0_u64;
+            auto const Diff = r[i] - Sub - borrow;
+            borrow = (r[i] < Sub || (r[i] == Sub && borrow > 0_u64)) ? 1_u64 : 0_u64;
+            r[i]   = Diff;
+         }
+         q[bit / 64uz] |= 1_u64 << (bit % 64uz);
+      }
+   }
+
+   while (q.size() > 1uz && q.back() == 0_u64)
+   { // trim
+      q.pop_back();
+   }
+
+   return q;
+}
+
+/** makePowersOfFive
+ *
+ * @brief Builds the table.
+ *
+ * @note Non-negative powers are 5^q truncated to its leading 128 bits. Negative powers are
+ *       floor(2^b / 5^-q) + 1 truncated likewise, with b large enough to keep 128 bits
+ *       (exactly so for q >= -27). Same values as the fast_float library.
+ *
+ * @ref <https://github.com/fastfloat/fast_float/blob/main/script/table_generation.py>
+ *
+ * @returns PowersOfFive_T -- Table.
+ */
+PowersOfFive_T makePowersOfFive(void)
+{
+   auto       table = PowersOfFive_T{};
+   auto const Zero  = static_cast<sizet>(-SmallestPowerOfTen); // index of 5^0
+
+   auto pow5 = BigUint_T{1_u64};
+   for (auto q = 0uz; q <= static_cast<sizet>(LargestPowerOfTen); ++q)
+   { // 5^q
+      auto const NBits = getBitLength(pow5);
+      table[Zero + q] = (NBits <= 128uz) ? getBits128(pow5, 0uz) << (128uz - NBits) : getBits128(pow5, NBits - 128uz);
+      multiplyBy5(pow5);
+   }
+
+   pow5 = BigUint_T{1_u64};
+   for (auto n = 1uz; n <= Zero; ++n)
+   { // 5^-n
+      multiplyBy5(pow5);
+
+      auto const NBits = getBitLength(pow5);
+      auto       q     = divide2PowBy((n <= 27uz) ? NBits + 127uz : (2uz * NBits) + 128uz, pow5);
+
+      auto i = 0uz;
+      while (i < q.size() && ++q[i] == 0_u64) { ++i; } // + 1, carrying
+      if (i == q.size()) { q.push_back(1_u64); }
+
+      auto const QBits = getBitLength(q);
+      table[Zero - n] = getBits128(q, (QBits > 128uz) ? QBits - 128uz : 0uz);
+   }
+
+   return table;
+}
+
+/** getPowersOfFive
+ *
+ * @brief Table of powers of five, built on first use.
+ *
+ * @note Building takes on the order of 10ms, against 10KiB of literals in the source.
+ *
+ * @returns PowersOfFive_T const & -- Table.
+ */
+PowersOfFive_T const & getPowersOfFive(void)
+{
+   static auto const s_Table = makePowersOfFive();
+   return s_Table;
+}
+
+/** FloatTraits_T
+ *
+ * @brief Parameters of the binary formats.
+ *
+ * @note _s_MinPowerOfTen/_s_MaxPowerOfTen - below (above) these any 19-digit significand
+ *       rounds to zero (infinity).
+ *
+ * @note _s_MinRoundToEven/_s_MaxRoundToEven - only powers in this range can land
+ *       exactly halfway between two floats.
+ *
+ * @note _s_MaxExactPowerOfTen/_s_MaxExactSignificand - Clinger's fast path. Both operands
+ *       are exact so the one rounding of the multiply (or divide) is the correct one.
+ */
+template <typename T>
+struct FloatTraits_T;
+
+template <>
+struct FloatTraits_T<float32>
+{
+   using Bits_T = uint32;
+
+   static constexpr auto _s_MantissaBits        = 23_i32;
+   static constexpr auto _s_MinExponent         = -127_i32;
+   static constexpr auto _s_InfinitePower       = 0xff_i32;
+   static constexpr auto _s_MinPowerOfTen       = -65_i32;
+   static constexpr auto _s_MaxPowerOfTen       = 38_i32;
+   static constexpr auto _s_MinRoundToEven      = -17_i64;
+   static constexpr auto _s_MaxRoundToEven      = 10_i64;
+   static constexpr auto _s_MaxExactPowerOfTen  = 10_i64;
+   static constexpr auto _s_MaxExactSignificand = 1_u64 << 24_u64;
+
+   static constexpr auto _s_ExactPowersOfTen = std::array{
+      1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+};
+
+template <>
+struct FloatTraits_T<float64>
+{
+   using Bits_T = uint64;
+
+   static constexpr auto _s_MantissaBits        = 52_i32;
+   static constexpr auto _s_MinExponent         = -1023_i32;
+   static constexpr auto _s_InfinitePower       = 0x7ff_i32;
+   static constexpr auto _s_MinPowerOfTen       = SmallestPowerOfTen;
+   static constexpr auto _s_MaxPowerOfTen       = LargestPowerOfTen;
+   static constexpr auto _s_MinRoundToEven      = -4_i64;
+   static constexpr auto _s_MaxRoundToEven      = 23_i64;
+   static constexpr auto _s_MaxExactPowerOfTen  = 22_i64;
+   static constexpr auto _s_MaxExactSignificand = 1_u64 << 53_u64;
+
+   static constexpr auto _s_ExactPowersOfTen = std::array{
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+};
+
+/** Decimal_T
+ *
+ * @brief Number as w * 10^q.
+ */
+struct Decimal_T
+{
+   uint64 _w;         // first 19 significant digits
+   int64  _q;
+   bool   _neg;
+   bool   _truncated; // digits were dropped from w
+};
+
+/** AdjustedMantissa_T
+ *
+ * @brief Float in pieces - mantissa (with implicit bit) and biased exponent.
+ */
+struct AdjustedMantissa_T
+{
+   uint64 _mantissa;
+   int32  _power2;
+
+   constexpr bool operator == (AdjustedMantissa_T const &) const = default;
+};
+
+/** parseDecimalFloat
+ *
+ * @brief Splits plain decimal notation - [-]digits[.digits][(e|E)[+-]digits] - into
+ *        significand and exponent.
+ *
+ * @note Anything else (inf, nan, hex, malformed) is left to std::from_chars.
+ *
+ * @note Digits are accumulated in one pass, wrapping if there are more than 19. Only
+ *       then are they scanned again for the first 19 significant ones.
+ *
+ * @param S -- String.
+ *
+ * @returns std::optional<Decimal_T> -- Number, or nullopt if not in plain notation.
+ */
+std::optional<Decimal_T> parseDecimalFloat(std::string_view const S)
+{
+   constexpr auto MaxDigits = 19_i64;                        // any more may overflow w
+   constexpr auto Min19     = 1'000'000'000'000'000'000_u64; // smallest 19 digit number
+
+   auto const IsDigit = [](char const C) { return static_cast<uint8>(C - '0') <= 9_u8; };
+
+   auto       p   = S.data();
+   auto const End = p + S.size();
+
+   auto dec = Decimal_T{0_u64, 0_i64, false, false};
+
+   if (p != End && *p == '-')
+   { // sign ('+' is stripped by the caller)
+      dec._neg = true;
+      ++p;
+   }
+
+   auto const IntBegin = p;
+   for (; p != End && IsDigit(*p); ++p)
+   { // integer part
+      dec._w = (dec._w * 10_u64) + static_cast<uint64>(*p - '0');
+   }
+   auto const IntEnd = p;
+
+   auto FracBegin = p;
+   auto FracEnd   = p;
+   if (p != End && *p == '.')
+   { // fraction
+      FracBegin = ++p;
+
+      for (auto chunk = 0_u64; End - p >= 8 && (std::memcpy(&chunk, p, sizeof(chunk)), isEightDigits(chunk)); p += 8)
+      { // 8 at a time
+         dec._w = (dec._w * 100'000'000_u64) + parseEightDigits(chunk);
+      }
+
+      for (; p != End && IsDigit(*p); ++p)
+      { // leftovers
+         dec._w = (dec._w * 10_u64) + static_cast<uint64>(*p - '0');
+      }
+
+      FracEnd = p;
+   }
+
+   auto nDigits = (IntEnd - IntBegin) + (FracEnd - FracBegin);
+   if (nDigits == 0)
+   { // ".", "-", "inf", ...
+      return std::nullopt;
+   }
+
+   auto exp = 0_i64;
+   if (p != End && (*p == 'e' || *p == 'E'))
+   { // exponent
+      ++p;
+
+      auto const NegExp = (p != End && *p == '-');
+      if (p != End && (*p == '-' || *p == '+')) { ++p; }
+
+      if (p == End || !IsDigit(*p))
+      { // "1e" and the like
+         return std::nullopt;
+      }
+
+      for (; p != End && IsDigit(*p); ++p)
+      { // saturates well past the range of any float
+         exp = std::min((exp * 10_i64) + (*p - '0'), 1'000'000_i64);
+      }
+
+      exp = NegExp ? -exp : exp;
+   }
+
+   if (p != End)
+   { // trailing chars
+      return std::nullopt;
+   }
+
+   dec._q = exp - (FracEnd - FracBegin);
+
+   if (nDigits > MaxDigits)
+   { // w wrapped - leading zeros don't count though
+      for (auto z = IntBegin; z != FracEnd && (*z == '0' || *z == '.'); ++z)
+      { // skip
+         nDigits -= (*z == '0') ? 1 : 0;
+      }
+   }
+
+   if (nDigits > MaxDigits)
+   { // keep the first 19 significant digits
+      dec._w = 0_u64;
+
+      auto z = IntBegin;
+      for (; dec._w < Min19 && z != IntEnd; ++z)
+      { // integer part
+         dec._w = (dec._w * 10_u64) + static_cast<uint64>(*z - '0');
+      }
+
+      if (dec._w >= Min19)
+      { // dropped integer digits
+         dec._q = exp + (IntEnd - z);
+      }
+      else
+      { // dropped fraction digits
+         for (z = FracBegin; dec._w < Min19 && z != FracEnd; ++z)
+         { // fraction
+            dec._w = (dec._w * 10_u64) + static_cast<uint64>(*z - '0');
+         }
+         dec._q = exp - (z - FracBegin);
+      }
+
+      dec._truncated = true;
+   }
+
+   return dec;
+}
+
+/** computeFloat
+ *
+ * @brief Eisel-Lemire - w * 10^q correctly rounded, from one (rarely two) 64x64-bit
+ *        multiplies against the table of powers of five.
+ *
+ * @note The leading 64 bits of w * 5^q are enough unless the bits just below the
+ *       mantissa are all ones, in which case the next 64 bits of 5^q settle it.
+ *
+ * @ref Lemire, Number Parsing at a Gigabyte per Second (2021).
+ * @ref Mushtak & Lemire, Fast Number Parsing Without Fallback (2023).
+ *
+ * @tparam T -- float32 or float64.
+ *
+ * @param Q -- Decimal exponent.
+ * @param w -- Significand.
+ *
+ * @returns AdjustedMantissa_T -- Float in pieces.
+ */
+template <typename T>
+AdjustedMantissa_T computeFloat(
+   int64  const Q,
+   uint64       w)
+{
+   using Traits_T = FloatTraits_T<T>;
+
+   if (w == 0_u64 || Q < Traits_T::_s_MinPowerOfTen)
+   { // zero
+      return {0_u64, 0_i32};
+   }
+
+   if (Q > Traits_T::_s_MaxPowerOfTen)
+   { // infinity
+      return {0_u64, Traits_T::_s_InfinitePower};
+   }
+
+   auto const Lz = std::countl_zero(w);
+   w <<= static_cast<uint64>(Lz);
+
+   constexpr auto PrecisionMask = ~0_u64 >> static_cast<uint64>(Traits_T::_s_MantissaBits + 3_i32);
+
+   auto const Pow5    = getPowersOfFive()[static_cast<sizet>(Q - SmallestPowerOfTen)];
+   auto       product = static_cast<uint128>(w) * static_cast<uint64>(Pow5 >> 64_u32);
+
+   if ((static_cast<uint64>(product >> 64_u32) & PrecisionMask) == PrecisionMask)
+   { // not enough bits to decide - bring in the next 64
+      product += (static_cast<uint128>(w) * static_cast<uint64>(Pow5)) >> 64_u32;
+   }
+
+   auto const Hi       = static_cast<uint64>(product >> 64_u32);
+   auto const Lo       = static_cast<uint64>(product);
+   auto const UpperBit = static_cast<int32>(Hi >> 63_u64);
+   auto const Shift    = static_cast<uint64>(UpperBit + 64_i32 - Traits_T::_s_MantissaBits - 3_i32);
+
+   // floor(log2(10^q)) + 63 == ((217706 * q) >> 16) + 63
+   auto am = AdjustedMantissa_T{
+      Hi >> Shift,
+      static_cast<int32>(((217'706_i64 * Q) >> 16_i64) + 63_i64) + UpperBit - Lz - Traits_T::_s_MinExponent};
+
+   if (am._power2 <= 0_i32)
+   { // subnormal (or zero)
+      if (-am._power2 + 1_i32 >= 64_i32)
+      { // every bit shifted out
+         return {0_u64, 0_i32};
+      }
+
+      am._mantissa >>= static_cast<uint64>(-am._power2 + 1_i32);
+      am._mantissa  += am._mantissa & 1_u64; // round
+      am._mantissa >>= 1_u64;
+      am._power2     = (am._mantissa < (1_u64 << Traits_T::_s_MantissaBits)) ? 0_i32 : 1_i32; // rounded up to normal
+      return am;
+   }
+
+   if (Lo <= 1_u64                          &&
+       Q  >= Traits_T::_s_MinRoundToEven    &&
+       Q  <= Traits_T::_s_MaxRoundToEven    &&
+       (am._mantissa & 3_u64) == 1_u64      &&
+       (am._mantissa << Shift) == Hi)
+   { // exactly halfway - round to even (down)
+      am._mantissa &= ~1_u64;
+   }
+
+   am._mantissa += am._mantissa & 1_u64; // round
+   am._mantissa >>= 1_u64;
+
+   if (am._mantissa >= (2_u64 << Traits_T::_s_MantissaBits))
+   { // rounded up a binade
+      am._mantissa = 1_u64 << Traits_T::_s_MantissaBits;
+      ++am._power2;
+   }
+
+   am._mantissa &= ~(1_u64 << Traits_T::_s_MantissaBits); // implicit bit
+
+   if (am._power2 >= Traits_T::_s_InfinitePower)
+   { // overflow
+      return {0_u64, Traits_T::_s_InfinitePower};
+   }
+
+   return am;
+}
+
+/** fromChars
+ *
+ * @brief std::from_chars over the whole string.
+ *
+ * @tparam T -- Arithmetic type.
+ *
+ * @param S -- String.
+ *
+ * @returns std::expected<T, std::errc> -- Value, or invalid_argument/result_out_of_range.
+ */
+template <typename T>
+std::expected<T, std::errc> fromChars(std::string_view const S)
+{
+   auto       val = T{};
+   auto const End = S.data() + S.size();
+
+   auto const [Ptr, Ec] = std::from_chars(S.data(), End, val);
+
+   if (Ec != std::errc())
+   { // no number or doesn't fit
+      return std::unexpected(Ec);
+   }
+
+   if (Ptr != End)
+   { // trailing chars
+      return std::unexpected(std::errc::invalid_argument);
+   }
+
+   return val;
+}
+
+/** parseFloat
+ *
+ * @brief Correctly rounded, locale independent string to float.
+ *
+ * @note Clinger's fast path, then Eisel-Lemire. Hard cases - more than 19 significant
+ *       digits that straddle two floats, or notation other than plain decimal - go to
+ *       std::from_chars.
+ *
+ * @note Assumes the default rounding mode.
+ *
+ * @tparam T -- float32 or float64.
+ *
+ * @param S -- String (no leading '+').
+ *
+ * @returns std::expected<T, std::errc> -- Value, or invalid_argument/result_out_of_range.
+ */
+template <typename T>
+std::expected<T, std::errc> parseFloat(std::string_view const S)
+{
+   using Traits_T = FloatTraits_T<T>;
+   using Bits_T   = typename Traits_T::Bits_T;
+
+   auto const Dec = parseDecimalFloat(S);
+
+   if (!Dec)
+   { // not plain decimal
+      return fromChars<T>(S);
+   }
+
+   if (!Dec->_truncated                                  &&
+       Dec->_w <= Traits_T::_s_MaxExactSignificand       &&
+       Dec->_q >= -Traits_T::_s_MaxExactPowerOfTen       &&
+       Dec->_q <=  Traits_T::_s_MaxExactPowerOfTen)
+   { // clinger
+      auto       val  = static_cast<T>(Dec->_w);
+      auto const Pow  = Traits_T::_s_ExactPowersOfTen[static_cast<sizet>(Dec->_q < 0_i64 ? -Dec->_q : Dec->_q)];
+      val = (Dec->_q < 0_i64) ? val / Pow : val * Pow;
+      return Dec->_neg ? -val : val;
+   }
+
+   auto const Am = computeFloat<T>(Dec->_q, Dec->_w);
+
+   if (Dec->_truncated && Am != computeFloat<T>(Dec->_q, Dec->_w + 1_u64))
+   { // dropped digits decide the rounding
+      return fromChars<T>(S);
+   }
+
+   if (Am._power2 == Traits_T::_s_InfinitePower || (Am._power2 == 0_i32 && Am._mantissa == 0_u64 && Dec->_w > 0_u64))
+   { // overflow or underflow
+      return std::unexpected(std::errc::result_out_of_range);
+   }
+
+   auto bits = static_cast<Bits_T>(Am._mantissa | (static_cast<uint64>(Am._power2) << Traits_T::_s_MantissaBits));
+   bits |= Dec->_neg ? static_cast<Bits_T>(Bits_T{1} << (sizeof(Bits_T) * 8uz - 1uz)) : Bits_T{0};
+
+   return std::bit_cast<T>(bits);
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/// @brief "00" through "99" back to back - integers are written two digits at a time.
+constexpr auto DigitPairs = []() {
+   auto pairs = std::array<char, 200uz>{};
+   for (auto i = 0uz; i < 100uz; ++i)
+   { // each pair
+      pairs[2uz * i      ] = static_cast<char>('0' + (i / 10uz));
+      pairs[2uz * i + 1uz] = static_cast<char>('0' + (i % 10uz));
+   }
+   return pairs;
+}();
+
+/** countDigits
+ *
+ * @brief Number of decimal digits of value.
+ *
+ * @note bit_width * 1233 / 4096 estimates log10 from log2. The estimate is exact or one
+ *       too small, which one comparison settles.
+ *
+ * @param Val -- Value.
+ *
+ * @returns sizet -- Number of digits (1 for 0).
+ */
+constexpr sizet countDigits(uint64 const Val)
+{
+   constexpr auto s_PowersOfTen = []() {
+      auto powers = std::array<uint64, 20uz>{};
+      powers[0uz] = 1_u64;
+      for (auto i = 1uz; i < powers.size(); ++i)
+      { // each power
+         powers[i] = powers[i - 1uz] * 10_u64;
+      }
+      return powers;
+   }();
+
+   auto const Val1  = Val | 1_u64; // 0 has one digit too
+   auto const Guess = (static_cast<sizet>(std::bit_width(Val1)) * 1233uz) >> 12uz;
+   return Guess + 1uz - static_cast<sizet>(Val1 < s_PowersOfTen[Guess]);
+}
+
+/** writeDigits
+ *
+ * @brief Writes the low digits of value backwards, ending at end_ptr.
+ *
+ * @param end_ptr -- One past where the last digit goes.
+ * @param val     -- Value.
+ * @param nDigits -- Number of digits to write (zero padded).
+ */
+inline void writeDigits(
+   char   * end_ptr,
+   uint64   val,
+   sizet    nDigits)
+{
+   for (; nDigits >= 2uz; nDigits -= 2uz)
+   { // two at a time
+      end_ptr -= 2uz;
+      std::memcpy(end_ptr, DigitPairs.data() + 2uz * (val % 100_u64), 2uz);
+      val /= 100_u64;
+   }
+
+   if (nDigits > 0uz)
+   { // odd one out
+      *--end_ptr = static_cast<char>('0' + (val % 10_u64));
+   }
+}
+
+/** formatUnsigned
+ *
+ * @brief Writes value in decimal.
+ *
+ * @param out_ptr -- Where to write.
+ * @param Val     -- Value.
+ *
+ * @returns char * -- One past the last char written.
+ */
+inline char * formatUnsigned(
+   char   * const out_ptr,
+   uint64   const Val)
+{
+   auto const NDigits = countDigits(Val);
+   writeDigits(out_ptr + NDigits, Val, NDigits);
+   return out_ptr + NDigits;
+}
+
+/// @brief Decimal exponents covered by the table of scaled powers of ten.
+constexpr auto SmallestScaledPowerOfTen = -292_i32;
+constexpr auto LargestScaledPowerOfTen  =  324_i32;
+
+/// @brief 10^e scaled into [2^125..2^126), rounded up, for every e in the range above.
+using ScaledPowersOfTen_T = std::array<uint128, static_cast<sizet>(LargestScaledPowerOfTen - SmallestScaledPowerOfTen + 1)>;
+
+/** makeScaledPowersOfTen
+ *
+ * @brief Builds the table.
+ *
+ * @note Entry e is floor(10^e * 2^-r) + 1, with r such that the floor has 126 bits.
+ *       10^e * 2^-r is 5^e shifted (e >= 0) or 2^b / 5^-e (e < 0), both exact here.
+ *
+ * @returns ScaledPowersOfTen_T -- Table.
+ */
+ScaledPowersOfTen_T makeScaledPowersOfTen(void)
+{
+   auto       table = ScaledPowersOfTen_T{};
+   auto const Zero  = static_cast<sizet>(-SmallestScaledPowerOfTen); // index of 10^0
+
+   auto pow5 = BigUint_T{1_u64};
+   for (auto e = 0uz; e <= static_cast<sizet>(LargestScaledPowerOfTen); ++e)
+   { // 5^e
+      auto const NBits = getBitLength(pow5);
+      auto const G     = (NBits <= 126uz) ? getBits128(pow5, 0uz) << (126uz - NBits) : getBits128(pow5, NBits - 126uz);
+      table[Zero + e] = G + 1_u64;
+      multiplyBy5(pow5);
+   }
+
+   pow5 = BigUint_T{1_u64};
+   for (auto n = 1uz; n <= Zero; ++n)
+   { // 5^-n
+      multiplyBy5(pow5);
+      table[Zero - n] = getBits128(divide2PowBy(getBitLength(pow5) + 125uz, pow5), 0uz) + 1_u64;
+   }
+
+   return table;
+}
+
+/** getScaledPowersOfTen
+ *
+ * @brief Table of scaled powers of ten, built on first use.
+ *
+ * @returns ScaledPowersOfTen_T const & -- Table.
+ */
+ScaledPowersOfTen_T const & getScaledPowersOfTen(void)
+{
+   static auto const s_Table = makeScaledPowersOfTen();
+   return s_Table;
+}
+
+/// @brief floor(log10(2^Q)), floor(log10(3/4 * 2^Q)) and floor(log2(10^E)) - fixed point, exact well past float64's range.
+constexpr int32 floorLog10Pow2             (int32 const Q) { return static_cast<int32>((static_cast<int64>(Q) * 661'971'961'083_i64                      ) >> 41_i64); }
+constexpr int32 floorLog10ThreeQuartersPow2(int32 const Q) { return static_cast<int32>((static_cast<int64>(Q) * 661'971'961'083_i64 - 274'743'187'321_i64) >> 41_i64); }
+constexpr int32 floorLog2Pow10             (int32 const E) { return static_cast<int32>((static_cast<int64>(E) * 913'124'641'741_i64                      ) >> 38_i64); }
+
+/** roundToOdd
+ *
+ * @brief Computes G * Cp / 2^127, rounded to odd.
+ *
+ * @note Rounding to odd keeps "exact" apart from "just above" through to the comparisons
+ *       in toShortestDecimal().
+ *
+ * @param G  -- Scaled power of ten (126 bits).
+ * @param Cp -- Scaled significand (< 2^63).
+ *
+ * @returns uint64 -- Product.
+ */
+constexpr uint64 roundToOdd(
+   uint128 const G,
+   uint64  const Cp)
+{
+   constexpr auto Mask63 = (1_u64 << 63_u64) - 1_u64;
+
+   auto const G1 = static_cast<uint64>(G >> 63_u32);
+   auto const G0 = static_cast<uint64>(G) & Mask63;
+
+   auto const X1 = static_cast<uint64>((static_cast<uint128>(G0) * Cp) >> 64_u32);
+   auto const Y  = static_cast<uint128>(G1) * Cp;
+   auto const Z  = (static_cast<uint64>(Y) >> 1_u64) + X1;
+
+   auto const Vbp = static_cast<uint64>(Y >> 64_u32) + (Z >> 63_u64);
+   return Vbp | (((Z & Mask63) + Mask63) >> 63_u64);
+}
+
+/** ShortestDecimal_T
+ *
+ * @brief Number as digits * 10^exp.
+ */
+struct ShortestDecimal_T
+{
+   uint64 _digits; // may end in zeros
+   int32  _exp;
+};
+
+/** toShortestDecimal
+ *
+ * @brief Finds the decimal with fewest digits that reads back as value (Schubfach).
+ *
+ * @note Value is c * 2^q. The decimals that read back as it lie in the interval halfway
+ *       to its neighbours. Scaled by 10^-k, with k chosen so the interval is about 1 wide,
+ *       the answer is a multiple of 10 (one digit less) if one fits, else whichever of
+ *       floor/ceil fits, or is closer if both do.
+ *
+ * @note Same digits as Ryu (std::to_chars) and Dragonbox (fmt) - shortest, then closest,
+ *       then even.
+ *
+ * @ref <https://drive.google.com/file/d/1KLtG_LaIbK9ETXI290zqCxvBW94dj058> (Giulietti).
+ *
+ * @tparam T -- float32 or float64.
+ *
+ * @param Val -- Value, finite and > 0.
+ *
+ * @returns ShortestDecimal_T -- Decimal.
+ */
+template <typename T>
+ShortestDecimal_T toShortestDecimal(T const Val)
+{
+   using Traits_T = FloatTraits_T<T>;
+   using Bits_T   = typename Traits_T::Bits_T;
+
+   constexpr auto MantissaBits = Traits_T::_s_MantissaBits;
+   constexpr auto QMin         = Traits_T::_s_MinExponent + 1_i32 - MantissaBits;
+   constexpr auto CMin         = 1_u64 << static_cast<uint64>(MantissaBits);
+
+   auto const Bits     = std::bit_cast<Bits_T>(Val);
+   auto const Fraction = static_cast<uint64>(Bits) & (CMin - 1_u64);
+   auto const Biased   = static_cast<int32>(Bits >> MantissaBits);
+
+   auto const Schubfach = [](int32 const Q, uint64 const C) -> ShortestDecimal_T {
+      auto const Out = C & 1_u64; // odd values exclude the interval ends
+      auto const Cb  = C << 2_u64;
+      auto const Cbr = Cb + 2_u64;
+
+      auto const Regular = (C != CMin || Q == QMin);
+      auto const Cbl     = Regular ? Cb - 2_u64 : Cb - 1_u64; // closer neighbour below
+      auto const K       = Regular ? floorLog10Pow2(Q) : floorLog10ThreeQuartersPow2(Q);
+      auto const H       = static_cast<uint64>(Q + floorLog2Pow10(-K) + 2_i32);
+
+      auto const G = getScaledPowersOfTen()[static_cast<sizet>(-K - SmallestScaledPowerOfTen)];
+
+      auto const Vb  = roundToOdd(G, Cb  << H);
+      auto const Vbl = roundToOdd(G, Cbl << H);
+      auto const Vbr = roundToOdd(G, Cbr << H);
+
+      auto const S = Vb >> 2_u64;
+
+      auto const Sp10 = (S / 10_u64) * 10_u64;
+      auto const Tp10 = Sp10 + 10_u64;
+      auto const UpIn = Vbl + Out <= (Sp10 << 2_u64);
+      auto const WpIn = (Tp10 << 2_u64) + Out <= Vbr;
+
+      if (UpIn != WpIn)
+      { // one digit less
+         return {UpIn ? Sp10 : Tp10, K};
+      }
+
+      auto const T1  = S + 1_u64;
+      auto const UIn = Vbl + Out <= (S << 2_u64);
+      auto const WIn = (T1 << 2_u64) + Out <= Vbr;
+
+      if (UIn != WIn)
+      { // only one fits
+         return {UIn ? S : T1, K};
+      }
+
+      auto const Cmp = static_cast<int64>(Vb - ((S + T1) << 1_u64));
+      return {(Cmp < 0_i64 || (Cmp == 0_i64 && (S & 1_u64) == 0_u64)) ? S : T1, K};
+   };
+
+   if (Biased == 0_i32)
+   { // subnormal
+      return Schubfach(QMin, Fraction);
+   }
+
+   auto const C      = CMin | Fraction;
+   auto const MinusQ = 1_i32 - QMin - Biased;
+
+   if (MinusQ > 0_i32 && MinusQ <= MantissaBits)
+   { // integers need all their digits
+      auto const F = C >> static_cast<uint64>(MinusQ);
+      if ((F << static_cast<uint64>(MinusQ)) == C) { return {F, 0_i32}; }
+   }
+
+   return Schubfach(-MinusQ, C);
+}
+
+/** formatFloat
+ *
+ * @brief Writes value with the fewest digits that read back as the same value.
+ *
+ * @note Laid out like fmt's "{}" - fixed notation for decimal exponents in [-4..16)
+ *       ([-4..7) for float32, past which its digits run out), scientific otherwise.
+ *
+ * @tparam T -- float32 or float64.
+ *
+ * @param out_ptr -- Where to write.
+ * @param Val     -- Value.
+ *
+ * @returns char * -- One past the last char written.
+ */
+template <typename T>
+char * formatFloat(
+   char * out_ptr,
+   T      const Val)
+{
+   if (std::signbit(Val))
+   { // includes -0 and -nan
+      *out_ptr++ = '-';
+   }
+
+   if (!std::isfinite(Val) || Val == T(0))
+   { // nothing to round
+      auto const Text = std::isnan(Val) ? std::string_view("nan") :
+                        std::isinf(Val) ? std::string_view("inf") : std::string_view("0");
+      std::memcpy(out_ptr, Text.data(), Text.size());
+      return out_ptr + Text.size();
+   }
+
+   auto [digits, exp] = toShortestDecimal(std::fabs(Val));
+
+   while (digits % 10_u64 == 0_u64)
+   { // shortest
+      digits /= 10_u64;
+      ++exp;
+   }
+
+   constexpr auto ExpUpper = std::min(16_i32, std::numeric_limits<T>::digits10 + 1_i32);
+
+   auto const NDigits = countDigits(digits);
+   auto const SciExp  = exp + static_cast<int32>(NDigits) - 1_i32;
+
+   if (SciExp >= ExpUpper || SciExp < -4_i32)
+   { // d.ddde+xx
+      writeDigits(out_ptr + 1uz + NDigits, digits, NDigits);
+      out_ptr[0uz] = out_ptr[1uz];
+      out_ptr[1uz] = '.';
+      out_ptr += (NDigits > 1uz) ? NDigits + 1uz : 1uz;
+
+      *out_ptr++ = 'e';
+      *out_ptr++ = (SciExp < 0_i32) ? '-' : '+';
+      auto const ExpMag     = static_cast<uint64>(SciExp < 0_i32 ? -SciExp : SciExp);
+      auto const NExpDigits = std::max(countDigits(ExpMag), 2uz);
+      writeDigits(out_ptr + NExpDigits, ExpMag, NExpDigits);
+      return out_ptr + NExpDigits;
+   }
+
+   if (SciExp < 0_i32)
+   { // 0.000ddd
+      auto const NLead = static_cast<sizet>(1_i32 - SciExp); // "0." and zeros
+      std::memcpy(out_ptr, "0.0000", NLead);
+      writeDigits(out_ptr + NLead + NDigits, digits, NDigits);
+      return out_ptr + NLead + NDigits;
+   }
+
+   auto const NIntDigits = static_cast<sizet>(SciExp) + 1uz;
+
+   if (NDigits <= NIntDigits)
+   { // dddd000
+      writeDigits(out_ptr + NDigits, digits, NDigits);
+      std::memset(out_ptr + NDigits, '0', NIntDigits - NDigits);
+      return out_ptr + NIntDigits;
+   }
+
+   // dd.ddd
+   writeDigits(out_ptr + 1uz + NDigits, digits, NDigits);
+   std::memmove(out_ptr, out_ptr + 1uz, NIntDigits);
+   out_ptr[NIntDigits] = '.';
+   return out_ptr + NDigits + 1uz;
+}
+
+} // anon
+
+/** tryCastToChar
+ *
+ * @brief Casts string to char.
+ *
+ * @param S -- String to cast.
+ *
+ * @returns Expected_T<char> -- String as char, or invalid_argument if S is not exactly one char.
+ */
+auto ym::Ops::tryCastToChar(std::string_view const S) -> Expected_T<char>
+{
+   if (S.size() != 1uz)
+   { // empty or too long
+      return std::unexpected(std::errc::invalid_argument);
+   }
+
+   return S.front();
+}
+
+/** tryCastTo
+ *
+ * @brief Casts string to integer.
+ *
+ * @note Decimal strings take a SWAR fast path. Others, and those too long for the fast
+ *       path to rule out overflow, go through std::from_chars.
+ *
+ * @note The range of the narrow types is checked directly rather than through a wider
+ *       type, so "-129" is out of range for int8 rather than wrapping.
+ *
+ * @tparam T -- Integer type.
+ *
+ * @param S    -- String to cast.
+ * @param Base -- Radix of integer [2..36].
+ *
+ * @returns Expected_T<T> -- String as T, or invalid_argument/result_out_of_range.
+ */
+template <typename T>
+requires (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+auto ym::Ops::tryCastTo(
+   std::string_view const S,
+   uint32           const Base) -> Expected_T<T>
+{
+   if (Base < 2_u32 || Base > 36_u32)
+   { // std::from_chars' precondition
+      return std::unexpected(std::errc::invalid_argument);
+   }
+
+   auto const Trimmed = stripPlus(S);
+
+   if (Trimmed.size() != S.size() && !Trimmed.empty() && Trimmed.front() == '-')
+   { // "+-" is not a number
+      return std::unexpected(std::errc::invalid_argument);
+   }
+
+   if (Base == 10_u32)
+   { // fast path
+      auto const Neg    = !Trimmed.empty() && Trimmed.front() == '-';
+      auto const Digits = Neg ? Trimmed.substr(1uz) : Trimmed;
+      auto const Mag    = parseDecimal(Digits);
+
+      if (Mag.has_value())
+      { // parsed - check range
+         if constexpr (std::is_signed_v<T>)
+         { // magnitude of min is one more than max
+            auto const Limit = static_cast<uint64>(std::numeric_limits<T>::max()) + (Neg ? 1_u64 : 0_u64);
+
+            if (*Mag > Limit)
+            { // doesn't fit
+               return std::unexpected(std::errc::result_out_of_range);
+            }
+
+            return static_cast<T>(Neg ? 0_u64 - *Mag : *Mag); // wraps to negative
+         }
+         else
+         { // no negative numbers here
+            if (Neg)
+            { // not even -0
+               return std::unexpected(std::errc::invalid_argument);
+            }
+
+            if (*Mag > static_cast<uint64>(std::numeric_limits<T>::max()))
+            { // doesn't fit
+               return std::unexpected(std::errc::result_out_of_range);
+            }
+
+            return static_cast<T>(*Mag);
+         }
+      }
+
+      if (Mag.error() == std::errc::invalid_argument)
+      { // stray char or no digits
+         return std::unexpected(std::errc::invalid_argument);
+      }
+   }
+
+   auto       val   = T{};
+   auto const Begin = Trimmed.data();
+   auto const End   = Begin + Trimmed.size();
+
+   auto const [Ptr, Ec] = std::from_chars(Begin, End, val, static_cast<int>(Base));
+
+   if (Ec != std::errc())
+   { // no number or doesn't fit
+      return std::unexpected(Ec);
+   }
+
+   if (Ptr != End)
+   { // trailing chars
+      return std::unexpected(std::errc::invalid_argument);
+   }
+
+   return val;
+}
+
+/** tryCastTo
+ *
+ * @brief Casts string to floating point.
+ *
+ * @note float32 and float64 go through the Eisel-Lemire parser above, floatext through
+ *       std::from_chars. Neither depends on the locale.
+ *
+ * @note Results too small to be normal are out of range, as with std::strtof and
+ *       friends. std::from_chars would quietly return the subnormal. So formatTo() output
+ *       doesn't round trip for subnormals - callers that must keep them fall back on
+ *       std::from_chars (see CsvReader's parseFloat()).
+ *
+ * @tparam T -- Floating point type.
+ *
+ * @param S -- String to cast.
+ *
+ * @returns Expected_T<T> -- String as T, or invalid_argument/result_out_of_range.
+ */
+template <typename T>
+requires (std::is_floating_point_v<T>)
+auto ym::Ops::tryCastTo(std::string_view const S) -> Expected_T<T>
+{
+   auto const Trimmed = stripPlus(S);
+
+   if (Trimmed.size() != S.size() && !Trimmed.empty() && Trimmed.front() == '-')
+   { // "+-" is not a number
+      return std::unexpected(std::errc::invalid_argument);
+   }
+
+   auto const Result = [Trimmed]() {
+      if constexpr (std::is_same_v<T, floatext>) { return fromChars<T>(Trimmed);  }
+      else                                       { return parseFloat<T>(Trimmed); }
+   }();
+
+   if (!Result)
+   { // no number or doesn't fit
+      return Result;
+   }
+
+   auto const Val = *Result;
+
+   if (std::fpclassify(Val) == FP_SUBNORMAL)
+   { // underflow
+      return std::unexpected(std::errc::result_out_of_range);
+   }
+
+   return Val;
+}
+
+/** tryCastColumn
+ *
+ * @brief Casts a column of delimited numbers, e.g. one value per line.
+ *
+ * @note A trailing delimiter is fine. With '\n' as the delimiter so are "\r\n" endings.
+ *
+ * @param Buffer -- Text to cast.
+ * @param vals   -- Where to put the values.
+ * @param Delim  -- Separator between values.
+ *
+ * @returns Expected_T<sizet> -- Number of values cast, or invalid_argument/result_out_of_range
+ *                               for a bad field, or value_too_large if vals is too small.
+ */
+auto ym::Ops::tryCastColumn(
+   std::string_view   const Buffer,
+   std::span<float64> const vals,
+   char               const Delim) -> Expected_T<sizet>
+{
+   auto nVals = 0uz;
+   auto rest  = Buffer;
+
+   while (!rest.empty())
+   { // each field
+      auto const Pos   = rest.find(Delim);
+      auto       field = rest.substr(0uz, Pos);
+      rest = (Pos == std::string_view::npos) ? std::string_view() : rest.substr(Pos + 1uz);
+
+      if (Delim == '\n' && field.ends_with('\r'))
+      { // windows line ending
+         field.remove_suffix(1uz);
+      }
+
+      if (nVals == vals.size())
+      { // out of room
+         return std::unexpected(std::errc::value_too_large);
+      }
+
+      auto const Val = tryCastTo<float64>(field);
+
+      if (!Val)
+      { // bad field
+         return std::unexpected(Val.error());
+      }
+
+      vals[nVals++] = *Val;
+   }
+
+   return nVals;
+}
+
+/** castToChar
+ *
+ * @brief Casts string to char.
+ *
+ * @throws BadCastError -- If string is not a valid char (exception builds).
+ *
+ * @param S -- String to cast.
+ *
+ * @returns Cast_T<char> -- String as char.
+ */
+auto ym::Ops::castToChar(std::string_view const S) -> Cast_T<char>
+{
+   auto const Result = tryCastToChar(S);
+
+   #if (YM_YES_EXCEPTIONS)
+      YMASSERT(Result.has_value(), BadCastError, YM_DAH, "String '{}' not a valid char", S);
+      return *Result;
+   #else
+      return Result;
+   #endif
+}
+
+/** castTo
+ *
+ * @brief Casts string to integer.
+ *
+ * @throws BadCastError -- If string is not a valid or out of range T (exception builds).
+ *
+ * @tparam T -- Integer type.
+ *
+ * @param S    -- String to cast.
+ * @param Base -- Radix of integer [2..36].
+ *
+ * @returns Cast_T<T> -- String as T.
+ */
+template <typename T>
+requires (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+auto ym::Ops::castTo(
+   std::string_view const S,
+   uint32           const Base) -> Cast_T<T>
+{
+   auto const Result = tryCastTo<T>(S, Base);
+
+   #if (YM_YES_EXCEPTIONS)
+      YMASSERT(Result.has_value(), BadCastError, YM_DAH,
+         "String '{}' {} {} (base {})", S, getErrorName(Result.error()), getTypeName<T>(), Base);
+      return *Result;
+   #else
+      return Result;
+   #endif
+}
+
+/** castTo
+ *
+ * @brief Casts string to floating point.
+ *
+ * @throws BadCastError -- If string is not a valid or out of range T (exception builds).
+ *
+ * @tparam T -- Floating point type.
+ *
+ * @param S -- String to cast.
+ *
+ * @returns Cast_T<T> -- String as T.
+ */
+template <typename T>
+requires (std::is_floating_point_v<T>)
+auto ym::Ops::castTo(std::string_view const S) -> Cast_T<T>
+{
+   auto const Result = tryCastTo<T>(S);
+
+   #if (YM_YES_EXCEPTIONS)
+      YMASSERT(Result.has_value(), BadCastError, YM_DAH,
+         "String '{}' {} {}", S, getErrorName(Result.error()), getTypeName<T>());
+      return *Result;
+   #else
+      return Result;
+   #endif
+}
+
+/** castColumn
+ *
+ * @brief Casts a column of delimited numbers, e.g. one value per line.
+ *
+ * @throws BadCastError -- If a field is not a valid float64, or vals is too small (exception builds).
+ *
+ * @param Buffer -- Text to cast.
+ * @param vals   -- Where to put the values.
+ * @param Delim  -- Separator between values.
+ *
+ * @returns Cast_T<sizet> -- Number of values cast.
+ */
+auto ym::Ops::castColumn(
+   std::string_view   const Buffer,
+   std::span<float64> const vals,
+   char               const Delim) -> Cast_T<sizet>
+{
+   auto const Result = tryCastColumn(Buffer, vals, Delim);
+
+   #if (YM_YES_EXCEPTIONS)
+      YMASSERT(Result.has_value(), BadCastError, YM_DAH,
+         "Column of {} bytes has a {} float64 or more than {} values",
+         Buffer.size(), getErrorName(Result.error()), vals.size());
+      return *Result;
+   #else
+      return Result;
+   #endif
+}
+
+/** formatTo
+ *
+ * @brief Writes value in decimal, as fmt's "{}" would.
+ *
+ * @note Does *not* write null terminator.
+ *
+ * @note Everything written reads back through tryCastTo() to the same bits (any nan for
+ *       nan) - except subnormals, which tryCastTo() rejects as out of range. Read those
+ *       back with std::from_chars.
+ *
+ * @tparam T -- Type of value.
+ *
+ * @param out_ptr -- Where to write (room for _s_MaxFormattedSize chars).
+ * @param Val     -- Value.
+ *
+ * @returns char * -- Where to continue writing into the buffer.
+ */
+template <Formattable T>
+char * ym::Ops::formatTo(
+   char * const out_ptr,
+   T      const Val)
+{
+   if constexpr (std::is_floating_point_v<T>)
+   { // shortest round trip
+      return formatFloat(out_ptr, Val);
+   }
+   else if constexpr (std::is_signed_v<T>)
+   { // magnitude of the most negative value is fine in uint64
+      if (Val < T(0))
+      { // negative
+         *out_ptr = '-';
+         return formatUnsigned(out_ptr + 1, 0_u64 - static_cast<uint64>(Val));
+      }
+      return formatUnsigned(out_ptr, static_cast<uint64>(Val));
+   }
+   else
+   { // unsigned
+      return formatUnsigned(out_ptr, Val);
+   }
+}
+
+/** formatFixedTo
+ *
+ * @brief Writes exactly the low NDigits digits of value, zero padded, e.g. for time stamps.
+ *
+ * @note Does *not* write null terminator.
+ *
+ * @param out_ptr -- Where to write.
+ * @param Val     -- Value.
+ * @param NDigits -- Number of digits to write.
+ *
+ * @returns char * -- Where to continue writing into the buffer.
+ */
+char * ym::Ops::formatFixedTo(
+   char   * const out_ptr,
+   uint64   const Val,
+   sizet    const NDigits)
+{
+   writeDigits(out_ptr + NDigits, Val, NDigits);
+   return out_ptr + NDigits;
+}
+
+/** formatColumn
+ *
+ * @brief Writes values into buffer, each followed by delimiter, e.g. one value per line.
+ *
+ * @note Stops early once buffer might not fit the next value. Write out what was
+ *       formatted and call again with the rest of the values.
+ *
+ * @tparam T -- Type of values.
+ *
+ * @param Vals   -- Values to format.
+ * @param buffer -- Where to write (not null terminated).
+ * @param Delim  -- Written after each value.
+ *
+ * @returns FormatResult_T -- Number of values formatted and of chars written.
+ */
+template <Formattable T>
+auto ym::Ops::formatColumn(
+   std::span<T const> const Vals,
+   std::span<char>    const buffer,
+   char               const Delim) -> FormatResult_T
+{
+   auto *       out_ptr = buffer.data();
+   auto * const End_Ptr = buffer.data() + buffer.size();
+
+   auto nVals = 0uz;
+
+   for (; nVals < Vals.size() && static_cast<sizet>(End_Ptr - out_ptr) > _s_MaxFormattedSize; ++nVals)
+   { // room for value and delimiter
+      out_ptr    = formatTo(out_ptr, Vals[nVals]);
+      *out_ptr++ = Delim;
+   }
+
+   return {nVals, static_cast<sizet>(out_ptr - buffer.data())};
+}
+
+/// @brief Supported types - the definitions above stay out of the header.
+#define YM_HELPER_INST_INT(T_)                                                                      \
+   template auto ym::Ops::tryCastTo<ym::T_>(std::string_view const, uint32 const) -> Expected_T<T_>; \
+   template auto ym::Ops::castTo   <ym::T_>(std::string_view const, uint32 const) -> Cast_T    <T_>;
+
+#define YM_HELPER_INST_FLT(T_)                                                        \
+   template auto ym::Ops::tryCastTo<ym::T_>(std::string_view const) -> Expected_T<T_>; \
+   template auto ym::Ops::castTo   <ym::T_>(std::string_view const) -> Cast_T    <T_>;
+
+YM_HELPER_INST_INT(int8    )
+YM_HELPER_INST_INT(int16   )
+YM_HELPER_INST_INT(int32   )
+YM_HELPER_INST_INT(int64   )
+YM_HELPER_INST_INT(uint8   )
+YM_HELPER_INST_INT(uint16  )
+YM_HELPER_INST_INT(uint32  )
+YM_HELPER_INST_INT(uint64  )
+YM_HELPER_INST_FLT(float32 )
+YM_HELPER_INST_FLT(float64 )
+YM_HELPER_INST_FLT(floatext)
+
+#define YM_HELPER_INST_FMT(T_)                                                                         \
+   template char * ym::Ops::formatTo    <ym::T_>(char * const, T_ const);                                  \
+   template auto   ym::Ops::formatColumn<ym::T_>(std::span<T_ const> const, std::span<char> const, char const) \
+      -> FormatResult_T;
+
+YM_HELPER_INST_FMT(int8   )
+YM_HELPER_INST_FMT(int16  )
+YM_HELPER_INST_FMT(int32  )
+YM_HELPER_INST_FMT(int64  )
+YM_HELPER_INST_FMT(uint8  )
+YM_HELPER_INST_FMT(uint16 )
+YM_HELPER_INST_FMT(uint32 )
+YM_HELPER_INST_FMT(uint64 )
+YM_HELPER_INST_FMT(float32)
+YM_HELPER_INST_FMT(float64)
+
+#undef YM_HELPER_INST_INT
+#undef YM_HELPER_INST_FLT
+#undef YM_HELPER_INST_FMT
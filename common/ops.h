@@ -1,53 +1,143 @@
-// /**
-//  * @file    ops.h
-//  * @version 1.0.0
-//  * @author  Forrest Jablonski
-//  */
-
-// #pragma once
-
-// #include "ymglobals.h"
-
-// #include <string>
-// #include <type_traits>
-
-// namespace ym
-// {
-
-// /** Ops
-//  *
-//  * @brief Collection of useful operations.
-//  */
-// class Ops
-// {
-// public:
-//    YM_NO_DEFAULT(Ops)
-
-//    static char castToChar(str const S);
-
-//    template <typename T>
-//    requires (std::is_floating_point_v<T>)
-//    static T castTo(std::string const & S) = delete;
-
-//    template <typename T>
-//    requires (std::is_integral_v<T>)
-//    static T castTo(std::string const & S,
-//                    uint32      const   Base = 10_u32) = delete;
-
-//    YM_DECL_YMERROR(OpsError)
-//    YM_DECL_YMERROR(OpsError, OpsError_BadCast)
-// };
-
-// template <> int8     Ops::castTo<int8>    (std::string const & S, uint32 const Base);
-// template <> int16    Ops::castTo<int16>   (std::string const & S, uint32 const Base);
-// template <> int32    Ops::castTo<int32>   (std::string const & S, uint32 const Base);
-// template <> int64    Ops::castTo<int64>   (std::string const & S, uint32 const Base);
-// template <> uint8    Ops::castTo<uint8>   (std::string const & S, uint32 const Base);
-// template <> uint16   Ops::castTo<uint16>  (std::string const & S, uint32 const Base);
-// template <> uint32   Ops::castTo<uint32>  (std::string const & S, uint32 const Base);
-// template <> uint64   Ops::castTo<uint64>  (std::string const & S, uint32 const Base);
-// template <> float32  Ops::castTo<float32> (std::string const & S);
-// template <> float64  Ops::castTo<float64> (std::string const & S);
-// template <> floatext Ops::castTo<floatext>(std::string const & S);
-
-// } // ym
+/**
+ * @file    ops.h
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#pragma once
+
+#include "ymglobals.h"
+
+#include <expected>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace ym
+{
+
+/** Formattable
+ *
+ * @brief Types Ops is able to format.
+ *
+ * @tparam T -- Data type.
+ */
+template <typename T>
+concept Formattable = std::is_same_v<T, int8   > ||
+                      std::is_same_v<T, int16  > ||
+                      std::is_same_v<T, int32  > ||
+                      std::is_same_v<T, int64  > ||
+                      std::is_same_v<T, uint8  > ||
+                      std::is_same_v<T, uint16 > ||
+                      std::is_same_v<T, uint32 > ||
+                      std::is_same_v<T, uint64 > ||
+                      std::is_same_v<T, float32> ||
+                      std::is_same_v<T, float64>;
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** Ops
+ *
+ * @brief Collection of useful operations.
+ *
+ * @note Casts never allocate. tryCastTo() never throws - it reports why a cast failed
+ *       with the same error codes as std::from_chars. castTo() asserts on failure in
+ *       builds with exceptions, and hands back the std::expected otherwise.
+ *
+ * @note The whole string must be consumed. A leading '+' is accepted.
+ *
+ * @note float32/float64 are parsed with Eisel-Lemire - correctly rounded and locale
+ *       independent - falling back on std::from_chars for the rare hard case.
+ *
+ * @note formatTo() writes numbers the way fmt's "{}" does, straight into the caller's
+ *       buffer, without a null terminator. Integers go two digits at a time; floats get
+ *       the shortest digits that round trip. Room for _s_MaxFormattedSize chars is
+ *       assumed, which no value exceeds.
+ */
+class Ops
+{
+public:
+   YM_NO_DEFAULT(Ops)
+
+   YM_DECL_YMASSERT(Error)
+   YM_DECL_YMASSERT(Error, BadCastError)
+
+   /// @brief Value, or std::errc::invalid_argument/result_out_of_range.
+   template <typename T>
+   using Expected_T = std::expected<T, std::errc>;
+
+   #if (YM_YES_EXCEPTIONS)
+      template <typename T>
+      using Cast_T = T;
+   #else
+      template <typename T>
+      using Cast_T = Expected_T<T>;
+   #endif
+
+   static Expected_T<char> tryCastToChar(std::string_view const S);
+
+   template <typename T>
+   requires (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+   static Expected_T<T> tryCastTo(
+      std::string_view const S,
+      uint32           const Base = 10_u32);
+
+   template <typename T>
+   requires (std::is_floating_point_v<T>)
+   static Expected_T<T> tryCastTo(std::string_view const S);
+
+   static Expected_T<sizet> tryCastColumn(
+      std::string_view   const Buffer,
+      std::span<float64> const vals,
+      char               const Delim = '\n');
+
+   static Cast_T<char> castToChar(std::string_view const S);
+
+   template <typename T>
+   requires (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+   static Cast_T<T> castTo(
+      std::string_view const S,
+      uint32           const Base = 10_u32);
+
+   template <typename T>
+   requires (std::is_floating_point_v<T>)
+   static Cast_T<T> castTo(std::string_view const S);
+
+   static Cast_T<sizet> castColumn(
+      std::string_view   const Buffer,
+      std::span<float64> const vals,
+      char               const Delim = '\n');
+
+   /** FormatResult_T
+    *
+    * @brief Progress of formatColumn().
+    */
+   struct FormatResult_T
+   {
+      sizet _nVals;  // formatted
+      sizet _nChars; // written
+   };
+
+   template <Formattable T>
+   static char * formatTo(
+      char * const out_ptr,
+      T      const Val);
+
+   static char * formatFixedTo(
+      char   * const out_ptr,
+      uint64   const Val,
+      sizet    const NDigits);
+
+   template <Formattable T>
+   static FormatResult_T formatColumn(
+      std::span<T const> const Vals,
+      std::span<char>    const buffer,
+      char               const Delim = '\n');
+
+   /// @brief Longest formatTo() output, e.g. "-2.2250738585072014e-308".
+   static constexpr auto _s_MaxFormattedSize = 24uz;
+};
+
+} // ym
@@ -0,0 +1,340 @@
+/**
+ * @file    profiler.cpp
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#include "profiler.h"
+
+#include "fileio.h"
+#include "textlogger.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+#include <unistd.h>
+
+namespace
+{
+
+/** writeJsonStr
+ *
+ * @brief Writes a json string (quoted and escaped).
+ *
+ * @param out -- Buffer to append to.
+ * @param Str -- String to write.
+ */
+void writeJsonStr(
+   fmt::memory_buffer &   out,
+   std::string_view const Str)
+{
+   out.push_back('"');
+   for (auto const C : Str)
+   { // escape what json can't hold
+      if (C == '"' || C == '\\')
+      { // escape character
+         out.push_back('\\');
+         out.push_back(C);
+      }
+      else if (static_cast<unsigned char>(C) < 0x20u)
+      { // control character
+         fmt::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned>(C));
+      }
+      else
+      { // as is
+         out.push_back(C);
+      }
+   }
+   out.push_back('"');
+}
+
+} // anonymous
+
+/** Registry_T
+ *
+ * @brief Every thread buffer ever registered.
+ */
+struct ym::Profiler::Registry_T
+{
+   std::mutex                                   _mutex  { };
+   std::vector<std::unique_ptr<ThreadBuffer_T>> _buffers{ };
+};
+
+/** getRegistry
+ *
+ * @brief Returns the registry of thread buffers.
+ *
+ * @note Never destroyed - threads may still record while statics are torn down.
+ *
+ * @returns Registry_T & -- Registry.
+ */
+auto ym::Profiler::getRegistry(void) -> Registry_T &
+{
+   static auto * const s_Registry_Ptr = new Registry_T();
+   return *s_Registry_Ptr;
+}
+
+/** ~ThreadBuffer_T
+ *
+ * @brief Destructor.
+ */
+ym::Profiler::ThreadBuffer_T::~ThreadBuffer_T(void)
+{
+   clear();
+}
+
+/** clear
+ *
+ * @brief Frees chained chunks and forgets all events.
+ */
+void ym::Profiler::ThreadBuffer_T::clear(void)
+{
+   auto * chunk_ptr = _head._next_ptr.exchange(nullptr, std::memory_order_acq_rel);
+
+   while (chunk_ptr)
+   { // free chain
+      auto * const next_Ptr = chunk_ptr->_next_ptr.load(std::memory_order_acquire);
+      delete chunk_ptr;
+      chunk_ptr = next_Ptr;
+   }
+
+   _head._count.store(0uz, std::memory_order_release);
+   _tail_ptr = &_head;
+}
+
+/** registerThread
+ *
+ * @brief Creates the buffer of the calling thread.
+ *
+ * @returns ThreadBuffer_T * -- Buffer (owned by the registry).
+ */
+auto ym::Profiler::registerThread(void) -> ThreadBuffer_T *
+{
+   auto & registry = getRegistry();
+
+   std::lock_guard const Lock(registry._mutex);
+
+   auto const ThreadId = static_cast<uint32>(registry._buffers.size());
+   registry._buffers.emplace_back(std::make_unique<ThreadBuffer_T>(ThreadId));
+
+   return registry._buffers.back().get();
+}
+
+/** reset
+ *
+ * @brief Forgets all recorded events.
+ *
+ * @note Must not be called while any thread is inside a zone or recording.
+ */
+void ym::Profiler::reset(void)
+{
+   auto & registry = getRegistry();
+
+   std::lock_guard const Lock(registry._mutex);
+
+   for (auto const & Buffer : registry._buffers)
+   { // each thread
+      Buffer->clear();
+   }
+}
+
+/** summarize
+ *
+ * @brief Aggregates the events of all threads per zone.
+ *
+ * @note Zones still open are not counted. Zones are matched by name, not by address.
+ *
+ * @returns std::vector<ZoneStats_T> -- Stats, most inclusive time first.
+ */
+auto ym::Profiler::summarize(void) -> std::vector<ZoneStats_T>
+{
+   /** Open_T
+    *
+    * @brief Zone entered but not yet left.
+    */
+   struct Open_T
+   {
+      std::string_view _name    {     };
+      int64            _start_ns{0_i64};
+      int64            _child_ns{0_i64};
+   };
+
+   auto & registry = getRegistry();
+
+   std::lock_guard const Lock(registry._mutex);
+
+   auto zones = std::unordered_map<std::string_view, ZoneStats_T>();
+   auto stack = std::vector<Open_T>();
+
+   for (auto const & Buffer : registry._buffers)
+   { // each thread
+      stack.clear();
+
+      for (auto const * chunk_ptr = &Buffer->_head; chunk_ptr; chunk_ptr = chunk_ptr->_next_ptr.load(std::memory_order_acquire))
+      { // each chunk
+         auto const Count = chunk_ptr->_count.load(std::memory_order_acquire);
+
+         for (auto i = 0uz; i < Count; ++i)
+         { // each event
+            auto const & Event = chunk_ptr->_events[i];
+
+            if (Event._begin)
+            { // entered
+               stack.push_back({Event._name_ptr, Event._time_ns, 0_i64});
+            }
+            else if (!stack.empty())
+            { // left
+               auto const Open        = stack.back();
+               auto const Duration_ns = Event._time_ns - Open._start_ns;
+               stack.pop_back();
+
+               auto & zone = zones[Open._name];
+               zone._calls        += 1_u64;
+               zone._inclusive_ns += Duration_ns;
+               zone._exclusive_ns += Duration_ns - Open._child_ns;
+
+               if (!stack.empty())
+               { // charge parent
+                  stack.back()._child_ns += Duration_ns;
+               }
+            }
+         }
+      }
+   }
+
+   auto stats = std::vector<ZoneStats_T>();
+   stats.reserve(zones.size());
+
+   for (auto & [Name, zone] : zones)
+   { // flatten
+      zone._name = Name;
+      stats.push_back(std::move(zone));
+   }
+
+   std::ranges::sort(stats, std::ranges::greater(), &ZoneStats_T::_inclusive_ns);
+
+   return stats;
+}
+
+/** getSummaryTable
+ *
+ * @brief Formats the summary as a table.
+ *
+ * @returns std::string -- Table, one zone per line.
+ */
+auto ym::Profiler::getSummaryTable(void) -> std::string
+{
+   auto const Stats = summarize();
+
+   auto nameWidth = std::string_view("zone").size();
+   for (auto const & Zone : Stats)
+   { // widest name
+      nameWidth = std::max(nameWidth, Zone._name.size());
+   }
+
+   auto out = fmt::memory_buffer();
+   fmt::format_to(std::back_inserter(out), "{:<{}} {:>10} {:>14} {:>14} {:>12}\n",
+      "zone", nameWidth, "calls", "inclusive ms", "exclusive ms", "avg us");
+
+   for (auto const & Zone : Stats)
+   { // one row per zone
+      fmt::format_to(std::back_inserter(out), "{:<{}} {:>10} {:>14.3f} {:>14.3f} {:>12.3f}\n",
+         Zone._name, nameWidth,
+         Zone._calls,
+         static_cast<float64>(Zone._inclusive_ns) / 1.0e6_f64,
+         static_cast<float64>(Zone._exclusive_ns) / 1.0e6_f64,
+         static_cast<float64>(Zone._inclusive_ns) / 1.0e3_f64 / static_cast<float64>(Zone._calls));
+   }
+
+   return fmt::to_string(out);
+}
+
+/** writeSummary
+ *
+ * @brief Writes the summary table to a file.
+ *
+ * @param Filename -- Name of file.
+ *
+ * @returns bool -- If the file was written.
+ */
+bool ym::Profiler::writeSummary(str const Filename)
+{
+   auto writer = FileIO::Writer();
+
+   return writer.open(Filename) && writer.write(getSummaryTable()) && writer.commit();
+}
+
+/** writeChromeTrace
+ *
+ * @brief Writes all events in Chrome's trace_event format.
+ *
+ * @note Open in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * @param Filename -- Name of file.
+ *
+ * @returns bool -- If the file was written.
+ */
+bool ym::Profiler::writeChromeTrace(str const Filename)
+{
+   constexpr auto FlushAt_bytes = 1uz << 20uz;
+
+   auto & registry = getRegistry();
+
+   std::lock_guard const Lock(registry._mutex);
+
+   auto writer = FileIO::Writer();
+   auto ok     = writer.open(Filename);
+   auto out    = fmt::memory_buffer();
+   auto sep    = std::string_view("\n");
+
+   // chrome wants microseconds - make them relative to the first event
+   auto origin_ns = std::numeric_limits<int64>::max();
+   for (auto const & Buffer : registry._buffers)
+   { // first event of each thread
+      if (Buffer->_head._count.load(std::memory_order_acquire) > 0uz)
+      { // recorded something
+         origin_ns = std::min(origin_ns, Buffer->_head._events[0]._time_ns);
+      }
+   }
+
+   fmt::format_to(std::back_inserter(out), "{{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+   for (auto const & Buffer : registry._buffers)
+   { // each thread
+      for (auto const * chunk_ptr = &Buffer->_head; ok && chunk_ptr; chunk_ptr = chunk_ptr->_next_ptr.load(std::memory_order_acquire))
+      { // each chunk
+         auto const Count = chunk_ptr->_count.load(std::memory_order_acquire);
+
+         for (auto i = 0uz; i < Count; ++i)
+         { // each event
+            auto const & Event = chunk_ptr->_events[i];
+
+            fmt::format_to(std::back_inserter(out), "{}{{\"name\":", sep);
+            writeJsonStr(out, Event._name_ptr);
+            fmt::format_to(std::back_inserter(out), ",\"ph\":\"{}\",\"ts\":{:.3f},\"pid\":{},\"tid\":{}}}",
+               Event._begin ? 'B' : 'E',
+               static_cast<float64>(Event._time_ns - origin_ns) / 1.0e3_f64,
+               ::getpid(),
+               Buffer->_ThreadId);
+            sep = ",\n";
+         }
+
+         if (out.size() >= FlushAt_bytes)
+         { // keep the staging string small
+            ok  = writer.write(std::string_view(out.data(), out.size()));
+            out.clear();
+         }
+      }
+   }
+
+   fmt::format_to(std::back_inserter(out), "\n]}}\n");
+
+   return ok && writer.write(std::string_view(out.data(), out.size())) && writer.commit();
+}
@@ -0,0 +1,217 @@
+/**
+ * @file    profiler.h
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#pragma once
+
+#include "ymglobals.h"
+
+#include "timer.h"
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Compile-time switch. With YM_PROFILE 0 (or undefined) the macros below expand to
+ *        nothing - no clock reads, no buffers, no registration.
+ */
+#if (YM_PROFILE)
+   #define YM_HELPER_PROFILE_CAT2(A_, B_) A_##B_
+   #define YM_HELPER_PROFILE_CAT1(A_, B_) YM_HELPER_PROFILE_CAT2(A_, B_)
+
+   #define YM_PROFILE_SCOPE(Name_) \
+      ym::ProfileScope const YM_HELPER_PROFILE_CAT1(ymProfileScope_, __LINE__){Name_}
+   #define YM_PROFILE_FUNCTION() YM_PROFILE_SCOPE(__func__)
+#else
+   #define YM_PROFILE_SCOPE(Name_) (void)0
+   #define YM_PROFILE_FUNCTION()   (void)0
+#endif
+
+namespace ym
+{
+
+/** Profiler
+ *
+ * @brief Records begin/end events of named zones and aggregates them.
+ *
+ * @note Each thread appends to its own buffer - a chain of fixed size chunks. Only the
+ *       owning thread writes to it and publishes each event with a release store, so
+ *       recording takes no locks. A thread takes the registry lock once, on its first
+ *       event. Buffers outlive their threads so zones of finished threads still count.
+ *
+ * @note Zone names must outlive the profiler (string literals, __func__).
+ *
+ * @note reset() must not race with recording. Summaries and traces can be taken at any
+ *       time - they see every event published so far.
+ */
+class Profiler
+{
+public:
+   YM_NO_DEFAULT(Profiler)
+
+   using Clock_T = TscClock;
+
+   /** ZoneStats_T
+    *
+    * @brief Aggregated timings of one zone (over all threads).
+    *
+    * @note Exclusive time excludes time spent in nested zones. Inclusive time of a
+    *       recursive zone counts the nested calls again.
+    */
+   struct ZoneStats_T
+   {
+      std::string _name        {     };
+      uint64      _calls       {0_u64};
+      int64       _inclusive_ns{0_i64};
+      int64       _exclusive_ns{0_i64};
+   };
+
+   static inline void begin(char const * const Name_Ptr);
+   static inline void end  (char const * const Name_Ptr);
+
+   static void reset(void);
+
+   static std::vector<ZoneStats_T> summarize(void);
+
+   static std::string getSummaryTable (void);
+   static bool        writeSummary    (str const Filename);
+   static bool        writeChromeTrace(str const Filename);
+
+private:
+   /** Event_T
+    *
+    * @brief A zone was entered or left.
+    */
+   struct Event_T
+   {
+      char const * _name_ptr{nullptr};
+      int64        _time_ns {0_i64  };
+      bool         _begin   {false  };
+   };
+
+   /** Chunk_T
+    *
+    * @brief Fixed size piece of a thread buffer.
+    */
+   struct Chunk_T
+   {
+      static constexpr auto _s_NEvents = 4096uz;
+
+      std::array<Event_T, _s_NEvents> _events  {       };
+      std::atomic<sizet>              _count   {0uz    }; // published events
+      std::atomic<Chunk_T *>          _next_ptr{nullptr};
+   };
+
+   /** ThreadBuffer_T
+    *
+    * @brief Events of one thread.
+    */
+   struct ThreadBuffer_T
+   {
+      explicit ThreadBuffer_T(uint32 const ThreadId) : _ThreadId{ThreadId} { }
+      ~ThreadBuffer_T(void);
+
+      YM_NO_COPY  (ThreadBuffer_T)
+      YM_NO_ASSIGN(ThreadBuffer_T)
+
+      inline void push(Event_T const & Event);
+
+      void clear(void);
+
+      Chunk_T         _head    {      };
+      Chunk_T *       _tail_ptr{&_head}; // owner only
+      uint32    const _ThreadId{      };
+   };
+
+   struct Registry_T;
+
+   static Registry_T &     getRegistry   (void);
+   static ThreadBuffer_T * registerThread(void);
+
+   static inline ThreadBuffer_T * getThreadBuffer(void);
+
+   static inline thread_local ThreadBuffer_T * _s_tlBuffer_ptr{nullptr};
+};
+
+/** ProfileScope
+ *
+ * @brief Records the zone for the lifetime of the object. See YM_PROFILE_SCOPE.
+ */
+class ProfileScope
+{
+public:
+   explicit inline ProfileScope(char const * const Name_Ptr) : _Name_Ptr{Name_Ptr} { Profiler::begin(_Name_Ptr); }
+   inline ~ProfileScope(void) { Profiler::end(_Name_Ptr); }
+
+   YM_NO_COPY  (ProfileScope)
+   YM_NO_ASSIGN(ProfileScope)
+
+private:
+   char const * const _Name_Ptr;
+};
+
+/** begin
+ *
+ * @brief Records entering a zone.
+ *
+ * @param Name_Ptr -- Name of zone.
+ */
+inline void Profiler::begin(char const * const Name_Ptr)
+{
+   getThreadBuffer()->push({Name_Ptr, Clock_T::now().time_since_epoch().count(), true});
+}
+
+/** end
+ *
+ * @brief Records leaving a zone.
+ *
+ * @param Name_Ptr -- Name of zone.
+ */
+inline void Profiler::end(char const * const Name_Ptr)
+{
+   getThreadBuffer()->push({Name_Ptr, Clock_T::now().time_since_epoch().count(), false});
+}
+
+/** getThreadBuffer
+ *
+ * @brief Returns the buffer of the calling thread, registering it the first time.
+ *
+ * @returns ThreadBuffer_T * -- Buffer.
+ */
+inline auto Profiler::getThreadBuffer(void) -> ThreadBuffer_T *
+{
+   if (!_s_tlBuffer_ptr)
+   { // first event on this thread
+      _s_tlBuffer_ptr = registerThread();
+   }
+
+   return _s_tlBuffer_ptr;
+}
+
+/** push
+ *
+ * @brief Appends and publishes an event (owner thread only).
+ *
+ * @param Event -- Event to append.
+ */
+inline void Profiler::ThreadBuffer_T::push(Event_T const & Event)
+{
+   auto n = _tail_ptr->_count.load(std::memory_order_relaxed);
+
+   if (n == Chunk_T::_s_NEvents)
+   { // chunk full - chain a new one
+      auto * const chunk_Ptr = new Chunk_T();
+      _tail_ptr->_next_ptr.store(chunk_Ptr, std::memory_order_release);
+      _tail_ptr = chunk_Ptr;
+      n         = 0uz;
+   }
+
+   _tail_ptr->_events[n] = Event;
+   _tail_ptr->_count.store(n + 1uz, std::memory_order_release);
+}
+
+} // ym
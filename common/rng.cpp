@@ -1,91 +1,1044 @@
-// /**
-//  * @file    rng.cpp
-//  * @version 1.0.0
-//  * @author  Forrest Jablonski
-//  */
-
-// #include "rng.h"
-
-// /** Prng
-//  * 
-//  * @brief Constructor.
-//  */
-// ym::Prng::Prng(void)
-//    : Prng(0x763b'15c2'1847'ea8d_u64)
-// {
-// }
-
-// /** Prng
-//  * 
-//  * @brief Constructor.
-//  * 
-//  * @param Seed -- Seed.
-//  */
-// ym::Prng::Prng(State_T const Seed)
-//    : _seed  {Seed},
-//      _state {Seed}
-// {
-// }
-
-// /** setSeed
-//  * 
-//  * @brief Sets the seed for the PRNG.
-//  * 
-//  * @param Seed -- Seed.
-//  */
-// void ym::Prng::setSeed(State_T const Seed)
-// {
-//    _seed  = Seed;
-//    _state = Seed;
-// }
-
-// /** jump
-//  * 
-//  * @brief Advances the state by nJumps.
-//  * 
-//  * @param nJumps -- # of jumps to perform.
-//  */
-// void ym::Prng::jump(uint64 nJumps)
-// {
-//    auto acc_mult = 1_u64;
-//    auto acc_plus = 0_u64;
-//    auto cur_mult = _s_Mult;
-//    auto cur_plus = _s_Plus;
-
-//    while (nJumps > 0_u64)
-//    {
-//       if (nJumps & 1_u64)
-//       {
-//          acc_mult *= cur_mult;
-//          acc_plus = acc_plus * cur_mult + cur_plus;
-//       }
-//       cur_plus = (cur_mult + 1_u64) * cur_plus;
-//       cur_mult *= cur_mult;
-//       nJumps /= 2_u64;
-//    }
-
-//    _state = (_state * acc_mult) + acc_plus;
-// }
-
-// // -----------------------------------------------------------------------------
-// // -----------------------------------------------------------------------------
-
-// /** Trng
-//  * 
-//  * @brief Constructor.
-//  */
-// ym::Trng::Trng(void)
-//    : _prng {}
-// {
-// }
-
-// /** Trng
-//  * 
-//  * @brief Constructor.
-//  * 
-//  * @param Seed -- Seed.
-//  */
-// ym::Trng::Trng(Prng::State_T const Seed)
-//    : _prng {Seed}
-// {
-// }
+/**
+ * @file    rng.cpp
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#include "rng.h"
+
+#include "textlogger.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <mutex>
+
+#if defined(__linux__)
+   #include <cerrno>
+   #include <sys/random.h>
+#endif
+
+#if defined(__unix__)
+   #include <pthread.h>
+#endif
+
+#if defined(__x86_64__)
+   #include <immintrin.h>
+#endif
+
+namespace
+{
+
+/** FillKernel_T
+ *
+ * @brief Generates nBlocks blocks of _s_NLanes values, advancing every lane as it goes.
+ *
+ * @note Lane k produces values k, k + _s_NLanes, k + 2*_s_NLanes, ... of the block run.
+ *
+ * @tparam T -- uint64 or float64.
+ */
+template <typename T>
+using FillKernel_T = void (*)(
+   ym::uint64 *       lanes_Ptr,
+   ym::uint64   const StepMult,
+   ym::uint64   const StepPlus,
+   T *                out_ptr,
+   ym::sizet          nBlocks);
+
+/** fill_scalar
+ *
+ * @brief See FillKernel_T. Portable version - the lanes are independent so the
+ *        compiler is free to overlap (or auto-vectorize) them.
+ *
+ * @tparam T -- uint64 or float64.
+ */
+template <typename T>
+void fill_scalar(
+   ym::uint64 *       lanes_Ptr,
+   ym::uint64   const StepMult,
+   ym::uint64   const StepPlus,
+   T *                out_ptr,
+   ym::sizet          nBlocks)
+{
+   using namespace ym;
+
+   auto lanes = std::array<uint64, Prng::_s_NLanes>{};
+   std::copy_n(lanes_Ptr, lanes.size(), lanes.begin());
+
+   for (; nBlocks > 0uz; --nBlocks, out_ptr += lanes.size())
+   { // one value per lane
+      for (auto k = 0uz; k < lanes.size(); ++k)
+      { // each lane
+         if constexpr (std::is_same_v<T, float64>)
+         { // real
+            out_ptr[k] = Prng::convertToFloat64(Prng::permute(lanes[k]));
+         }
+         else
+         { // integer
+            out_ptr[k] = Prng::permute(lanes[k]);
+         }
+         lanes[k] = (lanes[k] * StepMult) + StepPlus;
+      }
+   }
+
+   std::copy_n(lanes.begin(), lanes.size(), lanes_Ptr);
+}
+
+#if defined(__x86_64__)
+
+/** mullo64_avx2
+ *
+ * @brief Low 64 bits of a 64x64 multiply (AVX2 has no such instruction).
+ *
+ * @param A   -- Multiplicand.
+ * @param B   -- Multiplier.
+ * @param BHi -- High halves of the multiplier (B >> 32).
+ *
+ * @returns __m256i -- Products.
+ */
+__attribute__((target("avx2")))
+inline __m256i mullo64_avx2(
+   __m256i const A,
+   __m256i const B,
+   __m256i const BHi)
+{
+   auto const Lo    = _mm256_mul_epu32(A, B);
+   auto const Cross = _mm256_add_epi64(
+      _mm256_mul_epu32(_mm256_srli_epi64(A, 32), B),
+      _mm256_mul_epu32(A, BHi));
+
+   return _mm256_add_epi64(Lo, _mm256_slli_epi64(Cross, 32));
+}
+
+/** permute_avx2
+ *
+ * @brief Vector version of Prng::permute().
+ *
+ * @param State -- LCG states.
+ *
+ * @returns __m256i -- Random numbers.
+ */
+__attribute__((target("avx2")))
+inline __m256i permute_avx2(__m256i const State)
+{
+   using namespace ym;
+
+   constexpr auto Mult = 12605985483714917081_u64;
+
+   auto const M    = _mm256_set1_epi64x(static_cast<int64>(Mult));
+   auto const MHi  = _mm256_set1_epi64x(static_cast<int64>(Mult >> 32_u64));
+   auto const Five = _mm256_set1_epi64x(5);
+
+   auto const Shift = _mm256_add_epi64(_mm256_srli_epi64(State, 59), Five);
+   auto const Word  = mullo64_avx2(_mm256_xor_si256(_mm256_srlv_epi64(State, Shift), State), M, MHi);
+
+   return _mm256_xor_si256(_mm256_srli_epi64(Word, 43), Word);
+}
+
+/** toFloat64_avx2
+ *
+ * @brief Vector version of Prng::convertToFloat64().
+ *
+ * @param Val -- Values to convert.
+ *
+ * @returns __m256d -- Random numbers in [0..1).
+ */
+__attribute__((target("avx2")))
+inline __m256d toFloat64_avx2(__m256i const Val)
+{
+   using namespace ym;
+
+   auto const Exp = _mm256_set1_epi64x(static_cast<int64>(1023_u64 << 52_u64));
+   auto const One = _mm256_set1_pd(1.0);
+
+   return _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(Val, 12), Exp)), One);
+}
+
+/** fill_avx2
+ *
+ * @brief See FillKernel_T. Four lanes per register.
+ *
+ * @note Compiled for AVX2 regardless of build flags - only called if the CPU has it.
+ *
+ * @tparam T -- uint64 or float64.
+ */
+template <typename T>
+__attribute__((target("avx2")))
+void fill_avx2(
+   ym::uint64 *       lanes_Ptr,
+   ym::uint64   const StepMult,
+   ym::uint64   const StepPlus,
+   T *                out_ptr,
+   ym::sizet          nBlocks)
+{
+   using namespace ym;
+
+   constexpr auto NRegs = Prng::_s_NLanes / 4uz;
+
+   auto const M   = _mm256_set1_epi64x(static_cast<int64>(StepMult));
+   auto const MHi = _mm256_set1_epi64x(static_cast<int64>(StepMult >> 32_u64));
+   auto const P   = _mm256_set1_epi64x(static_cast<int64>(StepPlus));
+
+   __m256i regs[NRegs]; // std::array would drop the vector type's alignment attribute
+   for (auto r = 0uz; r < NRegs; ++r)
+   { // load lanes
+      regs[r] = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(lanes_Ptr + (r * 4uz)));
+   }
+
+   for (; nBlocks > 0uz; --nBlocks, out_ptr += Prng::_s_NLanes)
+   { // one value per lane
+      for (auto r = 0uz; r < NRegs; ++r)
+      { // independent chains - hides the multiply latency
+         auto const Out = permute_avx2(regs[r]);
+
+         if constexpr (std::is_same_v<T, float64>)
+         { // real
+            _mm256_storeu_pd(out_ptr + (r * 4uz), toFloat64_avx2(Out));
+         }
+         else
+         { // integer
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out_ptr + (r * 4uz)), Out);
+         }
+
+         regs[r] = _mm256_add_epi64(mullo64_avx2(regs[r], M, MHi), P);
+      }
+   }
+
+   for (auto r = 0uz; r < NRegs; ++r)
+   { // store lanes
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes_Ptr + (r * 4uz)), regs[r]);
+   }
+}
+
+/** fill_avx512
+ *
+ * @brief See FillKernel_T. Eight lanes per register, native 64-bit multiplies.
+ *
+ * @note Compiled for AVX-512 regardless of build flags - only called if the CPU has it.
+ *
+ * @tparam T -- uint64 or float64.
+ */
+template <typename T>
+__attribute__((target("avx512f,avx512dq")))
+void fill_avx512(
+   ym::uint64 *       lanes_Ptr,
+   ym::uint64   const StepMult,
+   ym::uint64   const StepPlus,
+   T *                out_ptr,
+   ym::sizet          nBlocks)
+{
+   using namespace ym;
+
+   constexpr auto NRegs = Prng::_s_NLanes / 8uz;
+
+   auto const M    = _mm512_set1_epi64(static_cast<int64>(StepMult));
+   auto const P    = _mm512_set1_epi64(static_cast<int64>(StepPlus));
+   auto const PM   = _mm512_set1_epi64(static_cast<int64>(12605985483714917081_u64));
+   auto const Five = _mm512_set1_epi64(5);
+   auto const Exp  = _mm512_set1_epi64(static_cast<int64>(1023_u64 << 52_u64));
+   auto const One  = _mm512_set1_pd(1.0);
+
+   __m512i regs[NRegs]; // std::array would drop the vector type's alignment attribute
+   for (auto r = 0uz; r < NRegs; ++r)
+   { // load lanes
+      regs[r] = _mm512_loadu_si512(lanes_Ptr + (r * 8uz));
+   }
+
+   for (; nBlocks > 0uz; --nBlocks, out_ptr += Prng::_s_NLanes)
+   { // one value per lane
+      for (auto r = 0uz; r < NRegs; ++r)
+      { // independent chains - hides the multiply latency
+         auto const Shift = _mm512_add_epi64(_mm512_srli_epi64(regs[r], 59), Five);
+         auto const Word  = _mm512_mullo_epi64(_mm512_xor_si512(_mm512_srlv_epi64(regs[r], Shift), regs[r]), PM);
+         auto const Out   = _mm512_xor_si512(_mm512_srli_epi64(Word, 43), Word);
+
+         if constexpr (std::is_same_v<T, float64>)
+         { // real
+            _mm512_storeu_pd(out_ptr + (r * 8uz),
+               _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(Out, 12), Exp)), One));
+         }
+         else
+         { // integer
+            _mm512_storeu_si512(out_ptr + (r * 8uz), Out);
+         }
+
+         regs[r] = _mm512_add_epi64(_mm512_mullo_epi64(regs[r], M), P);
+      }
+   }
+
+   for (auto r = 0uz; r < NRegs; ++r)
+   { // store lanes
+      _mm512_storeu_si512(lanes_Ptr + (r * 8uz), regs[r]);
+   }
+}
+
+#endif // __x86_64__
+
+/** getFillKernel
+ *
+ * @brief Returns the widest kernel the CPU supports.
+ *
+ * @tparam T -- uint64 or float64.
+ *
+ * @returns FillKernel_T<T> -- Kernel.
+ */
+template <typename T>
+FillKernel_T<T> getFillKernel(void)
+{
+#if defined(__x86_64__)
+   if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq"))
+   { // eight lanes per register
+      return fill_avx512<T>;
+   }
+
+   if (__builtin_cpu_supports("avx2"))
+   { // four lanes per register
+      return fill_avx2<T>;
+   }
+#endif
+
+   return fill_scalar<T>;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** PhiloxKernel_T
+ *
+ * @brief Encrypts nBlocks consecutive counters, starting at block blockIdx, two values each.
+ *
+ * @tparam T -- uint64 or float64.
+ */
+template <typename T>
+using PhiloxKernel_T = void (*)(
+   ym::Philox::Key_T const Key,
+   ym::uint64              blockIdx,
+   T *                     out_ptr,
+   ym::sizet               nBlocks);
+
+/** philox_scalar
+ *
+ * @brief See PhiloxKernel_T. Portable version.
+ *
+ * @tparam T -- uint64 or float64.
+ */
+template <typename T>
+void philox_scalar(
+   ym::Philox::Key_T const Key,
+   ym::uint64              blockIdx,
+   T *                     out_ptr,
+   ym::sizet               nBlocks)
+{
+   using namespace ym;
+
+   for (; nBlocks > 0uz; --nBlocks, ++blockIdx, out_ptr += 2uz)
+   { // two values per block
+      auto const Block = Philox::encrypt(
+         {static_cast<uint32>(blockIdx), static_cast<uint32>(blockIdx >> 32_u64), 0_u32, 0_u32}, Key);
+
+      auto const Lo = (static_cast<uint64>(Block[1uz]) << 32_u64) | Block[0uz];
+      auto const Hi = (static_cast<uint64>(Block[3uz]) << 32_u64) | Block[2uz];
+
+      if constexpr (std::is_same_v<T, float64>)
+      { // real
+         out_ptr[0uz] = Prng::convertToFloat64(Lo);
+         out_ptr[1uz] = Prng::convertToFloat64(Hi);
+      }
+      else
+      { // integer
+         out_ptr[0uz] = Lo;
+         out_ptr[1uz] = Hi;
+      }
+   }
+}
+
+#if defined(__x86_64__)
+
+/** philox_avx2
+ *
+ * @brief See PhiloxKernel_T. One block per 64-bit lane (word in the low half), so the
+ *        32x32 -> 64 multiplies are native.
+ *
+ * @note Compiled for AVX2 regardless of build flags - only called if the CPU has it.
+ *
+ * @tparam T -- uint64 or float64.
+ */
+template <typename T>
+__attribute__((target("avx2")))
+void philox_avx2(
+   ym::Philox::Key_T const Key,
+   ym::uint64              blockIdx,
+   T *                     out_ptr,
+   ym::sizet               nBlocks)
+{
+   using namespace ym;
+
+   constexpr auto NRegs   = 4uz;
+   constexpr auto NPerRun = NRegs * 4uz; // blocks
+
+   auto const Mask = _mm256_set1_epi64x(0xffff'ffff_i64);
+   auto const M0   = _mm256_set1_epi64x(Philox::_s_Mult0);
+   auto const M1   = _mm256_set1_epi64x(Philox::_s_Mult1);
+
+   for (; nBlocks >= NPerRun; nBlocks -= NPerRun, blockIdx += NPerRun, out_ptr += 2uz * NPerRun)
+   { // independent blocks - hides the multiply latency
+      __m256i x0[NRegs], x1[NRegs], x2[NRegs], x3[NRegs]; // std::array would drop the vector type's alignment attribute
+      for (auto r = 0uz; r < NRegs; ++r)
+      { // counters
+         auto const First = static_cast<int64>(blockIdx + (r * 4uz));
+         auto const Idx   = _mm256_add_epi64(_mm256_set1_epi64x(First), _mm256_set_epi64x(3, 2, 1, 0));
+
+         x0[r] = _mm256_and_si256(Idx, Mask);
+         x1[r] = _mm256_srli_epi64(Idx, 32);
+         x2[r] = _mm256_setzero_si256();
+         x3[r] = _mm256_setzero_si256();
+      }
+
+      auto k0 = Key[0uz];
+      auto k1 = Key[1uz];
+      for (auto round = 0uz; round < Philox::_s_NRounds; ++round)
+      { // see Philox::encrypt()
+         auto const K0 = _mm256_set1_epi64x(k0);
+         auto const K1 = _mm256_set1_epi64x(k1);
+
+         for (auto r = 0uz; r < NRegs; ++r)
+         { // each register of blocks
+            auto const Prod0 = _mm256_mul_epu32(x0[r], M0);
+            auto const Prod1 = _mm256_mul_epu32(x2[r], M1);
+
+            x0[r] = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(Prod1, 32), x1[r]), K0);
+            x1[r] = _mm256_and_si256(Prod1, Mask);
+            x2[r] = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(Prod0, 32), x3[r]), K1);
+            x3[r] = _mm256_and_si256(Prod0, Mask);
+         }
+
+         k0 += Philox::_s_Weyl0;
+         k1 += Philox::_s_Weyl1;
+      }
+
+      for (auto r = 0uz; r < NRegs; ++r)
+      { // interleave - value 2b then 2b+1 for each block b
+         auto const Lo = _mm256_or_si256(x0[r], _mm256_slli_epi64(x1[r], 32));
+         auto const Hi = _mm256_or_si256(x2[r], _mm256_slli_epi64(x3[r], 32));
+         auto const A  = _mm256_unpacklo_epi64(Lo, Hi);
+         auto const B  = _mm256_unpackhi_epi64(Lo, Hi);
+         auto const V0 = _mm256_permute2x128_si256(A, B, 0x20);
+         auto const V1 = _mm256_permute2x128_si256(A, B, 0x31);
+
+         if constexpr (std::is_same_v<T, float64>)
+         { // real
+            _mm256_storeu_pd(out_ptr + (r * 8uz),        toFloat64_avx2(V0));
+            _mm256_storeu_pd(out_ptr + (r * 8uz) + 4uz, toFloat64_avx2(V1));
+         }
+         else
+         { // integer
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out_ptr + (r * 8uz)),        V0);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out_ptr + (r * 8uz) + 4uz), V1);
+         }
+      }
+   }
+
+   philox_scalar(Key, blockIdx, out_ptr, nBlocks);
+}
+
+/** philox_avx512
+ *
+ * @brief See PhiloxKernel_T. Eight blocks per register, same layout as philox_avx2().
+ *
+ * @note Compiled for AVX-512 regardless of build flags - only called if the CPU has it.
+ *
+ * @tparam T -- uint64 or float64.
+ */
+template <typename T>
+__attribute__((target("avx512f")))
+void philox_avx512(
+   ym::Philox::Key_T const Key,
+   ym::uint64              blockIdx,
+   T *                     out_ptr,
+   ym::sizet               nBlocks)
+{
+   using namespace ym;
+
+   constexpr auto NRegs   = 4uz;
+   constexpr auto NPerRun = NRegs * 8uz; // blocks
+
+   auto const Mask  = _mm512_set1_epi64(0xffff'ffff_i64);
+   auto const M0    = _mm512_set1_epi64(Philox::_s_Mult0);
+   auto const M1    = _mm512_set1_epi64(Philox::_s_Mult1);
+   auto const Exp   = _mm512_set1_epi64(static_cast<int64>(1023_u64 << 52_u64));
+   auto const One   = _mm512_set1_pd(1.0);
+   auto const Lanes = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+   auto const Perm0 = _mm512_set_epi64(11, 3, 10, 2, 9, 1, 8, 0);
+   auto const Perm1 = _mm512_set_epi64(15, 7, 14, 6, 13, 5, 12, 4);
+
+   for (; nBlocks >= NPerRun; nBlocks -= NPerRun, blockIdx += NPerRun, out_ptr += 2uz * NPerRun)
+   { // independent blocks - hides the multiply latency
+      __m512i x0[NRegs], x1[NRegs], x2[NRegs], x3[NRegs]; // std::array would drop the vector type's alignment attribute
+      for (auto r = 0uz; r < NRegs; ++r)
+      { // counters
+         auto const First = static_cast<int64>(blockIdx + (r * 8uz));
+         auto const Idx   = _mm512_add_epi64(_mm512_set1_epi64(First), Lanes);
+
+         x0[r] = _mm512_and_si512(Idx, Mask);
+         x1[r] = _mm512_srli_epi64(Idx, 32);
+         x2[r] = _mm512_setzero_si512();
+         x3[r] = _mm512_setzero_si512();
+      }
+
+      auto k0 = Key[0uz];
+      auto k1 = Key[1uz];
+      for (auto round = 0uz; round < Philox::_s_NRounds; ++round)
+      { // see Philox::encrypt()
+         auto const K0 = _mm512_set1_epi64(k0);
+         auto const K1 = _mm512_set1_epi64(k1);
+
+         for (auto r = 0uz; r < NRegs; ++r)
+         { // each register of blocks
+            auto const Prod0 = _mm512_mul_epu32(x0[r], M0);
+            auto const Prod1 = _mm512_mul_epu32(x2[r], M1);
+
+            x0[r] = _mm512_xor_si512(_mm512_xor_si512(_mm512_srli_epi64(Prod1, 32), x1[r]), K0);
+            x1[r] = _mm512_and_si512(Prod1, Mask);
+            x2[r] = _mm512_xor_si512(_mm512_xor_si512(_mm512_srli_epi64(Prod0, 32), x3[r]), K1);
+            x3[r] = _mm512_and_si512(Prod0, Mask);
+         }
+
+         k0 += Philox::_s_Weyl0;
+         k1 += Philox::_s_Weyl1;
+      }
+
+      for (auto r = 0uz; r < NRegs; ++r)
+      { // interleave - value 2b then 2b+1 for each block b
+         auto const Lo = _mm512_or_si512(x0[r], _mm512_slli_epi64(x1[r], 32));
+         auto const Hi = _mm512_or_si512(x2[r], _mm512_slli_epi64(x3[r], 32));
+         auto const V0 = _mm512_permutex2var_epi64(Lo, Perm0, Hi);
+         auto const V1 = _mm512_permutex2var_epi64(Lo, Perm1, Hi);
+
+         if constexpr (std::is_same_v<T, float64>)
+         { // real
+            _mm512_storeu_pd(out_ptr + (r * 16uz),
+               _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(V0, 12), Exp)), One));
+            _mm512_storeu_pd(out_ptr + (r * 16uz) + 8uz,
+               _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(V1, 12), Exp)), One));
+         }
+         else
+         { // integer
+            _mm512_storeu_si512(out_ptr + (r * 16uz),        V0);
+            _mm512_storeu_si512(out_ptr + (r * 16uz) + 8uz, V1);
+         }
+      }
+   }
+
+   philox_scalar(Key, blockIdx, out_ptr, nBlocks);
+}
+
+#endif // __x86_64__
+
+/** getPhiloxKernel
+ *
+ * @brief Returns the widest kernel the CPU supports.
+ *
+ * @tparam T -- uint64 or float64.
+ *
+ * @returns PhiloxKernel_T<T> -- Kernel.
+ */
+template <typename T>
+PhiloxKernel_T<T> getPhiloxKernel(void)
+{
+#if defined(__x86_64__)
+   if (__builtin_cpu_supports("avx512f"))
+   { // eight blocks per register
+      return philox_avx512<T>;
+   }
+
+   if (__builtin_cpu_supports("avx2"))
+   { // four blocks per register
+      return philox_avx2<T>;
+   }
+#endif
+
+   return philox_scalar<T>;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** readOsEntropy
+ *
+ * @brief Fills the range from the OS entropy pool.
+ *
+ * @note getrandom(2) blocks only until the pool is first initialized (early boot).
+ *       On x86 the kernel already mixes RDSEED/RDRAND into the pool.
+ *
+ * @param vals -- Range to fill.
+ *
+ * @returns bool -- True if filled, false if the OS has no such source.
+ */
+bool readOsEntropy(std::span<ym::uint64> vals)
+{
+#if defined(__linux__)
+   using namespace ym;
+
+   auto * bytes_Ptr = reinterpret_cast<std::byte *>(vals.data());
+   auto   nLeft     = vals.size_bytes();
+
+   while (nLeft > 0uz)
+   { // large requests may come back short
+      auto const NRead = getrandom(bytes_Ptr, nLeft, 0u);
+      if (NRead < 0)
+      { // interrupted or unsupported
+         if (errno == EINTR)
+         { // try again
+            continue;
+         }
+         return false;
+      }
+      bytes_Ptr += NRead;
+      nLeft     -= static_cast<sizet>(NRead);
+   }
+
+   return true;
+#else
+   (void)vals;
+   return false;
+#endif
+}
+
+#if defined(__x86_64__)
+
+/** readRdseed
+ *
+ * @brief Fills the range with RDSEED (conditioned output of the CPU's noise source).
+ *
+ * @note RDSEED fails transiently when drained - each value gets a few retries.
+ *
+ * @param vals -- Range to fill.
+ *
+ * @returns bool -- True if filled.
+ */
+__attribute__((target("rdseed")))
+bool readRdseed(std::span<ym::uint64> vals)
+{
+   for (auto & val : vals)
+   { // each value
+      auto word = 0ull;
+      auto nTries = 0;
+      while (_rdseed64_step(&word) == 0)
+      { // drained
+         if (++nTries == 100)
+         { // give up
+            return false;
+         }
+         _mm_pause();
+      }
+      val = word;
+   }
+
+   return true;
+}
+
+/** readRdrand
+ *
+ * @brief Fills the range with RDRAND (the CPU's DRBG, reseeded from its noise source).
+ *
+ * @param vals -- Range to fill.
+ *
+ * @returns bool -- True if filled.
+ */
+__attribute__((target("rdrnd")))
+bool readRdrand(std::span<ym::uint64> vals)
+{
+   for (auto & val : vals)
+   { // each value
+      auto word = 0ull;
+      auto nTries = 0;
+      while (_rdrand64_step(&word) == 0)
+      { // only fails if the hardware is broken
+         if (++nTries == 10)
+         { // give up
+            return false;
+         }
+      }
+      val = word;
+   }
+
+   return true;
+}
+
+#endif // __x86_64__
+
+/** readCpuEntropy
+ *
+ * @brief Fills the range from the CPU - RDSEED, else RDRAND.
+ *
+ * @param vals -- Range to fill.
+ *
+ * @returns bool -- True if filled, false if the CPU has no such source.
+ */
+bool readCpuEntropy(std::span<ym::uint64> vals)
+{
+#if defined(__x86_64__)
+   if (__builtin_cpu_supports("rdseed") && readRdseed(vals))
+   { // true entropy
+      return true;
+   }
+
+   if (__builtin_cpu_supports("rdrnd") && readRdrand(vals))
+   { // entropy stretched by a DRBG
+      return true;
+   }
+#endif
+
+   (void)vals;
+   return false;
+}
+
+} // anonymous
+
+/** Prng
+ *
+ * @brief Constructor.
+ */
+ym::Prng::Prng(void)
+   : Prng(0x763b'15c2'1847'ea8d_u64)
+{
+}
+
+/** Prng
+ *
+ * @brief Constructor.
+ *
+ * @param Seed -- Seed.
+ */
+ym::Prng::Prng(State_T const Seed)
+   : _seed  {Seed},
+     _state {Seed}
+{
+}
+
+/** setSeed
+ *
+ * @brief Sets the seed for the PRNG.
+ *
+ * @param Seed -- Seed.
+ */
+void ym::Prng::setSeed(State_T const Seed)
+{
+   _seed  = Seed;
+   _state = Seed;
+}
+
+/** fill
+ *
+ * @brief Fills the range with uniform positive integer values in the range [0..2^64).
+ *
+ * @note Same values (and resulting state) as calling gen<uint64>() vals.size() times.
+ *
+ * @param vals -- Range to fill.
+ */
+void ym::Prng::fill(std::span<uint64> vals)
+{
+   fillImpl(vals);
+}
+
+/** fill
+ *
+ * @brief Fills the range with uniform real values in the range [0..1).
+ *        Resolution is 2^52 (~4 quadrillion).
+ *
+ * @note Same values (and resulting state) as calling gen<float64>() vals.size() times.
+ *
+ * @param vals -- Range to fill.
+ */
+void ym::Prng::fill(std::span<float64> vals)
+{
+   fillImpl(vals);
+}
+
+/** fillImpl
+ *
+ * @brief See fill().
+ *
+ * @tparam T -- uint64 or float64.
+ *
+ * @param vals -- Range to fill.
+ */
+template <typename T>
+void ym::Prng::fillImpl(std::span<T> vals)
+{
+   static auto const s_Kernel_Ptr = getFillKernel<T>();
+
+   auto const NBlocks = vals.size() / _s_NLanes;
+
+   if (NBlocks > 0uz)
+   { // lane k starts k+1 steps ahead and leapfrogs the others
+      constexpr auto Step = getJumpLcg(_s_NLanes);
+
+      auto lanes = std::array<uint64, _s_NLanes>{};
+      for (auto & lane : lanes)
+      { // consecutive states
+         _state = (_state * _s_Mult) + _s_Plus;
+         lane   = _state;
+      }
+
+      s_Kernel_Ptr(lanes.data(), Step._mult, Step._plus, vals.data(), NBlocks);
+      jump((NBlocks - 1uz) * _s_NLanes); // to the state of the last value handed out
+   }
+
+   for (auto & val : vals.subspan(NBlocks * _s_NLanes))
+   { // leftovers
+      val = gen<T>();
+   }
+}
+
+/** jump
+ *
+ * @brief Advances the state by nJumps.
+ *
+ * @note O(log nJumps) - the LCG is composed with itself by repeated squaring.
+ *
+ * @note The period is 2^64, so jump(0_u64 - n) steps back n values.
+ *
+ * @ref <https://www.pcg-random.org/pdf/hmc-cs-2014-0905.pdf> (section 4.3.1)
+ *
+ * @param nJumps -- # of jumps to perform.
+ */
+void ym::Prng::jump(uint64 const nJumps)
+{
+   auto const Lcg = getJumpLcg(nJumps);
+   _state = (_state * Lcg._mult) + Lcg._plus;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** PrngStreamSet
+ *
+ * @brief Constructor.
+ *
+ * @throws Error -- If the stream length is 0.
+ *
+ * @param Seed         -- Seed every stream derives from.
+ * @param StreamLength -- Max # of values each stream may draw.
+ */
+ym::PrngStreamSet::PrngStreamSet(
+   Prng::State_T const Seed,
+   uint64        const StreamLength) :
+      _Seed         {Seed        },
+      _StreamLength {StreamLength}
+{
+   YMASSERT(_StreamLength > 0_u64, Error, YM_DAH, "Stream length must be > 0");
+}
+
+/** getStream
+ *
+ * @brief Returns a generator positioned at the start of the given stream.
+ *
+ * @note O(log n) in the distance jumped. Same index, same stream - on any thread.
+ *
+ * @throws Error -- If the index is past the last stream.
+ *
+ * @param Idx -- Index of stream.
+ *
+ * @returns Prng -- Generator for the stream.
+ */
+auto ym::PrngStreamSet::getStream(uint64 const Idx) const -> Prng
+{
+   YMASSERT(Idx < getMaxNStreams(), Error, YM_DAH,
+      "Stream {} out of range (only {} streams of {} values)", Idx, getMaxNStreams(), _StreamLength);
+
+   Prng prng(_Seed);
+   prng.jump(Idx * _StreamLength);
+   return prng;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** Philox
+ *
+ * @brief Constructor.
+ */
+ym::Philox::Philox(void)
+   : Philox(0x763b'15c2'1847'ea8d_u64)
+{
+}
+
+/** Philox
+ *
+ * @brief Constructor.
+ *
+ * @param Key -- Key (the seed).
+ */
+ym::Philox::Philox(uint64 const Key)
+   : _key   {static_cast<uint32>(Key), static_cast<uint32>(Key >> 32_u64)},
+     _pos   {0_u64},
+     _block {}
+{
+}
+
+/** setKey
+ *
+ * @brief Sets the key and rewinds to the start of its sequence.
+ *
+ * @param Key -- Key (the seed).
+ */
+void ym::Philox::setKey(uint64 const Key)
+{
+   _key = {static_cast<uint32>(Key), static_cast<uint32>(Key >> 32_u64)};
+   _pos = 0_u64;
+}
+
+/** setPosition
+ *
+ * @brief Moves to value Pos of the sequence. O(1).
+ *
+ * @param Pos -- Index of next value to generate.
+ */
+void ym::Philox::setPosition(uint64 const Pos)
+{
+   _pos = Pos;
+
+   if ((_pos & 1_u64) != 0_u64)
+   { // next value is the second half of a block
+      _block = encrypt(getCounter(_pos >> 1_u64), _key);
+   }
+}
+
+/** fill
+ *
+ * @brief Fills the range with uniform positive integer values in the range [0..2^64).
+ *
+ * @note Same values (and resulting state) as calling gen<uint64>() vals.size() times.
+ *
+ * @param vals -- Range to fill.
+ */
+void ym::Philox::fill(std::span<uint64> vals)
+{
+   fillImpl(vals);
+}
+
+/** fill
+ *
+ * @brief Fills the range with uniform real values in the range [0..1).
+ *        Resolution is 2^52 (~4 quadrillion).
+ *
+ * @note Same values (and resulting state) as calling gen<float64>() vals.size() times.
+ *
+ * @param vals -- Range to fill.
+ */
+void ym::Philox::fill(std::span<float64> vals)
+{
+   fillImpl(vals);
+}
+
+/** fillImpl
+ *
+ * @brief See fill().
+ *
+ * @tparam T -- uint64 or float64.
+ *
+ * @param vals -- Range to fill.
+ */
+template <typename T>
+void ym::Philox::fillImpl(std::span<T> vals)
+{
+   static auto const s_Kernel_Ptr = getPhiloxKernel<T>();
+
+   if (!vals.empty() && (_pos & 1_u64) != 0_u64)
+   { // finish the current block
+      vals.front() = gen<T>();
+      vals = vals.subspan(1uz);
+   }
+
+   auto const NBlocks = vals.size() / 2uz;
+
+   if (NBlocks > 0uz)
+   { // whole blocks
+      s_Kernel_Ptr(_key, _pos >> 1_u64, vals.data(), NBlocks);
+      _pos += 2uz * NBlocks;
+   }
+
+   for (auto & val : vals.subspan(2uz * NBlocks))
+   { // leftover
+      val = gen<T>();
+   }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** Trng
+ *
+ * @brief Constructor.
+ *
+ * @note Nothing is read until the first value is asked for.
+ */
+ym::Trng::Trng(void)
+   : _buffer {            },
+     _idx    {_buffer.size()},
+     _nForks {0_u64         }
+{
+#if defined(__unix__)
+   [[maybe_unused]] static auto const s_Registered = ::pthread_atfork(nullptr, nullptr, []() {
+      _s_nForks.fetch_add(1_u64, std::memory_order_relaxed);
+   });
+#endif
+}
+
+/** getThreadPrng
+ *
+ * @brief Returns a Prng private to the calling thread, seeded with true randomness.
+ *
+ * @note Seeded on first use in each thread, from one Trng shared by all threads.
+ *       Reseeded in a fork() child, so parent and child don't share a sequence.
+ *
+ * @returns Prng & -- Generator of calling thread.
+ */
+auto ym::Trng::getThreadPrng(void) -> Prng &
+{
+   static auto       s_mutex  = std::mutex();
+   static auto       s_trng   = Trng();
+   thread_local auto s_nForks = _s_nForks.load(std::memory_order_relaxed);
+   thread_local auto s_prng   = []() {
+      auto const Lock = std::scoped_lock(s_mutex);
+      return s_trng.makePrng();
+   }();
+
+#if defined(__unix__)
+   // a fork while another thread holds the mutex would leave it locked for good in the child
+   [[maybe_unused]] static auto const s_Registered = ::pthread_atfork(
+      []() { s_mutex.lock  (); },
+      []() { s_mutex.unlock(); },
+      []() { s_mutex.unlock(); });
+#endif
+
+   if (auto const NForks = _s_nForks.load(std::memory_order_relaxed); s_nForks != NForks)
+   { // copied into a fork() child
+      auto const Lock = std::scoped_lock(s_mutex);
+      s_prng   = s_trng.makePrng();
+      s_nForks = NForks;
+   }
+
+   return s_prng;
+}
+
+/** refill
+ *
+ * @brief Reads the next batch of entropy.
+ *
+ * @throws Error -- If there is no source of entropy.
+ */
+void ym::Trng::refill(void)
+{
+   _nForks = _s_nForks.load(std::memory_order_relaxed);
+
+   if (!readOsEntropy(_buffer))
+   { // fall back on the hardware
+      auto const Filled = readCpuEntropy(_buffer);
+      YMASSERT(Filled, Error, YM_DAH, "No source of entropy (getrandom, RDSEED or RDRAND) available");
+      ymLog(VG::Rng_Trng, "getrandom() unavailable - read entropy from the CPU");
+   }
+
+   _idx = 0uz;
+}
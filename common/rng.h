@@ -1,319 +1,688 @@
-// /**
-//  * @file    rng.h
-//  * @version 1.0.0
-//  * @author  Forrest Jablonski
-//  */
-
-// #pragma once
-
-// #include "ymdefs.h"
-
-// #include <array>
-// #include <limits>
-// #include <type_traits>
-// #include <x86intrin.h>
-
-// namespace ym
-// {
-
-// /** Randomable
-//  * 
-//  * @brief Supported types the PRNG is able to generate.
-//  * 
-//  * @tparam T -- Data type.
-//  */
-// template <typename T>
-// concept Randomable = std::is_same_v<T, uint32 > ||
-//                      std::is_same_v<T, uint64 > ||
-//                      std::is_same_v<T, float32> ||
-//                      std::is_same_v<T, float64>;
-
-// // -----------------------------------------------------------------------------
-// // -----------------------------------------------------------------------------
-
-// /** Prng
-//  * 
-//  * @brief A pseudo-random number generator.
-//  * 
-//  * @note Satisfies requirements of UniformRandomBitGenerator
-//  * 
-//  * @ref <https://en.cppreference.com/w/cpp/named_req/UniformRandomBitGenerator>
-//  * @ref <https://www.pcg-random.org/paper.html>
-//  * @ref <https://en.wikipedia.org/wiki/Linear-feedback_shift_register>.
-//  */
-// class Prng
-// {
-// public:
-//    friend class Trng;
-
-//    using result_type = uint64;
-//    using State_T     = uint64;
-
-//    explicit Prng(void);
-//    explicit Prng(State_T const Seed);
-
-//    void setSeed(State_T const Seed);
-
-//    inline auto getSeed (void) const { return _seed;  }
-//    inline auto getState(void) const { return _state; }
-
-//    template <Randomable Randomable_T>
-//    inline Randomable_T gen(void);
-
-//    void jump(uint64 nJumps);
-
-//    constexpr auto min(void) const { return std::numeric_limits<result_type>::min(); }
-//    constexpr auto max(void) const { return std::numeric_limits<result_type>::max(); }
-
-//    inline result_type operator () (void);
-
-// private:
-//    static inline float32 convertToFloat32(uint32 const Val);
-//    static inline float64 convertToFloat64(uint64 const Val);
-
-//    static constexpr auto _s_Mult = 6364136223846793005_u64;
-//    static constexpr auto _s_Plus = 1442695040888963407_u64;
-
-//    State_T _seed;
-//    State_T _state;
-// };
-
-// /** gen
-//  * 
-//  * @brief Generates uniform positive integer values in the range [0..2^64).
-//  * 
-//  * @note Changes internal state when called.
-//  *
-//  * @returns uint64 -- Random number in range.
-//  */
-// template <>
-// inline auto Prng::gen<uint64>(void) -> uint64
-// {
-//    // the lcg transform
-//    _state = (_state * _s_Mult) + _s_Plus;
-
-//    // the post-process transform
-//    auto const Word = ((_state >> ((_state >> 59_u64) + 5_u64)) ^ _state) * 12605985483714917081_u64;
-//    return (Word >> 43_u64) ^ Word;
-// }
-
-// /** gen
-//  * 
-//  * @brief Generates uniform positive integer values in the range [0..2^32).
-//  * 
-//  * @note Changes internal state when called.
-//  *
-//  * @returns uint32 -- Random number in range.
-//  */
-// template <>
-// inline auto Prng::gen<uint32>(void) -> uint32
-// {
-//    return static_cast<uint32>(gen<uint64>());
-// }
-
-// /** gen
-//  * 
-//  * @brief Generates uniform real values in the range [0..1).
-//  *        Resolution is 2^23 (~8 million).
-//  * 
-//  * @note Changes internal state when called.
-//  *
-//  * @returns float32 -- Random number in range.
-//  */
-// template <>
-// inline auto Prng::gen<float32>(void) -> float32
-// {
-//    return convertToFloat32(gen<uint32>());
-// }
-
-// /** gen
-//  * 
-//  * @brief Generates uniform real values in the range [0..1).
-//  *        Resolution is 2^52 (~4 quadrillion).
-//  * 
-//  * @note Changes internal state when called.
-//  *
-//  * @returns float64 -- Random number in range.
-//  */
-// template <>
-// inline auto Prng::gen<float64>(void) -> float64
-// {
-//    return convertToFloat64(gen<uint64>());
-// }
-
-// /** operator ()
-//  * 
-//  * @brief Generates uniform positive integer values in the range of result_type.
-//  * 
-//  * @note Changes internal state when called.
-//  *
-//  * @returns result_type -- Random number in range.
-//  */
-// inline auto Prng::operator () (void) -> result_type
-// {
-//    return gen<uint64>();
-// }
-
-// /** convertToFloat32
-//  * 
-//  * @brief Generates uniform real values in the range [0..1).
-//  *        Resolution is 2^23 (~8 million).
-//  * 
-//  * @param Val -- Value to convert.
-//  *
-//  * @returns float32 -- Random number in range.
-//  */
-// inline auto ym::Prng::convertToFloat32(uint32 const Val) -> float32
-// {
-//    union
-//    {
-//       uint32  u32;
-//       float32 f32;
-//    } uf{.u32 = Val};
-
-//    // sign bit  1
-//    // exp  bits 8
-//    // man  bits 23
-
-//    uf.u32  = uf.u32 >> (32_u32 - 23_u32); // move highest bits into mantissa
-//    uf.u32 |= 127_u32 << 23_u32; // bias exponent
-//    uf.f32 -= 1.0_f32;
-
-//    return uf.f32;
-// }
-
-// /** convertToFloat64
-//  * 
-//  * @brief Generates uniform real values in the range [0..1).
-//  *        Resolution is 2^52 (~4 quadrillion).
-//  * 
-//  * @param Val -- Value to convert.
-//  *
-//  * @returns float64 -- Random number in range.
-//  */
-// inline auto ym::Prng::convertToFloat64(uint64 const Val) -> float64
-// {
-//    union
-//    {
-//       uint64  u64;
-//       float64 f64;
-//    } uf{.u64 = Val};
-
-//    // sign bit  1
-//    // exp  bits 11
-//    // man  bits 52
-
-//    uf.u64  = uf.u64 >> (64_u64 - 52_u64); // move highest bits into mantissa
-//    uf.u64 |= 1023_u64 << 52_u64; // bias exponent
-//    uf.f64 -= 1.0_f64;
-
-//    return uf.f64;
-// }
-
-// // -----------------------------------------------------------------------------
-// // -----------------------------------------------------------------------------
-
-// /** Trng
-//  * 
-//  * @brief A true-random number generator.
-//  * 
-//  * @note Satisfies requirements of UniformRandomBitGenerator
-//  * 
-//  * @ref <https://en.cppreference.com/w/cpp/named_req/UniformRandomBitGenerator>
-//  */
-// class Trng
-// {
-// public:
-//    using result_type = uint64;
-
-//    explicit Trng(void);
-//    explicit Trng(Prng::State_T const Seed);
-
-//    inline auto const * getInternalPrngPtr(void) const { return &_prng; }
-
-//    template <Randomable Randomable_T>
-//    inline Randomable_T gen(void);
-
-//    constexpr auto min(void) const { return std::numeric_limits<result_type>::min(); }
-//    constexpr auto max(void) const { return std::numeric_limits<result_type>::max(); }
-
-//    inline result_type operator () (void);
-
-// private:
-//    Prng _prng;
-// };
-
-// /** gen
-//  * 
-//  * @brief Generates uniform positive integer values in the range [0..2^64).
-//  * 
-//  * @note Changes internal state when called.
-//  * 
-//  * @note __rdtsc() returns the cpu cycle count. @ref <https://learn.microsoft.com/en-us/cpp/intrinsics/rdtsc?view=msvc-170>
-//  *
-//  * @returns uint64 -- Random number in range.
-//  */
-// template <>
-// inline uint64 Trng::gen<uint64>(void)
-// {
-//    return _prng.gen<uint64>() ^ __rdtsc();
-// }
-
-// /** gen
-//  * 
-//  * @brief Generates uniform positive integer values in the range [0..2^32).
-//  * 
-//  * @note Changes internal state when called.
-//  *
-//  * @returns uint32 -- Random number in range.
-//  */
-// template <>
-// inline uint32 Trng::gen<uint32>(void)
-// {
-//    return static_cast<uint32>(gen<uint64>());
-// }
-
-// /** gen
-//  * 
-//  * @brief Generates uniform real values in the range [0..1).
-//  *        Resolution is 2^23 (~8 million).
-//  * 
-//  * @note Changes internal state when called.
-//  *
-//  * @returns float32 -- Random number in range.
-//  */
-// template <>
-// inline auto Trng::gen<float32>(void) -> float32
-// {
-//    return Prng::convertToFloat32(gen<uint32>());
-// }
-
-// /** gen
-//  * 
-//  * @brief Generates uniform real values in the range [0..1).
-//  *        Resolution is 2^52 (~4 quadrillion).
-//  * 
-//  * @note Changes internal state when called.
-//  *
-//  * @returns float64 -- Random number in range.
-//  */
-// template <>
-// inline auto Trng::gen<float64>(void) -> float64
-// {
-//    return Prng::convertToFloat64(gen<uint64>());
-// }
-
-// /** operator ()
-//  * 
-//  * @brief Generates uniform positive integer values in the range of result_type.
-//  * 
-//  * @note Changes internal state when called.
-//  *
-//  * @returns result_type -- Random number in range.
-//  */
-// inline auto Trng::operator () (void) -> result_type
-// {
-//    return gen<uint64>();
-// }
-
-// } // ym
+/**
+ * @file    rng.h
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#pragma once
+
+#include "ymglobals.h"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace ym
+{
+
+/** Randomable
+ *
+ * @brief Supported types the PRNG is able to generate.
+ *
+ * @tparam T -- Data type.
+ */
+template <typename T>
+concept Randomable = std::is_same_v<T, uint32 > ||
+                     std::is_same_v<T, uint64 > ||
+                     std::is_same_v<T, float32> ||
+                     std::is_same_v<T, float64>;
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** Prng
+ *
+ * @brief A pseudo-random number generator.
+ *
+ * @note Satisfies requirements of UniformRandomBitGenerator
+ *
+ * @note fill() generates in bulk. It runs _s_NLanes leapfrogged copies of the LCG side
+ *       by side (SIMD when the CPU has it), so it yields exactly the values repeated
+ *       calls to gen() would, only faster.
+ *
+ * @ref <https://en.cppreference.com/w/cpp/named_req/UniformRandomBitGenerator>
+ * @ref <https://www.pcg-random.org/paper.html>
+ * @ref <https://en.wikipedia.org/wiki/Linear-feedback_shift_register>.
+ */
+class Prng
+{
+public:
+   using result_type = uint64;
+   using State_T     = uint64;
+
+   explicit Prng(void);
+   explicit Prng(State_T const Seed);
+
+   void setSeed(State_T const Seed);
+
+   inline auto getSeed (void) const { return _seed;  }
+   inline auto getState(void) const { return _state; }
+
+   template <Randomable Randomable_T>
+   inline Randomable_T gen(void);
+
+   void fill(std::span<uint64 > vals);
+   void fill(std::span<float64> vals);
+
+   void jump(uint64 nJumps);
+
+   static constexpr auto min(void) { return std::numeric_limits<result_type>::min(); }
+   static constexpr auto max(void) { return std::numeric_limits<result_type>::max(); }
+
+   inline result_type operator () (void);
+
+   static constexpr result_type permute(State_T const State);
+
+   static constexpr float32 convertToFloat32(uint32 const Val);
+   static constexpr float64 convertToFloat64(uint64 const Val);
+
+   static constexpr auto _s_NLanes = 32uz; // multiple of 8 (one AVX-512 register)
+
+private:
+   /** Lcg_T
+    *
+    * @brief Affine map state -> (state * _mult) + _plus.
+    */
+   struct Lcg_T
+   {
+      State_T _mult;
+      State_T _plus;
+   };
+
+   static constexpr Lcg_T getJumpLcg(uint64 nJumps);
+
+   template <typename T>
+   void fillImpl(std::span<T> vals);
+
+   static constexpr auto _s_Mult = 6364136223846793005_u64;
+   static constexpr auto _s_Plus = 1442695040888963407_u64;
+
+   State_T _seed;
+   State_T _state;
+};
+
+/** gen
+ *
+ * @brief Generates uniform positive integer values in the range [0..2^64).
+ *
+ * @note Changes internal state when called.
+ *
+ * @returns uint64 -- Random number in range.
+ */
+template <>
+inline auto Prng::gen<uint64>(void) -> uint64
+{
+   // the lcg transform
+   _state = (_state * _s_Mult) + _s_Plus;
+
+   return permute(_state);
+}
+
+/** gen
+ *
+ * @brief Generates uniform positive integer values in the range [0..2^32).
+ *
+ * @note Changes internal state when called.
+ *
+ * @returns uint32 -- Random number in range.
+ */
+template <>
+inline auto Prng::gen<uint32>(void) -> uint32
+{
+   return static_cast<uint32>(gen<uint64>());
+}
+
+/** gen
+ *
+ * @brief Generates uniform real values in the range [0..1).
+ *        Resolution is 2^23 (~8 million).
+ *
+ * @note Changes internal state when called.
+ *
+ * @returns float32 -- Random number in range.
+ */
+template <>
+inline auto Prng::gen<float32>(void) -> float32
+{
+   return convertToFloat32(gen<uint32>());
+}
+
+/** gen
+ *
+ * @brief Generates uniform real values in the range [0..1).
+ *        Resolution is 2^52 (~4 quadrillion).
+ *
+ * @note Changes internal state when called.
+ *
+ * @returns float64 -- Random number in range.
+ */
+template <>
+inline auto Prng::gen<float64>(void) -> float64
+{
+   return convertToFloat64(gen<uint64>());
+}
+
+/** operator ()
+ *
+ * @brief Generates uniform positive integer values in the range of result_type.
+ *
+ * @note Changes internal state when called.
+ *
+ * @returns result_type -- Random number in range.
+ */
+inline auto Prng::operator () (void) -> result_type
+{
+   return gen<uint64>();
+}
+
+/** permute
+ *
+ * @brief The post-process transform (RXS M XS) - turns an LCG state into an output.
+ *
+ * @param State -- LCG state.
+ *
+ * @returns result_type -- Random number.
+ */
+constexpr auto Prng::permute(State_T const State) -> result_type
+{
+   auto const Word = ((State >> ((State >> 59_u64) + 5_u64)) ^ State) * 12605985483714917081_u64;
+   return (Word >> 43_u64) ^ Word;
+}
+
+/** convertToFloat32
+ *
+ * @brief Generates uniform real values in the range [0..1).
+ *        Resolution is 2^23 (~8 million).
+ *
+ * @param Val -- Value to convert.
+ *
+ * @returns float32 -- Random number in range.
+ */
+constexpr auto Prng::convertToFloat32(uint32 const Val) -> float32
+{
+   // sign bit  1
+   // exp  bits 8
+   // man  bits 23
+
+   auto bits = Val >> (32_u32 - 23_u32); // move highest bits into mantissa
+   bits |= 127_u32 << 23_u32; // bias exponent
+
+   return std::bit_cast<float32>(bits) - 1.0_f32;
+}
+
+/** convertToFloat64
+ *
+ * @brief Generates uniform real values in the range [0..1).
+ *        Resolution is 2^52 (~4 quadrillion).
+ *
+ * @param Val -- Value to convert.
+ *
+ * @returns float64 -- Random number in range.
+ */
+constexpr auto Prng::convertToFloat64(uint64 const Val) -> float64
+{
+   // sign bit  1
+   // exp  bits 11
+   // man  bits 52
+
+   auto bits = Val >> (64_u64 - 52_u64); // move highest bits into mantissa
+   bits |= 1023_u64 << 52_u64; // bias exponent
+
+   return std::bit_cast<float64>(bits) - 1.0_f64;
+}
+
+/** getJumpLcg
+ *
+ * @brief Composes the LCG with itself nJumps times.
+ *
+ * @param nJumps -- # of steps to combine.
+ *
+ * @returns Lcg_T -- Map that advances a state by nJumps steps.
+ */
+constexpr auto Prng::getJumpLcg(uint64 nJumps) -> Lcg_T
+{
+   auto acc_mult = 1_u64;
+   auto acc_plus = 0_u64;
+   auto cur_mult = _s_Mult;
+   auto cur_plus = _s_Plus;
+
+   while (nJumps > 0_u64)
+   { // square and multiply
+      if (nJumps & 1_u64)
+      { // this power is part of the jump
+         acc_mult *= cur_mult;
+         acc_plus = acc_plus * cur_mult + cur_plus;
+      }
+      cur_plus = (cur_mult + 1_u64) * cur_plus;
+      cur_mult *= cur_mult;
+      nJumps /= 2_u64;
+   }
+
+   return {acc_mult, acc_plus};
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** PrngStreamSet
+ *
+ * @brief Splits the sequence of one seed into non-overlapping substreams.
+ *
+ * @note Stream i starts i * getStreamLength() steps past the seed, so streams can't
+ *       overlap as long as none draws more than getStreamLength() values.
+ *
+ * @note Hand streams out per unit of work (eg chunk index), not per thread. Results
+ *       then don't depend on the number of threads or on how they get scheduled.
+ */
+class PrngStreamSet
+{
+public:
+   explicit PrngStreamSet(
+      Prng::State_T const Seed,
+      uint64        const StreamLength = _s_DefaultStreamLength);
+
+   YM_DECL_YMASSERT(Error)
+
+   inline auto getSeed        (void) const { return _Seed;         }
+   inline auto getStreamLength(void) const { return _StreamLength; }
+   inline auto getMaxNStreams (void) const { return Prng::max() / _StreamLength; }
+
+   Prng getStream(uint64 const Idx) const;
+
+   static constexpr auto _s_DefaultStreamLength = 1_u64 << 48_u64; // 65535 streams
+
+private:
+   Prng::State_T const _Seed;
+   uint64        const _StreamLength;
+};
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** Philox
+ *
+ * @brief A counter-based pseudo-random number generator (Philox4x32-10).
+ *
+ * @note Satisfies requirements of UniformRandomBitGenerator
+ *
+ * @note Value i of the sequence is a pure function of the key and i (see at()), so any
+ *       value can be computed on its own - no shared state between threads or SIMD lanes
+ *       and no jump computation. Block b (four 32-bit words) yields values 2b and 2b+1.
+ *
+ * @note Sequences match the Random123 reference for the same key and counter.
+ *
+ * @ref <https://www.thesalmons.org/john/random123/papers/random123sc11.pdf>
+ */
+class Philox
+{
+public:
+   using result_type = uint64;
+   using Block_T     = std::array<uint32, 4uz>;
+   using Key_T       = std::array<uint32, 2uz>;
+
+   explicit Philox(void);
+   explicit Philox(uint64 const Key);
+
+   void setKey(uint64 const Key);
+
+   inline auto getKey     (void) const { return (static_cast<uint64>(_key[1uz]) << 32_u64) | _key[0uz]; }
+   inline auto getPosition(void) const { return _pos; }
+
+   void setPosition(uint64 const Pos);
+
+   inline void jump(uint64 const nJumps) { setPosition(_pos + nJumps); }
+
+   template <Randomable Randomable_T>
+   inline Randomable_T gen(void);
+
+   void fill(std::span<uint64 > vals);
+   void fill(std::span<float64> vals);
+
+   inline result_type at(uint64 const Idx) const;
+
+   static constexpr auto min(void) { return std::numeric_limits<result_type>::min(); }
+   static constexpr auto max(void) { return std::numeric_limits<result_type>::max(); }
+
+   inline result_type operator () (void);
+
+   static constexpr Block_T encrypt(
+      Block_T       ctr,
+      Key_T   const Key);
+
+   static constexpr auto _s_NRounds = 10uz;
+   static constexpr auto _s_Mult0   = 0xd251'1f53_u32;
+   static constexpr auto _s_Mult1   = 0xcd9e'8d57_u32;
+   static constexpr auto _s_Weyl0   = 0x9e37'79b9_u32; // golden ratio
+   static constexpr auto _s_Weyl1   = 0xbb67'ae85_u32; // sqrt(3) - 1
+
+private:
+   static constexpr Block_T getCounter(uint64 const BlockIdx);
+
+   static constexpr uint64 combine(
+      uint32 const Lo,
+      uint32 const Hi);
+
+   template <typename T>
+   void fillImpl(std::span<T> vals);
+
+   Key_T   _key;
+   uint64  _pos;   // index of next value
+   Block_T _block; // block holding value _pos - 1 (valid when _pos is odd)
+};
+
+/** gen
+ *
+ * @brief Generates uniform positive integer values in the range [0..2^64).
+ *
+ * @note Changes internal state when called.
+ *
+ * @returns uint64 -- Random number in range.
+ */
+template <>
+inline auto Philox::gen<uint64>(void) -> uint64
+{
+   auto const Idx = _pos++;
+
+   if ((Idx & 1_u64) == 0_u64)
+   { // first half of a new block
+      _block = encrypt(getCounter(Idx >> 1_u64), _key);
+      return combine(_block[0uz], _block[1uz]);
+   }
+
+   return combine(_block[2uz], _block[3uz]);
+}
+
+/** gen
+ *
+ * @brief Generates uniform positive integer values in the range [0..2^32).
+ *
+ * @note Changes internal state when called.
+ *
+ * @returns uint32 -- Random number in range.
+ */
+template <>
+inline auto Philox::gen<uint32>(void) -> uint32
+{
+   return static_cast<uint32>(gen<uint64>());
+}
+
+/** gen
+ *
+ * @brief Generates uniform real values in the range [0..1).
+ *        Resolution is 2^23 (~8 million).
+ *
+ * @note Changes internal state when called.
+ *
+ * @returns float32 -- Random number in range.
+ */
+template <>
+inline auto Philox::gen<float32>(void) -> float32
+{
+   return Prng::convertToFloat32(gen<uint32>());
+}
+
+/** gen
+ *
+ * @brief Generates uniform real values in the range [0..1).
+ *        Resolution is 2^52 (~4 quadrillion).
+ *
+ * @note Changes internal state when called.
+ *
+ * @returns float64 -- Random number in range.
+ */
+template <>
+inline auto Philox::gen<float64>(void) -> float64
+{
+   return Prng::convertToFloat64(gen<uint64>());
+}
+
+/** at
+ *
+ * @brief Value Idx of the sequence - what gen<uint64>() returns at position Idx.
+ *
+ * @note Doesn't touch the state. Safe to call from any number of threads.
+ *
+ * @param Idx -- Position in sequence.
+ *
+ * @returns result_type -- Random number.
+ */
+inline auto Philox::at(uint64 const Idx) const -> result_type
+{
+   auto const Block = encrypt(getCounter(Idx >> 1_u64), _key);
+   auto const Half  = static_cast<sizet>(Idx & 1_u64) * 2uz;
+
+   return combine(Block[Half], Block[Half + 1uz]);
+}
+
+/** operator ()
+ *
+ * @brief Generates uniform positive integer values in the range of result_type.
+ *
+ * @note Changes internal state when called.
+ *
+ * @returns result_type -- Random number in range.
+ */
+inline auto Philox::operator () (void) -> result_type
+{
+   return gen<uint64>();
+}
+
+/** encrypt
+ *
+ * @brief The Philox4x32 bijection - scrambles a counter under a key.
+ *
+ * @param ctr -- Counter.
+ * @param Key -- Key.
+ *
+ * @returns Block_T -- Four random words.
+ */
+constexpr auto Philox::encrypt(
+   Block_T       ctr,
+   Key_T   const Key) -> Block_T
+{
+   auto k0 = Key[0uz];
+   auto k1 = Key[1uz];
+
+#if defined(__GNUC__)
+   #pragma GCC unroll 10 // rounds are a serial chain - unrolled they overlap with the next block
+#endif
+   for (auto r = 0uz; r < _s_NRounds; ++r)
+   { // S-box is a widening multiply, P-box a word swap
+      auto const Prod0 = static_cast<uint64>(_s_Mult0) * ctr[0uz];
+      auto const Prod1 = static_cast<uint64>(_s_Mult1) * ctr[2uz];
+
+      ctr = {
+         static_cast<uint32>(Prod1 >> 32_u64) ^ ctr[1uz] ^ k0,
+         static_cast<uint32>(Prod1),
+         static_cast<uint32>(Prod0 >> 32_u64) ^ ctr[3uz] ^ k1,
+         static_cast<uint32>(Prod0)
+      };
+
+      k0 += _s_Weyl0;
+      k1 += _s_Weyl1;
+   }
+
+   return ctr;
+}
+
+/** getCounter
+ *
+ * @brief Counter of block BlockIdx - the index in the low words, the high words zero.
+ *
+ * @param BlockIdx -- Index of block.
+ *
+ * @returns Block_T -- Counter.
+ */
+constexpr auto Philox::getCounter(uint64 const BlockIdx) -> Block_T
+{
+   return {static_cast<uint32>(BlockIdx), static_cast<uint32>(BlockIdx >> 32_u64), 0_u32, 0_u32};
+}
+
+/** combine
+ *
+ * @brief Joins two words into one value.
+ *
+ * @param Lo -- Low word.
+ * @param Hi -- High word.
+ *
+ * @returns uint64 -- Value.
+ */
+constexpr auto Philox::combine(
+   uint32 const Lo,
+   uint32 const Hi) -> uint64
+{
+   return (static_cast<uint64>(Hi) << 32_u64) | Lo;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** Trng
+ *
+ * @brief A true-random number generator.
+ *
+ * @note Satisfies requirements of UniformRandomBitGenerator
+ *
+ * @note Entropy is pulled in batches of _s_BufferSize values - from getrandom(2) where
+ *       the OS has it, else straight from the CPU (RDSEED, then RDRAND). Values are then
+ *       handed out of the buffer, so a call costs a buffer read.
+ *
+ * @note Not thread safe. Slow next to Prng even so (a syscall per batch) - best used to
+ *       seed Prngs, see makePrng() and getThreadPrng().
+ *
+ * @note Fork safe. A fork() child would otherwise inherit the buffered entropy (and the
+ *       thread Prng) and repeat what the parent hands out. A child handler bumps a fork
+ *       count, and a generator whose batch predates the fork throws it away.
+ *
+ * @ref <https://en.cppreference.com/w/cpp/named_req/UniformRandomBitGenerator>
+ * @ref <https://man7.org/linux/man-pages/man2/getrandom.2.html>
+ */
+class Trng
+{
+public:
+   using result_type = uint64;
+
+   explicit Trng(void);
+
+   YM_NO_COPY  (Trng) // copies would hand out the same values
+   YM_NO_ASSIGN(Trng)
+
+   YM_DECL_YMASSERT(Error)
+
+   template <Randomable Randomable_T>
+   inline Randomable_T gen(void);
+
+   inline Prng makePrng(void);
+
+   static Prng & getThreadPrng(void);
+
+   static constexpr auto min(void) { return std::numeric_limits<result_type>::min(); }
+   static constexpr auto max(void) { return std::numeric_limits<result_type>::max(); }
+
+   inline result_type operator () (void);
+
+   static constexpr auto _s_BufferSize = 512uz; // 4 KiB per batch
+
+private:
+   void refill(void);
+
+   static inline std::atomic<uint64> _s_nForks{0_u64}; // bumped in every fork() child
+
+   std::array<uint64, _s_BufferSize> _buffer;
+   sizet                             _idx;
+   uint64                            _nForks; // fork count when the batch was read
+};
+
+/** gen
+ *
+ * @brief Generates uniform positive integer values in the range [0..2^64).
+ *
+ * @note Changes internal state when called.
+ *
+ * @returns uint64 -- Random number in range.
+ */
+template <>
+inline uint64 Trng::gen<uint64>(void)
+{
+   if (_idx == _buffer.size() || _nForks != _s_nForks.load(std::memory_order_relaxed))
+   { // out of entropy (or it was read before a fork)
+      refill();
+   }
+
+   return _buffer[_idx++];
+}
+
+/** gen
+ *
+ * @brief Generates uniform positive integer values in the range [0..2^32).
+ *
+ * @note Changes internal state when called.
+ *
+ * @returns uint32 -- Random number in range.
+ */
+template <>
+inline uint32 Trng::gen<uint32>(void)
+{
+   return static_cast<uint32>(gen<uint64>());
+}
+
+/** gen
+ *
+ * @brief Generates uniform real values in the range [0..1).
+ *        Resolution is 2^23 (~8 million).
+ *
+ * @note Changes internal state when called.
+ *
+ * @returns float32 -- Random number in range.
+ */
+template <>
+inline auto Trng::gen<float32>(void) -> float32
+{
+   return Prng::convertToFloat32(gen<uint32>());
+}
+
+/** gen
+ *
+ * @brief Generates uniform real values in the range [0..1).
+ *        Resolution is 2^52 (~4 quadrillion).
+ *
+ * @note Changes internal state when called.
+ *
+ * @returns float64 -- Random number in range.
+ */
+template <>
+inline auto Trng::gen<float64>(void) -> float64
+{
+   return Prng::convertToFloat64(gen<uint64>());
+}
+
+/** makePrng
+ *
+ * @brief Returns a Prng seeded with true randomness.
+ *
+ * @note Changes internal state when called.
+ *
+ * @returns Prng -- Generator.
+ */
+inline auto Trng::makePrng(void) -> Prng
+{
+   return Prng(gen<uint64>());
+}
+
+/** operator ()
+ *
+ * @brief Generates uniform positive integer values in the range of result_type.
+ *
+ * @note Changes internal state when called.
+ *
+ * @returns result_type -- Random number in range.
+ */
+inline auto Trng::operator () (void) -> result_type
+{
+   return gen<uint64>();
+}
+
+} // ym
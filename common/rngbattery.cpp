@@ -0,0 +1,496 @@
+/**
+ * @file    rngbattery.cpp
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#include "rngbattery.h"
+
+#include "timer.h"
+
+#include "fmt/format.h"
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+namespace
+{
+
+/** regGammaQ
+ *
+ * @brief Regularized upper incomplete gamma function Q(a, x) = Γ(a, x) / Γ(a).
+ *
+ * @note Series for x < a + 1, continued fraction (modified Lentz) otherwise - each
+ *       converges quickly in its region.
+ *
+ * @ref Numerical Recipes, section 6.2.
+ *
+ * @param A -- Shape (> 0).
+ * @param X -- Point (>= 0).
+ *
+ * @returns float64 -- Q(a, x).
+ */
+ym::float64 regGammaQ(
+   ym::float64 const A,
+   ym::float64 const X)
+{
+   using namespace ym;
+
+   constexpr auto Eps     = 1e-15;
+   constexpr auto Tiny    = 1e-300;
+   constexpr auto MaxIter = 100'000uz;
+
+   if (X <= 0.0_f64)
+   { // all of the mass is above
+      return 1.0_f64;
+   }
+
+   auto const LogPrefix = (A * std::log(X)) - X - std::lgamma(A);
+
+   if (X < A + 1.0_f64)
+   { // series for P(a, x)
+      auto ap  = A;
+      auto del = 1.0_f64 / A;
+      auto sum = del;
+      for (auto i = 0uz; i < MaxIter && std::abs(del) > std::abs(sum) * Eps; ++i)
+      { // next term
+         ap  += 1.0_f64;
+         del *= X / ap;
+         sum += del;
+      }
+      return 1.0_f64 - (sum * std::exp(LogPrefix));
+   }
+
+   auto b = X + 1.0_f64 - A;
+   auto c = 1.0_f64 / Tiny;
+   auto d = 1.0_f64 / b;
+   auto h = d;
+   for (auto i = 1uz; i < MaxIter; ++i)
+   { // continued fraction for Q(a, x)
+      auto const An = -static_cast<float64>(i) * (static_cast<float64>(i) - A);
+      b += 2.0_f64;
+      d  = (An * d) + b;
+      d  = (std::abs(d) < Tiny) ? Tiny : d;
+      c  = b + (An / c);
+      c  = (std::abs(c) < Tiny) ? Tiny : c;
+      d  = 1.0_f64 / d;
+
+      auto const Del = d * c;
+      h *= Del;
+      if (std::abs(Del - 1.0_f64) < Eps)
+      { // converged
+         break;
+      }
+   }
+   return std::exp(LogPrefix) * h;
+}
+
+/** chiSquare
+ *
+ * @brief Pearson's statistic.
+ *
+ * @param Counts   -- Observed counts.
+ * @param Expected -- Expected counts.
+ *
+ * @returns float64 -- Sum of (observed - expected)^2 / expected.
+ */
+ym::float64 chiSquare(
+   std::span<ym::uint64  const> Counts,
+   std::span<ym::float64 const> Expected)
+{
+   using namespace ym;
+
+   auto chiSq = 0.0_f64;
+   for (auto i = 0uz; i < Counts.size(); ++i)
+   { // each cell
+      auto const Diff = static_cast<float64>(Counts[i]) - Expected[i];
+      chiSq += (Diff * Diff) / Expected[i];
+   }
+   return chiSq;
+}
+
+/** getRank
+ *
+ * @brief Rank over GF(2) of a 64x64 bit matrix.
+ *
+ * @param rows -- Rows of the matrix (destroyed).
+ *
+ * @returns ym::sizet -- Rank.
+ */
+ym::sizet getRank(std::span<ym::uint64, 64uz> rows)
+{
+   using namespace ym;
+
+   auto rank = 0uz;
+   for (auto bit = 0uz; bit < 64uz && rank < rows.size(); ++bit)
+   { // gaussian elimination, one column at a time
+      auto const Mask  = 1_u64 << bit;
+      auto const Pivot = std::ranges::find_if(rows.subspan(rank), [Mask](auto const Row) { return (Row & Mask) != 0_u64; });
+
+      if (Pivot == rows.subspan(rank).end())
+      { // column is dependent
+         continue;
+      }
+
+      std::swap(rows[rank], *Pivot);
+      for (auto r = rank + 1uz; r < rows.size(); ++r)
+      { // clear the column below the pivot
+         rows[r] ^= (rows[r] & Mask) ? rows[rank] : 0_u64;
+      }
+      ++rank;
+   }
+   return rank;
+}
+
+/** getRankProb
+ *
+ * @brief Probability that a random 64x64 bit matrix has the given rank.
+ *
+ * @ref NIST SP 800-22, section 3.5.
+ *
+ * @param Rank -- Rank.
+ *
+ * @returns ym::float64 -- Probability.
+ */
+ym::float64 getRankProb(ym::sizet const Rank)
+{
+   using namespace ym;
+
+   constexpr auto N = 64.0_f64;
+
+   auto const R = static_cast<float64>(Rank);
+
+   auto logProb = ((R * (N + N - R)) - (N * N)) * std::numbers::ln2;
+   for (auto i = 0uz; i < Rank; ++i)
+   { // product term
+      auto const I = static_cast<float64>(i);
+      logProb += 2.0_f64 * std::log1p(-std::exp2(I - N));
+      logProb -= std::log1p(-std::exp2(I - R));
+   }
+   return std::exp(logProb);
+}
+
+} // anonymous
+
+/** RngBattery
+ *
+ * @brief Constructor.
+ *
+ * @throws Error -- If too few values to keep the tests valid.
+ *
+ * @param NVals -- # of values each test draws.
+ */
+ym::RngBattery::RngBattery(uint64 const NVals) :
+   _NVals {NVals}
+{
+   YMASSERT(_NVals >= _s_MinNVals, Error, YM_DAH, "Need at least {} values per test, got {}", _s_MinNVals, _NVals);
+}
+
+/** run
+ *
+ * @brief Runs every test and the benchmark.
+ *
+ * @param Source -- Generator to test.
+ *
+ * @returns Report_T -- Results.
+ */
+auto ym::RngBattery::run(Source_T const & Source) const -> Report_T
+{
+   auto results = std::vector{
+      frequency       (Source),
+      serial          (Source),
+      gap             (Source),
+      birthdaySpacings(Source),
+      matrixRank      (Source)
+   };
+
+   return {std::move(results), measureThroughput(Source), _NVals};
+}
+
+/** frequency
+ *
+ * @brief Monobit test - the fraction of set bits should be 1/2.
+ *
+ * @param Source -- Generator to test.
+ *
+ * @returns Result_T -- Outcome (statistic is the z-score).
+ */
+auto ym::RngBattery::frequency(Source_T const & Source) const -> Result_T
+{
+   auto const Vals = draw(Source);
+
+   auto nOnes = 0_u64;
+   for (auto const Val : Vals)
+   { // count bits
+      nOnes += static_cast<uint64>(std::popcount(Val));
+   }
+
+   auto const NBits = static_cast<float64>(Vals.size() * 64uz);
+   auto const Z     = ((2.0_f64 * static_cast<float64>(nOnes)) - NBits) / std::sqrt(NBits);
+
+   return makeResult("Frequency", Z, std::erfc(std::abs(Z) / std::numbers::sqrt2));
+}
+
+/** serial
+ *
+ * @brief Serial test - pairs of consecutive values, top 6 bits each, should fill the
+ *        64x64 cells evenly.
+ *
+ * @param Source -- Generator to test.
+ *
+ * @returns Result_T -- Outcome (statistic is chi-square, 4095 dof).
+ */
+auto ym::RngBattery::serial(Source_T const & Source) const -> Result_T
+{
+   constexpr auto NBits  = 6_u64;
+   constexpr auto NCells = 1uz << (2_u64 * NBits);
+
+   auto const Vals = draw(Source);
+
+   auto counts = std::vector<uint64>(NCells, 0_u64);
+   for (auto i = 0uz; i + 1uz < Vals.size(); i += 2uz)
+   { // non-overlapping pairs
+      auto const Cell = ((Vals[i] >> (64_u64 - NBits)) << NBits) | (Vals[i + 1uz] >> (64_u64 - NBits));
+      counts[Cell] += 1_u64;
+   }
+
+   auto const Expected = std::vector<float64>(NCells, static_cast<float64>(Vals.size() / 2uz) / static_cast<float64>(NCells));
+   auto const ChiSq    = chiSquare(counts, Expected);
+
+   return makeResult("Serial", ChiSq, chiSquarePValue(ChiSq, static_cast<float64>(NCells - 1uz)));
+}
+
+/** gap
+ *
+ * @brief Gap test - runs of values between hits of [0..1/8) should be geometric.
+ *
+ * @param Source -- Generator to test.
+ *
+ * @returns Result_T -- Outcome (statistic is chi-square, 32 dof).
+ */
+auto ym::RngBattery::gap(Source_T const & Source) const -> Result_T
+{
+   constexpr auto MaxGap = 32uz;   // gaps this long or longer share a cell
+   constexpr auto P      = 0.125; // top 3 bits zero
+
+   auto const Vals = draw(Source);
+
+   auto counts  = std::array<uint64, MaxGap + 1uz>{};
+   auto nGaps   = 0_u64;
+   auto gapLen  = 0uz;
+   auto started = false;
+
+   for (auto const Val : Vals)
+   { // gaps between hits, starting from the first hit
+      if ((Val >> 61_u64) != 0_u64)
+      { // miss
+         ++gapLen;
+         continue;
+      }
+
+      if (started)
+      { // gap complete
+         counts[std::min(gapLen, MaxGap)] += 1_u64;
+         nGaps += 1_u64;
+      }
+      started = true;
+      gapLen  = 0uz;
+   }
+
+   auto expected = std::array<float64, MaxGap + 1uz>{};
+   for (auto r = 0uz; r < MaxGap; ++r)
+   { // geometric
+      expected[r] = static_cast<float64>(nGaps) * P * std::pow(1.0_f64 - P, static_cast<float64>(r));
+   }
+   expected[MaxGap] = static_cast<float64>(nGaps) * std::pow(1.0_f64 - P, static_cast<float64>(MaxGap));
+
+   auto const ChiSq = chiSquare(counts, expected);
+
+   return makeResult("Gap", ChiSq, chiSquarePValue(ChiSq, static_cast<float64>(MaxGap)));
+}
+
+/** birthdaySpacings
+ *
+ * @brief Birthday spacings test - 4096 birthdays in a year of 2^32 days (low 32 bits).
+ *        The number of repeated spacings between sorted birthdays is Poisson(4) per year.
+ *
+ * @note The statistic is the total over all years, Poisson(4 * years). The p-value is
+ *       P(X >= total).
+ *
+ * @param Source -- Generator to test.
+ *
+ * @returns Result_T -- Outcome (statistic is the total # of repeats).
+ */
+auto ym::RngBattery::birthdaySpacings(Source_T const & Source) const -> Result_T
+{
+   constexpr auto NBirthdays = 4'096uz;
+   constexpr auto Lambda     = 4.0; // m^3 / 4n
+
+   auto vals = draw(Source);
+
+   auto const NYears = vals.size() / NBirthdays;
+
+   auto nRepeats = 0_u64;
+   auto spacings = std::vector<uint64>(NBirthdays - 1uz);
+
+   for (auto y = 0uz; y < NYears; ++y)
+   { // each year
+      auto const Year = std::span(vals).subspan(y * NBirthdays, NBirthdays);
+
+      std::ranges::transform(Year, Year.begin(), [](auto const Val) { return Val & 0xffff'ffff_u64; });
+      std::ranges::sort(Year);
+      std::ranges::transform(Year.subspan(1uz), Year, spacings.begin(), std::minus{});
+      std::ranges::sort(spacings);
+
+      for (auto i = 1uz; i < spacings.size(); ++i)
+      { // repeats
+         nRepeats += (spacings[i] == spacings[i - 1uz]) ? 1_u64 : 0_u64;
+      }
+   }
+
+   auto const Mean   = Lambda * static_cast<float64>(NYears);
+   auto const PValue = (nRepeats == 0_u64) ? 1.0_f64 : 1.0_f64 - regGammaQ(static_cast<float64>(nRepeats), Mean);
+
+   return makeResult("BirthdaySpacings", static_cast<float64>(nRepeats), PValue);
+}
+
+/** matrixRank
+ *
+ * @brief Binary rank test - 64 consecutive values as the rows of a 64x64 matrix over
+ *        GF(2). Ranks 64, 63, 62 and <= 61 should show up with their known frequencies.
+ *
+ * @param Source -- Generator to test.
+ *
+ * @returns Result_T -- Outcome (statistic is chi-square, 3 dof).
+ */
+auto ym::RngBattery::matrixRank(Source_T const & Source) const -> Result_T
+{
+   auto vals = draw(Source);
+
+   auto const NMatrices = vals.size() / 64uz;
+
+   auto counts = std::array<uint64, 4uz>{}; // rank 64, 63, 62, <= 61
+   for (auto m = 0uz; m < NMatrices; ++m)
+   { // each matrix
+      auto const Rank = getRank(std::span(vals).subspan(m * 64uz).first<64uz>());
+      counts[std::min(64uz - Rank, 3uz)] += 1_u64;
+   }
+
+   auto expected = std::array<float64, 4uz>{};
+   for (auto i = 0uz; i < 3uz; ++i)
+   { // exact ranks
+      expected[i] = static_cast<float64>(NMatrices) * getRankProb(64uz - i);
+   }
+   expected[3uz] = static_cast<float64>(NMatrices) - (expected[0uz] + expected[1uz] + expected[2uz]);
+
+   auto const ChiSq = chiSquare(counts, expected);
+
+   return makeResult("MatrixRank", ChiSq, chiSquarePValue(ChiSq, 3.0_f64));
+}
+
+/** measureThroughput
+ *
+ * @brief Times bulk generation.
+ *
+ * @param Source -- Generator to time.
+ *
+ * @returns float64 -- Nanoseconds per value.
+ */
+auto ym::RngBattery::measureThroughput(Source_T const & Source) const -> float64
+{
+   constexpr auto NBatch = 4'096uz; // stays in cache
+
+   auto       vals     = std::vector<uint64>(NBatch);
+   auto const NBatches = std::max<uint64>(_NVals / NBatch, 1_u64);
+
+   Source(vals); // warm up
+
+   Timer timer;
+   for (auto b = 0_u64; b < NBatches; ++b)
+   { // bulk
+      Source(vals);
+   }
+
+   return static_cast<float64>(timer.getElapsedTime().count()) / static_cast<float64>(NBatches * NBatch);
+}
+
+/** formatReport
+ *
+ * @brief Formats a report as a table.
+ *
+ * @param Name   -- Name of generator.
+ * @param Report -- Results.
+ *
+ * @returns std::string -- Table.
+ */
+auto ym::RngBattery::formatReport(
+   strlit   const   Name,
+   Report_T const & Report) -> std::string
+{
+   auto report = fmt::format("{} - {} values per test\n", Name, Report._nVals);
+   report += fmt::format("   {:<18} {:>14} {:>12}  {}\n", "Test", "Statistic", "p-value", "Result");
+
+   for (auto const & Result : Report._results)
+   { // each test
+      report += fmt::format("   {:<18} {:>14.3f} {:>12.6f}  {}\n",
+         Result._name, Result._stat, Result._pValue, Result._passed ? "pass" : "FAIL");
+   }
+
+   report += fmt::format("   Throughput {:.3f} ns/val ({:.2f} GB/s)\n",
+      Report._throughput_ns, 8.0_f64 / Report._throughput_ns);
+   report += fmt::format("   {}\n", Report.passed() ? "PASSED" : "FAILED");
+
+   return report;
+}
+
+/** chiSquarePValue
+ *
+ * @brief Upper tail probability of the chi-square distribution.
+ *
+ * @param ChiSq -- Statistic.
+ * @param NDof  -- Degrees of freedom.
+ *
+ * @returns float64 -- P(X >= ChiSq).
+ */
+auto ym::RngBattery::chiSquarePValue(
+   float64 const ChiSq,
+   float64 const NDof) -> float64
+{
+   return regGammaQ(NDof / 2.0_f64, ChiSq / 2.0_f64);
+}
+
+/** makeResult
+ *
+ * @brief Judges a p-value - fails if too close to either end.
+ *
+ * @param Name   -- Name of test.
+ * @param Stat   -- Statistic.
+ * @param PValue -- p-value.
+ *
+ * @returns Result_T -- Outcome.
+ */
+auto ym::RngBattery::makeResult(
+   strlit  const Name,
+   float64 const Stat,
+   float64 const PValue) const -> Result_T
+{
+   return {Name, Stat, PValue, PValue >= _s_Alpha && PValue <= 1.0_f64 - _s_Alpha};
+}
+
+/** draw
+ *
+ * @brief Draws a fresh batch of values for a test.
+ *
+ * @param Source -- Generator to draw from.
+ *
+ * @returns std::vector<uint64> -- getNVals() values.
+ */
+auto ym::RngBattery::draw(Source_T const & Source) const -> std::vector<uint64>
+{
+   auto vals = std::vector<uint64>(_NVals);
+   Source(vals);
+   return vals;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file    rngbattery.h
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#pragma once
+
+#include "ymglobals.h"
+
+#include <algorithm>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ym
+{
+
+/** RngBattery
+ *
+ * @brief Battery of statistical tests (and a throughput benchmark) for 64-bit generators.
+ *
+ * @note Classic empirical tests, each probing a different weakness:
+ *          frequency         -- bias in the bits
+ *          serial            -- correlation between consecutive values (top bits)
+ *          gap               -- clustering in time of values landing in a subinterval
+ *          birthday spacings -- lattice structure (low bits, where LCGs are weakest)
+ *          matrix rank       -- linearity over GF(2) (xorshift, LFSRs and the like)
+ *
+ * @note Every test yields a p-value, uniform on [0..1] for a perfect generator. Values
+ *       too close to 0 (bad fit) or to 1 (too good a fit) fail. With _s_Alpha at 1e-6 a
+ *       good generator fails by chance about once per 100k tests.
+ *
+ * @note Each test draws getNVals() fresh values from the source.
+ *
+ * @ref Knuth, The Art of Computer Programming Vol 2, section 3.3.2.
+ * @ref <https://csrc.nist.gov/pubs/sp/800/22/r1/upd1/final> (matrix rank).
+ * @ref <https://simul.iro.umontreal.ca/testu01/tu01.html>
+ */
+class RngBattery
+{
+public:
+   /// @brief Fills the range with the raw 64-bit output of a generator.
+   using Source_T = std::function<void(std::span<uint64>)>;
+
+   /** Result_T
+    *
+    * @brief Outcome of one test.
+    */
+   struct Result_T
+   {
+      strlit  _name;
+      float64 _stat;   // test statistic (chi-square, z, or count)
+      float64 _pValue;
+      bool    _passed;
+   };
+
+   /** Report_T
+    *
+    * @brief Outcome of the whole battery.
+    */
+   struct Report_T
+   {
+      std::vector<Result_T> _results;
+      float64               _throughput_ns; // per value, bulk
+      uint64                _nVals;         // per test
+
+      inline bool passed(void) const { return std::ranges::all_of(_results, &Result_T::_passed); }
+   };
+
+   explicit RngBattery(uint64 const NVals = _s_DefaultNVals);
+
+   YM_DECL_YMASSERT(Error)
+
+   inline auto getNVals(void) const { return _NVals; }
+
+   Report_T run(Source_T const & Source) const;
+
+   template <typename Gen_T>
+   inline Report_T run(Gen_T & gen) const;
+
+   template <typename Gen_T>
+   static inline Source_T makeSource(Gen_T & gen);
+
+   Result_T frequency       (Source_T const & Source) const;
+   Result_T serial          (Source_T const & Source) const;
+   Result_T gap             (Source_T const & Source) const;
+   Result_T birthdaySpacings(Source_T const & Source) const;
+   Result_T matrixRank      (Source_T const & Source) const;
+
+   float64 measureThroughput(Source_T const & Source) const;
+
+   static std::string formatReport(
+      strlit   const   Name,
+      Report_T const & Report);
+
+   static float64 chiSquarePValue(
+      float64 const ChiSq,
+      float64 const NDof);
+
+   static constexpr auto _s_DefaultNVals = 1_u64 << 22_u64; // 32 MiB per test
+   static constexpr auto _s_MinNVals     = 1_u64 << 17_u64; // keeps expected cell counts >= 5
+   static constexpr auto _s_Alpha        = 1e-6;
+
+private:
+   Result_T makeResult(
+      strlit  const Name,
+      float64 const Stat,
+      float64 const PValue) const;
+
+   std::vector<uint64> draw(Source_T const & Source) const;
+
+   uint64 const _NVals;
+};
+
+/** run
+ *
+ * @brief Runs every test and the benchmark on a generator.
+ *
+ * @tparam Gen_T -- Generator (see makeSource()).
+ *
+ * @param gen -- Generator to test.
+ *
+ * @returns Report_T -- Results.
+ */
+template <typename Gen_T>
+inline auto RngBattery::run(Gen_T & gen) const -> Report_T
+{
+   return run(makeSource(gen));
+}
+
+/** makeSource
+ *
+ * @brief Wraps a generator as a source - through its bulk fill() if it has one.
+ *
+ * @tparam Gen_T -- Generator with fill(span<uint64>), or a UniformRandomBitGenerator
+ *                  over the whole uint64 range.
+ *
+ * @param gen -- Generator (must outlive the source).
+ *
+ * @returns Source_T -- Source.
+ */
+template <typename Gen_T>
+inline auto RngBattery::makeSource(Gen_T & gen) -> Source_T
+{
+   return [&gen](std::span<uint64> vals) {
+      if constexpr (requires { gen.fill(vals); })
+      { // bulk
+         gen.fill(vals);
+      }
+      else
+      { // one at a time
+         std::ranges::generate(vals, [&gen]() { return static_cast<uint64>(gen()); });
+      }
+   };
+}
+
+} // ym
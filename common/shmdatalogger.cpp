@@ -0,0 +1,303 @@
+/**
+ * @file    shmdatalogger.cpp
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#include "shmdatalogger.h"
+
+#include "textlogger.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/** ShmResource
+ *
+ * @brief Constructor.
+ *
+ * @note Nothing is mapped until the first allocation.
+ *
+ * @param SegmentName -- Name of shared memory segment (eg "/ym_blackbox").
+ */
+ym::ShmResource::ShmResource(str const SegmentName) :
+   _SegmentName {SegmentName}
+{ }
+
+/** do_allocate
+ *
+ * @brief Creates and maps the shared memory segment.
+ *
+ * @note The segment is sized to hold the reserved region plus the requested block.
+ *
+ * @note The segment is always created fresh. One of the same name is unlinked first, never
+ *       truncated - processes that still map it keep reading the old one undisturbed.
+ *
+ * @throws MapError -- If a block is already handed out.
+ * @throws MapError -- If the segment cannot be created or mapped.
+ *
+ * @param Size_bytes -- Size of block.
+ * @param Alignment  -- Alignment of block.
+ *
+ * @returns void * -- Block (just past the reserved region).
+ */
+void * ym::ShmResource::do_allocate(
+   sizet const Size_bytes,
+   sizet const Alignment)
+{
+   YMASSERT(!_base_ptr, MapError, YM_DAH,
+      "Segment '{}' can only hand out one block", _SegmentName)
+
+   YMASSERT(_reserved_bytes % Alignment == 0uz, MapError, YM_DAH,
+      "Reserved region ({} bytes) breaks alignment of {}", _reserved_bytes, Alignment)
+
+   auto const Total_bytes = _reserved_bytes + Size_bytes;
+
+   // never truncate a segment someone may have mapped - they would get SIGBUS
+   auto FD = ::shm_open(_SegmentName.get(), O_CREAT | O_EXCL | O_RDWR, 0644);
+
+   if (FD < 0 && errno == EEXIST)
+   { // left behind by a dead writer (or in use) - existing mappings keep the old segment
+      ymLog(VG::Warning, "Segment '{}' already exists - replacing it", _SegmentName);
+      (void)::shm_unlink(_SegmentName.get());
+      FD = ::shm_open(_SegmentName.get(), O_CREAT | O_EXCL | O_RDWR, 0644);
+   }
+
+   YMASSERT(FD >= 0, MapError, YM_DAH,
+      "Could not create segment '{}' (errno {})", _SegmentName, errno)
+
+   auto const Truncated = ::ftruncate(FD, static_cast<off_t>(Total_bytes)) == 0;
+   auto * const map_Ptr = Truncated ?
+      ::mmap(nullptr, Total_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, FD, 0) : MAP_FAILED;
+   auto const Errno = errno;
+
+   (void)::close(FD); // mapping keeps the segment alive
+
+   if (map_Ptr == MAP_FAILED)
+   { // don't leave a dangling segment behind
+      (void)::shm_unlink(_SegmentName.get());
+   }
+
+   YMASSERT(map_Ptr != MAP_FAILED, MapError, YM_DAH,
+      "Could not size or map segment '{}' (errno {})", _SegmentName, Errno)
+
+   _base_ptr     = static_cast<byte *>(map_Ptr);
+   _mapped_bytes = Total_bytes;
+
+   return _base_ptr + _reserved_bytes;
+}
+
+/** do_deallocate
+ *
+ * @brief Unmaps and unlinks the shared memory segment.
+ *
+ * @param ptr        -- Block handed out by do_allocate().
+ * @param Size_bytes -- Size of block.
+ * @param Alignment  -- Alignment of block.
+ */
+void ym::ShmResource::do_deallocate(
+   void *           const ptr,
+   [[maybe_unused]] sizet const Size_bytes,
+   [[maybe_unused]] sizet const Alignment)
+{
+   if (_base_ptr && ptr == _base_ptr + _reserved_bytes)
+   { // our block
+      (void)::munmap(_base_ptr, _mapped_bytes);
+      (void)::shm_unlink(_SegmentName.get());
+      _base_ptr     = nullptr;
+      _mapped_bytes = 0uz;
+   }
+}
+
+/** do_is_equal
+ *
+ * @brief Resources are only interchangeable with themselves.
+ *
+ * @param Other -- Resource to compare against.
+ *
+ * @returns bool -- True if the same resource, false otherwise.
+ */
+bool ym::ShmResource::do_is_equal(std::pmr::memory_resource const & Other) const noexcept
+{
+   return this == &Other;
+}
+
+// ----------------------------------------------------------------------------
+
+/** ShmDataLogger
+ *
+ * @brief Constructor. See ready().
+ *
+ * @note ShmResource is a base so it outlives the blackbox buffer.
+ *
+ * @param SegmentName      -- Name of shared memory segment (eg "/ym_blackbox").
+ * @param MaxDepth         -- Max number of entries to store per tracked variable.
+ * @param NTrackedValsHint -- Expected number of tracked variables.
+ */
+ym::ShmDataLogger::ShmDataLogger(
+   str   const SegmentName,
+   sizet const MaxDepth,
+   sizet const NTrackedValsHint) :
+      ShmResource (SegmentName),
+      _dataLogger (MaxDepth, NTrackedValsHint, static_cast<ShmResource *>(this))
+{ }
+
+/** ready
+ *
+ * @brief Initializes the data logger and publishes the layout to the shared memory segment.
+ *
+ * @throws Error -- If no variables are tracked.
+ * @throws Whatever DataLogger::ready() throws.
+ *
+ * @returns bool -- If the data logger is ready.
+ */
+bool ym::ShmDataLogger::ready(void)
+{
+   auto const & TrackedVals = _dataLogger._trackedVals;
+
+   YMASSERT(!TrackedVals.empty(), Error, YM_DAH,
+      "Shared memory data logger '{}' has nothing to track", getSegmentName())
+
+   auto const RoundUp = [](sizet const N) { return (N + 63uz) & ~63uz; };
+
+   auto const BufferOffset_bytes = RoundUp(
+      sizeof(ShmDataHeader_T) + (TrackedVals.size() * sizeof(ShmDataColumn_T)));
+
+   setReserved_bytes(BufferOffset_bytes);
+
+   (void)_dataLogger.ready(); // maps the segment (only the first time)
+
+   auto * const header_Ptr = getHeaderPtr();
+
+   if (header_Ptr->_magic.load(std::memory_order_relaxed) != ShmDataHeader_T::_s_Magic)
+   { // freshly mapped (zero filled) segment - publish the layout
+
+      ::new (header_Ptr) ShmDataHeader_T{};
+      header_Ptr->_version            = ShmDataHeader_T::_s_Version;
+      header_Ptr->_nColumns           = static_cast<uint32>(TrackedVals.size());
+      header_Ptr->_maxDepth           = getMaxDepth();
+      header_Ptr->_rowSize_bytes      = _dataLogger._blackBoxBuffer.size() / getMaxDepth();
+      header_Ptr->_bufferOffset_bytes = BufferOffset_bytes;
+
+      auto * const cols_Ptr = ymCastPtrTo<ShmDataColumn_T>(header_Ptr + 1);
+      auto         offset   = 0uz;
+
+      for (auto i = 0uz; i < TrackedVals.size(); ++i)
+      { // describe each column
+         auto const & TV = TrackedVals[i];
+
+         auto * const col_Ptr = ::new (cols_Ptr + i) ShmDataColumn_T{};
+         auto   const Name    = TV->getName();
+         auto   const NameLen = std::min(std::strlen(Name.get()), ShmDataColumn_T::_s_MaxNameSize_bytes - 1uz);
+
+         std::memcpy(col_Ptr->_name, Name.get(), NameLen);
+         col_Ptr->_offset_bytes = offset;
+         col_Ptr->_size_bytes   = static_cast<uint32>(TV->_Size_bytes);
+         col_Ptr->_type         = TV->getDataType();
+
+         offset += TV->_Size_bytes;
+      }
+
+      header_Ptr->_magic.store(ShmDataHeader_T::_s_Magic, std::memory_order_release); // publish
+   }
+
+   return isInitialized();
+}
+
+/** acquire
+ *
+ * @brief Reads all registered variables and publishes them as the latest row.
+ *
+ * @note Writer side of the seqlock - two stores to a line readers only ever read.
+ *
+ * @throws Whatever ready() throws.
+ */
+void ym::ShmDataLogger::acquire(void)
+{
+   if (!isInitialized())
+   { // get the logger ready
+      (void)ready();
+   }
+
+   auto * const header_Ptr = getHeaderPtr();
+   auto   const Seq        = header_Ptr->_seq.load(std::memory_order_relaxed);
+
+   header_Ptr->_seq.store(Seq + 1_u64, std::memory_order_relaxed);
+   std::atomic_thread_fence(std::memory_order_release);
+
+   _dataLogger.acquire();
+
+   // release - a reader may have passed an even seq before this row started, so seeing the
+   // new count must also mean seeing the whole row (the reader loads the count with acquire)
+   header_Ptr->_rowsWritten.store(
+      header_Ptr->_rowsWritten.load(std::memory_order_relaxed) + 1_u64,
+      std::memory_order_release);
+   header_Ptr->_seq.store(Seq + 2_u64, std::memory_order_release);
+}
+
+/** reset
+ *
+ * @brief Resets black box buffer.
+ *
+ * @note Readers observe the reset through the epoch counter.
+ */
+void ym::ShmDataLogger::reset(void)
+{
+   if (getBasePtr())
+   { // segment exists - let readers know
+      auto * const header_Ptr = getHeaderPtr();
+      auto   const Seq        = header_Ptr->_seq.load(std::memory_order_relaxed);
+
+      header_Ptr->_seq.store(Seq + 1_u64, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+
+      _dataLogger.reset();
+
+      header_Ptr->_rowsWritten.store(0_u64, std::memory_order_relaxed);
+      header_Ptr->_epoch.fetch_add(1_u64, std::memory_order_relaxed);
+      header_Ptr->_seq.store(Seq + 2_u64, std::memory_order_release);
+   }
+   else
+   { // nothing published yet
+      _dataLogger.reset();
+   }
+}
+
+/** armCrashDump
+ *
+ * @brief Registers the blackbox to be dumped if the program dies (see DataLogger::armCrashDump()).
+ *
+ * @note Readies the logger first, so the segment is laid out before it is mapped.
+ *
+ * @throws Whatever ready() throws.
+ * @throws Whatever DataLogger::armCrashDump() throws.
+ *
+ * @param Filename -- Name of file to dump data to.
+ *
+ * @returns bool -- If the logger is armed.
+ */
+bool ym::ShmDataLogger::armCrashDump(str const Filename)
+{
+   if (!isInitialized())
+   { // before the wrapped logger readies (and maps) the buffer itself
+      (void)ready();
+   }
+
+   return _dataLogger.armCrashDump(Filename);
+}
+
+/** getHeaderPtr
+ *
+ * @brief Returns the header at the start of the segment.
+ *
+ * @returns ShmDataHeader_T * -- Header.
+ */
+auto ym::ShmDataLogger::getHeaderPtr(void) const -> ShmDataHeader_T *
+{
+   return std::launder(ymCastPtrTo<ShmDataHeader_T>(getBasePtr()));
+}
@@ -0,0 +1,181 @@
+/**
+ * @file    shmdatalogger.h
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#pragma once
+
+#include "ymglobals.h"
+
+#include "datalogger.h"
+
+#include <atomic>
+#include <memory_resource>
+
+namespace ym
+{
+
+/** ShmDataHeader_T
+ *
+ * @brief Layout of the start of a shared memory blackbox segment.
+ *
+ * @note Segment layout:
+ *       -------------------------------------------------------
+ *       | header | column 0 .. column N-1 | pad | row 0 .. row D-1 |
+ *       -------------------------------------------------------
+ *
+ * @note The writer publishes rows with a seqlock. _seq is odd while a row (or a reset) is
+ *       being written and even otherwise. _rowsWritten is bumped (release) after a row is
+ *       complete. _epoch is bumped on every reset so readers can tell a restarted row count
+ *       from a continuing one.
+ */
+struct ShmDataHeader_T
+{
+   static constexpr auto _s_Magic   = 0x314c'444d'4853'4d59_u64; // "YMSHMDL1"
+   static constexpr auto _s_Version = 1_u32;
+
+   static_assert(std::atomic<uint64>::is_always_lock_free, "Atomics must be address free to be shared");
+
+   std::atomic<uint64> _magic              {0_u64}; // written last
+   uint32              _version            {0_u32};
+   uint32              _nColumns           {0_u32};
+   uint64              _maxDepth           {0_u64};
+   uint64              _rowSize_bytes      {0_u64};
+   uint64              _bufferOffset_bytes {0_u64}; // from start of segment
+
+   alignas(64)
+   std::atomic<uint64> _seq        {0_u64};
+   std::atomic<uint64> _epoch      {0_u64};
+   std::atomic<uint64> _rowsWritten{0_u64}; // since last reset
+};
+
+/** ShmDataColumn_T
+ *
+ * @brief Meta data of a tracked variable in a shared memory blackbox segment.
+ */
+struct ShmDataColumn_T
+{
+   static constexpr auto _s_MaxNameSize_bytes = 48uz;
+
+   char                   _name[_s_MaxNameSize_bytes]{'\0'}; // always null terminated
+   uint64                 _offset_bytes{0_u64};              // within a row
+   uint32                 _size_bytes  {0_u32};
+   DataLogger::DataType_T _type        {DataLogger::DataType_T::Other};
+};
+
+/** ShmResource
+ *
+ * @brief Memory resource that hands out one block backed by a named shared memory segment.
+ *
+ * @note A region in front of the block can be reserved for meta data (see setReserved_bytes()).
+ *
+ * @note The segment is unlinked when the block is deallocated.
+ */
+class ShmResource : public std::pmr::memory_resource
+{
+public:
+   explicit ShmResource(str const SegmentName);
+   virtual ~ShmResource(void) = default;
+
+   YM_NO_COPY  (ShmResource)
+   YM_NO_ASSIGN(ShmResource)
+
+   YM_DECL_YMASSERT(MapError)
+
+   inline auto getSegmentName(void) const { return _SegmentName; }
+   inline auto getBasePtr    (void) const { return _base_ptr;    }
+
+   inline void setReserved_bytes(sizet const Reserved_bytes) { _reserved_bytes = Reserved_bytes; }
+
+private:
+   virtual void * do_allocate(
+      sizet const Size_bytes,
+      sizet const Alignment) override;
+
+   virtual void do_deallocate(
+      void * const ptr,
+      sizet  const Size_bytes,
+      sizet  const Alignment) override;
+
+   virtual bool do_is_equal(std::pmr::memory_resource const & Other) const noexcept override;
+
+   str    const _SegmentName;
+   sizet        _reserved_bytes{0uz    };
+   byte *       _base_ptr      {nullptr};
+   sizet        _mapped_bytes  {0uz    };
+};
+
+/** ShmDataLogger
+ *
+ * @brief A blackbox that lives in a named shared memory segment.
+ *
+ * @note The blackbox buffer and the column meta data are placed in shared memory so a
+ *       separate process (see ShmDataReader) can take snapshots of the most recent rows
+ *       while the program runs. The reader never writes to the segment, so acquire() only
+ *       pays for the seqlock bookkeeping.
+ *
+ * @note Wraps (rather than derives from) a DataLogger. The segment layout has to be
+ *       reserved before the buffer is mapped, and every row has to go through the seqlock,
+ *       so there must be no way to reach the DataLogger's own ready() or acquire() - not
+ *       even through a DataLogger & (they aren't virtual).
+ *
+ * @note *Not* thread-safe (single writer).
+ */
+class ShmDataLogger : private ShmResource
+{
+public:
+   using Error     = DataLogger::Error;
+   using Options_T = DataLogger::Options_T;
+   using Stats_T   = DataLogger::Stats_T;
+
+   explicit ShmDataLogger(
+      str   const SegmentName,
+      sizet const MaxDepth,
+      sizet const NTrackedValsHint = 0uz);
+
+   YM_NO_COPY  (ShmDataLogger)
+   YM_NO_ASSIGN(ShmDataLogger)
+
+   using ShmResource::getSegmentName;
+
+   bool ready(void);
+   void acquire(void);
+   void reset(void);
+
+   bool armCrashDump(str const Filename);
+
+   inline auto getMaxDepth     (void) const { return _dataLogger.getMaxDepth();      }
+   inline auto isInitialized   (void) const { return _dataLogger.isInitialized();    }
+   inline auto isTimestamped   (void) const { return _dataLogger.isTimestamped();    }
+   inline auto isCrashDumpArmed(void) const { return _dataLogger.isCrashDumpArmed(); }
+
+   template <typename T>
+   inline void track(
+      str       const Name,
+      T const * const Read_Ptr) { _dataLogger.track(Name, Read_Ptr); }
+
+   inline void trackTimestamp(void) { _dataLogger.trackTimestamp(); }
+
+   inline void trackStats(
+      str     const Name,
+      float64 const HistMin,
+      float64 const HistMax) { _dataLogger.trackStats(Name, HistMin, HistMax); }
+
+   inline auto getStats  (str const Name) const { return _dataLogger.getStats(Name); }
+   inline void resetStats(void                ) { _dataLogger.resetStats();          }
+
+   inline bool dump(
+      str       const   Filename,
+      Options_T const & Options = DataLogger::getDefaultOptions()) { return _dataLogger.dump(Filename, Options); }
+
+   inline void disarmCrashDump(void)                { _dataLogger.disarmCrashDump();   }
+   inline bool crashDump      (void) const noexcept { return _dataLogger.crashDump(); }
+
+private:
+   ShmDataHeader_T * getHeaderPtr(void) const;
+
+   DataLogger _dataLogger; // after ShmResource (base) - its buffer lives in the segment
+};
+
+} // ym
@@ -0,0 +1,373 @@
+/**
+ * @file    shmdatareader.cpp
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#include "shmdatareader.h"
+
+#include "ops.h"
+#include "textlogger.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__x86_64__)
+   #include <immintrin.h>
+#endif
+
+namespace
+{
+
+/** formatAs
+ *
+ * @brief Formats the raw value as the given type.
+ *
+ * @tparam T -- Type of value.
+ *
+ * @param Data_Ptr -- Raw value (possibly unaligned).
+ * @param buffer   -- Buffer to write to (null terminated).
+ */
+template <typename T>
+void formatAs(
+   ym::byte const * const Data_Ptr,
+   std::span<char>        buffer)
+{
+   T val{};
+   std::memcpy(&val, Data_Ptr, sizeof(T));
+
+   if constexpr (ym::Formattable<T>)
+   { // fast path
+      if (buffer.size() > ym::Ops::_s_MaxFormattedSize)
+      { // room for any value and null terminator
+         *ym::Ops::formatTo(buffer.data(), val) = '\0';
+         return;
+      }
+   }
+
+   auto const Result = fmt::format_to_n(buffer.data(), buffer.size() - 1uz, "{}", val);
+   *Result.out = '\0';
+}
+
+} // anonymous
+
+/** ~ShmDataReader
+ *
+ * @brief Destructor.
+ */
+ym::ShmDataReader::~ShmDataReader(void)
+{
+   close();
+}
+
+/** open
+ *
+ * @brief Maps the named shared memory segment (read-only) and validates its layout.
+ *
+ * @param SegmentName -- Name of shared memory segment (eg "/ym_blackbox").
+ *
+ * @returns bool -- If the segment was opened.
+ */
+bool ym::ShmDataReader::open(str const SegmentName)
+{
+   close();
+
+   auto const FD = ::shm_open(SegmentName.get(), O_RDONLY, 0);
+
+   if (FD < 0)
+   { // no such segment (yet)
+      ymLog(VG::ShmData, "Could not open segment '{}' (errno {})", SegmentName, errno);
+      return false;
+   }
+
+   struct stat st{};
+   auto const Size_bytes = (::fstat(FD, &st) == 0) ? static_cast<sizet>(st.st_size) : 0uz;
+
+   auto * const map_Ptr = (Size_bytes >= sizeof(ShmDataHeader_T)) ?
+      ::mmap(nullptr, Size_bytes, PROT_READ, MAP_SHARED, FD, 0) : MAP_FAILED;
+
+   (void)::close(FD); // mapping keeps the segment alive
+
+   if (map_Ptr == MAP_FAILED)
+   { // segment too small or not mappable
+      ymLog(VG::ShmData, "Could not map segment '{}' ({} bytes)", SegmentName, Size_bytes);
+      return false;
+   }
+
+   auto const * const Header_Ptr = static_cast<ShmDataHeader_T const *>(map_Ptr);
+
+   auto const Valid =
+      Header_Ptr->_magic.load(std::memory_order_acquire) == ShmDataHeader_T::_s_Magic &&
+      Header_Ptr->_version  == ShmDataHeader_T::_s_Version                            &&
+      Header_Ptr->_maxDepth >  0_u64                                                  &&
+      Header_Ptr->_bufferOffset_bytes >=
+         sizeof(ShmDataHeader_T) + (Header_Ptr->_nColumns * sizeof(ShmDataColumn_T))  &&
+      Header_Ptr->_bufferOffset_bytes +
+         (Header_Ptr->_maxDepth * Header_Ptr->_rowSize_bytes) <= Size_bytes;
+
+   if (!Valid)
+   { // not (yet) a published blackbox
+      ymLog(VG::ShmData, "Segment '{}' is not a valid blackbox", SegmentName);
+      (void)::munmap(map_Ptr, Size_bytes);
+      return false;
+   }
+
+   _header_ptr   = Header_Ptr;
+   _mapped_bytes = Size_bytes;
+
+   return true;
+}
+
+/** close
+ *
+ * @brief Unmaps the segment.
+ */
+void ym::ShmDataReader::close(void)
+{
+   if (isOpen())
+   { // mapped
+      (void)::munmap(const_cast<ShmDataHeader_T *>(_header_ptr), _mapped_bytes);
+      _header_ptr   = nullptr;
+      _mapped_bytes = 0uz;
+   }
+}
+
+/** getColumns
+ *
+ * @brief Returns meta data of all tracked variables.
+ *
+ * @returns std::span<ShmDataColumn_T const> -- Columns, in row order.
+ */
+auto ym::ShmDataReader::getColumns(void) const -> std::span<ShmDataColumn_T const>
+{
+   return isOpen() ?
+      std::span(ymCastPtrTo<ShmDataColumn_T const>(_header_ptr + 1), _header_ptr->_nColumns) :
+      std::span<ShmDataColumn_T const>();
+}
+
+/** getMaxDepth
+ *
+ * @brief Returns the number of rows the blackbox holds.
+ *
+ * @returns sizet -- Max number of rows.
+ */
+auto ym::ShmDataReader::getMaxDepth(void) const -> sizet
+{
+   return isOpen() ? _header_ptr->_maxDepth : 0uz;
+}
+
+/** getRowSize_bytes
+ *
+ * @brief Returns the size of one row.
+ *
+ * @returns sizet -- Size of row in bytes.
+ */
+auto ym::ShmDataReader::getRowSize_bytes(void) const -> sizet
+{
+   return isOpen() ? _header_ptr->_rowSize_bytes : 0uz;
+}
+
+/** getEpoch
+ *
+ * @brief Returns the number of resets the writer has performed.
+ *
+ * @returns uint64 -- Current epoch.
+ */
+auto ym::ShmDataReader::getEpoch(void) const -> uint64
+{
+   return isOpen() ? _header_ptr->_epoch.load(std::memory_order_acquire) : 0_u64;
+}
+
+/** backOff
+ *
+ * @brief Waits a little before retrying a snapshot - spins first, then yields the core.
+ *
+ * @param NTries -- Number of tries so far.
+ */
+void ym::ShmDataReader::backOff(sizet const NTries)
+{
+   if (NTries < _s_NSpins)
+   { // writer is likely mid-row
+#if defined(__x86_64__)
+      _mm_pause();
+#endif
+   }
+   else
+   { // writer may be descheduled
+      std::this_thread::yield();
+   }
+}
+
+/** snapshot
+ *
+ * @brief Copies the most recent rows, oldest to newest.
+ *
+ * @note Reader side of the seqlock. If the writer overwrote some of the copied rows they
+ *       are dropped (the oldest ones) instead of retrying the whole copy. We only retry
+ *       if the writer was mid-row when we started, if it reset under us, or if it lapped
+ *       every row we copied.
+ *
+ * @note Retries back off and are bounded (see _s_MaxRetries). If the writer never lets us
+ *       through - eg it died mid-row - no rows are copied and isWriterStalled() is set.
+ *
+ * @param rows    -- Destination. Holds up to rows.size() / getRowSize_bytes() rows.
+ * @param end_Ptr -- (Optional) Set to the number of rows written (this epoch) up to and
+ *                   including the newest row copied. Lets callers pick up where they left off.
+ *                   Untouched if the writer stalled.
+ *
+ * @returns sizet -- Number of rows copied.
+ */
+auto ym::ShmDataReader::snapshot(
+   std::span<byte> rows,
+   uint64 * const  end_Ptr) -> sizet
+{
+   _stalled = false;
+
+   if (!isOpen() || _header_ptr->_rowSize_bytes == 0_u64)
+   { // nothing to read
+      return 0uz;
+   }
+
+   auto const   Depth       = _header_ptr->_maxDepth;
+   auto const   RowSize     = _header_ptr->_rowSize_bytes;
+   auto const   NRowsWanted = std::min(rows.size() / RowSize, Depth);
+   auto const * Buffer_Ptr  = ymCastPtrTo<byte const>(_header_ptr) + _header_ptr->_bufferOffset_bytes;
+
+   auto nRows = 0uz;
+   auto end   = 0_u64;
+
+   for (auto nTries = 0uz; ; ++nTries)
+   { // until we get a consistent view
+
+      if (nTries == _s_MaxRetries)
+      { // writer died mid-row, or is starved - don't hang with it
+         ymLog(VG::ShmData, "Gave up on a snapshot after {} retries", nTries);
+         _stalled = true;
+         return 0uz;
+      }
+
+      if (nTries > 0uz)
+      { // back off - let the writer finish its row
+         backOff(nTries);
+      }
+
+      auto const Seq1 = _header_ptr->_seq.load(std::memory_order_acquire);
+
+      if (Seq1 & 1_u64)
+      { // writer mid-row
+         continue;
+      }
+
+      auto const Epoch1 = _header_ptr->_epoch      .load(std::memory_order_acquire);
+      auto const W1     = _header_ptr->_rowsWritten.load(std::memory_order_acquire); // pairs with the release - complete rows
+
+      end   = W1;
+      nRows = std::min(NRowsWanted, W1);
+      auto const First_idx = W1 - nRows; // absolute index of oldest row copied
+
+      for (auto i = First_idx; i < W1; ++i)
+      { // copy rows (circular buffer)
+         std::memcpy(rows.data() + ((i - First_idx) * RowSize), Buffer_Ptr + ((i % Depth) * RowSize), RowSize);
+      }
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      auto const Seq2 = _header_ptr->_seq.load(std::memory_order_relaxed);
+
+      if (Seq2 == Seq1)
+      { // writer didn't touch anything
+         break;
+      }
+
+      auto const Epoch2 = _header_ptr->_epoch.load(std::memory_order_relaxed);
+
+      if (Epoch2 != Epoch1)
+      { // reset under us
+         continue;
+      }
+
+      // every row started since Seq1 overwrote the slot of the row Depth behind it
+      auto const RowsStarted = (Seq2 - Seq1 + 1_u64) / 2_u64;
+      auto const Reached_idx = W1 + RowsStarted; // conservative
+      auto const Valid_idx   = std::max(First_idx, (Reached_idx > Depth) ? Reached_idx - Depth : 0_u64);
+
+      if (Valid_idx >= W1)
+      { // lapped completely
+         continue;
+      }
+
+      nRows = W1 - Valid_idx;
+      std::memmove(rows.data(), rows.data() + ((Valid_idx - First_idx) * RowSize), nRows * RowSize);
+      break;
+   }
+
+   if (end_Ptr)
+   { // caller wants to know how far we got
+      *end_Ptr = end;
+   }
+
+   return nRows;
+}
+
+/** toStr
+ *
+ * @brief Stringifies one value of a row.
+ *
+ * @note Values of unknown type are printed as hex bytes.
+ *
+ * @param Col     -- Column to stringify.
+ * @param Row_Ptr -- Start of row.
+ * @param buffer  -- Buffer to write to (null terminated).
+ */
+void ym::ShmDataReader::toStr(
+   ShmDataColumn_T const & Col,
+   byte const *    const   Row_Ptr,
+   std::span<char>         buffer)
+{
+   if (buffer.empty())
+   { // no room to write
+      return;
+   }
+
+   auto const * const Data_Ptr = Row_Ptr + Col._offset_bytes;
+
+   using DT = DataLogger::DataType_T;
+
+   switch (Col._type)
+   {
+      case DT::Bool:    formatAs<bool   >(Data_Ptr, buffer); break;
+      case DT::Char:    formatAs<char   >(Data_Ptr, buffer); break;
+      case DT::Int8:    formatAs<int8   >(Data_Ptr, buffer); break;
+      case DT::Int16:   formatAs<int16  >(Data_Ptr, buffer); break;
+      case DT::Int32:   formatAs<int32  >(Data_Ptr, buffer); break;
+      case DT::Int64:   formatAs<int64  >(Data_Ptr, buffer); break;
+      case DT::Uint8:   formatAs<uint8  >(Data_Ptr, buffer); break;
+      case DT::Uint16:  formatAs<uint16 >(Data_Ptr, buffer); break;
+      case DT::Uint32:  formatAs<uint32 >(Data_Ptr, buffer); break;
+      case DT::Uint64:  formatAs<uint64 >(Data_Ptr, buffer); break;
+      case DT::Float32: formatAs<float32>(Data_Ptr, buffer); break;
+      case DT::Float64: formatAs<float64>(Data_Ptr, buffer); break;
+      case DT::Other:
+      default:
+      { // raw bytes
+         auto out_ptr = buffer.data();
+         auto left    = buffer.size() - 1uz;
+         for (auto i = 0uz; i < Col._size_bytes && left >= 2uz; ++i, left -= 2uz)
+         { // two hex digits per byte
+            auto const Result = fmt::format_to_n(out_ptr, 2uz, "{:02x}", std::to_integer<uint32>(Data_Ptr[i]));
+            out_ptr = Result.out;
+         }
+         *out_ptr = '\0';
+         break;
+      }
+   }
+}
@@ -0,0 +1,76 @@
+/**
+ * @file    shmdatareader.h
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#pragma once
+
+#include "ymglobals.h"
+
+#include "shmdatalogger.h"
+
+#include <span>
+
+namespace ym
+{
+
+/** ShmDataReader
+ *
+ * @brief Reads a ShmDataLogger blackbox from another process.
+ *
+ * @note The segment is mapped read-only. Readers never write to shared memory so they
+ *       cannot slow down the writer.
+ *
+ * @note Snapshots follow the seqlock published by the writer. If the writer lapped part
+ *       of the copy only the rows that are guaranteed intact are returned, so a reader
+ *       can't be starved by a fast writer.
+ *
+ * @note A writer that dies mid-row leaves the seqlock odd for good. Snapshots give up
+ *       after _s_MaxRetries instead of spinning forever (see isWriterStalled()).
+ */
+class ShmDataReader
+{
+public:
+   /// @brief Retries of a snapshot before giving up on the writer.
+   static constexpr auto _s_MaxRetries = 100'000uz;
+
+   explicit ShmDataReader(void) = default;
+   ~ShmDataReader(void);
+
+   YM_NO_COPY  (ShmDataReader)
+   YM_NO_ASSIGN(ShmDataReader)
+
+   bool open(str const SegmentName);
+   void close(void);
+
+   inline auto isOpen         (void) const { return _header_ptr != nullptr; }
+   inline auto isWriterStalled(void) const { return _stalled;                }
+
+   std::span<ShmDataColumn_T const> getColumns(void) const;
+
+   sizet getMaxDepth     (void) const;
+   sizet getRowSize_bytes(void) const;
+   uint64 getEpoch       (void) const;
+
+   sizet snapshot(
+      std::span<byte> rows,
+      uint64 * const  end_Ptr = nullptr);
+
+   static void toStr(
+      ShmDataColumn_T const & Col,
+      byte const *    const   Row_Ptr,
+      std::span<char>         buffer);
+
+private:
+   /// @brief Retries that spin before yielding.
+   static constexpr auto _s_NSpins = 64uz;
+
+   static void backOff(sizet const NTries);
+
+   ShmDataHeader_T const * _header_ptr  {nullptr};
+   sizet                   _mapped_bytes{0uz    };
+   bool                    _stalled     {false  }; // last snapshot gave up
+};
+
+} // ym
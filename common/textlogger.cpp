@@ -6,6 +6,8 @@
 
 #include "textlogger.h"
 
+#include "ops.h"
+
 #include "fmt/format.h"
 
 #include <chrono>
@@ -275,6 +277,7 @@ void ym::TextLogger::printf_Handler(
       // anyways (see DataLogger).
 
       std::fwrite(buffer, sizeof(char), TotalWritten_bytes, _outfile_uptr.get());
+      commitWrite();
 
       if (getOptions() == RedirectMode_T::ToLogAndStdOut)
       { // print to console
@@ -331,13 +334,10 @@ char * ym::TextLogger::populateFormattedTime(char * write_ptr) const
       auto       elapsed      = _timer.getElapsedTime();
       auto const TotalTime_us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
 
-      auto const Result = fmt::format_to_n(
+      write_ptr = Ops::formatFixedTo(
          write_ptr,
-         RawTimeStampTemplate.size(),
-         "{:012}",
-         TotalTime_us.count());
-
-      write_ptr = Result.out;
+         static_cast<uint64>(TotalTime_us.count()),
+         RawTimeStampTemplate.size());
 
       if (getOptions() == PrintMode_T::PrependHumanReadableTimeStamp)
       { // print human readable form of the time stamp
@@ -353,16 +353,17 @@ char * ym::TextLogger::populateFormattedTime(char * write_ptr) const
 
          auto const Time_us   = std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
 
-         auto const Result = fmt::format_to_n(
-            write_ptr,
-            HumanReadableTimeStampTemplate.size(),
-            " {:03}:{:02}:{:02}.{:06}: ",
-            Time_hr.count(),
-            Time_min.count(),
-            Time_sec.count(),
-            Time_us.count());
-
-         write_ptr = Result.out;
+         // " HHH:MM:SS.uuuuuu: "
+         *write_ptr++ = ' ';
+         write_ptr    = Ops::formatFixedTo(write_ptr, static_cast<uint64>(Time_hr .count()), 3uz);
+         *write_ptr++ = ':';
+         write_ptr    = Ops::formatFixedTo(write_ptr, static_cast<uint64>(Time_min.count()), 2uz);
+         *write_ptr++ = ':';
+         write_ptr    = Ops::formatFixedTo(write_ptr, static_cast<uint64>(Time_sec.count()), 2uz);
+         *write_ptr++ = '.';
+         write_ptr    = Ops::formatFixedTo(write_ptr, static_cast<uint64>(Time_us .count()), 6uz);
+         *write_ptr++ = ':';
+         *write_ptr++ = ' ';
       }
    }
 
@@ -203,7 +203,7 @@ private:
    str       const      _Filename {""_str          };
    Options_T const      _Options  { /* default */  };
    VGroups_T            _vGroups  { /* default */  };
-   Timer                _timer    { /* default */  };
+   TscTimer             _timer    { /* default */  };
    std::atomic<State_T> _state    {State_T::Closed };
    std::atomic_flag     _writeFlag{ATOMIC_FLAG_INIT};
 };
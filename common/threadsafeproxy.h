@@ -1,129 +1,444 @@
-// /**
-//  * @file    threadsafeproxy.h
-//  * @version 1.0.0
-//  * @author  Forrest Jablonski
-//  */
-
-// #pragma once
-
-// #include "ymdefs.h"
-
-// #include <mutex>
-
-// namespace ym
-// {
-
-// /** ThreadSafeProxy
-//  *
-//  * @brief A thread safe wrapper.
-//  * 
-//  * @note This wrapper functionally makes operations (ie member access and function calls)
-//  *       thread safe. It does this by overloading the arrow operator, a recursively function
-//  *       until it hits a raw pointer, which is then dereferenced. We inject a proxy class
-//  *       before the underlying type's pointer is dereferenced that employs RAII had locks
-//  *       a shared mutex before the dereference, and unlocks the shared mutex at the conclusion
-//  *       of the statement the initial dereference is in. For example...
-//  * 
-//  *       struct A { int _i; };
-//  *       A a{._i = 9};
-//  *       ThreadSafeProxy tsp(&a);
-//  *       tsp->_i = 7;
-//  * 
-//  *       The arrow operator will first acquire the mutex in tsp, then the semantics of the
-//  *       statement will happen, then (in this example when _i has been set to 7) the
-//  *       destructor of the temporary monitor class will be called, releasing the mutex.
-//  * 
-//  * @tparam Underlying_T -- Type which needs thread protection.
-//  * @tparam Mtx_T        -- A type that satisfies @ref <https://en.cppreference.com/w/cpp/named_req/Mutex>.
-//  */
-// template <typename Underlying_T,
-//           typename Mtx_T = std::mutex>
-// class ThreadSafeProxy
-// {
-// private:
-//    /** Monitor
-//     *
-//     * @brief Temp proxy object that acquires lock upon creation and releases it upon destruction.
-//     */
-//    class Monitor
-//    {
-//    public:
-//       explicit inline Monitor(Mtx_T        * const mtx_Ptr,
-//                               Underlying_T * const obj_Ptr);
-
-//       YM_NO_COPY  (Monitor);
-//       YM_NO_ASSIGN(Monitor);
-
-//       inline Underlying_T * operator -> (void) { return _obj_Ptr; }
-
-//    private:
-//       std::lock_guard<Mtx_T> _lock;
-//       Underlying_T * const   _obj_Ptr;
-//    };
-
-// public:
-//    explicit inline ThreadSafeProxy(Underlying_T * const obj_Ptr);
-
-//    // mutex is not copyable nor movable
-//    YM_NO_COPY  (ThreadSafeProxy);
-//    YM_NO_ASSIGN(ThreadSafeProxy);
-
-//    inline auto operator -> (void);
-
-// private:
-//    Mtx_T                _mtx;
-//    Underlying_T * const _obj_Ptr;
-// };
-
-// /** Monitor
-//  *
-//  * @brief Constructor.
-//  * 
-//  * @tparam Underlying_T -- Type which needs thread protection.
-//  * @tparam Mtx_T        -- A type that satisfies @ref <https://en.cppreference.com/w/cpp/named_req/Mutex>.
-//  * 
-//  * @param mtx_Ptr -- Pointer to shared mutex.
-//  * @param obj_Ptr -- Pointer to wrapped object.
-//  */
-// template <typename Underlying_T,
-//           typename Mtx_T>
-// inline ThreadSafeProxy<Underlying_T, Mtx_T>::Monitor::Monitor(
-//    Mtx_T        * const mtx_Ptr,
-//    Underlying_T * const obj_Ptr)
-//    : _lock    {*mtx_Ptr},
-//      _obj_Ptr { obj_Ptr}
-// {
-// }
-
-// /** ThreadSafeProxy
-//  *
-//  * @brief Constructor.
-//  * 
-//  * @tparam Underlying_T -- Type which needs thread protection.
-//  * @tparam Mtx_T        -- A type that satisfies @ref <https://en.cppreference.com/w/cpp/named_req/Mutex>.
-//  * 
-//  * @param obj_Ptr -- Pointer to wrapped object.
-//  */
-// template <typename Underlying_T,
-//           typename Mtx_T>
-// inline ThreadSafeProxy<Underlying_T, Mtx_T>::ThreadSafeProxy(
-//    Underlying_T * const obj_Ptr)
-//    : _mtx     {/*default*/},
-//      _obj_Ptr {obj_Ptr    }
-// {
-// }
-
-// /** operator ->
-//  *
-//  * @brief Returns a temporary proxy object to allow for thread safe access.
-//  * 
-//  * @returns Monitor -- Temp proxy object.
-//  */
-// template <typename Underlying_T,
-//           typename Mtx_T>
-// inline auto ThreadSafeProxy<Underlying_T, Mtx_T>::operator -> (void)
-// {
-//    return Monitor(&_mtx, _obj_Ptr);
-// }
-
-// } // ym
+/**
+ * @file    threadsafeproxy.h
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#pragma once
+
+#include "ymdefs.h"
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+
+namespace ym
+{
+
+/** SharedLockable
+ *
+ * @brief Mutexes that can be locked by many readers at once.
+ *
+ * @ref <https://en.cppreference.com/w/cpp/named_req/SharedLockable>.
+ *
+ * @tparam T -- Mutex type.
+ */
+template <typename T>
+concept SharedLockable = requires(T mtx) {
+   mtx.lock_shared();
+   mtx.unlock_shared();
+};
+
+/** ThreadSafeProxy
+ *
+ * @brief A thread safe wrapper.
+ *
+ * @note This wrapper functionally makes operations (ie member access and function calls)
+ *       thread safe. It does this by overloading the arrow operator, a recursively function
+ *       until it hits a raw pointer, which is then dereferenced. We inject a proxy class
+ *       before the underlying type's pointer is dereferenced that employs RAII and locks
+ *       the mutex before the dereference, and unlocks the mutex at the conclusion of the
+ *       statement the initial dereference is in. For example...
+ *
+ *       struct A { int _i; };
+ *       A a{._i = 9};
+ *       ThreadSafeProxy tsp(&a);
+ *       tsp->_i = 7;
+ *
+ *       The arrow operator will first acquire the mutex in tsp, then the semantics of the
+ *       statement will happen, then (in this example when _i has been set to 7) the
+ *       destructor of the temporary monitor class will be called, releasing the mutex.
+ *
+ * @note The const arrow operator only hands out const access, and takes a shared lock
+ *       if the mutex has one - readers don't wait on each other, only on writers. Use
+ *       std::as_const(tsp)->... to read through a non-const proxy.
+ *
+ * @tparam Underlying_T -- Type which needs thread protection.
+ * @tparam Mtx_T        -- A type that satisfies @ref <https://en.cppreference.com/w/cpp/named_req/Mutex>.
+ */
+template <typename Underlying_T,
+          typename Mtx_T = std::shared_mutex>
+class ThreadSafeProxy
+{
+private:
+   /** Monitor
+    *
+    * @brief Temp proxy object that acquires lock upon creation and releases it upon destruction.
+    *
+    * @tparam Lock_T -- Exclusive or shared lock.
+    * @tparam Obj_T  -- Underlying type, const for readers.
+    */
+   template <typename Lock_T,
+             typename Obj_T>
+   class Monitor
+   {
+   public:
+      explicit inline Monitor(Mtx_T & mtx,
+                              Obj_T * const obj_Ptr)
+         : _lock    {mtx    },
+           _obj_Ptr {obj_Ptr}
+      {
+      }
+
+      YM_NO_COPY  (Monitor)
+      YM_NO_ASSIGN(Monitor)
+
+      inline Obj_T * operator -> (void) const { return _obj_Ptr; }
+
+   private:
+      Lock_T        _lock;
+      Obj_T * const _obj_Ptr;
+   };
+
+   /// @brief Lock for readers - shared if the mutex allows it.
+   using ReadLock_T = std::conditional_t<SharedLockable<Mtx_T>, std::shared_lock<Mtx_T>, std::unique_lock<Mtx_T>>;
+
+public:
+   explicit inline ThreadSafeProxy(Underlying_T * const obj_Ptr);
+
+   // mutex is not copyable nor movable
+   YM_NO_COPY  (ThreadSafeProxy)
+   YM_NO_ASSIGN(ThreadSafeProxy)
+
+   inline auto operator -> (void);
+   inline auto operator -> (void) const;
+
+private:
+   mutable Mtx_T        _mtx;
+   Underlying_T * const _obj_Ptr;
+};
+
+/** ThreadSafeProxy
+ *
+ * @brief Constructor.
+ *
+ * @tparam Underlying_T -- Type which needs thread protection.
+ * @tparam Mtx_T        -- A type that satisfies @ref <https://en.cppreference.com/w/cpp/named_req/Mutex>.
+ *
+ * @param obj_Ptr -- Pointer to wrapped object.
+ */
+template <typename Underlying_T,
+          typename Mtx_T>
+inline ThreadSafeProxy<Underlying_T, Mtx_T>::ThreadSafeProxy(
+   Underlying_T * const obj_Ptr)
+   : _mtx     {/*default*/},
+     _obj_Ptr {obj_Ptr    }
+{
+}
+
+/** operator ->
+ *
+ * @brief Returns a temporary proxy object to allow for thread safe access.
+ *
+ * @note Holds the mutex exclusively.
+ *
+ * @returns Monitor -- Temp proxy object.
+ */
+template <typename Underlying_T,
+          typename Mtx_T>
+inline auto ThreadSafeProxy<Underlying_T, Mtx_T>::operator -> (void)
+{
+   return Monitor<std::unique_lock<Mtx_T>, Underlying_T>(_mtx, _obj_Ptr);
+}
+
+/** operator ->
+ *
+ * @brief Returns a temporary proxy object to allow for thread safe reads.
+ *
+ * @note Holds the mutex shared (if possible), so many readers may hold it at once.
+ *
+ * @returns Monitor -- Temp proxy object.
+ */
+template <typename Underlying_T,
+          typename Mtx_T>
+inline auto ThreadSafeProxy<Underlying_T, Mtx_T>::operator -> (void) const
+{
+   return Monitor<ReadLock_T, Underlying_T const>(_mtx, _obj_Ptr);
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+
+/** SeqLockable
+ *
+ * @brief Types small and simple enough to be guarded by a SeqLockProxy.
+ *
+ * @tparam T -- Data type.
+ */
+template <typename T>
+concept SeqLockable = std::is_trivially_copyable_v<T>    &&
+                      std::is_default_constructible_v<T> &&
+                      sizeof(T) <= 64uz;
+
+/** SeqLockProxy
+ *
+ * @brief Owns a small value read by many threads and seldom written.
+ *
+ * @note Readers never write shared memory - a read is a copy bracketed by two loads of a
+ *       sequence counter, retried if a writer was active in between. Reads therefore don't
+ *       bounce cache lines between readers, unlike a lock (shared or not). Writers take
+ *       turns by bumping the counter to odd, and make it even again when done.
+ *
+ *       struct Config_T { float64 _gain; int32 _period; };
+ *       SeqLockProxy<Config_T> config({._gain = 1.0, ._period = 10});
+ *       auto const Gain = config->_gain;                    // any thread
+ *       config.update([](Config_T & c) { c._period = 20; }); // any thread
+ *
+ * @note The value is stored as relaxed atomic words, so torn reads are never undefined
+ *       behaviour - they are just thrown away.
+ *
+ * @note Readers spin while a write is in progress, so keep writes short.
+ *
+ * @tparam Underlying_T -- Type which needs thread protection.
+ */
+template <SeqLockable Underlying_T>
+class SeqLockProxy
+{
+private:
+   /** Snapshot
+    *
+    * @brief Temp copy of the value, taken as a whole.
+    */
+   class Snapshot
+   {
+   public:
+      explicit inline Snapshot(Underlying_T const & Val) : _val{Val} {}
+
+      inline Underlying_T const * operator -> (void) const { return &_val; }
+
+   private:
+      Underlying_T const _val;
+   };
+
+   /** WriteScope
+    *
+    * @brief Holds the write side for its lifetime - released even if the writer throws.
+    */
+   class WriteScope
+   {
+   public:
+      explicit inline WriteScope(SeqLockProxy & proxy_ref) : _proxy_ref{proxy_ref}, _seq{proxy_ref.beginWrite()} {}
+      inline ~WriteScope(void) { _proxy_ref.endWrite(_seq); }
+
+      YM_NO_COPY  (WriteScope)
+      YM_NO_ASSIGN(WriteScope)
+
+   private:
+      SeqLockProxy &       _proxy_ref;
+      uint64         const _seq;
+   };
+
+   static constexpr auto _s_NWords = (sizeof(Underlying_T) + sizeof(uint64) - 1uz) / sizeof(uint64);
+
+   using Words_T = std::array<uint64, _s_NWords>;
+
+public:
+   explicit inline SeqLockProxy(Underlying_T const & Val = Underlying_T{});
+
+   // atomics are not copyable nor movable
+   YM_NO_COPY  (SeqLockProxy)
+   YM_NO_ASSIGN(SeqLockProxy)
+
+   inline Underlying_T load (void) const;
+   inline void         store(Underlying_T const & Val);
+
+   template <typename Func_T>
+   inline void update(Func_T && func);
+
+   inline auto operator -> (void) const { return Snapshot(load()); }
+
+private:
+   inline uint64 beginWrite(void);
+   inline void   endWrite  (uint64 const Seq);
+
+   inline Words_T readWords (void) const;
+   inline void    writeWords(Words_T const & Words);
+
+   alignas(64)
+   std::atomic<uint64>                        _seq  {0_u64}; // odd while being written
+   std::array<std::atomic<uint64>, _s_NWords> _words{     };
+};
+
+/** SeqLockProxy
+ *
+ * @brief Constructor.
+ *
+ * @tparam Underlying_T -- Type which needs thread protection.
+ *
+ * @param Val -- Initial value.
+ */
+template <SeqLockable Underlying_T>
+inline SeqLockProxy<Underlying_T>::SeqLockProxy(Underlying_T const & Val)
+{
+   auto words = Words_T{};
+   std::memcpy(words.data(), &Val, sizeof(Underlying_T));
+   writeWords(words);
+}
+
+/** load
+ *
+ * @brief Copies the value out, never torn.
+ *
+ * @tparam Underlying_T -- Type which needs thread protection.
+ *
+ * @returns Underlying_T -- Copy of value.
+ */
+template <SeqLockable Underlying_T>
+inline Underlying_T SeqLockProxy<Underlying_T>::load(void) const
+{
+   auto words = Words_T{};
+
+   while (true)
+   { // until no write overlapped the copy
+      auto const Seq1 = _seq.load(std::memory_order_acquire);
+
+      if (Seq1 & 1_u64)
+      { // write in progress
+         std::this_thread::yield();
+         continue;
+      }
+
+      words = readWords();
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      if (_seq.load(std::memory_order_relaxed) == Seq1)
+      { // consistent
+         break;
+      }
+   }
+
+   auto val = Underlying_T{};
+   std::memcpy(static_cast<void *>(&val), words.data(), sizeof(Underlying_T)); // trivially copyable
+   return val;
+}
+
+/** store
+ *
+ * @brief Replaces the value.
+ *
+ * @tparam Underlying_T -- Type which needs thread protection.
+ *
+ * @param Val -- New value.
+ */
+template <SeqLockable Underlying_T>
+inline void SeqLockProxy<Underlying_T>::store(Underlying_T const & Val)
+{
+   auto words = Words_T{};
+   std::memcpy(words.data(), &Val, sizeof(Underlying_T));
+
+   WriteScope const Scope(*this);
+   writeWords(words);
+}
+
+/** update
+ *
+ * @brief Modifies the value in place - no other writer can interleave.
+ *
+ * @note func works on a copy. If it throws, the value is left as it was and the
+ *       write side is still released.
+ *
+ * @tparam Underlying_T -- Type which needs thread protection.
+ * @tparam Func_T       -- Callable taking Underlying_T &.
+ *
+ * @param func -- Modification.
+ */
+template <SeqLockable Underlying_T>
+template <typename Func_T>
+inline void SeqLockProxy<Underlying_T>::update(Func_T && func)
+{
+   WriteScope const Scope(*this);
+
+   auto words = readWords(); // we are the only writer
+   auto val   = Underlying_T{};
+   std::memcpy(static_cast<void *>(&val), words.data(), sizeof(Underlying_T)); // trivially copyable
+
+   std::forward<Func_T>(func)(val);
+
+   std::memcpy(words.data(), &val, sizeof(Underlying_T));
+   writeWords(words);
+}
+
+/** beginWrite
+ *
+ * @brief Waits for other writers, then marks the value as being written (odd sequence).
+ *
+ * @tparam Underlying_T -- Type which needs thread protection.
+ *
+ * @returns uint64 -- Sequence before the write.
+ */
+template <SeqLockable Underlying_T>
+inline uint64 SeqLockProxy<Underlying_T>::beginWrite(void)
+{
+   auto seq = _seq.load(std::memory_order_relaxed);
+
+   while ((seq & 1_u64) || !_seq.compare_exchange_weak(seq, seq + 1_u64, std::memory_order_acquire, std::memory_order_relaxed))
+   { // another writer
+      if (seq & 1_u64)
+      { // still writing
+         std::this_thread::yield();
+         seq = _seq.load(std::memory_order_relaxed);
+      }
+   }
+
+   // words must not be written before readers can see the odd sequence
+   std::atomic_thread_fence(std::memory_order_release);
+
+   return seq;
+}
+
+/** endWrite
+ *
+ * @brief Publishes the written value (even sequence).
+ *
+ * @tparam Underlying_T -- Type which needs thread protection.
+ *
+ * @param Seq -- Sequence before the write.
+ */
+template <SeqLockable Underlying_T>
+inline void SeqLockProxy<Underlying_T>::endWrite(uint64 const Seq)
+{
+   _seq.store(Seq + 2_u64, std::memory_order_release);
+}
+
+/** readWords
+ *
+ * @brief Loads the words of the value (may be torn - see load()).
+ *
+ * @tparam Underlying_T -- Type which needs thread protection.
+ *
+ * @returns Words_T -- Words of the value.
+ */
+template <SeqLockable Underlying_T>
+inline auto SeqLockProxy<Underlying_T>::readWords(void) const -> Words_T
+{
+   auto words = Words_T{};
+   for (auto i = 0uz; i < _s_NWords; ++i)
+   { // each word
+      words[i] = _words[i].load(std::memory_order_relaxed);
+   }
+   return words;
+}
+
+/** writeWords
+ *
+ * @brief Stores the words of the value.
+ *
+ * @tparam Underlying_T -- Type which needs thread protection.
+ *
+ * @param Words -- Words of the value.
+ */
+template <SeqLockable Underlying_T>
+inline void SeqLockProxy<Underlying_T>::writeWords(Words_T const & Words)
+{
+   for (auto i = 0uz; i < _s_NWords; ++i)
+   { // each word
+      _words[i].store(Words[i], std::memory_order_relaxed);
+   }
+}
+
+} // ym
@@ -6,19 +6,391 @@
 
 #include "timer.h"
 
-/** Timer
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <thread>
+
+#include <time.h>
+
+#if defined(__x86_64__)
+   #include <cpuid.h>
+   #include <x86intrin.h>
+#endif
+
+namespace
+{
+
+/** readMonotonic_ns
+ *
+ * @brief Reads CLOCK_MONOTONIC - what steady_clock reads on Linux.
+ *
+ * @returns int64 -- Nanoseconds since boot.
+ */
+ym::int64 readMonotonic_ns(void)
+{
+   using namespace ym;
+
+   struct timespec ts{};
+   (void)::clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (static_cast<ym::int64>(ts.tv_sec) * 1'000'000'000_i64) + ts.tv_nsec;
+}
+
+#if defined(__x86_64__)
+
+/** isTscInvariant
+ *
+ * @brief Asks the cpu if the TSC ticks at a constant rate regardless of power state.
+ *
+ * @returns bool -- If the invariant TSC bit (CPUID 0x80000007 EDX[8]) is set.
+ */
+bool isTscInvariant(void)
+{
+   auto eax = 0u, ebx = 0u, ecx = 0u, edx = 0u;
+
+   if (!__get_cpuid(0x8000'0000u, &eax, &ebx, &ecx, &edx) || eax < 0x8000'0007u)
+   { // leaf not supported
+      return false;
+   }
+
+   (void)__get_cpuid(0x8000'0007u, &eax, &ebx, &ecx, &edx);
+
+   return (edx & (1u << 8u)) != 0u;
+}
+
+/** samplePair
+ *
+ * @brief Reads the TSC and CLOCK_MONOTONIC as close together as we can.
+ *
+ * @note Takes the tightest of a few tries, with the TSC taken as the midpoint of the
+ *       two reads bracketing the clock read.
+ *
+ * @param tsc_ref -- Ticks.
+ * @param ns_ref  -- Nanoseconds.
+ */
+void samplePair(
+   ym::uint64 & tsc_ref,
+   ym::int64  & ns_ref)
+{
+   using namespace ym;
+
+   auto best = ~0_u64;
+
+   for (auto i = 0; i < 16; ++i)
+   { // several tries - an interrupt may land in between
+      auto       aux    = 0u;
+      auto const Before = __rdtscp(&aux);
+      auto const NS     = readMonotonic_ns();
+      auto const After  = __rdtscp(&aux);
+
+      if (After - Before < best)
+      { // tighter
+         best    = After - Before;
+         tsc_ref = Before + ((After - Before) / 2_u64);
+         ns_ref  = NS;
+      }
+   }
+}
+
+#endif // __x86_64__
+
+} // anonymous
+
+/** now
+ *
+ * @brief Reads the clock.
+ *
+ * @note rdtsc is not ordered with respect to surrounding instructions. See nowSerialized().
+ *
+ * @returns time_point -- Current time.
+ */
+auto ym::TscClock::now(void) noexcept -> time_point
+{
+   auto const & Cal = getCalibration();
+
+#if defined(__x86_64__)
+   if (Cal._reliable)
+   { // fast path
+      return toTimePoint(Cal, __rdtsc());
+   }
+#endif
+
+   return time_point(duration(readMonotonic_ns()));
+}
+
+/** nowSerialized
+ *
+ * @brief Reads the clock after all previous instructions have executed (rdtscp).
+ *
+ * @note Useful at the end of a timed region.
+ *
+ * @returns time_point -- Current time.
+ */
+auto ym::TscClock::nowSerialized(void) noexcept -> time_point
+{
+   auto const & Cal = getCalibration();
+
+#if defined(__x86_64__)
+   if (Cal._reliable)
+   { // fast path
+      auto aux = 0u;
+      return toTimePoint(Cal, __rdtscp(&aux));
+   }
+#endif
+
+   return time_point(duration(readMonotonic_ns()));
+}
+
+/** getCalibration
+ *
+ * @brief Returns the calibration in use, calibrating the first time.
+ *
+ * @note Calibration takes about 20ms.
+ *
+ * @returns Calibration_T const & -- Calibration.
+ */
+auto ym::TscClock::getCalibration(void) -> Calibration_T const &
+{
+   static auto const s_Cal = calibrate(std::chrono::milliseconds(20));
+   return s_Cal;
+}
+
+/** calibrate
+ *
+ * @brief Measures the TSC rate against CLOCK_MONOTONIC.
+ *
+ * @note A longer window gives a more precise rate (less drift).
+ *
+ * @param Window -- How long to measure for.
+ *
+ * @returns Calibration_T -- Calibration (not reliable if the TSC shouldn't be trusted).
+ */
+auto ym::TscClock::calibrate(std::chrono::nanoseconds const Window) -> Calibration_T
+{
+   auto cal = Calibration_T{};
+   cal._ns0 = readMonotonic_ns();
+
+#if defined(__x86_64__)
+   if (isTscInvariant())
+   { // worth measuring
+      auto tsc0 = 0_u64, tsc1 = 0_u64;
+      auto ns0  = 0_i64, ns1  = 0_i64;
+
+      samplePair(tsc0, ns0);
+      std::this_thread::sleep_for(Window);
+      samplePair(tsc1, ns1);
+
+      auto const Ticks = tsc1 - tsc0;
+      auto const NS    = ns1  - ns0;
+
+      if (tsc1 > tsc0 && NS > 0_i64)
+      { // sane (the TSC did move forward)
+         cal._tsc0       = tsc1;
+         cal._ns0        = ns1;
+         cal._ticksPerNs = static_cast<float64>(Ticks) / static_cast<float64>(NS);
+         cal._mult       = static_cast<uint64>(
+            ((static_cast<float64>(NS) * static_cast<float64>(1_u64 << _s_Shift)) / static_cast<float64>(Ticks)) + 0.5_f64);
+         cal._reliable   = cal._mult > 0_u64;
+      }
+   }
+#endif
+
+   return cal;
+}
+
+/** toTimePoint
+ *
+ * @brief Converts ticks to a time point - (ticks * mult) >> shift, in 128 bits so a long
+ *        uptime can't overflow.
+ *
+ * @param Cal   -- Calibration.
+ * @param Ticks -- Raw TSC.
+ *
+ * @returns time_point -- Time.
+ */
+auto ym::TscClock::toTimePoint(
+   Calibration_T const & Cal,
+   uint64        const   Ticks) noexcept -> time_point
+{
+   __extension__ using Uint128_T = unsigned __int128;
+
+   auto const Delta = static_cast<int64>(Ticks - Cal._tsc0); // may be (slightly) negative across cores
+   auto const Abs   = static_cast<uint64>(Delta < 0_i64 ? -Delta : Delta);
+   auto const NS    = static_cast<int64>((static_cast<Uint128_T>(Abs) * Cal._mult) >> _s_Shift);
+
+   return time_point(duration(Cal._ns0 + (Delta < 0_i64 ? -NS : NS)));
+}
+
+// ----------------------------------------------------------------------------
+
+/** getActive
+ *
+ * @brief Returns the clock source ActiveClock reads.
+ *
+ * @returns ClockSource & -- Active source (steady clock unless set).
+ */
+auto ym::ClockSource::getActive(void) -> ClockSource &
+{
+   static SteadyClockSource s_steady;
+
+   auto * const source_Ptr = _s_active_ptr.load(std::memory_order_acquire);
+   return source_Ptr ? *source_Ptr : s_steady;
+}
+
+/** setActive
+ *
+ * @brief Sets the clock source ActiveClock reads.
+ *
+ * @param source_Ptr -- Source (must outlive its use), nullptr for the steady clock.
+ */
+void ym::ClockSource::setActive(ClockSource * const source_Ptr)
+{
+   _s_active_ptr.store(source_Ptr, std::memory_order_release);
+}
+
+/** now
+ *
+ * @brief Reads the steady clock.
+ *
+ * @returns Duration_T -- Time since the steady clock's epoch.
+ */
+auto ym::SteadyClockSource::now(void) const -> Duration_T
+{
+   return std::chrono::steady_clock::now().time_since_epoch();
+}
+
+/** sleepUntil
+ *
+ * @brief Sleeps until the deadline.
+ *
+ * @param Deadline -- Time since the steady clock's epoch.
+ */
+void ym::SteadyClockSource::sleepUntil(Duration_T const Deadline)
+{
+   std::this_thread::sleep_until(std::chrono::steady_clock::time_point(
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(Deadline)));
+}
+
+/** VirtualClock
  *
  * @brief Constructor.
+ *
+ * @param Start -- Initial time.
  */
-ym::Timer::Timer(void) :
-   _startTime {Clock_T::now()}
-{}
+ym::VirtualClock::VirtualClock(Duration_T const Start) :
+   _now_ns {Start.count()}
+{ }
 
-/** reset
+/** now
+ *
+ * @brief Reads simulated time.
+ *
+ * @returns Duration_T -- Current simulated time.
+ */
+auto ym::VirtualClock::now(void) const -> Duration_T
+{
+   return Duration_T(_now_ns.load(std::memory_order_acquire));
+}
+
+/** sleepUntil
+ *
+ * @brief Blocks until simulated time reaches the deadline.
+ *
+ * @note If this was the last running participant, time jumps right away.
+ *
+ * @param Deadline -- Simulated time to wake at.
+ */
+void ym::VirtualClock::sleepUntil(Duration_T const Deadline)
+{
+   std::unique_lock lock(_mutex);
+
+   if (Deadline <= now())
+   { // already due
+      return;
+   }
+
+   auto const IsParticipant = _s_nJoins > 0uz;
+
+   (void)_deadlines.emplace(Deadline, IsParticipant);
+   _nSleeping += IsParticipant ? 1uz : 0uz;
+
+   advanceIfIdle_locked();
+
+   _cv.wait(lock, [this, Deadline]() { return now() >= Deadline; });
+}
+
+/** join
+ *
+ * @brief Registers the calling thread as a participant.
+ */
+void ym::VirtualClock::join(void)
+{
+   std::lock_guard const Lock(_mutex);
+   ++_nParticipants;
+   ++_s_nJoins;
+}
+
+/** leave
+ *
+ * @brief Unregisters a participant - time may move on without it.
+ */
+void ym::VirtualClock::leave(void)
+{
+   std::lock_guard const Lock(_mutex);
+
+   --_nParticipants;
+   --_s_nJoins;
+   advanceIfIdle_locked();
+}
+
+/** advanceTo
+ *
+ * @brief Moves simulated time forward by hand, waking every sleeper due.
+ *
+ * @note Time never moves backwards.
+ *
+ * @param Time -- New simulated time.
+ */
+void ym::VirtualClock::advanceTo(Duration_T const Time)
+{
+   std::lock_guard const Lock(_mutex);
+   advanceTo_locked(Time);
+}
+
+/** advanceTo_locked
+ *
+ * @brief See advanceTo(). Mutex must be held.
+ *
+ * @note Sleepers due stop counting as sleeping right here, not when they get to run,
+ *       so time can't jump again before they've had their turn.
+ *
+ * @param Time -- New simulated time.
+ */
+void ym::VirtualClock::advanceTo_locked(Duration_T const Time)
+{
+   if (Time > now())
+   { // forwards only
+      _now_ns.store(Time.count(), std::memory_order_release);
+   }
+
+   auto const Due = _deadlines.upper_bound(now());
+   _nSleeping -= static_cast<sizet>(std::count_if(_deadlines.begin(), Due,
+      [](auto const & Sleeper) { return Sleeper.second; }));
+   _deadlines.erase(_deadlines.begin(), Due);
+
+   _cv.notify_all();
+}
+
+/** advanceIfIdle_locked
+ *
+ * @brief Jumps to the earliest deadline if every participant sleeps. Mutex must be held.
  *
- * @brief Resets the start time.
+ * @note Keeps jumping while only non-participants were due - they don't hold time back.
  */
-void ym::Timer::reset(void)
+void ym::VirtualClock::advanceIfIdle_locked(void)
 {
-   _startTime = Clock_T::now();
+   while (_nParticipants > 0uz && _nSleeping >= _nParticipants && !_deadlines.empty())
+   { // nobody left to do work at the current time
+      advanceTo_locked(_deadlines.begin()->first);
+   }
 }
@@ -8,23 +8,214 @@
 
 #include "ymglobals.h"
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <map>
 
 namespace ym
 {
 
-/** Timer
+/** TscClock
+ *
+ * @brief Clock backed by the time stamp counter. Meets the std Clock requirements.
+ *
+ * @note Reading the counter is a handful of cycles (no syscall, no vDSO). Ticks are
+ *       converted to nanoseconds with a fixed-point multiply and shift, calibrated once
+ *       against CLOCK_MONOTONIC the first time the clock is used.
+ *
+ * @note If the TSC is not invariant (it may stop or change rate with the core) or we're
+ *       not on x86-64, the clock quietly falls back to std::chrono::steady_clock.
+ *
+ * @note Time points share the epoch of steady_clock (at calibration) so they can be
+ *       compared, modulo drift.
+ */
+class TscClock
+{
+public:
+   using rep        = int64;
+   using period     = std::nano;
+   using duration   = std::chrono::duration<rep, period>;
+   using time_point = std::chrono::time_point<TscClock>;
+
+   static constexpr bool is_steady = true;
+
+   /** Calibration_T
+    *
+    * @brief Conversion from ticks to nanoseconds.
+    */
+   struct Calibration_T
+   {
+      uint64  _tsc0       {0_u64  }; // ticks at calibration
+      int64   _ns0        {0_i64  }; // steady clock at calibration
+      uint64  _mult       {0_u64  }; // ns per tick, scaled by 2^_s_Shift
+      float64 _ticksPerNs {0.0_f64};
+      bool    _reliable   {false  }; // TSC is used
+   };
+
+   static constexpr auto _s_Shift = 32_u32;
+
+   static time_point now          (void) noexcept;
+   static time_point nowSerialized(void) noexcept;
+
+   static Calibration_T const & getCalibration(void);
+
+   inline static auto isTscReliable(void) { return getCalibration()._reliable; }
+
+   static Calibration_T calibrate(std::chrono::nanoseconds const Window);
+
+private:
+   static time_point toTimePoint(
+      Calibration_T const & Cal,
+      uint64        const   Ticks) noexcept;
+};
+
+/** ClockSource
+ *
+ * @brief Pluggable source of time - what ActiveClock reads and sleeps on.
+ *
+ * @note The default source is the steady clock. Swap in a VirtualClock (see setActive())
+ *       to run timed code in simulated time. Swap before starting any threads that use it.
+ */
+class ClockSource
+{
+public:
+   using Duration_T = std::chrono::duration<int64, std::nano>;
+
+   virtual ~ClockSource(void) = default;
+
+   virtual Duration_T now       (void) const                 = 0;
+   virtual void       sleepUntil(Duration_T const Deadline) = 0;
+
+   virtual void join (void) { }
+   virtual void leave(void) { }
+
+   static ClockSource & getActive(void);
+   static void          setActive(ClockSource * const source_Ptr);
+
+   /** Participant
+    *
+    * @brief Joins the active clock for the lifetime of the object (RAII).
+    *
+    * @note Threads that sleep on a VirtualClock should be participants - simulated time
+    *       only moves once every participant sleeps. A thread participates in at most
+    *       one clock at a time.
+    */
+   class Participant
+   {
+   public:
+      explicit inline Participant(void) : _source_ref{getActive()} { _source_ref.join(); }
+      inline ~Participant(void) { _source_ref.leave(); }
+
+      YM_NO_COPY  (Participant)
+      YM_NO_ASSIGN(Participant)
+
+   private:
+      ClockSource & _source_ref;
+   };
+
+private:
+   static inline std::atomic<ClockSource *> _s_active_ptr{nullptr};
+};
+
+/** SteadyClockSource
+ *
+ * @brief Real time - std::chrono::steady_clock.
+ */
+class SteadyClockSource : public ClockSource
+{
+public:
+   virtual Duration_T now       (void) const                 override;
+   virtual void       sleepUntil(Duration_T const Deadline) override;
+};
+
+/** VirtualClock
+ *
+ * @brief Simulated time that jumps straight to the next deadline.
+ *
+ * @note Discrete event style. Time stands still while any participant is running. Once
+ *       every participant sleeps, time jumps to the earliest deadline and the sleepers
+ *       due are woken. Results don't depend on how long the work takes or how threads
+ *       are scheduled, and an hour of sleeping takes no time at all.
+ *
+ * @note Threads that sleep without joining don't hold time back, nor do they count towards
+ *       "every participant sleeps".
+ *
+ * @note advanceTo()/advanceBy() move time by hand (eg single threaded tests).
+ */
+class VirtualClock : public ClockSource
+{
+public:
+   explicit VirtualClock(Duration_T const Start = Duration_T::zero());
+
+   YM_NO_COPY  (VirtualClock)
+   YM_NO_ASSIGN(VirtualClock)
+
+   virtual Duration_T now       (void) const                 override;
+   virtual void       sleepUntil(Duration_T const Deadline) override;
+
+   virtual void join (void) override;
+   virtual void leave(void) override;
+
+   void advanceTo(Duration_T const Time);
+
+   inline void advanceBy(Duration_T const Delta) { advanceTo(now() + Delta); }
+
+private:
+   void advanceTo_locked(Duration_T const Time);
+   void advanceIfIdle_locked(void);
+
+   static inline thread_local sizet _s_nJoins{0uz}; // of the calling thread
+
+   mutable std::mutex              _mutex        {     };
+   std::condition_variable         _cv           {     };
+   std::multimap<Duration_T, bool> _deadlines    {     }; // of sleepers not yet due (participant?)
+   std::atomic<Duration_T::rep>    _now_ns       {0_i64};
+   sizet                           _nParticipants{0uz  };
+   sizet                           _nSleeping    {0uz  }; // participants only
+};
+
+/** ActiveClock
+ *
+ * @brief Std clock that reads the active ClockSource.
+ *
+ * @note Costs a virtual call - use TscClock or steady_clock where simulation doesn't matter.
+ */
+class ActiveClock
+{
+public:
+   using rep        = int64;
+   using period     = std::nano;
+   using duration   = std::chrono::duration<rep, period>;
+   using time_point = std::chrono::time_point<ActiveClock>;
+
+   static constexpr bool is_steady = true;
+
+   inline static time_point now(void) { return time_point(ClockSource::getActive().now()); }
+
+   inline static void sleepUntil(time_point const Deadline) { ClockSource::getActive().sleepUntil(Deadline.time_since_epoch()); }
+   inline static void sleepFor  (duration   const Delta   ) { sleepUntil(now() + Delta); }
+};
+
+/** BasicTimer
  *
  * @brief Provides basic timing functionality.
+ *
+ * @note Timer reads ActiveClock, so it runs in simulated time while a VirtualClock is
+ *       active. Use SteadyTimer (or TscTimer) to measure real time regardless.
+ *
+ * @tparam Clock_T_ -- Clock to time with.
  */
-class Timer
+template <typename Clock_T_>
+class BasicTimer
 {
 public:
-   using Clock_T    = std::chrono::high_resolution_clock;
+   using Clock_T    = Clock_T_;
    using Time_T     = Clock_T::time_point;
    using Duration_T = std::chrono::duration<int64, std::nano>;
 
-   Timer(void);
+   BasicTimer(void);
 
    void reset(void);
 
@@ -34,13 +225,38 @@ private:
    Time_T _startTime;
 };
 
+using Timer       = BasicTimer<ActiveClock>;
+using ActiveTimer = Timer;
+using SteadyTimer = BasicTimer<std::chrono::steady_clock>;
+using TscTimer    = BasicTimer<TscClock>;
+
+/** BasicTimer
+ *
+ * @brief Constructor.
+ */
+template <typename Clock_T_>
+BasicTimer<Clock_T_>::BasicTimer(void) :
+   _startTime {Clock_T::now()}
+{}
+
+/** reset
+ *
+ * @brief Resets the start time.
+ */
+template <typename Clock_T_>
+void BasicTimer<Clock_T_>::reset(void)
+{
+   _startTime = Clock_T::now();
+}
+
 /** getElapsedTime
  *
  * @brief Returns the elapsed time.
  *
  * @returns Duration_T -- Duration of elapsed time.
  */
-auto Timer::getElapsedTime(void) const -> Duration_T
+template <typename Clock_T_>
+auto BasicTimer<Clock_T_>::getElapsedTime(void) const -> Duration_T
 {
    return Clock_T::now() - _startTime;
 }
@@ -0,0 +1,101 @@
+/**
+ * @file    rngbattery.cpp
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ *
+ * @brief Runs the RngBattery on the ym generators and prints a report.
+ *
+ * @note Usage:
+ *       ym.rngbattery [--gen all|prng|philox|trng] [--values 4194304] [--seed 1]
+ *
+ * @note Exits with failure if any test fails.
+ */
+
+#include "ymglobals.h"
+
+#include "argparser.h"
+#include "rng.h"
+#include "rngbattery.h"
+
+#include "fmt/format.h"
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+
+/** main
+ *
+ * @brief Entry point.
+ *
+ * @param Argc     -- Number of command line args.
+ * @param Argv_Ptr -- Command line args.
+ *
+ * @returns int -- Exit status.
+ */
+int main(
+   int                const Argc,
+   ym::strlit const * const Argv_Ptr)
+{
+   using namespace ym;
+
+   auto const DefaultNVals = fmt::format("{}", RngBattery::_s_DefaultNVals);
+
+   auto args = std::array{
+      ArgParser::Arg("gen"   ).desc("Generator (all, prng, philox, trng)").abbr('g').defval("all"),
+      ArgParser::Arg("values").desc("Number of values per test"         ).abbr('n').defval(DefaultNVals.c_str()),
+      ArgParser::Arg("seed"  ).desc("Seed of prng and philox"           ).abbr('s').defval("1")
+   };
+
+   ArgParser ap(Argc, Argv_Ptr, args);
+
+   switch (ap.parse())
+   {
+      case ArgParser::ParseResult_T::Success:        break;
+      case ArgParser::ParseResult_T::HelpMenuCalled: return EXIT_SUCCESS;
+      case ArgParser::ParseResult_T::Failure:
+      default:                                       return EXIT_FAILURE;
+   }
+
+   auto const Gen   = std::string_view(ap["gen"]->getVal());
+   auto const NVals = std::strtoull(ap["values"]->getVal(), nullptr, 10);
+   auto const Seed  = std::strtoull(ap["seed"  ]->getVal(), nullptr, 0);
+
+   if (NVals < RngBattery::_s_MinNVals)
+   { // tests would be meaningless
+      fmt::print(stderr, "Need at least {} values per test\n", RngBattery::_s_MinNVals);
+      return EXIT_FAILURE;
+   }
+
+   RngBattery const Battery(NVals);
+
+   auto nRun   = 0uz;
+   auto passed = true;
+
+   auto const RunOn = [&](strlit const Name, auto & gen) {
+      if (Gen == "all" || Gen == Name)
+      { // selected
+         auto const Report = Battery.run(gen);
+         fmt::print("{}\n", RngBattery::formatReport(Name, Report));
+         std::fflush(stdout);
+         passed &= Report.passed();
+         ++nRun;
+      }
+   };
+
+   Prng   prng  (Seed);
+   Philox philox(Seed);
+   Trng   trng;
+
+   RunOn("prng",   prng  );
+   RunOn("philox", philox);
+   RunOn("trng",   trng  );
+
+   if (nRun == 0uz)
+   { // typo
+      fmt::print(stderr, "Unknown generator '{}'\n", Gen);
+      return EXIT_FAILURE;
+   }
+
+   return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file    shmdatareader.cpp
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ *
+ * @brief Prints the most recent rows of a ShmDataLogger blackbox as csv.
+ *
+ * @note Usage:
+ *       ym.shmdatareader --segment /ym_blackbox [--rows 10] [--follow] [--period 100]
+ */
+
+#include "ymglobals.h"
+
+#include "argparser.h"
+#include "shmdatareader.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+/** printRows
+ *
+ * @brief Prints rows as csv.
+ *
+ * @param Reader -- Opened reader.
+ * @param Rows   -- Rows from ShmDataReader::snapshot().
+ * @param NRows  -- Number of rows to print.
+ */
+void printRows(
+   ym::ShmDataReader const & Reader,
+   std::span<ym::byte const> Rows,
+   ym::sizet const           NRows)
+{
+   auto buffer = std::array<char, 64uz>{};
+
+   for (auto r = 0uz; r < NRows; ++r)
+   { // each row
+      auto const * const Row_Ptr = Rows.data() + (r * Reader.getRowSize_bytes());
+      auto               sep     = "";
+
+      for (auto const & Col : Reader.getColumns())
+      { // each value
+         ym::ShmDataReader::toStr(Col, Row_Ptr, buffer);
+         fmt::print("{}{}", sep, buffer.data());
+         sep = ",";
+      }
+
+      fmt::print("\n");
+   }
+}
+
+} // anonymous
+
+/** main
+ *
+ * @brief Entry point.
+ *
+ * @param Argc     -- Number of command line args.
+ * @param Argv_Ptr -- Command line args.
+ *
+ * @returns int -- Exit status.
+ */
+int main(
+   int                const Argc,
+   ym::strlit const * const Argv_Ptr)
+{
+   using namespace ym;
+
+   auto args = std::array{
+      ArgParser::Arg("segment").desc("Name of shared memory segment").abbr('s').defval("/ym_blackbox"),
+      ArgParser::Arg("rows"   ).desc("Max number of rows to print" ).abbr('n').defval("10"),
+      ArgParser::Arg("follow" ).desc("Keep printing new rows"      ).abbr('f').enbl(false),
+      ArgParser::Arg("period" ).desc("Poll period in ms (follow)"  ).abbr('p').defval("100")
+   };
+
+   ArgParser ap(Argc, Argv_Ptr, args);
+
+   switch (ap.parse())
+   {
+      case ArgParser::ParseResult_T::Success:        break;
+      case ArgParser::ParseResult_T::HelpMenuCalled: return EXIT_SUCCESS;
+      case ArgParser::ParseResult_T::Failure:
+      default:                                       return EXIT_FAILURE;
+   }
+
+   auto const SegmentName = ap["segment"]->getVal();
+   auto const MaxRows     = std::strtoull(ap["rows"  ]->getVal(), nullptr, 10);
+   auto const Follow      = ap["follow"]->isEnbl();
+   auto const Period      = std::chrono::milliseconds(std::strtoull(ap["period"]->getVal(), nullptr, 10));
+
+   ShmDataReader reader;
+
+   if (!reader.open(str(SegmentName)))
+   { // nothing to read
+      fmt::print(stderr, "Could not open blackbox '{}'\n", SegmentName);
+      return EXIT_FAILURE;
+   }
+
+   { // header
+      auto sep = "";
+      for (auto const & Col : reader.getColumns())
+      { // each name
+         fmt::print("{}{}", sep, Col._name);
+         sep = ",";
+      }
+      fmt::print("\n");
+   }
+
+   auto const NRows = std::min<sizet>(MaxRows, reader.getMaxDepth());
+   auto       rows  = std::vector<byte>(NRows * reader.getRowSize_bytes());
+
+   auto end     = 0_u64;
+   auto epoch   = reader.getEpoch();
+   auto nCopied = reader.snapshot(rows, &end);
+
+   if (reader.isWriterStalled() && !Follow)
+   { // nothing consistent to print
+      fmt::print(stderr, "Writer of blackbox '{}' appears stuck mid-row\n", SegmentName);
+      return EXIT_FAILURE;
+   }
+
+   printRows(reader, rows, nCopied);
+
+   while (Follow)
+   { // until killed - only print rows we haven't seen yet
+      std::this_thread::sleep_for(Period);
+
+      auto const PrevEnd  = end;
+      auto const NewEpoch = reader.getEpoch();
+
+      nCopied = reader.snapshot(rows, &end);
+
+      if (reader.isWriterStalled())
+      { // try again next period
+         fmt::print(stderr, "Writer of blackbox '{}' appears stuck mid-row\n", SegmentName);
+      }
+
+      auto const NNew = (NewEpoch == epoch && end >= PrevEnd) ?
+         std::min<sizet>(nCopied, end - PrevEnd) : nCopied; // everything is new after a reset
+
+      printRows(reader, std::span(rows).subspan((nCopied - NNew) * reader.getRowSize_bytes()), NNew);
+      std::fflush(stdout);
+
+      epoch = NewEpoch;
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -39,14 +39,18 @@ struct VerboGroup
       Error,
 
       ArgParser,       UnitTest_ArgParser,
+      CsvReader,       UnitTest_CsvReader,
       DataLogger,      UnitTest_DataLogger,
       FileIO,          UnitTest_FileIO,
+      Latency,         UnitTest_Latency,
       Logger,          UnitTest_Logger,
       TextLogger,      UnitTest_TextLogger,
       ThreadSafeProxy, UnitTest_ThreadSafeProxy,
       MemIO,           UnitTest_MemIO,
       Ops,             UnitTest_Ops,
+      Profiler,        UnitTest_Profiler,
       Rng,             UnitTest_Rng,
+      ShmData,         UnitTest_ShmData,
       Timer,           UnitTest_Timer,
       YmAssert,        UnitTest_YmAssert,
       YmDefs,          UnitTest_YmDefs,
@@ -112,8 +116,10 @@ struct VerboGroupMask
       Error   = YM_FMT_MSK(Error  ),
 
       YM_MAKE_MSK_AND_UNIT_MSK(ArgParser      ),
+      YM_MAKE_MSK_AND_UNIT_MSK(CsvReader      ),
       YM_MAKE_MSK_AND_UNIT_MSK(DataLogger     ),
       YM_MAKE_MSK_AND_UNIT_MSK(FileIO         ),
+      YM_MAKE_MSK_AND_UNIT_MSK(Latency        ),
       YM_MAKE_MSK_AND_UNIT_MSK(Logger         ),
       YM_MAKE_MSK_AND_UNIT_MSK(TextLogger     ),
          TextLogger_Basic  = YM_FMT_MSK(TextLogger, 0b0000'0001),
@@ -121,9 +127,11 @@ struct VerboGroupMask
       YM_MAKE_MSK_AND_UNIT_MSK(ThreadSafeProxy),
       YM_MAKE_MSK_AND_UNIT_MSK(MemIO          ),
       YM_MAKE_MSK_AND_UNIT_MSK(Ops            ),
+      YM_MAKE_MSK_AND_UNIT_MSK(Profiler       ),
       YM_MAKE_MSK_AND_UNIT_MSK(Rng            ),
          Rng_Prng = YM_FMT_MSK(Rng, 0b0000'0001),
          Rng_Trng = YM_FMT_MSK(Rng, 0b0000'0010),
+      YM_MAKE_MSK_AND_UNIT_MSK(ShmData        ),
       YM_MAKE_MSK_AND_UNIT_MSK(Timer          ),
       YM_MAKE_MSK_AND_UNIT_MSK(YmAssert       ),
          YmAssert_Strong = YM_FMT_MSK(YmAssert, 0b0000'0001),
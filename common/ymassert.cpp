@@ -35,6 +35,19 @@ void ym::ymassert_Base::write_Helper(
    *Result.out = '\0';
 }
 
+/** setFatalHook
+ *
+ * @brief Installs a callback to run before a fatal assert terminates the program.
+ *
+ * @note The hook runs in a dying process and must be async-signal-safe.
+ *
+ * @param Hook -- Callback to install, or null to uninstall.
+ */
+void ym::ymassert_Base::setFatalHook(FatalHook_T const Hook)
+{
+   _s_fatalHook = Hook;
+}
+
 #if (YM_YES_EXCEPTIONS)
 
 /** what
@@ -52,11 +65,19 @@ auto ym::ymassert_Base::what(void) const noexcept -> rawstr
  *
  * @brief Logs the error message and raises interrupt.
  *
+ * @note The fatal hook (if any) runs before the interrupt is raised.
+ *
  * @param E -- Raised error.
  */
 void ym::ymassert_Base::defaultNoExceptHandler(ymassert_Base const & E)
 {
    logAssert(E);
+
+   if (_s_fatalHook)
+   { // give interested parties a last look
+      _s_fatalHook();
+   }
+
    std::raise(SIGTERM);
 }
 
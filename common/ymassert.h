@@ -121,6 +121,11 @@ public:
    static void defaultNoExceptHandler(ymassert_Base const & E);
 #endif
 
+   /// @brief Callback invoked right before a fatal assert terminates the program.
+   using FatalHook_T = void(*)(void) noexcept;
+
+   static void setFatalHook(FatalHook_T const Hook);
+
    static void logAssert(ymassert_Base const & E);
    static inline auto logAndReturn(ymassert_Base const & E, auto && v_uref) {
       logAssert(E); return v_uref;
@@ -141,6 +146,8 @@ public:
       fmt::format_args args);
 
 private:
+   static inline FatalHook_T _s_fatalHook{nullptr};
+
    char _msg[_s_MaxMsgSize_bytes]{'\0'};
 };
 
@@ -4,7 +4,7 @@
 
 #include "FixedUpdater.h"
 
-#include "TimerDefs.h"
+#include "timer.h"
 
 /**
  *
@@ -21,11 +21,13 @@ ym::hsm::FixedUpdater::FixedUpdater(char const * const Name_Ptr,
  */
 void ym::hsm::FixedUpdater::taskLoop(void)
 {
-   typedef timer::Tick_T<int64, std::nano> Tick_T;
+   ClockSource::Participant const Participant; // lets virtual time wait on us
+
+   typedef ActiveClock::duration Tick_T;
 
    Tick_T const TickDelay(std::nano::den / getHerz()); // # of ticks per frame
    
-   auto startTime = timer::Clock_T::now();
+   auto startTime = ActiveClock::now();
    
    while (isRunning())
    {
@@ -35,7 +37,7 @@ void ym::hsm::FixedUpdater::taskLoop(void)
       {
          updateMHsms();
    
-         auto const EndTime   = timer::Clock_T::now();
+         auto const EndTime   = ActiveClock::now();
                     startTime = startTime + TickDelay;
          auto const Headroom  = startTime - EndTime;
 
@@ -45,13 +47,13 @@ void ym::hsm::FixedUpdater::taskLoop(void)
          }
          else
          {
-            std::this_thread::sleep_until(startTime);
+            ActiveClock::sleepUntil(startTime);
          }
 
          aveHeadroom += Headroom;
       }
 
       aveHeadroom /= getHerz();
-      addBlackboxEntry(timer::Tick_T<float64, std::milli>(aveHeadroom).count());
+      addBlackboxEntry(std::chrono::duration<float64, std::milli>(aveHeadroom).count());
    }
 }
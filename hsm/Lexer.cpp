@@ -6,13 +6,41 @@
 
 #include "Assert.h"
 #include "Logger.h"
+#include "ops.h"
 
-#include <cstdlib>
+#include <string_view>
 
 #define YM_GET_NEXT_CHAR() _p_Stream[_index]
 #define YM_GET_NEXT_CHAR_AND_ADVANCE_INDEX() _p_Stream[_index++]
 #define YM_ADVANCE_INDEX_AND_GOTO(Label_State) ++_index; goto Label_State
 
+namespace
+{
+
+/**
+ * Casts a lexed number. Only digits and a '.' make it this far, so the cast can
+ *  only fail if the number is out of float32 range.
+ *
+ * castTo() asserts on failure itself in exception builds, and hands back the
+ *  std::expected otherwise.
+ */
+ym::float32 toNumber(std::string_view const Text)
+{
+   using namespace ym;
+
+   auto const Result = Ops::castTo<float32>(Text);
+
+#if (YM_YES_EXCEPTIONS)
+   return Result;
+#else
+   YM_ASSERT(Result.has_value(), YM_LOG,
+      "Number '%.*s' out of range", static_cast<int32>(Text.size()), Text.data());
+   return Result.value_or(0.0f);
+#endif
+}
+
+} // anonymous
+
 /**
  * Initialize members.
  *
@@ -81,7 +109,7 @@ Label_State_1:
        c <= '9') { YM_ADVANCE_INDEX_AND_GOTO(Label_State_1); }
    if (c == '.') { YM_ADVANCE_INDEX_AND_GOTO(Label_State_2); }
 
-   return Token(Token::Type_T::Number, {std::strtof(_p_Stream + startIndex, nullptr)});
+   return Token(Token::Type_T::Number, {toNumber(std::string_view(_p_Stream + startIndex, _index - startIndex))});
 }
 
 // -----------------------------------------------------------------------------
@@ -93,7 +121,7 @@ Label_State_2:
    if (c >= '0' &&
        c <= '9') { YM_ADVANCE_INDEX_AND_GOTO(Label_State_2); }
 
-   return Token(Token::Type_T::Number, {std::strtof(_p_Stream + startIndex, nullptr)});
+   return Token(Token::Type_T::Number, {toNumber(std::string_view(_p_Stream + startIndex, _index - startIndex))});
 }
 
    // UNREACHABLE
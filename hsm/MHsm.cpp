@@ -35,7 +35,7 @@ bool ym::hsm::MHsm::update(UpdatePK const &)
    {
       if (isTimerActive())
       {
-         if (Clock_T::now() >= _endTime)
+         if (ActiveClock::now() >= _endTime)
          {
             dispatch(_s_MHsmCommandTimerExpired);
             stopTimer();
@@ -83,11 +83,11 @@ void ym::hsm::MHsm::setHerz(float32 const Herz)
 
 /**
  * TODO it'd be nice if I could write
- *      _endTime = Clock_T::now() + nanoize(Time_sec)
+ *      _endTime = ActiveClock::now() + nanoize(Time_sec)
  */
 void ym::hsm::MHsm::startTimer(float64 const Time_sec)
 {
-   _endTime = Clock_T::now() + std::chrono::nanoseconds(static_cast<int64>(Time_sec * std::nano::den));
+   _endTime = ActiveClock::now() + std::chrono::nanoseconds(static_cast<int64>(Time_sec * std::nano::den));
 
    _isTimerActive = true;
 }
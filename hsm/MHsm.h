@@ -10,7 +10,7 @@
 #include "MHsmCommands.h"
 #include "PassKey.h"
 #include "Signal.h"
-#include "TimerDefs.h"
+#include "timer.h"
 
 namespace ym::hsm
 {
@@ -51,10 +51,10 @@ protected:
    virtual void onCurrentStateExit(void) override;
 
 private:
-   bool          _areUpdatesActive;
-   bool          _isTimerActive;
-   timer::Time_T _endTime;
-   float32       _herz;
+   bool                    _areUpdatesActive;
+   bool                    _isTimerActive;
+   ActiveClock::time_point _endTime;
+   float32                 _herz;
 
    static inline MHsmCommandPreUpdate    const _s_MHsmCommandPreUpdate;
    static inline MHsmCommandUpdate       const _s_MHsmCommandUpdate;
@@ -4,7 +4,7 @@
 
 #include "VariableUpdater.h"
 
-#include "TimerDefs.h"
+#include "timer.h"
 
 /**
  *
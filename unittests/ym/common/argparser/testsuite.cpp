@@ -25,6 +25,7 @@ ym::unit::TestSuite::TestSuite(void) :
    addTestCase<BasicParse           >();
    addTestCase<FlagIntegrity        >();
    addTestCase<SizeOfArg            >();
+   addTestCase<ParseResult          >();
 }
 
 /** run
@@ -174,3 +175,48 @@ auto ym::unit::TestSuite::SizeOfArg::run([[maybe_unused]] DataShuttle const & In
       {"Size", Size}
    };
 }
+
+/** run
+ *
+ * @brief Tests that parse() reports success for each kind of argument on its own.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::ParseResult::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_ArgParser);
+
+   // parses the args (after the program name) - true if it succeeded and Key got the value (or was enabled)
+   auto const Parse = []<typename... Args_T>(str const Key, rawstr const Expected, Args_T const... Args) {
+      strlit const Argv[] = {"testsuite", Args...};
+
+      std::array argHandlers{
+         ArgParser::Arg("input"  ).desc("Input file"),
+         ArgParser::Arg("verbose").desc("Verbosity" )           .enbl(),
+         ArgParser::Arg("clean"  ).desc("Cleans"    ).abbr('c').enbl(),
+         ArgParser::Arg("key"    ).desc("Passkey"   ).abbr('k')
+      };
+
+      auto parsed = false;
+
+      try
+      {
+         ArgParser ap(static_cast<int32>(std::size(Argv)), Argv, argHandlers);
+         parsed = ap.parse() == ArgParser::ParseResult_T::Success;
+         parsed = parsed && (Expected ? std::strcmp(ap[Key]->getVal(), Expected) == 0 : ap[Key]->isEnbl());
+      }
+      catch (ArgParser::Error const & E)
+      {
+         ymLog(VG::UnitTest_ArgParser, "--> {}", E.what());
+      }
+
+      return parsed;
+   };
+
+   return {
+      {"LongValue",  Parse("input",   "settings.json", "--input", "settings.json")},
+      {"LongFlag",   Parse("verbose", nullptr,         "--verbose"                )},
+      {"ShortValue", Parse("key",     "Torchic1234",   "-k", "Torchic1234"        )},
+      {"ShortFlag",  Parse("clean",   nullptr,         "-c"                       )}
+   };
+}
@@ -29,6 +29,7 @@ public:
    YM_UT_TESTCASE(BasicParse           )
    YM_UT_TESTCASE(FlagIntegrity        )
    YM_UT_TESTCASE(SizeOfArg            )
+   YM_UT_TESTCASE(ParseResult          )
 };
 
 } // ym::unit
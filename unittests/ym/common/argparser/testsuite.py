@@ -110,6 +110,20 @@ class TestSuite(testsuitebase.TestSuiteBase):
       size = results.get[std.size_t]("Size")
       self.assertEqual(size, 32, "Unexpected Arg size")
 
+   def test_ParseResult(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("ParseResult")
+
+      self.assertTrue(results.get[bool]("LongValue" ), "Long-hand arg with a value did not parse")
+      self.assertTrue(results.get[bool]("LongFlag"  ), "Long-hand flag did not parse")
+      self.assertTrue(results.get[bool]("ShortValue"), "Short-hand arg with a value did not parse")
+      self.assertTrue(results.get[bool]("ShortFlag" ), "Short-hand flag did not parse")
+
 # kick-off
 if __name__ == "__main__":
    TestSuite.runSuite()
@@ -33,10 +33,12 @@ function(unitbuild-ym.common Ctx_JSON)
    cmake_language(CALL srcbuild-${BaseBuild} ${Ctx_JSON})
    target_link_libraries(${TargetInt} INTERFACE ${BaseBuild})
    target_link_libraries(${BaseBuild} PRIVATE ${TargetInt})
+   target_link_libraries(${BaseBuild}.shmdatareader PRIVATE ${TargetInt})
+   target_link_libraries(${BaseBuild}.rngbattery    PRIVATE ${TargetInt})
    set_target_properties(${BaseBuild} PROPERTIES VERSION ${PROJECT_VERSION})
    set_target_properties(${BaseBuild} PROPERTIES LIBRARY_OUTPUT_DIRECTORY ${YM_CustomLibsDir})
 
-   set(SubBuilds argparser datalogger fileio logger textlogger timer ymassert ymdefs ymutils)
+   set(SubBuilds argparser csvreader datalogger distributions fileio latencyhistogram logger ops profiler rng rngbattery shmdatalogger textlogger threadsafeproxy timer ymassert ymdefs ymutils)
    foreach(SubBuild ${SubBuilds})
 
       set(SubBaseBuild ${BaseBuild}.${SubBuild})
@@ -0,0 +1,366 @@
+/**
+ * @file    testsuite.cpp
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#include "testsuite.h"
+
+#include "textlogger.h"
+#include "timer.h"
+#include "ymglobals.h"
+
+#include "csvreader.h" // Structures under test
+#include "datalogger.h"
+
+#include "fmt/format.h"
+
+#include <cmath>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+using namespace ym;
+
+/** makeText
+ *
+ * @brief Generates rows of mixed types.
+ *
+ * @note Column x only turns float near the end, and column tag only turns to text there,
+ *       so with several chunks the chunks disagree on the types.
+ *
+ * @param NRows  -- # of rows.
+ * @param BadRow -- Row given an extra field (none if out of range).
+ *
+ * @returns std::string -- Header and rows.
+ */
+std::string makeText(
+   sizet const NRows,
+   sizet const BadRow = static_cast<sizet>(-1))
+{
+   auto text = std::string("id,x,flag,tag\n");
+   text.reserve(NRows * 32uz);
+
+   for (auto i = 0uz; i < NRows; ++i)
+   { // each row
+      auto const Late = i + NRows / 8uz >= NRows;
+
+      fmt::format_to(std::back_inserter(text), "{},", static_cast<int64>(i) - 1000_i64);
+      if (Late) { fmt::format_to(std::back_inserter(text), "{},", static_cast<float64>(i) * 0.25); }
+      else      { fmt::format_to(std::back_inserter(text), "{},", i * 3uz                       ); }
+      text += (i % 3uz == 0uz) ? "true," : "false,";
+      if (Late && i % 7uz == 0uz) { text += "oops";                                       }
+      else                        { fmt::format_to(std::back_inserter(text), "{}", i % 10uz); }
+      if (i == BadRow) { text += ",extra"; }
+      text += '\n';
+   }
+
+   return text;
+}
+
+/** isSameColumn
+ *
+ * @brief Compares columns (NaNs are not expected).
+ *
+ * @param A -- Column.
+ * @param B -- Column.
+ *
+ * @returns bool -- If the columns have the same name, type, and values.
+ */
+bool isSameColumn(
+   CsvReader::Column_T const & A,
+   CsvReader::Column_T const & B)
+{
+   return A._name   == B._name   &&
+          A._type   == B._type   &&
+          A._bools  == B._bools  &&
+          A._ints   == B._ints   &&
+          A._floats == B._floats &&
+          A._texts  == B._texts;
+}
+
+} // anonymous
+
+/** TestSuite
+ *
+ * @brief Constructor.
+ */
+ym::unit::TestSuite::TestSuite(void) :
+   TestSuiteBase("CsvReader")
+{
+   addTestCase<ReadDump  >();
+   addTestCase<Typing    >();
+   addTestCase<Chunking  >();
+   addTestCase<BadRow    >();
+   addTestCase<Throughput>();
+}
+
+/** run
+ *
+ * @brief Reads a DataLogger text dump back in.
+ *
+ * @note The columns are handed to python, which checks them against the dump.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::ReadDump::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_CsvReader);
+
+   str const Filename = "logs/csv_dump.csv";
+
+   auto dumped = false;
+   { // logger closes the dump when it goes out of scope
+      DataLogger blackbox(1024uz);
+
+      auto a = 0_i32;
+      auto b = 1.0_f64;
+      auto c = false;
+      blackbox.track("a", &a);
+      blackbox.track("b", &b);
+      blackbox.track("c", &c);
+      blackbox.trackTimestamp();
+
+      for (auto i = 0uz; i < 500uz; ++i)
+      { // fill
+         blackbox.acquire();
+         a -= 3;
+         b *= -1.1;
+         c  = !c;
+      }
+
+      auto options = DataLogger::getDefaultOptions();
+      options._openingOptions._filenameMode  = Logger::FilenameMode_T::KeepOriginal;
+      options._openingOptions._overwriteMode = Logger::OverwriteMode_T::Allow;
+      dumped = blackbox.dump(Filename, options);
+   }
+
+   CsvReader reader;
+   auto const Read = dumped && reader.read(Filename);
+
+   using enum CsvReader::ColumnType_T;
+   auto const * const TS_Ptr = reader.findColumn("timestamp_ns");
+   auto const * const A_Ptr  = reader.findColumn("a");
+   auto const * const B_Ptr  = reader.findColumn("b");
+   auto const * const C_Ptr  = reader.findColumn("c");
+
+   auto const Found = TS_Ptr && A_Ptr && B_Ptr && C_Ptr;
+
+   auto names = std::vector<std::string>();
+   for (auto const & Col : reader.getColumns())
+   { // in order
+      names.push_back(Col._name);
+   }
+
+   if (!Found)
+   { // nothing to compare
+      return {
+         {"Read",  Read },
+         {"Found", Found}
+      };
+   }
+
+   return {
+      {"Read",            Read                                                                               },
+      {"Found",           Found                                                                              },
+      {"TypesAsExpected", TS_Ptr->_type == Int64 && A_Ptr->_type == Int64 && B_Ptr->_type == Float64 && C_Ptr->_type == Bool},
+      {"NRows",           static_cast<uint64>(reader.getNRows())                                             },
+      {"Names",           names                                                                              },
+      {"timestamp_ns",    TS_Ptr->_ints                                                                      },
+      {"a",               A_Ptr->_ints                                                                       },
+      {"b",               B_Ptr->_floats                                                                     },
+      {"c",               std::vector<bool>(C_Ptr->_bools.begin(), C_Ptr->_bools.end())                      }
+   };
+}
+
+/** run
+ *
+ * @brief Checks the type picked for each column.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Typing::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_CsvReader);
+
+   CsvReader reader;
+   reader.parse("i,f,b,t,e,n\r\n"
+                "1,1,true,x,,1\r\n"
+                "\r\n"
+                "2,2.5,false,y,,-3\r\n"
+                "3,1e-310,true,z,,+4");
+
+   using enum CsvReader::ColumnType_T;
+   auto const & Cols = reader.getColumns();
+
+   auto const ShapeAsExpected = reader.getNRows() == 3uz && Cols.size() == 6uz;
+
+   if (!ShapeAsExpected)
+   { // nothing to compare
+      return {
+         {"ShapeAsExpected", ShapeAsExpected}
+      };
+   }
+
+   auto const TypesAsExpected =
+      Cols[0]._type == Int64   && Cols[1]._type == Float64 && Cols[2]._type == Bool &&
+      Cols[3]._type == Text    && Cols[4]._type == Float64 && Cols[5]._type == Int64;
+
+   auto const ValsAsExpected =
+      Cols[0]._ints   == std::vector<int64  >{1_i64, 2_i64, 3_i64}           &&
+      Cols[1]._floats == std::vector<float64>{1.0, 2.5, 1e-310}              &&
+      Cols[2]._bools  == std::vector<uint8  >{1u, 0u, 1u}                    &&
+      Cols[3]._texts  == std::vector<std::string>{"x", "y", "z"}             &&
+      Cols[4]._floats.size() == 3uz && std::isnan(Cols[4]._floats.front())   &&
+      Cols[5]._ints   == std::vector<int64  >{1_i64, -3_i64, 4_i64};
+
+   auto const NamesAsExpected = Cols[0]._name == "i" && Cols[5]._name == "n" &&
+                                reader.findColumn("t") == &Cols[3] && !reader.findColumn("q");
+
+   return {
+      {"ShapeAsExpected", ShapeAsExpected},
+      {"TypesAsExpected", TypesAsExpected},
+      {"ValsAsExpected",  ValsAsExpected },
+      {"NamesAsExpected", NamesAsExpected}
+   };
+}
+
+/** run
+ *
+ * @brief Checks that parsing in chunks gives the same columns as in one go.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Chunking::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_CsvReader);
+
+   constexpr auto NRows = 20'000uz;
+   auto const Csv = makeText(NRows);
+
+   auto whole = CsvReader::getDefaultOptions();
+   whole._maxThreads = 1uz;
+
+   auto chunked = CsvReader::getDefaultOptions();
+   chunked._minChunk_bytes = 4uz * 1024uz;
+
+   CsvReader one (whole  );
+   CsvReader many(chunked);
+   one .parse(Csv);
+   many.parse(Csv);
+
+   auto same = one.getNRows() == many.getNRows() && one.getColumns().size() == many.getColumns().size();
+   for (auto c = 0uz; same && c < one.getColumns().size(); ++c)
+   { // each column
+      same = isSameColumn(one.getColumns()[c], many.getColumns()[c]);
+   }
+
+   using enum CsvReader::ColumnType_T;
+   auto const & Cols = one.getColumns();
+   auto const TypesAsExpected = Cols.size() == 4uz &&
+      Cols[0]._type == Int64 && Cols[1]._type == Float64 && Cols[2]._type == Bool && Cols[3]._type == Text;
+
+   ymLog(VG::UnitTest_CsvReader, "Parsed {} rows in {} chunks", many.getNRows(), many.getNChunks());
+
+   return {
+      {"NRowsAsExpected", one.getNRows() == NRows          },
+      {"TypesAsExpected", TypesAsExpected                  },
+      {"Same",            same                             },
+      {"NChunks",         static_cast<uint64>(many.getNChunks())}
+   };
+}
+
+/** run
+ *
+ * @brief Checks that malformed rows are reported.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::BadRow::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_CsvReader);
+
+   // returns the error message, empty if none
+   auto const TryParse = [](std::string_view const Text, sizet const MinChunk_bytes) {
+      auto options = CsvReader::getDefaultOptions();
+      options._minChunk_bytes = MinChunk_bytes;
+
+      auto msg = std::string();
+      try
+      {
+         CsvReader reader(options);
+         reader.parse(Text);
+      }
+      catch (CsvReader::ParseError const & E)
+      {
+         ymLog(VG::UnitTest_CsvReader, "--> {}", E.what());
+         msg = E.what();
+      }
+      return msg;
+   };
+
+   auto const TooFew  = TryParse("a,b\n1,2\n3\n4,5\n",   1uz << 20uz);
+   auto const TooMany = TryParse("a,b\n1,2\n3,4,5,6\n",  1uz << 20uz);
+   auto const Fine    = TryParse("a,b\n1,2\n\n3,4",      1uz << 20uz);
+   auto const Late    = TryParse(makeText(20'000uz, 15'000uz), 4uz * 1024uz);
+
+   auto excBadDelim = false;
+   try
+   {
+      auto options = CsvReader::getDefaultOptions();
+      options._delim = '\n';
+      CsvReader reader(options);
+   }
+   catch (CsvReader::Error const & E)
+   {
+      ymLog(VG::UnitTest_CsvReader, "--> {}", E.what());
+      excBadDelim = true;
+   }
+
+   return {
+      {"TooFew",   TooFew .find("Line 3 has 1 fields")     != std::string::npos},
+      {"TooMany",  TooMany.find("Line 3 has 4 fields")     != std::string::npos},
+      {"Fine",     Fine.empty()                                               },
+      {"Late",     Late   .find("Line 15002 has 5 fields") != std::string::npos},
+      {"BadDelim", excBadDelim                                                }
+   };
+}
+
+/** run
+ *
+ * @brief Measures parsing speed, on one thread and on all of them.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Throughput::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_CsvReader);
+
+   auto const Text = makeText(1'000'000uz);
+
+   auto const TimeParse = [&Text](sizet const MaxThreads) {
+      auto options = CsvReader::getDefaultOptions();
+      options._maxThreads = MaxThreads;
+      CsvReader reader(options);
+
+      Timer timer;
+      reader.parse(Text);
+      auto const Elapsed_ns = static_cast<float64>(timer.getElapsedTime().count());
+
+      return static_cast<float64>(Text.size()) / Elapsed_ns * 1'000.0; // MB/s
+   };
+
+   auto const Single_MBps = TimeParse(1uz );
+   auto const Multi_MBps  = TimeParse(16uz);
+
+   ymLog(VG::UnitTest_CsvReader, "{:.1f} MB/s on one thread, {:.1f} MB/s on many", Single_MBps, Multi_MBps);
+
+   return {
+      {"Single_MBps", Single_MBps},
+      {"Multi_MBps",  Multi_MBps }
+   };
+}
@@ -0,0 +1,33 @@
+/**
+ * @file    testsuite.h
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#pragma once
+
+#include "ymdefs.h"
+
+#include "testsuitebase.h"
+
+namespace ym::unit
+{
+
+/** TestSuite
+ *
+ * @brief Test suite for CsvReader.
+ */
+class TestSuite : public TestSuiteBase
+{
+public:
+   explicit TestSuite(void);
+   virtual ~TestSuite(void) = default;
+
+   YM_UT_TESTCASE(ReadDump  )
+   YM_UT_TESTCASE(Typing    )
+   YM_UT_TESTCASE(Chunking  )
+   YM_UT_TESTCASE(BadRow    )
+   YM_UT_TESTCASE(Throughput)
+};
+
+} // ym::unit
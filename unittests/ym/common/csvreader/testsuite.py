@@ -0,0 +1,145 @@
+##
+# @file    testsuite.py
+# @version 1.0.0
+# @author  Forrest Jablonski
+#
+
+import glob
+import os
+import sys
+
+import ympyutils as ympy
+
+try:
+   import testsuitebase
+except:
+   print("Cannot import testsuitebase - path set correctly?")
+   sys.exit(1)
+
+try:
+   import cppyy
+except:
+   print("Cannot import cppyy - started the venv?")
+   sys.exit(1)
+
+class TestSuite(testsuitebase.TestSuiteBase):
+   """
+   Collection of all tests for CsvReader.
+   """
+   @classmethod
+   def setUpClass(cls):
+      """
+      Acting constructor.
+      """
+      super().setUpBaseClass(
+         filepath="ym/common",
+         filename="csvreader")
+
+   @classmethod
+   def tearDownClass(cls):
+      """
+      Acting destructor.
+      """
+      super().tearDownBaseClass()
+
+   def setUp(self):
+      """
+      Set up logic that is run before each test.
+      """
+      prev_files = glob.glob(os.path.join(self.unittestdir, "logs/csv_*.csv"))
+      if prev_files:
+         ympy.runCmd(f"rm -rf {' '.join(prev_files)}")
+
+   def tearDown(self):
+      """
+      Tear down logic that is run after each test.
+      """
+      pass
+
+   def test_ReadDump(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("ReadDump")
+
+      self.assertTrue(results.get[bool]("Read" ), "Dump not read")
+      self.assertTrue(results.get[bool]("Found"), "Columns missing")
+      self.assertTrue(results.get[bool]("TypesAsExpected"), "Columns not of expected types")
+
+      names, rows = ympy.load_datalogger_dump(os.path.join(self.unittestdir, "logs/csv_dump.csv"))
+
+      self.assertEqual([str(n) for n in results.get["std::vector<std::string>"]("Names")], names, "Names differ")
+      self.assertEqual(results.get[ym.uint64]("NRows"), len(rows), "Row counts differ")
+
+      cols = {name: [row[i] for row in rows] for i, name in enumerate(names)}
+
+      self.assertEqual(list(results.get["std::vector<ym::int64>"]("timestamp_ns")), [int(v) for v in cols["timestamp_ns"]], "Timestamps differ")
+      self.assertEqual(list(results.get["std::vector<ym::int64>"]("a")), [int(v) for v in cols["a"]], "Column a differs")
+      self.assertEqual(list(results.get["std::vector<double>"]("b")), [float(v) for v in cols["b"]], "Column b differs")
+      self.assertEqual(list(results.get["std::vector<bool>"]("c")), [v == "true" for v in cols["c"]], "Column c differs")
+
+   def test_Typing(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Typing")
+
+      self.assertTrue(results.get[bool]("ShapeAsExpected"), "Wrong # of rows or columns")
+      self.assertTrue(results.get[bool]("TypesAsExpected"), "Columns not of expected types")
+      self.assertTrue(results.get[bool]("ValsAsExpected" ), "Values not as expected")
+      self.assertTrue(results.get[bool]("NamesAsExpected"), "Columns not found by name")
+
+   def test_Chunking(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Chunking")
+
+      self.assertTrue(results.get[bool]("NRowsAsExpected"), "Wrong # of rows")
+      self.assertTrue(results.get[bool]("TypesAsExpected"), "Columns not of expected types")
+      self.assertTrue(results.get[bool]("Same"           ), "Chunked parse differs from whole parse")
+
+      print(f"parsed in {results.get[ym.uint64]('NChunks')} chunks")
+
+   def test_BadRow(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("BadRow")
+
+      self.assertTrue(results.get[bool]("TooFew"  ), "Short row not reported")
+      self.assertTrue(results.get[bool]("TooMany" ), "Long row not reported")
+      self.assertTrue(results.get[bool]("Fine"    ), "Well formed text reported")
+      self.assertTrue(results.get[bool]("Late"    ), "Malformed row in later chunk not reported correctly")
+      self.assertTrue(results.get[bool]("BadDelim"), "Newline delimiter accepted")
+
+   def test_Throughput(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Throughput")
+
+      single = results.get["double"]("Single_MBps")
+      multi  = results.get["double"]("Multi_MBps" )
+      print(f"parse: {single:.1f} MB/s on one thread, {multi:.1f} MB/s on many")
+
+# kick-off
+if __name__ == "__main__":
+   TestSuite.runSuite()
+else:
+   TestSuite.runSuite()
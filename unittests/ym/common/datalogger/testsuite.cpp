@@ -10,6 +10,12 @@
 #include "ymglobals.h"
 
 #include "datalogger.h" // Structures under test
+#include "timer.h"
+
+#include <cmath>
+#include <filesystem>
+#include <numeric>
+#include <system_error>
 
 /** TestSuite
  *
@@ -19,6 +25,10 @@ ym::unit::TestSuite::TestSuite(void) :
    TestSuiteBase("DataLogger")
 {
    addTestCase<InteractiveInspection>();
+   addTestCase<CrashDump            >();
+   addTestCase<Timestamps           >();
+   addTestCase<TimestampCost        >();
+   addTestCase<Stats                >();
 }
 
 /** run
@@ -61,3 +71,198 @@ auto ym::unit::TestSuite::InteractiveInspection::run([[maybe_unused]] DataShuttl
       {"Success", DataDumpSuccessful}
    };
 }
+
+/** run
+ *
+ * @brief Dumps an armed blackbox through the crash dump path.
+ * 
+ * @note The crash dump is invoked directly - we don't actually want to die.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::CrashDump::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_DataLogger);
+
+   constexpr auto MaxDepth = 8uz;
+   str const Filename = "logs/data_crash.bin";
+
+   DataLogger blackbox(MaxDepth);
+
+   auto a = 0_i32;
+   auto b = 0.0_f64;
+   blackbox.track("a", &a);
+   blackbox.track("b", &b);
+
+   auto const Armed = blackbox.armCrashDump(Filename);
+
+   for (auto i = 0uz; i < MaxDepth + 3uz; ++i)
+   { // force a rollover
+      blackbox.acquire();
+      a++;
+      b += 0.5;
+   }
+
+   auto const Dumped = blackbox.crashDump();
+
+   blackbox.reset(); // dying before the next acquire still dumps (the header - no rows left)
+   auto const DumpedAfterReset = blackbox.crashDump();
+
+   blackbox.disarmCrashDump();
+   auto const Disarmed = !blackbox.isCrashDumpArmed();
+
+   std::error_code ec;
+   auto const Size_bytes         = std::filesystem::file_size(Filename.get(), ec);
+   auto const ExpectedSize_bytes = 2uz * (sizeof("a,b\n") - 1uz) + MaxDepth * (sizeof(a) + sizeof(b));
+
+   return {
+      {"Armed",            Armed                                  },
+      {"Dumped",           Dumped                                 },
+      {"DumpedAfterReset", DumpedAfterReset                       },
+      {"Disarmed",         Disarmed                               },
+      {"SizeAsExpected",   !ec && Size_bytes == ExpectedSize_bytes}
+   };
+}
+
+/** run
+ *
+ * @brief Dumps two timestamped loggers sampled in an interleaved fashion.
+ * 
+ * @note The python side merges the dumps and checks the timeline.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Timestamps::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_DataLogger);
+
+   DataLogger fast(16uz);
+   DataLogger slow(16uz);
+
+   auto a = 0_i32;
+   auto b = 0.0_f64;
+   fast.track("a", &a);
+   slow.track("b", &b);
+   fast.trackTimestamp();
+   slow.trackTimestamp();
+
+   for (auto i = 0uz; i < 10uz; ++i)
+   { // slow logger samples every other iteration
+      fast.acquire();
+      if (i % 2uz == 0uz)
+      { // slow sample
+         slow.acquire();
+      }
+      a++;
+      b += 0.5;
+   }
+
+   auto options = DataLogger::getDefaultOptions();
+   options._openingOptions._filenameMode  = Logger::FilenameMode_T::KeepOriginal;
+   options._openingOptions._overwriteMode = Logger::OverwriteMode_T::Allow;
+   auto const FastDumped = fast.dump("logs/data_fast.csv", options);
+
+   options._dumpMode = DataLogger::DumpMode_T::Binary;
+   auto const SlowDumped = slow.dump("logs/data_slow.bin", options);
+
+   return {
+      {"Timestamped", fast.isTimestamped() && slow.isTimestamped()},
+      {"Dumped",      FastDumped && SlowDumped                    }
+   };
+}
+
+/** run
+ *
+ * @brief Measures the cost of stamping rows.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::TimestampCost::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_DataLogger);
+
+   constexpr auto NAcquires = 1'000'000uz;
+
+   auto const TimeAcquires = [](bool const Timestamped) {
+      DataLogger blackbox(1024uz);
+
+      auto a = 0_i32;
+      auto b = 0.0_f64;
+      blackbox.track("a", &a);
+      blackbox.track("b", &b);
+      if (Timestamped)
+      { // hidden column
+         blackbox.trackTimestamp();
+      }
+      (void)blackbox.ready();
+
+      Timer timer;
+      for (auto i = 0uz; i < NAcquires; ++i)
+      { // hot loop
+         blackbox.acquire();
+         a++;
+      }
+
+      return static_cast<float64>(timer.getElapsedTime().count()) / static_cast<float64>(NAcquires);
+   };
+
+   auto const Plain_ns       = TimeAcquires(false);
+   auto const Timestamped_ns = TimeAcquires(true );
+
+   ymLog(VG::UnitTest_DataLogger, "acquire() {:.1f} ns, timestamped {:.1f} ns", Plain_ns, Timestamped_ns);
+
+   return {
+      {"Plain_ns",       Plain_ns      },
+      {"Timestamped_ns", Timestamped_ns}
+   };
+}
+
+/** run
+ *
+ * @brief Verifies streaming statistics against known values.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Stats::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_DataLogger);
+
+   DataLogger blackbox(8uz);
+
+   auto a = 0_i32;
+   auto b = 1.0_f32;
+   blackbox.track("a", &a);
+   blackbox.track("b", &b);
+   blackbox.trackStats("a", 0.0, 100.0);
+   blackbox.trackStats("b", 0.0,   2.0);
+
+   for (auto i = 0; i < 100; ++i)
+   { // a in [0, 99], b constant
+      a = i;
+      blackbox.acquire();
+   }
+
+   auto const A = blackbox.getStats("a");
+   auto const B = blackbox.getStats("b");
+
+   auto const Near = [](float64 const X, float64 const Y) { return std::abs(X - Y) < 1e-9; };
+
+   auto const StatsAsExpected =
+      A._count == 100_u64 && Near(A._min, 0.0) && Near(A._max, 99.0) &&
+      Near(A._mean, 49.5) && Near(A._variance, 100.0 * 101.0 / 12.0);
+
+   auto const HistAsExpected =
+      std::accumulate(A._hist.cbegin(), A._hist.cend(), 0_u64) == 100_u64 &&
+      A._hist.front() == 7_u64 && A._hist.back() == 6_u64              &&
+      B._hist[DataLogger::_s_NHistBins / 2uz] == 100_u64               &&
+      Near(B._variance, 0.0);
+
+   blackbox.resetStats();
+   auto const ResetAsExpected = blackbox.getStats("a")._count == 0_u64;
+
+   return {
+      {"StatsAsExpected", StatsAsExpected},
+      {"HistAsExpected",  HistAsExpected },
+      {"ResetAsExpected", ResetAsExpected}
+   };
+}
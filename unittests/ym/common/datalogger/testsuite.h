@@ -24,6 +24,10 @@ public:
    virtual ~TestSuite(void) = default;
 
    YM_UT_TESTCASE(InteractiveInspection)
+   YM_UT_TESTCASE(CrashDump            )
+   YM_UT_TESTCASE(Timestamps           )
+   YM_UT_TESTCASE(TimestampCost        )
+   YM_UT_TESTCASE(Stats                )
 };
 
 } // ym::unit
@@ -46,7 +46,8 @@ class TestSuite(testsuitebase.TestSuiteBase):
       """
       Set up logic that is run before each test.
       """
-      prev_files = glob.glob(os.path.join(self.unittestdir, "logs/data*.csv"))
+      prev_files = glob.glob(os.path.join(self.unittestdir, "logs/data*.csv")) + \
+                   glob.glob(os.path.join(self.unittestdir, "logs/data*.bin"))
       if prev_files:
          ympy.runCmd(f"rm -rf {' '.join(prev_files)}")
 
@@ -66,6 +67,73 @@ class TestSuite(testsuitebase.TestSuiteBase):
       # uncomment to run test
       results = self.run_test_case("InteractiveInspection")
 
+   def test_CrashDump(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("CrashDump")
+
+      self.assertTrue(results.get[bool]("Armed"         ), "Crash dump failed to arm")
+      self.assertTrue(results.get[bool]("Dumped"        ), "Crash dump failed to write")
+      self.assertTrue(results.get[bool]("DumpedAfterReset"), "Crash dump failed to write after a reset")
+      self.assertTrue(results.get[bool]("Disarmed"      ), "Crash dump failed to disarm")
+      self.assertTrue(results.get[bool]("SizeAsExpected"), "Crash dump not of expected size")
+
+   def test_Timestamps(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Timestamps")
+
+      self.assertTrue(results.get[bool]("Timestamped"), "Timestamps not tracked")
+      self.assertTrue(results.get[bool]("Dumped"     ), "Timestamped dumps failed")
+
+      fast = os.path.join(self.unittestdir, "logs/data_fast.csv")
+      slow = os.path.join(self.unittestdir, "logs/data_slow.bin")
+
+      names, rows = ympy.load_datalogger_dump(fast)
+      self.assertEqual(names, ["timestamp_ns", "a"], "Timestamp not the first column")
+
+      merged = os.path.join(self.unittestdir, "logs/data_merged.csv")
+      n_rows = ympy.merge_datalogger_dumps([fast, slow], merged, binary_formats={slow: "=qd"})
+      self.assertEqual(n_rows, 15, "Merged dump missing rows")
+
+      _, rows = ympy.load_datalogger_dump(merged)
+      stamps  = [int(r[0]) for r in rows]
+      self.assertEqual(stamps, sorted(stamps), "Merged timeline not monotonic")
+
+   def test_TimestampCost(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("TimestampCost")
+
+      plain       = results.get["double"]("Plain_ns"      )
+      timestamped = results.get["double"]("Timestamped_ns")
+      print(f"acquire(): {plain:.1f} ns, timestamped: {timestamped:.1f} ns (+{timestamped - plain:.1f} ns)")
+
+   def test_Stats(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Stats")
+
+      self.assertTrue(results.get[bool]("StatsAsExpected"), "Running statistics not as expected")
+      self.assertTrue(results.get[bool]("HistAsExpected" ), "Histogram not as expected")
+      self.assertTrue(results.get[bool]("ResetAsExpected"), "Statistics not reset")
+
 # kick-off
 if __name__ == "__main__":
    TestSuite.runSuite()
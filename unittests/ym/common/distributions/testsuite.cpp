@@ -0,0 +1,388 @@
+/**
+ * @file    testsuite.cpp
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#include "testsuite.h"
+
+#include "textlogger.h"
+#include "timer.h"
+#include "ymglobals.h"
+
+#include "distributions.h" // Structures under test
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+/** moments
+ *
+ * @brief Sample mean and variance.
+ *
+ * @param Vals -- Samples.
+ *
+ * @returns std::pair<float64, float64> -- Mean and variance.
+ */
+std::pair<ym::float64, ym::float64> moments(std::vector<ym::float64> const & Vals)
+{
+   using namespace ym;
+
+   auto sum  = 0.0_f64;
+   auto sum2 = 0.0_f64;
+   for (auto const Val : Vals)
+   { // accumulate
+      sum  += Val;
+      sum2 += Val * Val;
+   }
+
+   auto const N    = static_cast<float64>(Vals.size());
+   auto const Mean = sum / N;
+   return {Mean, (sum2 / N) - (Mean * Mean)};
+}
+
+/** hashOf
+ *
+ * @brief FNV-1a hash of the bit patterns of a sequence.
+ *
+ * @tparam T -- Type of value.
+ *
+ * @param Vals -- Values to hash.
+ *
+ * @returns uint64 -- Hash.
+ */
+template <typename T>
+ym::uint64 hashOf(std::vector<T> const & Vals)
+{
+   using namespace ym;
+
+   auto hash = 0xcbf2'9ce4'8422'2325_u64;
+   for (auto const Val : Vals)
+   { // each value
+      auto const Bits = std::bit_cast<uint64>(Val);
+      for (auto i = 0_u64; i < 64_u64; i += 8_u64)
+      { // each byte
+         hash ^= (Bits >> i) & 0xff_u64;
+         hash *= 0x100'0000'01b3_u64;
+      }
+   }
+   return hash;
+}
+
+} // anonymous
+
+/** TestSuite
+ *
+ * @brief Constructor.
+ */
+ym::unit::TestSuite::TestSuite(void) :
+   TestSuiteBase("Distributions")
+{
+   addTestCase<UniformInt      >();
+   addTestCase<Normal          >();
+   addTestCase<Exponential     >();
+   addTestCase<Bernoulli       >();
+   addTestCase<FillMatchesCalls>();
+   addTestCase<Reproducible    >();
+   addTestCase<Speed           >();
+}
+
+/** run
+ *
+ * @brief Draws bounded integers and bins them.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::UniformInt::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   constexpr auto NDraws = 7'000'000uz;
+
+   Prng rand;
+   UniformIntDist const Dist(-3_i64, 3_i64);
+
+   auto bins    = std::vector<uint64>(7uz, 0_u64);
+   auto inRange = true;
+   for (auto i = 0uz; i < NDraws; ++i)
+   { // draw and bin
+      auto const Val = Dist(rand);
+      inRange &= Val >= -3_i64 && Val <= 3_i64;
+      bins[static_cast<sizet>(std::clamp(Val, -3_i64, 3_i64) + 3_i64)] += 1_u64;
+   }
+
+   auto chiSq = 0.0_f64;
+   for (auto const Bin : bins)
+   { // pearson's statistic
+      auto const Expected = static_cast<float64>(NDraws) / 7.0_f64;
+      auto const Diff     = static_cast<float64>(Bin) - Expected;
+      chiSq += (Diff * Diff) / Expected;
+   }
+
+   UniformIntDist const Single(5_i64, 5_i64);
+   UniformIntDist const Full(std::numeric_limits<int64>::min(), std::numeric_limits<int64>::max());
+
+   auto hitsHigh = false;
+   auto hitsLow  = false;
+   for (auto i = 0uz; i < 64uz; ++i)
+   { // full range draws should land everywhere
+      auto const Val = Full(rand);
+      hitsHigh |= Val > 0_i64;
+      hitsLow  |= Val < 0_i64;
+   }
+
+   return {
+      {"InRange",  inRange              },
+      {"ChiSq",    chiSq                },
+      {"Single",   Single(rand) == 5_i64},
+      {"FullSpan", hitsHigh && hitsLow  }
+   };
+}
+
+/** run
+ *
+ * @brief Checks the first four moments and the tail of the normal distribution.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Normal::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   Prng rand;
+   NormalDist const Dist;
+
+   auto vals = std::vector<float64>(10'000'000uz);
+   Dist.fill(rand, vals);
+
+   auto const [Mean, Var] = moments(vals);
+
+   auto skew  = 0.0_f64;
+   auto kurt  = 0.0_f64;
+   auto nTail = 0uz;
+   for (auto const Val : vals)
+   { // standardized moments (mean ~0, variance ~1)
+      skew += Val * Val * Val;
+      kurt += Val * Val * Val * Val;
+      nTail += (std::abs(Val) > 3.442619855899_f64) ? 1uz : 0uz; // only reachable through the tail
+   }
+
+   auto const N = static_cast<float64>(vals.size());
+
+   NormalDist const Shifted(10.0_f64, 0.5_f64);
+   auto shifted = std::vector<float64>(1'000'000uz);
+   Shifted.fill(rand, shifted);
+
+   auto const [ShiftedMean, ShiftedVar] = moments(shifted);
+
+   return {
+      {"Mean",        Mean                                              },
+      {"Var",         Var                                               },
+      {"Skew",        skew / N                                          },
+      {"Kurt",        kurt / N                                          },
+      {"TailFrac",    static_cast<float64>(nTail) / N                   },
+      {"ExpTailFrac", std::erfc(3.442619855899_f64 / std::sqrt(2.0_f64))},
+      {"ShiftedMean", ShiftedMean                                       },
+      {"ShiftedStd",  std::sqrt(ShiftedVar)                             }
+   };
+}
+
+/** run
+ *
+ * @brief Checks mean and variance of the exponential distribution.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Exponential::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   Prng rand;
+   ExponentialDist const Dist(4.0_f64);
+
+   auto vals = std::vector<float64>(10'000'000uz);
+   Dist.fill(rand, vals);
+
+   auto const [Mean, Var] = moments(vals);
+
+   return {
+      {"Mean",        Mean                                                      },
+      {"Var",         Var                                                       },
+      {"NonNegative", std::ranges::all_of(vals, [](auto V) { return V >= 0.0; })}
+   };
+}
+
+/** run
+ *
+ * @brief Checks the frequency of successes.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Bernoulli::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   constexpr auto NDraws = 10'000'000uz;
+
+   Prng rand;
+   BernoulliDist const Dist  (0.3_f64);
+   BernoulliDist const Never (0.0_f64);
+   BernoulliDist const Always(1.0_f64);
+
+   auto nTrue   = 0uz;
+   auto nNever  = 0uz;
+   auto nAlways = 0uz;
+   for (auto i = 0uz; i < NDraws; ++i)
+   { // draw
+      nTrue   += Dist  (rand) ? 1uz : 0uz;
+      nNever  += Never (rand) ? 1uz : 0uz;
+      nAlways += Always(rand) ? 1uz : 0uz;
+   }
+
+   return {
+      {"Frac",   static_cast<float64>(nTrue) / static_cast<float64>(NDraws)},
+      {"Never",  nNever  == 0uz                                            },
+      {"Always", nAlways == NDraws                                         }
+   };
+}
+
+/** run
+ *
+ * @brief Checks bulk draws yield the same values as one at a time draws.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::FillMatchesCalls::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   constexpr auto N = 1'001uz; // straddles the buffer size
+
+   auto const Matches = []<typename T>(auto const & Dist, std::vector<T> vals) {
+      Prng bulk  (0xabcd_u64);
+      Prng single(0xabcd_u64);
+
+      Dist.fill(bulk, vals);
+
+      auto same = std::ranges::all_of(vals, [&](T const Val) { return Val == Dist(single); });
+      return same && bulk.getState() == single.getState();
+   };
+
+   auto const BoolsMatch = [&]() { // vector<bool> has no span
+      auto const Dist = BernoulliDist(0.5_f64);
+      auto vals = std::unique_ptr<bool[]>(new bool[N]);
+
+      Prng bulk  (0xabcd_u64);
+      Prng single(0xabcd_u64);
+
+      Dist.fill(bulk, std::span(vals.get(), N));
+
+      auto same = std::all_of(vals.get(), vals.get() + N, [&](bool const Val) { return Val == Dist(single); });
+      return same && bulk.getState() == single.getState();
+   };
+
+   return {
+      {"UniformInt",  Matches(UniformIntDist(0_i64, 6_i64), std::vector<int64  >(N))},
+      {"Normal",      Matches(NormalDist(),                 std::vector<float64>(N))},
+      {"Exponential", Matches(ExponentialDist(),            std::vector<float64>(N))},
+      {"Bernoulli",   BoolsMatch()                                                  }
+   };
+}
+
+/** run
+ *
+ * @brief Hashes fixed-seed sequences - any platform must produce the same hashes.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Reproducible::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   constexpr auto N = 10'000uz;
+
+   Prng rand(42_u64);
+
+   auto ints = std::vector<int64  >(N);
+   auto nrms = std::vector<float64>(N);
+   auto exps = std::vector<float64>(N);
+   auto bers = std::vector<uint64 >(N);
+
+   UniformIntDist  const Uniform(-1'000_i64, 1'000_i64);
+   NormalDist      const Normal (1.5_f64, 2.0_f64);
+   ExponentialDist const Expo   (0.5_f64);
+   BernoulliDist   const Bern   (0.25_f64);
+
+   std::ranges::generate(ints, [&]() { return Uniform(rand); });
+   std::ranges::generate(nrms, [&]() { return Normal (rand); });
+   std::ranges::generate(exps, [&]() { return Expo   (rand); });
+   std::ranges::generate(bers, [&]() { return Bern   (rand) ? 1_u64 : 0_u64; });
+
+   return {
+      {"UniformInt",  hashOf(ints) == 0x6a18'dd4f'3aec'1968_u64},
+      {"Normal",      hashOf(nrms) == 0x04c1'166a'8cd3'df22_u64},
+      {"Exponential", hashOf(exps) == 0xb127'1573'b737'4741_u64},
+      {"Bernoulli",   hashOf(bers) == 0xd6e2'b74a'a535'6185_u64}
+   };
+}
+
+/** run
+ *
+ * @brief Times bulk draws against the standard library distributions.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Speed::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   constexpr auto NVals   = 4'096uz;
+   constexpr auto NRounds = 500uz;
+
+   auto const PerVal_ns = [](Timer const & T) {
+      return static_cast<float64>(T.getElapsedTime().count()) / static_cast<float64>(NVals * NRounds);
+   };
+
+   Prng rand;
+   std::mt19937_64 mt;
+   auto reals = std::vector<float64>(NVals);
+   auto ints  = std::vector<int64  >(NVals);
+
+   NormalDist const Normal;
+   std::normal_distribution<float64> stdNormal;
+
+   Timer normalTimer;
+   for (auto r = 0uz; r < NRounds; ++r) { Normal.fill(rand, reals); }
+   auto const Normal_ns = PerVal_ns(normalTimer);
+
+   Timer stdNormalTimer;
+   for (auto r = 0uz; r < NRounds; ++r) { std::ranges::generate(reals, [&]() { return stdNormal(mt); }); }
+   auto const StdNormal_ns = PerVal_ns(stdNormalTimer);
+
+   UniformIntDist const Uniform(0_i64, 999_i64);
+   std::uniform_int_distribution<int64> stdUniform(0_i64, 999_i64);
+
+   Timer uniformTimer;
+   for (auto r = 0uz; r < NRounds; ++r) { Uniform.fill(rand, ints); }
+   auto const Uniform_ns = PerVal_ns(uniformTimer);
+
+   Timer stdUniformTimer;
+   for (auto r = 0uz; r < NRounds; ++r) { std::ranges::generate(ints, [&]() { return stdUniform(mt); }); }
+   auto const StdUniform_ns = PerVal_ns(stdUniformTimer);
+
+   ymLog(VG::UnitTest_Rng, "normal {:.2f} ns (std {:.2f}), uniform int {:.2f} ns (std {:.2f})",
+      Normal_ns, StdNormal_ns, Uniform_ns, StdUniform_ns);
+
+   return {
+      {"Normal_ns",     Normal_ns    },
+      {"StdNormal_ns",  StdNormal_ns },
+      {"Uniform_ns",    Uniform_ns   },
+      {"StdUniform_ns", StdUniform_ns}
+   };
+}
@@ -0,0 +1,35 @@
+/**
+ * @file    testsuite.h
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#pragma once
+
+#include "ymdefs.h"
+
+#include "testsuitebase.h"
+
+namespace ym::unit
+{
+
+/** TestSuite
+ *
+ * @brief Test suite for Distributions.
+ */
+class TestSuite : public TestSuiteBase
+{
+public:
+   explicit TestSuite(void);
+   virtual ~TestSuite(void) = default;
+
+   YM_UT_TESTCASE(UniformInt      )
+   YM_UT_TESTCASE(Normal          )
+   YM_UT_TESTCASE(Exponential     )
+   YM_UT_TESTCASE(Bernoulli       )
+   YM_UT_TESTCASE(FillMatchesCalls)
+   YM_UT_TESTCASE(Reproducible    )
+   YM_UT_TESTCASE(Speed           )
+};
+
+} // ym::unit
@@ -0,0 +1,164 @@
+##
+# @file    testsuite.py
+# @version 1.0.0
+# @author  Forrest Jablonski
+#
+
+import sys
+
+try:
+   import testsuitebase
+except:
+   print("Cannot import testsuitebase - path set correctly?")
+   sys.exit(1)
+
+try:
+   import cppyy
+except:
+   print("Cannot import cppyy - started the venv?")
+   sys.exit(1)
+
+class TestSuite(testsuitebase.TestSuiteBase):
+   """
+   Collection of all tests for Distributions.
+   """
+
+   @classmethod
+   def setUpClass(cls):
+      """
+      Acting constructor.
+      """
+      super().setUpBaseClass(
+         filepath="ym/common/",
+         filename="distributions")
+
+   @classmethod
+   def tearDownClass(cls):
+      """
+      Acting destructor.
+      """
+      pass
+
+   def setUp(self):
+      """
+      Set up logic that is run before each test.
+      """
+      pass
+
+   def tearDown(self):
+      """
+      Tear down logic that is run after each test.
+      """
+      pass
+
+   def test_UniformInt(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("UniformInt")
+
+      chiSq = results.get["double"]("ChiSq")
+      print(f"chi-squared of 7 bins {chiSq:.3f}")
+
+      self.assertTrue(results.get[bool]("InRange" ), "Value outside of [lo..hi]"           )
+      self.assertTrue(results.get[bool]("Single"  ), "Single value range gave other value")
+      self.assertTrue(results.get[bool]("FullSpan"), "Full range stuck on one side"       )
+      self.assertLess(chiSq, 22.46, "Bins not uniform (p < 0.001, 6 dof)")
+
+   def test_Normal(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Normal")
+
+      tailFrac    = results.get["double"]("TailFrac"   )
+      expTailFrac = results.get["double"]("ExpTailFrac")
+      print(f"tail fraction {tailFrac:.6f} (expected {expTailFrac:.6f})")
+
+      self.assertAlmostEqual(results.get["double"]("Mean"       ),  0.0, delta=0.002, msg="Mean off"          )
+      self.assertAlmostEqual(results.get["double"]("Var"        ),  1.0, delta=0.002, msg="Variance off"      )
+      self.assertAlmostEqual(results.get["double"]("Skew"       ),  0.0, delta=0.005, msg="Skewness off"      )
+      self.assertAlmostEqual(results.get["double"]("Kurt"       ),  3.0, delta=0.01,  msg="Kurtosis off"      )
+      self.assertAlmostEqual(results.get["double"]("ShiftedMean"), 10.0, delta=0.005, msg="Shifted mean off"  )
+      self.assertAlmostEqual(results.get["double"]("ShiftedStd" ),  0.5, delta=0.002, msg="Shifted std dev off")
+      self.assertAlmostEqual(tailFrac, expTailFrac, delta=5e-5, msg="Tail beyond the base layer misweighted")
+
+   def test_Exponential(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Exponential")
+
+      self.assertTrue(results.get[bool]("NonNegative"), "Negative value drawn")
+      self.assertAlmostEqual(results.get["double"]("Mean"), 0.25,   delta=0.001, msg="Mean off"    )
+      self.assertAlmostEqual(results.get["double"]("Var" ), 0.0625, delta=0.001, msg="Variance off")
+
+   def test_Bernoulli(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Bernoulli")
+
+      self.assertTrue(results.get[bool]("Never" ), "P = 0 gave true" )
+      self.assertTrue(results.get[bool]("Always"), "P = 1 gave false")
+      self.assertAlmostEqual(results.get["double"]("Frac"), 0.3, delta=0.001, msg="Frequency off")
+
+   def test_FillMatchesCalls(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("FillMatchesCalls")
+
+      for dist in ["UniformInt", "Normal", "Exponential", "Bernoulli"]:
+         self.assertTrue(results.get[bool](dist), f"{dist} fill() differs from one at a time draws")
+
+   def test_Reproducible(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Reproducible")
+
+      for dist in ["UniformInt", "Normal", "Exponential", "Bernoulli"]:
+         self.assertTrue(results.get[bool](dist), f"{dist} sequence changed for a fixed seed")
+
+   def test_Speed(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Speed")
+
+      normal     = results.get["double"]("Normal_ns"    )
+      stdNormal  = results.get["double"]("StdNormal_ns" )
+      uniform    = results.get["double"]("Uniform_ns"   )
+      stdUniform = results.get["double"]("StdUniform_ns")
+      print(f"normal: {normal:.3f} ns/val (std {stdNormal:.3f}), uniform int: {uniform:.3f} ns/val (std {stdUniform:.3f})")
+
+      self.assertLess(normal,  stdNormal,  "Ziggurat slower than std::normal_distribution"     )
+      self.assertLess(uniform, stdUniform, "Lemire slower than std::uniform_int_distribution")
+
+# kick-off
+if __name__ == "__main__":
+   TestSuite.runSuite()
+else:
+   TestSuite.runSuite()
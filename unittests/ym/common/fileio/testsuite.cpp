@@ -11,6 +11,20 @@
 
 #include "fileio.h" // Structures under test
 
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 /** TestSuite
  *
  * @brief Constructor.
@@ -19,6 +33,13 @@ ym::unit::TestSuite::TestSuite(void) :
    TestSuiteBase("FileIO")
 {
    addTestCase<InteractiveInspection>();
+   addTestCase<MapRegularFile       >();
+   addTestCase<MapSpecialFile       >();
+   addTestCase<BufferFromArena      >();
+   addTestCase<FindDelim            >();
+   addTestCase<StreamLines          >();
+   addTestCase<LoadMany             >();
+   addTestCase<AtomicWrite          >();
 }
 
 /** run
@@ -42,3 +63,292 @@ auto ym::unit::TestSuite::InteractiveInspection::run([[maybe_unused]] DataShuttl
       {"E0", firstChar}
    };
 }
+
+/** run
+ *
+ * @brief Maps a regular file and verifies the view (and that it survives a move).
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::MapRegularFile::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_FileIO);
+
+   auto const     Filename = "logs/fileio_map.txt";
+   constexpr auto Contents = std::string_view("mapped, not copied\nsecond line\n");
+
+   { // write file
+      std::ofstream outfile(Filename);
+      outfile << Contents;
+   }
+
+   auto file = FileIO::mapFile(Filename);
+
+   auto const Mapped = file && file->isMapped();
+   auto const Equal  = file && file->getView() == Contents;
+
+   auto moved = FileIO::MappedFile();
+   if (file)
+   { // take over the mapping
+      moved = std::move(*file);
+   }
+
+   return {
+      {"Mapped",     Mapped                                                  },
+      {"Equal",      Equal                                                   },
+      {"MovedEqual", file && moved.getView() == Contents && !file->isMapped()}
+   };
+}
+
+/** run
+ *
+ * @brief Maps a special file (size 0 as reported by stat) - falls back to reading it in.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::MapSpecialFile::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_FileIO);
+
+   auto const File = FileIO::mapFile("/proc/self/status");
+
+   return {
+      {"Opened",   File.has_value()                            },
+      {"Buffered", File && !File->isMapped()                   },
+      {"Contents", File && File->getView().starts_with("Name:")}
+   };
+}
+
+/** run
+ *
+ * @brief Reads files into a caller supplied arena (known and unknown size).
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::BufferFromArena::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_FileIO);
+
+   auto const     Filename = "logs/fileio_arena.txt";
+   constexpr auto Contents = std::string_view("read into an arena\n");
+
+   { // write file
+      std::ofstream outfile(Filename);
+      outfile << Contents;
+   }
+
+   std::array<byte, 256uz * 1024uz> arena;
+   std::pmr::monotonic_buffer_resource mbr(arena.data(), arena.size(), std::pmr::null_memory_resource());
+
+   auto const Known   = FileIO::createFileBuffer(Filename,            &mbr);
+   auto const Unknown = FileIO::createFileBuffer("/proc/self/status", &mbr); // reports a size of 0
+
+   return {
+      {"KnownEqual",     Known   && *Known == Contents                         },
+      {"KnownInArena",   Known   && Known  ->get_allocator().resource() == &mbr},
+      {"UnknownRead",    Unknown && Unknown->starts_with("Name:")              },
+      {"UnknownInArena", Unknown && Unknown->get_allocator().resource() == &mbr}
+   };
+}
+
+/** run
+ *
+ * @brief Compares the vectorized delimiter search against std::find at every alignment.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::FindDelim::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_FileIO);
+
+   auto text = std::string(200uz, 'a');
+   auto allMatch = true;
+
+   for (auto pos = 0uz; pos <= text.size(); ++pos)
+   { // delimiter at every position (or none at all)
+      std::ranges::fill(text, 'a');
+      if (pos < text.size())
+      { // place delimiter
+         text[pos] = '\n';
+      }
+
+      for (auto first = 0uz; first < 40uz; ++first)
+      { // every alignment of the search
+         auto const * const First_Ptr = text.data() + first;
+         auto const * const Last_Ptr  = text.data() + text.size();
+         allMatch = allMatch &&
+            FileIO::findDelim(First_Ptr, Last_Ptr, '\n') == std::find(First_Ptr, Last_Ptr, '\n');
+      }
+   }
+
+   return {
+      {"AllMatch", allMatch}
+   };
+}
+
+/** run
+ *
+ * @brief Streams lines through chunks much smaller than (some of) the lines.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::StreamLines::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_FileIO);
+
+   auto const Filename = "logs/fileio_lines.txt";
+
+   auto expected = std::vector<std::string>();
+   for (auto i = 0uz; i <= 100uz; ++i)
+   { // short, empty, and long lines (last one is long)
+      expected.emplace_back(i % 10uz == 0uz ? 50uz + i : i % 3uz, static_cast<char>('a' + (i % 26uz)));
+   }
+
+   { // write file - last line unterminated
+      std::ofstream outfile(Filename);
+      for (auto i = 0uz; i < expected.size(); ++i)
+      { // each line
+         outfile << expected[i] << (i + 1uz < expected.size() ? "\n" : "");
+      }
+   }
+
+   FileIO::ChunkReader reader(7uz);
+   auto const Opened = reader.open(Filename);
+
+   FileIO::LineReader lines(reader);
+   auto actual = std::vector<std::string>();
+   while (auto const Line = lines.next())
+   { // collect
+      actual.emplace_back(*Line);
+   }
+
+   return {
+      {"Opened",     Opened                              },
+      {"LinesEqual", actual == expected                  },
+      {"CleanEOF",   reader.isEOF() && !reader.hasError()}
+   };
+}
+
+/** run
+ *
+ * @brief Loads a batch of files (one missing) both ways and verifies contents and status.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::LoadMany::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_FileIO);
+
+   auto filenames = std::vector<std::string>();
+   auto expected  = std::vector<std::string>();
+
+   for (auto i = 0uz; i < 32uz; ++i)
+   { // files of varying size (some empty)
+      filenames.emplace_back(fmt::format("logs/fileio_many_{}.txt", i));
+      expected .emplace_back(i * i * 97uz, static_cast<char>('a' + (i % 26uz)));
+
+      std::ofstream outfile(filenames.back());
+      outfile << expected.back();
+   }
+
+   filenames.emplace_back("logs/fileio_many_missing.txt");
+   std::filesystem::remove(filenames.back());
+
+   auto names = std::vector<str>();
+   for (auto const & Filename : filenames)
+   { // FileIO takes null terminated names
+      names.emplace_back(Filename.c_str());
+   }
+
+   auto const Check = [&expected](std::pmr::vector<FileIO::Loaded_T> const & Loaded) {
+      auto allEqual = Loaded.size() == expected.size() + 1uz;
+      for (auto i = 0uz; allEqual && i < expected.size(); ++i)
+      { // each file that exists
+         allEqual = Loaded[i].isOk() && Loaded[i]._contents == expected[i];
+      }
+      return allEqual && Loaded.back()._error == ENOENT;
+   };
+
+   std::pmr::monotonic_buffer_resource autoArena;
+   auto const AutoOk = Check(FileIO::loadMany(names, &autoArena));
+
+   std::pmr::monotonic_buffer_resource poolArena;
+   auto const PoolOk = Check(FileIO::loadMany(names, &poolArena, FileIO::LoadMode_T::ThreadPool));
+
+   return {
+      {"AutoEqual", AutoOk},
+      {"PoolEqual", PoolOk}
+   };
+}
+
+/** run
+ *
+ * @brief Writes a file through Writer (small and large writes) - the old contents must
+ *        survive until commit, an aborted write must leave no trace, and the replaced
+ *        file's permissions must carry over.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::AtomicWrite::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_FileIO);
+
+   auto const Filename = "logs/fileio_atomic.txt";
+
+   auto const Slurp = [Filename](void) {
+      std::ifstream infile(Filename, std::ios::binary);
+      return std::string(std::istreambuf_iterator<char>(infile), std::istreambuf_iterator<char>());
+   };
+
+   auto const CountFiles = [](void) {
+      return std::distance(std::filesystem::directory_iterator("logs"), std::filesystem::directory_iterator());
+   };
+
+   auto options = FileIO::getDefaultWriteOptions();
+   options._buffer_bytes = 16uz * 1024uz; // small so we exercise both paths
+   options._direct       = true;          // falls back to buffered where unsupported
+
+   { // old version
+      std::ofstream outfile(Filename);
+      outfile << "old";
+   }
+
+   namespace fs = std::filesystem;
+   auto const OldPerms = fs::perms::owner_all; // eg a private executable
+   fs::permissions(Filename, OldPerms);
+
+   auto const NFiles = CountFiles();
+
+   auto expected = std::string();
+   auto writer   = FileIO::Writer(options);
+   auto opened   = writer.open(Filename);
+   auto written  = true;
+
+   for (auto i = 0uz; i < 1000uz; ++i)
+   { // mostly small pieces, some larger than the buffer
+      auto const Piece = std::string(i % 100uz == 0uz ? 40'000uz : i % 17uz, static_cast<char>('a' + (i % 26uz)));
+      expected += Piece;
+      written   = writer.write(Piece) && written;
+   }
+
+   auto const OldWhileOpen = Slurp() == "old";
+   auto const Committed    = writer.commit();
+   auto const NewEqual     = Slurp() == expected;
+   auto const KeptPerms    = fs::status(Filename).permissions() == OldPerms;
+
+   { // abandon a write
+      auto aborted = FileIO::Writer(options);
+      opened = aborted.open(Filename) && opened;
+      (void)aborted.write("garbage");
+   }
+
+   return {
+      {"Opened",       opened                                                   },
+      {"Written",      written                                                  },
+      {"OldWhileOpen", OldWhileOpen                                             },
+      {"Committed",    Committed && writer.getBytesWritten() == expected.size() },
+      {"NewEqual",     NewEqual                                                 },
+      {"KeptPerms",    KeptPerms                                                },
+      {"AbortClean",   Slurp() == expected && CountFiles() == NFiles            }
+   };
+}
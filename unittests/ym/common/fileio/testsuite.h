@@ -24,6 +24,13 @@ public:
    virtual ~TestSuite(void) = default;
 
    YM_UT_TESTCASE(InteractiveInspection)
+   YM_UT_TESTCASE(MapRegularFile       )
+   YM_UT_TESTCASE(MapSpecialFile       )
+   YM_UT_TESTCASE(BufferFromArena      )
+   YM_UT_TESTCASE(FindDelim            )
+   YM_UT_TESTCASE(StreamLines          )
+   YM_UT_TESTCASE(LoadMany             )
+   YM_UT_TESTCASE(AtomicWrite          )
 };
 
 } // ym::unit
@@ -63,6 +63,99 @@ class TestSuite(testsuitebase.TestSuiteBase):
 
       print(f"--> {results.get[cppyy.gbl.char]('E0')}")
 
+   def test_MapRegularFile(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("MapRegularFile")
+
+      self.assertTrue(results.get[bool]("Mapped"    ), "Regular file not mapped")
+      self.assertTrue(results.get[bool]("Equal"     ), "Mapped view not equal to file contents")
+      self.assertTrue(results.get[bool]("MovedEqual"), "Mapping not transferred by move")
+
+   def test_MapSpecialFile(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("MapSpecialFile")
+
+      self.assertTrue(results.get[bool]("Opened"  ), "Special file not opened")
+      self.assertTrue(results.get[bool]("Buffered"), "Special file not read in")
+      self.assertTrue(results.get[bool]("Contents"), "Special file contents not as expected")
+
+   def test_BufferFromArena(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("BufferFromArena")
+
+      self.assertTrue(results.get[bool]("KnownEqual"    ), "File contents not as expected")
+      self.assertTrue(results.get[bool]("KnownInArena"  ), "File not read into arena")
+      self.assertTrue(results.get[bool]("UnknownRead"   ), "File of unknown size not read in")
+      self.assertTrue(results.get[bool]("UnknownInArena"), "File of unknown size not read into arena")
+
+   def test_FindDelim(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("FindDelim")
+
+      self.assertTrue(results.get[bool]("AllMatch"), "Vectorized search disagrees with std::find")
+
+   def test_StreamLines(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("StreamLines")
+
+      self.assertTrue(results.get[bool]("Opened"    ), "File not opened for streaming")
+      self.assertTrue(results.get[bool]("LinesEqual"), "Streamed lines not as expected")
+      self.assertTrue(results.get[bool]("CleanEOF"  ), "Stream did not end cleanly")
+
+   def test_LoadMany(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("LoadMany")
+
+      self.assertTrue(results.get[bool]("AutoEqual"), "Batch load (default) not as expected")
+      self.assertTrue(results.get[bool]("PoolEqual"), "Batch load (thread pool) not as expected")
+
+   def test_AtomicWrite(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("AtomicWrite")
+
+      self.assertTrue(results.get[bool]("Opened"      ), "Temporary file not created")
+      self.assertTrue(results.get[bool]("Written"     ), "Write failed")
+      self.assertTrue(results.get[bool]("OldWhileOpen"), "Target changed before commit")
+      self.assertTrue(results.get[bool]("Committed"   ), "Commit failed")
+      self.assertTrue(results.get[bool]("NewEqual"    ), "Committed contents not as expected")
+      self.assertTrue(results.get[bool]("KeptPerms"   ), "Replaced file lost its permissions")
+      self.assertTrue(results.get[bool]("AbortClean"  ), "Aborted write left a trace")
+
 # kick-off
 if __name__ == "__main__":
    TestSuite.runSuite()
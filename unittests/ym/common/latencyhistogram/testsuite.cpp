@@ -0,0 +1,222 @@
+/**
+ * @file    testsuite.cpp
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#include "testsuite.h"
+
+#include "textlogger.h"
+#include "ymglobals.h"
+
+#include "latencyhistogram.h" // Structures under test
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+/** TestSuite
+ *
+ * @brief Constructor.
+ */
+ym::unit::TestSuite::TestSuite(void) :
+   TestSuiteBase("LatencyHistogram")
+{
+   addTestCase<InteractiveInspection>();
+   addTestCase<Buckets              >();
+   addTestCase<Percentiles          >();
+   addTestCase<MergeThreads         >();
+   addTestCase<SaveLoad             >();
+}
+
+/** run
+ *
+ * @brief Interactive inspection - for debug purposes.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::InteractiveInspection::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Latency);
+   return {};
+}
+
+/** run
+ *
+ * @brief Every value lands in a bucket that contains it, and buckets are narrow.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Buckets::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Latency);
+
+   using LH = LatencyHistogram;
+
+   auto gen       = std::mt19937_64(0x1a7e'0c1e_u64);
+   auto contained = true;
+   auto narrow    = true;
+
+   for (auto i = 0uz; i < 1'000'000uz; ++i)
+   { // values spread over every magnitude
+      auto const Value = gen() >> (gen() % 64_u64);
+      auto const Idx   = LH::getBucketIdx(Value);
+      auto const Lower = LH::getBucketLower(Idx);
+      auto const Upper = LH::getBucketUpper(Idx);
+
+      contained = contained && Idx < LH::_s_NBuckets && Lower <= Value && Value <= Upper;
+      narrow    = narrow    && (Upper - Lower) <= (Value >> LH::_s_SubBucketBits);
+   }
+
+   auto contiguous = true;
+   for (auto i = 1uz; i < LH::_s_NBuckets; ++i)
+   { // no gaps or overlaps
+      contiguous = contiguous && LH::getBucketLower(i) == LH::getBucketUpper(i - 1uz) + 1_u64;
+   }
+
+   return {
+      {"Contained",  contained                                        },
+      {"Narrow",     narrow                                           },
+      {"Contiguous", contiguous                                       },
+      {"FullRange",  LH::getBucketIdx(~0_u64) == LH::_s_NBuckets - 1uz}
+   };
+}
+
+/** run
+ *
+ * @brief Percentiles agree with the exact ones (of sorted values) within a bucket.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Percentiles::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Latency);
+
+   auto hist   = std::make_unique<LatencyHistogram>();
+   auto gen    = std::mt19937_64(42_u64);
+   auto dist   = std::lognormal_distribution<float64>(8.0_f64, 1.0_f64); // ~3us typical, long tail
+   auto values = std::vector<uint64>();
+
+   for (auto i = 0uz; i < 100'000uz; ++i)
+   { // latencies
+      values.push_back(static_cast<uint64>(dist(gen)));
+      hist->record(values.back());
+   }
+
+   std::ranges::sort(values);
+
+   auto withinBucket = true;
+   for (auto const P : {50.0_f64, 90.0_f64, 99.0_f64, 99.9_f64, 100.0_f64})
+   { // reported value is the top of the bucket holding the exact one
+      auto const Exact    = values[static_cast<sizet>((P / 100.0_f64) * static_cast<float64>(values.size() - 1uz))];
+      auto const Reported = hist->getValueAtPercentile(P);
+      withinBucket = withinBucket && Reported >= Exact && Reported - Exact <= (Exact >> LatencyHistogram::_s_SubBucketBits) + 1_u64;
+   }
+
+   ymLog(VG::UnitTest_Latency, "\n{}", hist->getPercentileTable());
+
+   return {
+      {"WithinBucket", withinBucket                                                       },
+      {"MinMax",       hist->getMin() == values.front() && hist->getMax() == values.back()},
+      {"Count",        hist->getCount() == values.size()                                  }
+   };
+}
+
+/** run
+ *
+ * @brief Per-thread histograms merge into the same result as one shared histogram.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::MergeThreads::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Latency);
+
+   constexpr auto NThreads = 4uz;
+   constexpr auto NValues  = 100'000uz;
+
+   auto perThread = std::vector<std::unique_ptr<LatencyHistogram>>();
+   auto shared    = std::make_unique<LatencyHistogram>();
+
+   for (auto t = 0uz; t < NThreads; ++t)
+   { // one each
+      perThread.push_back(std::make_unique<LatencyHistogram>());
+   }
+
+   { // join before merging
+      auto threads = std::vector<std::jthread>();
+      for (auto t = 0uz; t < NThreads; ++t)
+      { // same values go to both
+         threads.emplace_back([&perThread, &shared, t]() {
+            auto gen = std::mt19937_64(t);
+            for (auto i = 0uz; i < NValues; ++i)
+            { // record
+               auto const Value = gen() >> 40_u64;
+               perThread[t]->record(Value);
+               shared->recordConcurrent(Value);
+            }
+         });
+      }
+   }
+
+   auto merged = std::make_unique<LatencyHistogram>();
+   for (auto const & Hist : perThread)
+   { // combine
+      merged->merge(*Hist);
+   }
+
+   auto same = merged->getCount() == shared->getCount() &&
+               merged->getMin()   == shared->getMin()   &&
+               merged->getMax()   == shared->getMax();
+   for (auto i = 0uz; same && i < LatencyHistogram::_s_NBuckets; ++i)
+   { // bucket by bucket
+      same = merged->getBucketCount(i) == shared->getBucketCount(i);
+   }
+
+   return {
+      {"Counted", merged->getCount() == NThreads * NValues},
+      {"Same",    same                                    }
+   };
+}
+
+/** run
+ *
+ * @brief A saved histogram loads back the same.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::SaveLoad::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Latency);
+
+   auto const Filename = "logs/latencyhistogram.txt";
+
+   auto saved  = std::make_unique<LatencyHistogram>();
+   auto loaded = std::make_unique<LatencyHistogram>();
+   auto gen    = std::mt19937_64(7_u64);
+
+   for (auto i = 0uz; i < 10'000uz; ++i)
+   { // some values
+      saved->record(gen() >> 44_u64);
+   }
+
+   auto const Saved  = saved ->save(Filename);
+   auto const Loaded = loaded->load(Filename);
+
+   auto same = loaded->getCount() == saved->getCount() &&
+               loaded->getMean()  == saved->getMean()  &&
+               loaded->getMin()   == saved->getMin()   &&
+               loaded->getMax()   == saved->getMax();
+   for (auto i = 0uz; same && i < LatencyHistogram::_s_NBuckets; ++i)
+   { // bucket by bucket
+      same = loaded->getBucketCount(i) == saved->getBucketCount(i);
+   }
+
+   return {
+      {"Saved",  Saved },
+      {"Loaded", Loaded},
+      {"Same",   same  }
+   };
+}
@@ -0,0 +1,109 @@
+##
+# @file    testsuite.py
+# @version 1.0.0
+# @author  Forrest Jablonski
+#
+
+import sys
+
+try:
+   import testsuitebase
+except:
+   print("Cannot import testsuitebase - path set correctly?")
+   sys.exit(1)
+
+try:
+   import cppyy
+except:
+   print("Cannot import cppyy - started the venv?")
+   sys.exit(1)
+
+class TestSuite(testsuitebase.TestSuiteBase):
+   """
+   Collection of all tests for LatencyHistogram.
+   """
+
+   @classmethod
+   def setUpClass(cls):
+      """
+      Acting constructor.
+      """
+      super().setUpBaseClass(
+         filepath="ym/common/",
+         filename="latencyhistogram")
+
+   @classmethod
+   def tearDownClass(cls):
+      """
+      Acting destructor.
+      """
+      pass
+
+   def test_InteractiveInspection(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+      
+      # uncomment to run test
+      # results = self.run_test_case("InteractiveInspection")
+      pass
+
+   def test_Buckets(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Buckets")
+
+      self.assertTrue(results.get[bool]("Contained" ), "Value outside of its bucket")
+      self.assertTrue(results.get[bool]("Narrow"    ), "Bucket wider than the promised precision")
+      self.assertTrue(results.get[bool]("Contiguous"), "Buckets have gaps or overlap")
+      self.assertTrue(results.get[bool]("FullRange" ), "Buckets don't cover the full range")
+
+   def test_Percentiles(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Percentiles")
+
+      self.assertTrue(results.get[bool]("WithinBucket"), "Percentile too far from exact value")
+      self.assertTrue(results.get[bool]("MinMax"      ), "Min or max not exact")
+      self.assertTrue(results.get[bool]("Count"       ), "Count not as expected")
+
+   def test_MergeThreads(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("MergeThreads")
+
+      self.assertTrue(results.get[bool]("Counted"), "Merged histogram missing values")
+      self.assertTrue(results.get[bool]("Same"   ), "Merged and shared histograms differ")
+
+   def test_SaveLoad(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("SaveLoad")
+
+      self.assertTrue(results.get[bool]("Saved" ), "Histogram not saved")
+      self.assertTrue(results.get[bool]("Loaded"), "Histogram not loaded")
+      self.assertTrue(results.get[bool]("Same"  ), "Loaded histogram differs from saved one")
+
+# kick-off
+if __name__ == "__main__":
+   TestSuite.runSuite()
+else:
+   TestSuite.runSuite()
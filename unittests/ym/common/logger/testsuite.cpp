@@ -11,6 +11,34 @@
 
 #include "logger.h" // Structures under test
 
+#include "fmt/format.h"
+
+#include <filesystem>
+#include <system_error>
+
+namespace
+{
+
+/** TestLogger
+ *
+ * @brief Exposes the protected interface of Logger.
+ */
+class TestLogger : public ym::Logger
+{
+public:
+   using Logger::openOutfile;
+   using Logger::closeOutfile;
+   using Logger::isOutfileOpened;
+
+   /// @brief Writes a line and commits it.
+   void write(ym::uint32 const Val) {
+      fmt::print(_outfile_uptr.get(), "line {:08}\n", Val);
+      commitWrite();
+   }
+};
+
+} // anonymous
+
 /** TestSuite
  *
  * @brief Constructor.
@@ -19,6 +47,8 @@ ym::unit::TestSuite::TestSuite(void) :
    TestSuiteBase("Logger")
 {
    addTestCase<InteractiveInspection>();
+   addTestCase<ExclusiveCreate      >();
+   addTestCase<BufferedDurable      >();
 }
 
 /** run
@@ -32,3 +62,78 @@ auto ym::unit::TestSuite::InteractiveInspection::run([[maybe_unused]] DataShuttl
    auto const SE = ymLogPushEnable(VG::UnitTest_Logger);
    return {};
 }
+
+/** run
+ *
+ * @brief Verifies files are only overwritten when allowed.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::ExclusiveCreate::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Logger);
+
+   auto const Filename = "logs/logger_excl.txt";
+
+   auto options = Logger::getDefaultOpeningOptions();
+   options._filenameMode  = Logger::FilenameMode_T::KeepOriginal;
+   options._overwriteMode = Logger::OverwriteMode_T::Disallow;
+
+   TestLogger logger;
+
+   auto const Created = logger.openOutfile(Filename, options);
+   logger.closeOutfile();
+
+   auto const Refused = !logger.openOutfile(Filename, options);
+
+   options._overwriteMode = Logger::OverwriteMode_T::Allow;
+   auto const Overwritten = logger.openOutfile(Filename, options);
+   logger.closeOutfile();
+
+   return {
+      {"Created",     Created    },
+      {"Refused",     Refused    },
+      {"Overwritten", Overwritten}
+   };
+}
+
+/** run
+ *
+ * @brief Writes through a large (possibly huge page backed) buffer, syncing every write.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::BufferedDurable::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Logger);
+
+   auto const     Filename   = "logs/logger_durable.txt";
+   constexpr auto NLines     = 100_u32;
+   constexpr auto Line_bytes = sizeof("line 00000000\n") - 1uz;
+
+   auto options = Logger::getDefaultOpeningOptions();
+   options._filenameMode     = Logger::FilenameMode_T::KeepOriginal;
+   options._overwriteMode    = Logger::OverwriteMode_T::Allow;
+   options._bufferMode       = Logger::BufferMode_T::HugePages;
+   options._bufferSize_bytes = 1uz << 20uz;
+   options._durabilityMode   = Logger::DurabilityMode_T::EveryWrite;
+
+   TestLogger logger;
+
+   auto const Opened = logger.openOutfile(Filename, options);
+
+   for (auto i = 0_u32; Opened && i < NLines; ++i)
+   { // each write is synced
+      logger.write(i);
+   }
+
+   std::error_code ec;
+   auto const SizeBeforeClose_bytes = std::filesystem::file_size(Filename, ec); // nothing left in stdio
+
+   logger.closeOutfile();
+
+   return {
+      {"Opened",         Opened                                             },
+      {"SizeAsExpected", !ec && SizeBeforeClose_bytes == NLines * Line_bytes}
+   };
+}
@@ -26,6 +26,8 @@ public:
    virtual ~TestSuite(void) = default;
 
    YM_UT_TESTCASE(InteractiveInspection)
+   YM_UT_TESTCASE(ExclusiveCreate      )
+   YM_UT_TESTCASE(BufferedDurable      )
 };
 
 } // ym::unit
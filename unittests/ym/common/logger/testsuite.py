@@ -4,8 +4,12 @@
 # @author  Forrest Jablonski
 #
 
+import glob
+import os
 import sys
 
+import ympyutils as ympy
+
 try:
    import testsuitebase
 except:
@@ -43,7 +47,9 @@ class TestSuite(testsuitebase.TestSuiteBase):
       """
       Set up logic that is run before each test.
       """
-      pass
+      prev_files = glob.glob(os.path.join(self.unittestdir, "logs/logger_*.txt"))
+      if prev_files:
+         ympy.runCmd(f"rm -rf {' '.join(prev_files)}")
 
    def tearDown(self):
       """
@@ -62,6 +68,31 @@ class TestSuite(testsuitebase.TestSuiteBase):
       # results = self.run_test_case("InteractiveInspection")
       pass
 
+   def test_ExclusiveCreate(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("ExclusiveCreate")
+
+      self.assertTrue(results.get[bool]("Created"    ), "File not created")
+      self.assertTrue(results.get[bool]("Refused"    ), "Existing file overwritten while disallowed")
+      self.assertTrue(results.get[bool]("Overwritten"), "Existing file not overwritten while allowed")
+
+   def test_BufferedDurable(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("BufferedDurable")
+
+      self.assertTrue(results.get[bool]("Opened"        ), "File not opened")
+      self.assertTrue(results.get[bool]("SizeAsExpected"), "Synced writes not on disk")
+
 # kick-off
 if __name__ == "__main__":
    TestSuite.runSuite()
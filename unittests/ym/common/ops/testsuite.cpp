@@ -4,26 +4,46 @@
  * @author  Forrest Jablonski
  */
 
-#include "ymdefs.h"
 #include "testsuite.h"
 
-#include "ops.h"
-
 #include "textlogger.h"
-#include "ymerror.h"
+#include "timer.h"
+#include "ymglobals.h"
+
+#include "ops.h" // Structures under test
+#include "rng.h"
+
+#include "fmt/format.h"
 
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
 #include <vector>
 
 /** TestSuite
  *
  * @brief Constructor.
  */
-ym::unit::TestSuite::TestSuite(void)
-   : TestSuiteBase("Ops")
+ym::unit::TestSuite::TestSuite(void) :
+   TestSuiteBase("Ops")
 {
-   addTestCase<Casting   >();
-   addTestCase<BadCasting>();
+   addTestCase<Casting        >();
+   addTestCase<BadCasting     >();
+   addTestCase<ErrorCodes     >();
+   addTestCase<DecimalFastPath>();
+   addTestCase<FloatRounding  >();
+   addTestCase<Column         >();
+   addTestCase<IntFormatting  >();
+   addTestCase<FloatFormatting>();
+   addTestCase<FormatColumn   >();
+   addTestCase<RoundTrip      >();
 }
 
 /** run
@@ -82,79 +102,615 @@ auto ym::unit::TestSuite::BadCasting::run([[maybe_unused]] DataShuttle const & I
    auto const SE = ymLogPushEnable(VG::UnitTest_Ops);
 
    std::vector<bool> badCasts_char{false, false}; // until told otherwise
-   try { (void)Ops::castToChar("");   } catch (Ops::OpsError_BadCast const & E) { badCasts_char[0] = true; }
-   try { (void)Ops::castToChar("it"); } catch (Ops::OpsError_BadCast const & E) { badCasts_char[1] = true; }
+   try { (void)Ops::castToChar("");   } catch (Ops::BadCastError const &) { badCasts_char[0] = true; }
+   try { (void)Ops::castToChar("it"); } catch (Ops::BadCastError const &) { badCasts_char[1] = true; }
 
    std::vector<bool> badCasts_int8{false, false, false}; // until told otherwise
-   try { (void)Ops::castTo<int8>("");     } catch (Ops::OpsError_BadCast const & E) { badCasts_int8[0] = true; }
-   try { (void)Ops::castTo<int8>("-");    } catch (Ops::OpsError_BadCast const & E) { badCasts_int8[1] = true; }
-   try { (void)Ops::castTo<int8>("-129"); } catch (Ops::OpsError_BadCast const & E) { badCasts_int8[2] = true; }
+   try { (void)Ops::castTo<int8>("");     } catch (Ops::BadCastError const &) { badCasts_int8[0] = true; }
+   try { (void)Ops::castTo<int8>("-");    } catch (Ops::BadCastError const &) { badCasts_int8[1] = true; }
+   try { (void)Ops::castTo<int8>("-129"); } catch (Ops::BadCastError const &) { badCasts_int8[2] = true; }
 
    std::vector<bool> badCasts_int16{false, false, false}; // until told otherwise
-   try { (void)Ops::castTo<int16>("");       } catch (Ops::OpsError_BadCast const & E) { badCasts_int16[0] = true; }
-   try { (void)Ops::castTo<int16>("-");      } catch (Ops::OpsError_BadCast const & E) { badCasts_int16[1] = true; }
-   try { (void)Ops::castTo<int16>("-32769"); } catch (Ops::OpsError_BadCast const & E) { badCasts_int16[2] = true; }
+   try { (void)Ops::castTo<int16>("");       } catch (Ops::BadCastError const &) { badCasts_int16[0] = true; }
+   try { (void)Ops::castTo<int16>("-");      } catch (Ops::BadCastError const &) { badCasts_int16[1] = true; }
+   try { (void)Ops::castTo<int16>("-32769"); } catch (Ops::BadCastError const &) { badCasts_int16[2] = true; }
 
    std::vector<bool> badCasts_int32{false, false, false}; // until told otherwise
-   try { (void)Ops::castTo<int32>("");            } catch (Ops::OpsError_BadCast const & E) { badCasts_int32[0] = true; }
-   try { (void)Ops::castTo<int32>("-");           } catch (Ops::OpsError_BadCast const & E) { badCasts_int32[1] = true; }
-   try { (void)Ops::castTo<int32>("-2147483649"); } catch (Ops::OpsError_BadCast const & E) { badCasts_int32[2] = true; }
+   try { (void)Ops::castTo<int32>("");            } catch (Ops::BadCastError const &) { badCasts_int32[0] = true; }
+   try { (void)Ops::castTo<int32>("-");           } catch (Ops::BadCastError const &) { badCasts_int32[1] = true; }
+   try { (void)Ops::castTo<int32>("-2147483649"); } catch (Ops::BadCastError const &) { badCasts_int32[2] = true; }
 
    std::vector<bool> badCasts_int64{false, false, false}; // until told otherwise
-   try { (void)Ops::castTo<int64>("");                     } catch (Ops::OpsError_BadCast const & E) { badCasts_int64[0] = true; }
-   try { (void)Ops::castTo<int64>("-");                    } catch (Ops::OpsError_BadCast const & E) { badCasts_int64[1] = true; }
-   try { (void)Ops::castTo<int64>("-9223372036854775809"); } catch (Ops::OpsError_BadCast const & E) { badCasts_int64[2] = true; }
+   try { (void)Ops::castTo<int64>("");                     } catch (Ops::BadCastError const &) { badCasts_int64[0] = true; }
+   try { (void)Ops::castTo<int64>("-");                    } catch (Ops::BadCastError const &) { badCasts_int64[1] = true; }
+   try { (void)Ops::castTo<int64>("-9223372036854775809"); } catch (Ops::BadCastError const &) { badCasts_int64[2] = true; }
 
    std::vector<bool> badCasts_uint8{false, false, false}; // until told otherwise
-   try { (void)Ops::castTo<uint8>("");     } catch (Ops::OpsError_BadCast const & E) { badCasts_uint8[0] = true; }
-   try { (void)Ops::castTo<uint8>("+");    } catch (Ops::OpsError_BadCast const & E) { badCasts_uint8[1] = true; }
-   try { (void)Ops::castTo<uint8>("+256"); } catch (Ops::OpsError_BadCast const & E) { badCasts_uint8[2] = true; }
+   try { (void)Ops::castTo<uint8>("");     } catch (Ops::BadCastError const &) { badCasts_uint8[0] = true; }
+   try { (void)Ops::castTo<uint8>("+");    } catch (Ops::BadCastError const &) { badCasts_uint8[1] = true; }
+   try { (void)Ops::castTo<uint8>("+256"); } catch (Ops::BadCastError const &) { badCasts_uint8[2] = true; }
 
    std::vector<bool> badCasts_uint16{false, false, false}; // until told otherwise
-   try { (void)Ops::castTo<uint16>("");       } catch (Ops::OpsError_BadCast const & E) { badCasts_uint16[0] = true; }
-   try { (void)Ops::castTo<uint16>("+");      } catch (Ops::OpsError_BadCast const & E) { badCasts_uint16[1] = true; }
-   try { (void)Ops::castTo<uint16>("+65536"); } catch (Ops::OpsError_BadCast const & E) { badCasts_uint16[2] = true; }
+   try { (void)Ops::castTo<uint16>("");       } catch (Ops::BadCastError const &) { badCasts_uint16[0] = true; }
+   try { (void)Ops::castTo<uint16>("+");      } catch (Ops::BadCastError const &) { badCasts_uint16[1] = true; }
+   try { (void)Ops::castTo<uint16>("+65536"); } catch (Ops::BadCastError const &) { badCasts_uint16[2] = true; }
 
    std::vector<bool> badCasts_uint32{false, false, false}; // until told otherwise
-   try { (void)Ops::castTo<uint32>("");            } catch (Ops::OpsError_BadCast const & E) { badCasts_uint32[0] = true; }
-   try { (void)Ops::castTo<uint32>("+");           } catch (Ops::OpsError_BadCast const & E) { badCasts_uint32[1] = true; }
-   try { (void)Ops::castTo<uint32>("+4294967296"); } catch (Ops::OpsError_BadCast const & E) { badCasts_uint32[2] = true; }
+   try { (void)Ops::castTo<uint32>("");            } catch (Ops::BadCastError const &) { badCasts_uint32[0] = true; }
+   try { (void)Ops::castTo<uint32>("+");           } catch (Ops::BadCastError const &) { badCasts_uint32[1] = true; }
+   try { (void)Ops::castTo<uint32>("+4294967296"); } catch (Ops::BadCastError const &) { badCasts_uint32[2] = true; }
 
    std::vector<bool> badCasts_uint64{false, false, false}; // until told otherwise
-   try { (void)Ops::castTo<uint64>("");                      } catch (Ops::OpsError_BadCast const & E) { badCasts_uint64[0] = true; }
-   try { (void)Ops::castTo<uint64>("+");                     } catch (Ops::OpsError_BadCast const & E) { badCasts_uint64[1] = true; }
-   try { (void)Ops::castTo<uint64>("+18446744073709551616"); } catch (Ops::OpsError_BadCast const & E) { badCasts_uint64[2] = true; }
+   try { (void)Ops::castTo<uint64>("");                      } catch (Ops::BadCastError const &) { badCasts_uint64[0] = true; }
+   try { (void)Ops::castTo<uint64>("+");                     } catch (Ops::BadCastError const &) { badCasts_uint64[1] = true; }
+   try { (void)Ops::castTo<uint64>("+18446744073709551616"); } catch (Ops::BadCastError const &) { badCasts_uint64[2] = true; }
 
    std::vector<bool> badCasts_flt32{false, false, false}; // until told otherwise
-   try { (void)Ops::castTo<float32>("");           } catch (Ops::OpsError_BadCast const & E) { badCasts_flt32[0] = true; }
-   try { (void)Ops::castTo<float32>(".");          } catch (Ops::OpsError_BadCast const & E) { badCasts_flt32[1] = true; }
-   try { (void)Ops::castTo<float32>("+1.175e-38"); } catch (Ops::OpsError_BadCast const & E) { badCasts_flt32[2] = true; }
+   try { (void)Ops::castTo<float32>("");           } catch (Ops::BadCastError const &) { badCasts_flt32[0] = true; }
+   try { (void)Ops::castTo<float32>(".");          } catch (Ops::BadCastError const &) { badCasts_flt32[1] = true; }
+   try { (void)Ops::castTo<float32>("+1.175e-38"); } catch (Ops::BadCastError const &) { badCasts_flt32[2] = true; }
 
    std::vector<bool> badCasts_flt64{false, false, false}; // until told otherwise
-   try { (void)Ops::castTo<float64>("");            } catch (Ops::OpsError_BadCast const & E) { badCasts_flt64[0] = true; }
-   try { (void)Ops::castTo<float64>(".");           } catch (Ops::OpsError_BadCast const & E) { badCasts_flt64[1] = true; }
-   try { (void)Ops::castTo<float64>("+2.225e-308"); } catch (Ops::OpsError_BadCast const & E) { badCasts_flt64[2] = true; }
+   try { (void)Ops::castTo<float64>("");            } catch (Ops::BadCastError const &) { badCasts_flt64[0] = true; }
+   try { (void)Ops::castTo<float64>(".");           } catch (Ops::BadCastError const &) { badCasts_flt64[1] = true; }
+   try { (void)Ops::castTo<float64>("+2.225e-308"); } catch (Ops::BadCastError const &) { badCasts_flt64[2] = true; }
 
    std::vector<bool> badCasts_flt80{false, false, false}; // until told otherwise
-   try { (void)Ops::castTo<floatext>("");             } catch (Ops::OpsError_BadCast const & E) { badCasts_flt80[0] = true; }
-   try { (void)Ops::castTo<floatext>(".");            } catch (Ops::OpsError_BadCast const & E) { badCasts_flt80[1] = true; }
-   try { (void)Ops::castTo<floatext>("+3.362e-4932"); } catch (Ops::OpsError_BadCast const & E) { badCasts_flt80[2] = true; }
+   try { (void)Ops::castTo<floatext>("");             } catch (Ops::BadCastError const &) { badCasts_flt80[0] = true; }
+   try { (void)Ops::castTo<floatext>(".");            } catch (Ops::BadCastError const &) { badCasts_flt80[1] = true; }
+   try { (void)Ops::castTo<floatext>("+3.362e-4932"); } catch (Ops::BadCastError const &) { badCasts_flt80[2] = true; }
 
    return {
-      {"BadCasts_char",   badCasts_char  },
+      {"BadCasts_char", badCasts_char},
 
-      {"BadCasts_int8",   badCasts_int8  },
-      {"BadCasts_int16",  badCasts_int16 },
-      {"BadCasts_int32",  badCasts_int32 },
-      {"BadCasts_int64",  badCasts_int64 },
+      {"BadCasts_int8",  badCasts_int8 },
+      {"BadCasts_int16", badCasts_int16},
+      {"BadCasts_int32", badCasts_int32},
+      {"BadCasts_int64", badCasts_int64},
 
       {"BadCasts_uint8",  badCasts_uint8 },
       {"BadCasts_uint16", badCasts_uint16},
       {"BadCasts_uint32", badCasts_uint32},
       {"BadCasts_uint64", badCasts_uint64},
 
-      {"BadCasts_flt32",  badCasts_flt32 },
-      {"BadCasts_flt64",  badCasts_flt64 },
-      {"BadCasts_flt80",  badCasts_flt80 }
+      {"BadCasts_flt32", badCasts_flt32},
+      {"BadCasts_flt64", badCasts_flt64},
+      {"BadCasts_flt80", badCasts_flt80}
+   };
+}
+
+/** run
+ *
+ * @brief Tests the non-throwing casts report why they failed.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::ErrorCodes::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Ops);
+
+   auto const IsError = [](auto const & Result, std::errc const Error) {
+      return !Result.has_value() && Result.error() == Error;
+   };
+
+   auto const Invalid    = std::errc::invalid_argument;
+   auto const OutOfRange = std::errc::result_out_of_range;
+
+   return {
+      {"Char_Empty",      IsError(Ops::tryCastToChar    (""                    ), Invalid   ) },
+      {"Int8_Range",      IsError(Ops::tryCastTo<int8   >("128"                 ), OutOfRange)},
+      {"Int16_Range",     IsError(Ops::tryCastTo<int16  >("-32769"              ), OutOfRange)},
+      {"UInt8_Range",     IsError(Ops::tryCastTo<uint8  >("256"                 ), OutOfRange)},
+      {"UInt8_Negative",  IsError(Ops::tryCastTo<uint8  >("-1"                  ), Invalid   )},
+      {"Int32_PlusMinus", IsError(Ops::tryCastTo<int32  >("+-1"                 ), Invalid   )},
+      {"Int32_Trailing",  IsError(Ops::tryCastTo<int32  >("12x"                 ), Invalid   )},
+      {"Int32_Space",     IsError(Ops::tryCastTo<int32  >(" 12"                 ), Invalid   )},
+      {"Int64_Long",      IsError(Ops::tryCastTo<int64  >("99999999999999999999"), OutOfRange)},
+      {"UInt64_BadBase",  IsError(Ops::tryCastTo<uint64 >("1", 1_u32            ), Invalid   )},
+      {"Flt64_Trailing",  IsError(Ops::tryCastTo<float64>("1.5f"                ), Invalid   )},
+      {"Flt64_Overflow",  IsError(Ops::tryCastTo<float64>("1e999"               ), OutOfRange)},
+      {"Hex",             Ops::tryCastTo<uint32 >("+ff",   16_u32) == 255_u32                 },
+      {"Binary",          Ops::tryCastTo<int8   >("-1000",  2_u32) == static_cast<int8>(-8)   },
+      {"LeadingZeros",    Ops::tryCastTo<int8   >("00000000000000000000127") == 127           },
+      {"Flt32",           Ops::tryCastTo<float32>("+0.5") == 0.5_f32                          }
+   };
+}
+
+/** run
+ *
+ * @brief Checks the decimal fast path against std::from_chars, and times both.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::DecimalFastPath::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Ops);
+
+   constexpr auto NVals   = 4'096uz;
+   constexpr auto NRounds = 200uz;
+
+   Prng rand;
+
+   auto strs = std::vector<std::string>(NVals);
+   auto vals = std::vector<int64>(NVals);
+
+   for (auto i = 0uz; i < NVals; ++i)
+   { // every length from 1 to 19 digits, both signs
+      auto const Shift = 1_u64 + (rand.gen<uint64>() % 63_u64);
+      auto const Mag   = static_cast<int64>(rand.gen<uint64>() >> Shift);
+      vals[i] = (i % 2uz == 0uz) ? Mag : -Mag;
+      strs[i] = std::to_string(vals[i]);
+   }
+
+   auto matches = true;
+   for (auto i = 0uz; i < NVals; ++i)
+   { // round trip
+      matches &= Ops::tryCastTo<int64>(strs[i]) == vals[i];
+   }
+
+   auto rejectsStray = true;
+   for (auto i = 0uz; i < NVals; ++i)
+   { // a stray char anywhere in the digits must be caught
+      auto       str   = strs[i];
+      auto const First = (str.front() == '-') ? 1uz : 0uz;
+      auto const Pos   = First + (rand.gen<uint64>() % (str.size() - First));
+      str[Pos] = std::array{'/', ':', 'a', ' ', '.', '\0'}[rand.gen<uint64>() % 6_u64];
+      rejectsStray &= !Ops::tryCastTo<int64>(str).has_value();
+   }
+
+   auto checksum = 0_i64;
+
+   Timer opsTimer;
+   for (auto r = 0uz; r < NRounds; ++r)
+   { // fast path
+      for (auto const & Str : strs) { checksum += *Ops::tryCastTo<int64>(Str); }
+   }
+   auto const Ops_ns = static_cast<float64>(opsTimer.getElapsedTime().count()) / static_cast<float64>(NVals * NRounds);
+
+   Timer fromCharsTimer;
+   for (auto r = 0uz; r < NRounds; ++r)
+   { // reference
+      for (auto const & Str : strs)
+      { // parse
+         auto val = 0_i64;
+         (void)std::from_chars(Str.data(), Str.data() + Str.size(), val);
+         checksum -= val;
+      }
+   }
+   auto const FromChars_ns = static_cast<float64>(fromCharsTimer.getElapsedTime().count()) / static_cast<float64>(NVals * NRounds);
+
+   ymLog(VG::UnitTest_Ops, "castTo<int64> {:.2f} ns (from_chars {:.2f})", Ops_ns, FromChars_ns);
+
+   return {
+      {"Matches",      matches          },
+      {"RejectsStray", rejectsStray     },
+      {"Checksum",     checksum == 0_i64},
+      {"Ops_ns",       Ops_ns           },
+      {"FromChars_ns", FromChars_ns     }
+   };
+}
+
+/** run
+ *
+ * @brief Checks float casts round exactly as std::from_chars does.
+ *
+ * @note Covers every power of ten in the table, shortest and full round trip strings
+ *       of random floats, and long strings that exceed 19 significant digits.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::FloatRounding::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Ops);
+
+   auto nMismatches = 0_u64;
+
+   auto const Check = [&nMismatches]<typename T>(std::string const & Str) {
+      auto       expected = T{};
+      auto const [Ptr, Ec] = std::from_chars(Str.data(), Str.data() + Str.size(), expected);
+      auto const Result    = Ops::tryCastTo<T>(Str);
+
+      if (Ec != std::errc() || std::fpclassify(expected) == FP_SUBNORMAL)
+      { // from_chars is more lenient on range - only care that ours failed too
+         nMismatches += Result.has_value() ? 1_u64 : 0_u64;
+      }
+      else if (!Result || std::memcmp(&*Result, &expected, sizeof(T)) != 0)
+      { // not the same bits
+         ymLog(VG::UnitTest_Ops, "Mismatch casting '{}'", Str);
+         nMismatches += 1_u64;
+      }
+   };
+
+   for (auto q = -350_i32; q <= 320_i32; ++q)
+   { // every power of five in the table, and past either end
+      for (auto const Sig : {"1", "9", "123456789", "1234567890123456789", "12345678901234567891234"})
+      { // short, long, truncated
+         auto const Str = fmt::format("{}e{}", Sig, q);
+         Check.operator()<float32>(Str);
+         Check.operator()<float64>(Str);
+      }
+   }
+
+   Prng rand;
+   std::array<char, 64uz> buffer{};
+
+   for (auto i = 0uz; i < 200'000uz; ++i)
+   { // random bit patterns
+      auto const Bits = rand.gen<uint64>();
+      auto const Dbl  = std::bit_cast<float64>(Bits);
+      auto const Flt  = std::bit_cast<float32>(static_cast<uint32>(Bits));
+      auto const NSig = 1 + static_cast<int>(Bits % 17_u64);
+
+      if (std::isfinite(Dbl))
+      { // shortest-ish and full precision
+         (void)std::snprintf(buffer.data(), buffer.size(), "%.*g", NSig, Dbl); Check.operator()<float64>(buffer.data());
+         (void)std::snprintf(buffer.data(), buffer.size(), "%.17g",     Dbl); Check.operator()<float64>(buffer.data());
+      }
+
+      if (std::isfinite(Flt))
+      { // full precision
+         (void)std::snprintf(buffer.data(), buffer.size(), "%.9g", static_cast<float64>(Flt)); Check.operator()<float32>(buffer.data());
+      }
+   }
+
+   for (auto i = 0uz; i < 200'000uz; ++i)
+   { // random digit strings, up to 30 digits
+      auto       str     = std::string(rand.gen<uint64>() % 2_u64 == 0_u64 ? "-" : "");
+      auto const NDigits = 1_u64 + (rand.gen<uint64>() % 30_u64);
+      auto const Dot     = rand.gen<uint64>() % (NDigits + 1_u64);
+
+      for (auto d = 0_u64; d < NDigits; ++d)
+      { // digits
+         if (d == Dot) { str += '.'; }
+         str += static_cast<char>('0' + (rand.gen<uint64>() % 10_u64));
+      }
+
+      str += fmt::format("e{}", static_cast<int64>(rand.gen<uint64>() % 700_u64) - 350_i64);
+
+      Check.operator()<float32>(str);
+      Check.operator()<float64>(str);
+   }
+
+   return {
+      {"NMismatches", nMismatches}
+   };
+}
+
+/** run
+ *
+ * @brief Casts a column of numbers.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Column::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Ops);
+
+   auto vals = std::vector<float64>(4uz);
+
+   auto const Lines = Ops::tryCastColumn("1.5\n-2\r\n3e2\n", vals);
+   auto const LinesOk = Lines == 3uz && vals[0uz] == 1.5_f64 && vals[1uz] == -2.0_f64 && vals[2uz] == 300.0_f64;
+
+   auto const Csv   = Ops::tryCastColumn("0.25,+4,1e-3,7", vals, ',');
+   auto const CsvOk = Csv == 4uz && vals[0uz] == 0.25_f64 && vals[1uz] == 4.0_f64 && vals[2uz] == 1e-3_f64 && vals[3uz] == 7.0_f64;
+
+   auto const Empty   = Ops::tryCastColumn("", vals);
+   auto const TooMany = Ops::tryCastColumn("1\n2\n3\n4\n5", vals);
+   auto const BadVal  = Ops::tryCastColumn("1\nx\n3", vals);
+   auto const Blank   = Ops::tryCastColumn("1\n\n3", vals);
+
+   auto badCast = false;
+   try { (void)Ops::castColumn("1\n2\n3\n4\n5", vals); } catch (Ops::BadCastError const &) { badCast = true; }
+
+   return {
+      {"Lines",   LinesOk                                                   },
+      {"Csv",     CsvOk                                                     },
+      {"Empty",   Empty == 0uz                                              },
+      {"TooMany", !TooMany && TooMany.error() == std::errc::value_too_large },
+      {"BadVal",  !BadVal  && BadVal .error() == std::errc::invalid_argument},
+      {"Blank",   !Blank   && Blank  .error() == std::errc::invalid_argument},
+      {"Throws",  badCast                                                   }
+   };
+}
+
+/** run
+ *
+ * @brief Formats integers, against fmt.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::IntFormatting::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Ops);
+
+   auto nMismatches = 0_u64;
+   auto buffer      = std::array<char, Ops::_s_MaxFormattedSize>{};
+
+   auto const Check = [&]<typename T>(T const Val) {
+      auto const * const End_Ptr = Ops::formatTo(buffer.data(), Val);
+      auto const         Str     = std::string_view(buffer.data(), End_Ptr);
+
+      if (Str != fmt::format("{}", Val))
+      { // not what fmt would write
+         ymLog(VG::UnitTest_Ops, "Mismatch formatting {} as '{}'", Val, Str);
+         nMismatches += 1_u64;
+      }
+   };
+
+   auto const CheckEdges = [&]<typename T>() {
+      Check(std::numeric_limits<T>::min());
+      Check(std::numeric_limits<T>::max());
+      for (auto p = 1_u64; p <= static_cast<uint64>(std::numeric_limits<T>::max()) / 10_u64; p *= 10_u64)
+      { // digit count changes
+         Check(static_cast<T>(p - 1_u64));
+         Check(static_cast<T>(p      ));
+         Check(static_cast<T>(p * 10_u64 - 1_u64));
+      }
+   };
+
+   CheckEdges.operator()<int8  >();
+   CheckEdges.operator()<int16 >();
+   CheckEdges.operator()<int32 >();
+   CheckEdges.operator()<int64 >();
+   CheckEdges.operator()<uint8 >();
+   CheckEdges.operator()<uint16>();
+   CheckEdges.operator()<uint32>();
+   CheckEdges.operator()<uint64>();
+
+   Prng rand;
+
+   for (auto i = 0uz; i < 200'000uz; ++i)
+   { // random magnitudes
+      auto const Bits = rand.gen<uint64>() >> (rand.gen<uint64>() % 64_u64);
+      Check(Bits);
+      Check(static_cast<int64>(Bits) * ((i % 2uz == 0uz) ? 1_i64 : -1_i64));
+      Check(static_cast<int32>(Bits));
+      Check(static_cast<uint16>(Bits));
+   }
+
+   auto const Fixed = [&buffer](uint64 const Val, sizet const NDigits) {
+      return std::string(buffer.data(), Ops::formatFixedTo(buffer.data(), Val, NDigits));
+   };
+
+   auto const FixedWidth =
+      Fixed(123_u64,     6uz) == "000123" &&
+      Fixed(7_u64,       1uz) == "7"      &&
+      Fixed(1234567_u64, 3uz) == "567"    &&
+      Fixed(0_u64,       2uz) == "00";
+
+   return {
+      {"NMismatches", nMismatches},
+      {"FixedWidth",  FixedWidth }
+   };
+}
+
+/** run
+ *
+ * @brief Formats floats - shortest digits that round trip, laid out like fmt.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::FloatFormatting::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Ops);
+
+   auto nMismatches = 0_u64;
+   auto buffer      = std::array<char, Ops::_s_MaxFormattedSize>{};
+   auto expected    = std::array<char, 64uz>{};
+
+   auto const NSignificant = [](std::string_view const Str) {
+      auto const Mantissa = Str.substr(0uz, Str.find('e'));
+      auto       digits   = std::string();
+      for (auto const C : Mantissa) { if (C >= '0' && C <= '9') { digits += C; } }
+      auto const First = digits.find_first_not_of('0');
+      auto const Last  = digits.find_last_not_of('0');
+      return (First == std::string::npos) ? 0uz : Last - First + 1uz;
+   };
+
+   auto const Check = [&]<typename T>(T const Val) {
+      auto const * const End_Ptr = Ops::formatTo(buffer.data(), Val);
+      auto const         Str     = std::string_view(buffer.data(), End_Ptr);
+
+      auto       readBack = T{};
+      auto const Parsed   = std::from_chars(Str.data(), Str.data() + Str.size(), readBack);
+      auto const Shortest = std::to_chars(expected.data(), expected.data() + expected.size(), Val, std::chars_format::scientific);
+
+      auto const RoundTrips = Parsed.ec == std::errc() && Parsed.ptr == End_Ptr && std::memcmp(&readBack, &Val, sizeof(T)) == 0;
+      auto const IsShortest = NSignificant(Str) == NSignificant(std::string_view(expected.data(), Shortest.ptr));
+
+      if (!RoundTrips || !IsShortest)
+      { // wrong value or too many digits
+         ymLog(VG::UnitTest_Ops, "Mismatch formatting {} as '{}'", Val, Str);
+         nMismatches += 1_u64;
+      }
+   };
+
+   for (auto e = -325_i32; e <= 309_i32; ++e)
+   { // across the whole range
+      auto const Str = fmt::format("1e{}", e);
+      Check(std::strtod(Str.c_str(), nullptr));
+      Check(std::strtof(Str.c_str(), nullptr));
+   }
+
+   for (auto t = 1_u64; t < 1'000_u64; ++t)
+   { // subnormals with few digits, and the largest values
+      Check(std::bit_cast<float64>(t));
+      Check(std::bit_cast<float32>(static_cast<uint32>(t)));
+      Check(std::bit_cast<float64>(0x7fef'ffff'ffff'ffff_u64 - t));
+      Check(std::bit_cast<float32>(static_cast<uint32>(0x7f7f'ffff_u64 - t)));
+   }
+
+   Prng rand;
+
+   for (auto i = 0uz; i < 200'000uz; ++i)
+   { // random bit patterns
+      auto const Bits = rand.gen<uint64>();
+      auto const Dbl  = std::bit_cast<float64>(Bits);
+      auto const Flt  = std::bit_cast<float32>(static_cast<uint32>(Bits));
+
+      if (std::isfinite(Dbl)) { Check(Dbl); }
+      if (std::isfinite(Flt)) { Check(Flt); }
+      Check(static_cast<float64>(static_cast<int64>(Bits) >> 20_i64)); // integers
+   }
+
+   auto const Format = [&buffer](auto const Val) {
+      return std::string(buffer.data(), Ops::formatTo(buffer.data(), Val));
+   };
+
+   auto const Layout =
+      Format( 1.0_f64                                  ) == "1"                        &&
+      Format(-0.0_f64                                  ) == "-0"                       &&
+      Format( 100000.0_f64                             ) == "100000"                   &&
+      Format( 123.456_f64                              ) == "123.456"                  &&
+      Format( 0.0001_f64                               ) == "0.0001"                   &&
+      Format( 1.5e-5_f64                               ) == "1.5e-05"                  &&
+      Format( 1e15_f64                                 ) == "1000000000000000"         &&
+      Format( 1e16_f64                                 ) == "1e+16"                    &&
+      Format( 5e-324_f64                               ) == "5e-324"                   &&
+      Format(-std::numeric_limits<float64>::max()      ) == "-1.7976931348623157e+308" &&
+      Format( std::numeric_limits<float64>::infinity() ) == "inf"                      &&
+      Format(-std::numeric_limits<float64>::infinity() ) == "-inf"                     &&
+      Format( std::numeric_limits<float64>::quiet_NaN()) == "nan"                      &&
+      Format( 0.1_f32                                  ) == "0.1"                      &&
+      Format( 1e6_f32                                  ) == "1000000"                  &&
+      Format( 1e7_f32                                  ) == "1e+07"                    &&
+      Format( 16777216.0_f32                           ) == "1.6777216e+07";
+
+   return {
+      {"NMismatches", nMismatches},
+      {"Layout",      Layout     }
+   };
+}
+
+/** run
+ *
+ * @brief Formats whole columns, through a buffer smaller than the column.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::FormatColumn::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Ops);
+
+   auto buffer = std::vector<char>(4uz * 1024uz);
+
+   auto const Small    = std::array{1.5_f64, -2.0_f64, 300.0_f64, 1e-3_f64};
+   auto const SmallRes = Ops::formatColumn<float64>(Small, buffer);
+   auto const SmallOk  = SmallRes._nVals == Small.size() &&
+                         std::string_view(buffer.data(), SmallRes._nChars) == "1.5\n-2\n300\n0.001\n";
+
+   auto const Ints    = std::array{7_i32, -42_i32, 0_i32};
+   auto const IntsRes = Ops::formatColumn<int32>(Ints, buffer, ',');
+   auto const IntsOk  = IntsRes._nVals == Ints.size() &&
+                        std::string_view(buffer.data(), IntsRes._nChars) == "7,-42,0,";
+
+   auto const Cramped   = Ops::formatColumn<float64>(Small, std::span<char>(buffer.data(), Ops::_s_MaxFormattedSize));
+   auto const CrampedOk = Cramped._nVals == 0uz && Cramped._nChars == 0uz;
+
+   // a large column, a chunk at a time, read back in
+   constexpr auto NVals = 1'000'000uz;
+
+   Prng rand;
+   auto vals = std::vector<float64>(NVals);
+   for (auto & val : vals) { val = rand.gen<float64>() * 2e6 - 1e6; }
+
+   auto text = std::string();
+   text.reserve(NVals * Ops::_s_MaxFormattedSize);
+
+   Timer opsTimer;
+   for (auto i = 0uz; i < NVals; )
+   { // chunk at a time
+      auto const Res = Ops::formatColumn<float64>(std::span<float64 const>(vals).subspan(i), buffer);
+      text.append(buffer.data(), Res._nChars);
+      i += Res._nVals;
+   }
+   auto const Ops_ns = static_cast<float64>(opsTimer.getElapsedTime().count()) / static_cast<float64>(NVals);
+
+   auto nFmtChars = 0uz;
+   Timer fmtTimer;
+   for (auto const Val : vals)
+   { // one value at a time
+      auto const Res = fmt::format_to_n(buffer.data(), Ops::_s_MaxFormattedSize, "{}\n", Val);
+      nFmtChars += Res.size;
+   }
+   auto const Fmt_ns = static_cast<float64>(fmtTimer.getElapsedTime().count()) / static_cast<float64>(NVals);
+
+   ymLog(VG::UnitTest_Ops, "formatColumn<float64> {:.2f} ns/val (fmt {:.2f})", Ops_ns, Fmt_ns);
+
+   auto readBack = std::vector<float64>(NVals);
+   auto const NRead = Ops::tryCastColumn(text, readBack);
+
+   return {
+      {"Small",     SmallOk                           },
+      {"Ints",      IntsOk                            },
+      {"Cramped",   CrampedOk                         },
+      {"SameSize",  text.size() == nFmtChars          },
+      {"RoundTrip", NRead == NVals && readBack == vals},
+      {"Ops_ns",    Ops_ns                            },
+      {"Fmt_ns",    Fmt_ns                            }
+   };
+}
+
+/** run
+ *
+ * @brief Formats special values and reads them back - inf and nan round trip through
+ *        tryCastTo(), subnormals only through std::from_chars.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::RoundTrip::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Ops);
+
+   auto buffer = std::array<char, Ops::_s_MaxFormattedSize>{};
+
+   auto const Format = [&buffer](auto const Val) {
+      return std::string_view(buffer.data(), Ops::formatTo(buffer.data(), Val));
+   };
+
+   auto const SameBits = []<typename T>(T const A, T const B) {
+      return (std::isnan(A) && std::isnan(B)) || std::memcmp(&A, &B, sizeof(T)) == 0;
+   };
+
+   auto const Casts = [&]<typename T>(T const Val) {
+      auto const Result = Ops::tryCastTo<T>(Format(Val));
+      return Result && SameBits(*Result, Val);
+   };
+
+   auto const Rejects = [&]<typename T>(T const Val) {
+      auto const Result = Ops::tryCastTo<T>(Format(Val));
+      return !Result && Result.error() == std::errc::result_out_of_range;
+   };
+
+   auto const FromChars = [&]<typename T>(T const Val) {
+      auto       readBack = T{};
+      auto const Str      = Format(Val);
+      auto const [Ptr, Ec] = std::from_chars(Str.data(), Str.data() + Str.size(), readBack);
+      return Ec == std::errc() && Ptr == Str.data() + Str.size() && SameBits(readBack, Val);
+   };
+
+   auto const Special = [&]<typename T>(T) {
+      using Limits_T = std::numeric_limits<T>;
+      return Casts( Limits_T::infinity ()) &&
+             Casts(-Limits_T::infinity ()) &&
+             Casts( Limits_T::quiet_NaN()) &&
+             Casts(-Limits_T::quiet_NaN()) &&
+             Casts( Limits_T::min      ()) && // smallest normal
+             Casts(-Limits_T::max      ());
+   };
+
+   auto const Subnormal = [&]<typename T>(T) {
+      using Limits_T = std::numeric_limits<T>;
+      auto const Largest = std::nextafter(Limits_T::min(), T(0));
+      return Rejects  ( Limits_T::denorm_min()) && FromChars( Limits_T::denorm_min()) &&
+             Rejects  (-Limits_T::denorm_min()) && FromChars(-Limits_T::denorm_min()) &&
+             Rejects  ( Largest               ) && FromChars( Largest               );
+   };
+
+   return {
+      {"Special32",   Special  (0.0_f32)},
+      {"Special64",   Special  (0.0_f64)},
+      {"Subnormal32", Subnormal(0.0_f32)},
+      {"Subnormal64", Subnormal(0.0_f64)}
    };
 }
@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include "utdefs.h"
+#include "ymdefs.h"
 
 #include "testsuitebase.h"
 
@@ -23,8 +23,16 @@ public:
    explicit TestSuite(void);
    virtual ~TestSuite(void) = default;
 
-   YM_UT_TESTCASE(Casting   )
-   YM_UT_TESTCASE(BadCasting)
+   YM_UT_TESTCASE(Casting        )
+   YM_UT_TESTCASE(BadCasting     )
+   YM_UT_TESTCASE(ErrorCodes     )
+   YM_UT_TESTCASE(DecimalFastPath)
+   YM_UT_TESTCASE(FloatRounding  )
+   YM_UT_TESTCASE(Column         )
+   YM_UT_TESTCASE(IntFormatting  )
+   YM_UT_TESTCASE(FloatFormatting)
+   YM_UT_TESTCASE(FormatColumn   )
+   YM_UT_TESTCASE(RoundTrip      )
 };
 
 } // ym::unit
@@ -4,13 +4,9 @@
 # @author  Forrest Jablonski
 #
 
-import os
 import sys
-import unittest
 
 try:
-   # @note Grabs the first directory in the chain named unittests/.
-   sys.path.append(os.path.join(os.getcwd().split("unittests")[0], "unittests/"))
    import testsuitebase
 except:
    print("Cannot import testsuitebase - path set correctly?")
@@ -32,9 +28,9 @@ class TestSuite(testsuitebase.TestSuiteBase):
       """
       Acting constructor.
       """
-
-      super().setUpBaseClass(filepath="ym/common/",
-                             filename="ops")
+      super().setUpBaseClass(
+         filepath="ym/common/",
+         filename="ops")
 
    @classmethod
    def tearDownClass(cls):
@@ -61,7 +57,7 @@ class TestSuite(testsuitebase.TestSuiteBase):
       """
       from cppyy.gbl import std # type:ignore
       from cppyy.gbl import ym  # type:ignore
-      
+
       results = self.run_test_case("Casting")
 
       self.assertTrue(results.get[bool]("Val_char"), "char cast failed")
@@ -117,10 +113,129 @@ class TestSuite(testsuitebase.TestSuiteBase):
       for result in results.get[std.vector[bool]]("BadCasts_flt80"):
          self.assertTrue(result, "float80 cast failed to fail")
 
+   def test_ErrorCodes(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("ErrorCodes")
+
+      for name in ["Char_Empty", "Int8_Range", "Int16_Range", "UInt8_Range", "UInt8_Negative",
+                   "Int32_PlusMinus", "Int32_Trailing", "Int32_Space", "Int64_Long", "UInt64_BadBase",
+                   "Flt64_Trailing", "Flt64_Overflow"]:
+         self.assertTrue(results.get[bool](name), f"{name} reported the wrong error")
+
+      self.assertTrue(results.get[bool]("Hex"         ), "Base 16 cast failed"       )
+      self.assertTrue(results.get[bool]("Binary"      ), "Base 2 cast failed"        )
+      self.assertTrue(results.get[bool]("LeadingZeros"), "Leading zeros cast failed" )
+      self.assertTrue(results.get[bool]("Flt32"       ), "float32 '+' cast failed"   )
+
+   def test_DecimalFastPath(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("DecimalFastPath")
+
+      print(f"castTo<int64> {results.get['double']('Ops_ns'):.2f} ns "
+            f"(from_chars {results.get['double']('FromChars_ns'):.2f} ns)")
+
+      self.assertTrue(results.get[bool]("Matches"     ), "Fast path disagrees with the value"  )
+      self.assertTrue(results.get[bool]("RejectsStray"), "Fast path accepted a stray char"     )
+      self.assertTrue(results.get[bool]("Checksum"    ), "Fast path disagrees with from_chars")
+      self.assertLess(results.get["double"]("Ops_ns"), 50.0, "Decimal casts too slow")
+
+   def test_FloatRounding(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("FloatRounding")
+
+      self.assertEqual(results.get[ym.uint64]("NMismatches"), 0, "Float casts rounded differently than from_chars")
+
+   def test_Column(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Column")
+
+      self.assertTrue(results.get[bool]("Lines"  ), "Column of lines cast wrong"          )
+      self.assertTrue(results.get[bool]("Csv"    ), "Column of comma separated cast wrong")
+      self.assertTrue(results.get[bool]("Empty"  ), "Empty column not empty"              )
+      self.assertTrue(results.get[bool]("TooMany"), "Overflowing column not caught"       )
+      self.assertTrue(results.get[bool]("BadVal" ), "Bad value in column not caught"      )
+      self.assertTrue(results.get[bool]("Blank"  ), "Blank field in column not caught"    )
+      self.assertTrue(results.get[bool]("Throws" ), "castColumn() didn't throw"           )
+
+   def test_IntFormatting(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("IntFormatting")
+
+      self.assertEqual(results.get[ym.uint64]("NMismatches"), 0, "Integers formatted differently than fmt")
+      self.assertTrue (results.get[bool]("FixedWidth"), "Fixed width integers formatted wrong")
+
+   def test_FloatFormatting(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("FloatFormatting")
+
+      self.assertEqual(results.get[ym.uint64]("NMismatches"), 0, "Floats not formatted shortest round trip")
+      self.assertTrue (results.get[bool]("Layout"), "Floats not laid out like fmt")
+
+   def test_FormatColumn(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("FormatColumn")
+
+      print(f"formatColumn<float64> {results.get['double']('Ops_ns'):.2f} ns/val "
+            f"(fmt {results.get['double']('Fmt_ns'):.2f} ns/val)")
+
+      self.assertTrue(results.get[bool]("Small"    ), "Column of floats formatted wrong"      )
+      self.assertTrue(results.get[bool]("Ints"     ), "Column of ints formatted wrong"        )
+      self.assertTrue(results.get[bool]("Cramped"  ), "Wrote past end of buffer"              )
+      self.assertTrue(results.get[bool]("SameSize" ), "Column not the same size as with fmt"  )
+      self.assertTrue(results.get[bool]("RoundTrip"), "Column didn't read back the same"      )
+      self.assertLess(results.get["double"]("Ops_ns"), results.get["double"]("Fmt_ns"), "formatColumn slower than fmt")
+
+   def test_RoundTrip(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("RoundTrip")
+
+      self.assertTrue(results.get[bool]("Special32"  ), "float32 inf/nan didn't round trip"            )
+      self.assertTrue(results.get[bool]("Special64"  ), "float64 inf/nan didn't round trip"            )
+      self.assertTrue(results.get[bool]("Subnormal32"), "float32 subnormals not handled as documented" )
+      self.assertTrue(results.get[bool]("Subnormal64"), "float64 subnormals not handled as documented" )
+
 # kick-off
 if __name__ == "__main__":
-   if os.path.basename(os.getcwd()) != "ops":
-      print("Needs to be run in the ops/ directory")
-      sys.exit(1)
-
-   unittest.main()
+   TestSuite.runSuite()
+else:
+   TestSuite.runSuite()
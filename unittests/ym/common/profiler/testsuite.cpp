@@ -0,0 +1,229 @@
+/**
+ * @file    testsuite.cpp
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#include "testsuite.h"
+
+#include "textlogger.h"
+#include "ymglobals.h"
+
+#include "profiler.h" // Structures under test
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+/** findZone
+ *
+ * @brief Returns the stats of the named zone.
+ *
+ * @param Stats -- From Profiler::summarize().
+ * @param Name  -- Name of zone.
+ *
+ * @returns Profiler::ZoneStats_T -- Stats, empty if the zone wasn't recorded.
+ */
+ym::Profiler::ZoneStats_T findZone(
+   std::vector<ym::Profiler::ZoneStats_T> const & Stats,
+   std::string_view                       const   Name)
+{
+   auto const It = std::ranges::find(Stats, Name, &ym::Profiler::ZoneStats_T::_name);
+   return (It != Stats.end()) ? *It : ym::Profiler::ZoneStats_T{};
+}
+
+/** spin
+ *
+ * @brief Burns some time inside a zone.
+ *
+ * @param Name_Ptr -- Name of zone.
+ */
+void spin(char const * const Name_Ptr)
+{
+   using namespace ym;
+
+   ProfileScope const Scope(Name_Ptr);
+
+   auto volatile sink = 0_u64;
+   for (auto i = 0_u64; i < 1000_u64; ++i)
+   { // busy
+      sink = sink + i;
+   }
+}
+
+} // anonymous
+
+/** TestSuite
+ *
+ * @brief Constructor.
+ */
+ym::unit::TestSuite::TestSuite(void) :
+   TestSuiteBase("Profiler")
+{
+   addTestCase<InteractiveInspection>();
+   addTestCase<Nesting              >();
+   addTestCase<Threads              >();
+   addTestCase<ChromeTrace          >();
+   addTestCase<CompileSwitch        >();
+}
+
+/** run
+ *
+ * @brief Interactive inspection - for debug purposes.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::InteractiveInspection::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Profiler);
+   return {};
+}
+
+/** run
+ *
+ * @brief Nested zones - counts, and exclusive time of the parent leaves out its children.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Nesting::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Profiler);
+
+   Profiler::reset();
+
+   for (auto i = 0; i < 10; ++i)
+   { // outer contains 3 inner
+      ProfileScope const Outer("outer");
+      spin("inner");
+      spin("inner");
+      spin("inner");
+   }
+
+   auto const Stats = Profiler::summarize();
+   auto const Outer = findZone(Stats, "outer");
+   auto const Inner = findZone(Stats, "inner");
+
+   ymLog(VG::UnitTest_Profiler, "\n{}", Profiler::getSummaryTable());
+
+   return {
+      {"OuterCalls",    Outer._calls == 10_u64                                          },
+      {"InnerCalls",    Inner._calls == 30_u64                                          },
+      {"InnerIsLeaf",   Inner._exclusive_ns == Inner._inclusive_ns                      },
+      {"OuterExcludes", Outer._exclusive_ns == Outer._inclusive_ns - Inner._inclusive_ns},
+      {"SortedByTime",  !Stats.empty() && Stats.front()._name == "outer"                }
+   };
+}
+
+/** run
+ *
+ * @brief Zones recorded on several threads (some already finished) are all counted.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Threads::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Profiler);
+
+   constexpr auto NThreads = 4uz;
+   constexpr auto NZones   = 10'000_u64; // spans several chunks
+
+   Profiler::reset();
+
+   { // join before summarizing
+      auto threads = std::vector<std::jthread>();
+      for (auto t = 0uz; t < NThreads; ++t)
+      { // each records its own zones
+         threads.emplace_back([]() {
+            for (auto i = 0_u64; i < NZones; ++i)
+            { // small zones
+               ProfileScope const Scope("threaded");
+            }
+         });
+      }
+   }
+
+   auto const Zone = findZone(Profiler::summarize(), "threaded");
+
+   return {
+      {"AllCounted", Zone._calls == NThreads * NZones}
+   };
+}
+
+/** run
+ *
+ * @brief Exports a Chrome trace - every begin has a matching end.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::ChromeTrace::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Profiler);
+
+   auto const Filename = "logs/profiler_trace.json";
+
+   Profiler::reset();
+
+   for (auto i = 0; i < 5; ++i)
+   { // a few zones, one with a name that needs escaping
+      ProfileScope const Outer("outer \"quoted\"");
+      spin("inner");
+   }
+
+   auto const Written = Profiler::writeChromeTrace(Filename);
+
+   std::ifstream infile(Filename);
+   auto const Contents = std::string(std::istreambuf_iterator<char>(infile), std::istreambuf_iterator<char>());
+
+   auto const Count = [&Contents](std::string_view const Pattern) {
+      auto n = 0uz;
+      for (auto pos = Contents.find(Pattern); pos != std::string::npos; pos = Contents.find(Pattern, pos + 1uz))
+      { // each occurrence
+         ++n;
+      }
+      return n;
+   };
+
+   return {
+      {"Written",  Written                                                       },
+      {"Header",   Contents.starts_with("{\"displayTimeUnit\"")                  },
+      {"Balanced", Count("\"ph\":\"B\"") == 10uz && Count("\"ph\":\"E\"") == 10uz},
+      {"Escaped",  Count("outer \\\"quoted\\\"") == 10uz                         }
+   };
+}
+
+/** run
+ *
+ * @brief The macros record zones only if profiling is compiled in.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::CompileSwitch::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Profiler);
+
+#if (YM_PROFILE)
+   constexpr auto Enabled = true;
+#else
+   constexpr auto Enabled = false;
+#endif
+
+   Profiler::reset();
+
+   { // zone
+      YM_PROFILE_SCOPE("macro");
+   }
+
+   auto const Zone = findZone(Profiler::summarize(), "macro");
+
+   return {
+      {"Enabled",  Enabled             },
+      {"Recorded", Zone._calls == 1_u64}
+   };
+}
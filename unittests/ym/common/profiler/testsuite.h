@@ -0,0 +1,33 @@
+/**
+ * @file    testsuite.h
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#pragma once
+
+#include "ymdefs.h"
+
+#include "testsuitebase.h"
+
+namespace ym::unit // TODO consider renaming namespace unit, YM_UT_TESTCASE -> YM_UNIT_TESTCASE
+{
+
+/** TestSuite
+ *
+ * @brief Test suite for Profiler.
+ */
+class TestSuite : public TestSuiteBase
+{
+public:
+   explicit TestSuite(void);
+   virtual ~TestSuite(void) = default;
+
+   YM_UT_TESTCASE(InteractiveInspection)
+   YM_UT_TESTCASE(Nesting              )
+   YM_UT_TESTCASE(Threads              )
+   YM_UT_TESTCASE(ChromeTrace          )
+   YM_UT_TESTCASE(CompileSwitch        )
+};
+
+} // ym::unit
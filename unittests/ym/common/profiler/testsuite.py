@@ -0,0 +1,110 @@
+##
+# @file    testsuite.py
+# @version 1.0.0
+# @author  Forrest Jablonski
+#
+
+import sys
+
+try:
+   import testsuitebase
+except:
+   print("Cannot import testsuitebase - path set correctly?")
+   sys.exit(1)
+
+try:
+   import cppyy
+except:
+   print("Cannot import cppyy - started the venv?")
+   sys.exit(1)
+
+class TestSuite(testsuitebase.TestSuiteBase):
+   """
+   Collection of all tests for Profiler.
+   """
+
+   @classmethod
+   def setUpClass(cls):
+      """
+      Acting constructor.
+      """
+      super().setUpBaseClass(
+         filepath="ym/common/",
+         filename="profiler")
+
+   @classmethod
+   def tearDownClass(cls):
+      """
+      Acting destructor.
+      """
+      pass
+
+   def test_InteractiveInspection(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+      
+      # uncomment to run test
+      # results = self.run_test_case("InteractiveInspection")
+      pass
+
+   def test_Nesting(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Nesting")
+
+      self.assertTrue(results.get[bool]("OuterCalls"   ), "Outer zone not counted correctly")
+      self.assertTrue(results.get[bool]("InnerCalls"   ), "Inner zone not counted correctly")
+      self.assertTrue(results.get[bool]("InnerIsLeaf"  ), "Leaf zone exclusive time not equal to inclusive time")
+      self.assertTrue(results.get[bool]("OuterExcludes"), "Parent exclusive time includes children")
+      self.assertTrue(results.get[bool]("SortedByTime" ), "Summary not sorted by inclusive time")
+
+   def test_Threads(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Threads")
+
+      self.assertTrue(results.get[bool]("AllCounted"), "Zones of some threads missing")
+
+   def test_ChromeTrace(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("ChromeTrace")
+
+      self.assertTrue(results.get[bool]("Written" ), "Trace not written")
+      self.assertTrue(results.get[bool]("Header"  ), "Trace not in trace_event format")
+      self.assertTrue(results.get[bool]("Balanced"), "Begin and end events don't match")
+      self.assertTrue(results.get[bool]("Escaped" ), "Zone name not escaped")
+
+   def test_CompileSwitch(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("CompileSwitch")
+
+      enabled  = results.get[bool]("Enabled" )
+      recorded = results.get[bool]("Recorded")
+      self.assertEqual(enabled, recorded, "Macro recorded zones while compiled out, or vice versa")
+
+# kick-off
+if __name__ == "__main__":
+   TestSuite.runSuite()
+else:
+   TestSuite.runSuite()
@@ -4,27 +4,46 @@
  * @author  Forrest Jablonski
  */
 
-#include "ymdefs.h"
 #include "testsuite.h"
 
-#include "rng.h"
 #include "textlogger.h"
-#include "ymerror.h"
+#include "timer.h"
+#include "ymglobals.h"
+
+#include "rng.h" // Structures under test
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <bitset>
+#include <numeric>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#include <sys/wait.h>
+#include <unistd.h>
+
 /** TestSuite
  *
  * @brief Constructor.
  */
-ym::unit::TestSuite::TestSuite(void)
-   : TestSuiteBase("Rng")
+ym::unit::TestSuite::TestSuite(void) :
+   TestSuiteBase("Rng")
 {
-   addTestCase<ZerosAndOnes>();
-   addTestCase<UniformBins >();
+   addTestCase<ZerosAndOnes      >();
+   addTestCase<UniformBins       >();
+   addTestCase<FillMatchesGen    >();
+   addTestCase<FillSpeed         >();
+   addTestCase<JumpAhead         >();
+   addTestCase<StreamSet         >();
+   addTestCase<PhiloxKnownAnswers>();
+   addTestCase<PhiloxRandomAccess>();
+   addTestCase<PhiloxSpeed       >();
+   addTestCase<TrngEntropy       >();
+   addTestCase<TrngSpeed         >();
+   addTestCase<TrngFork          >();
 }
 
 /** run
@@ -104,3 +123,508 @@ auto ym::unit::TestSuite::UniformBins::run([[maybe_unused]] DataShuttle const &
       {"f64Bins", f64Bins}
    };
 }
+
+/** run
+ *
+ * @brief Checks bulk generation yields the same values as one at a time generation.
+ *
+ * @note Sizes straddle the lane count so both the vector and the leftover paths run.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test case.
+ */
+auto ym::unit::TestSuite::FillMatchesGen::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   constexpr auto N = Prng::_s_NLanes;
+
+   auto sameU64   = true;
+   auto sameF64   = true;
+   auto sameState = true;
+
+   for (auto const Size : {0uz, 1uz, N - 1uz, N, N + 1uz, (7uz * N) + 3uz, 10'000uz})
+   { // each size
+      Prng bulk  (0xdead'beef_u64);
+      Prng single(0xdead'beef_u64);
+
+      auto u64s = std::vector<uint64 >(Size);
+      auto f64s = std::vector<float64>(Size);
+
+      bulk.fill(u64s);
+      sameU64 &= std::ranges::all_of(u64s, [&](auto const Val) { return Val == single.gen<uint64>(); });
+
+      bulk.fill(f64s);
+      sameF64 &= std::ranges::all_of(f64s, [&](auto const Val) { return Val == single.gen<float64>(); });
+
+      sameState &= bulk.getState() == single.getState();
+   }
+
+   return {
+      {"SameU64",   sameU64  },
+      {"SameF64",   sameF64  },
+      {"SameState", sameState}
+   };
+}
+
+/** run
+ *
+ * @brief Measures the cost per value of bulk generation against one at a time generation.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test case.
+ */
+auto ym::unit::TestSuite::FillSpeed::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   constexpr auto NVals   = 4'096uz; // stays in cache
+   constexpr auto NRounds = 2'000uz;
+
+   Prng rand;
+   auto vals = std::vector<float64>(NVals);
+   auto sum  = 0.0_f64; // keeps the values alive
+
+   auto const PerVal_ns = [](Timer const & T) {
+      return static_cast<float64>(T.getElapsedTime().count()) / static_cast<float64>(NVals * NRounds);
+   };
+
+   Timer fillTimer;
+   for (auto r = 0uz; r < NRounds; ++r)
+   { // bulk
+      rand.fill(vals);
+      sum += vals[r % NVals];
+   }
+   auto const Fill_ns = PerVal_ns(fillTimer);
+
+   Timer genTimer;
+   for (auto r = 0uz; r < NRounds; ++r)
+   { // one at a time
+      for (auto & val : vals)
+      { // each value
+         val = rand.gen<float64>();
+      }
+      sum += vals[r % NVals];
+   }
+   auto const Gen_ns = PerVal_ns(genTimer);
+
+   ymLog(VG::UnitTest_Rng, "fill() {:.3f} ns/val, gen() {:.3f} ns/val (checksum {})", Fill_ns, Gen_ns, sum);
+
+   return {
+      {"Fill_ns", Fill_ns},
+      {"Gen_ns",  Gen_ns }
+   };
+}
+
+/** run
+ *
+ * @brief Checks jumping ahead lands where stepping one at a time does.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test case.
+ */
+auto ym::unit::TestSuite::JumpAhead::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   auto forwards  = true;
+   auto backwards = true;
+
+   for (auto const NJumps : {0_u64, 1_u64, 31_u64, 1'000_u64, 123'457_u64})
+   { // each distance
+      Prng jumper (0x1234'5678_u64);
+      Prng stepper(0x1234'5678_u64);
+
+      jumper.jump(NJumps);
+      for (auto i = 0_u64; i < NJumps; ++i)
+      { // one at a time
+         (void)stepper.gen<uint64>();
+      }
+      forwards &= jumper.getState() == stepper.getState();
+
+      jumper.jump(0_u64 - NJumps);
+      backwards &= jumper.getState() == jumper.getSeed();
+   }
+
+   Prng far;
+   Timer timer;
+   far.jump(0x8000'0000'0000'0000_u64 - 1_u64);
+   auto const FarJump_ns = timer.getElapsedTime().count();
+
+   ymLog(VG::UnitTest_Rng, "jump(2^63 - 1) took {} ns", FarJump_ns);
+
+   return {
+      {"Forwards",   forwards  },
+      {"Backwards",  backwards },
+      {"FarJump_ns", FarJump_ns}
+   };
+}
+
+/** run
+ *
+ * @brief Estimates pi with a varying number of threads drawing from one stream set.
+ *
+ * @note Work is split into chunks, each with its own stream. The estimate must come out
+ *       bit for bit the same for any number of threads.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test case.
+ */
+auto ym::unit::TestSuite::StreamSet::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   constexpr auto NChunks         = 64uz;
+   constexpr auto NPointsPerChunk = 50'000uz;
+
+   PrngStreamSet const Streams(0xfeed'face_u64);
+
+   auto const EstimatePi = [&](sizet const NThreads) {
+      auto hits      = std::vector<uint64>(NChunks, 0_u64);
+      auto nextChunk = std::atomic<sizet>(0uz);
+
+      { // workers grab chunks in whatever order they get to them
+         auto threads = std::vector<std::jthread>();
+         for (auto t = 0uz; t < NThreads; ++t)
+         { // each worker
+            threads.emplace_back([&]() {
+               for (auto c = nextChunk++; c < NChunks; c = nextChunk++)
+               { // each chunk
+                  auto rand = Streams.getStream(c);
+                  for (auto i = 0uz; i < NPointsPerChunk; ++i)
+                  { // each point
+                     auto const X = rand.gen<float64>();
+                     auto const Y = rand.gen<float64>();
+                     hits[c] += ((X * X) + (Y * Y) < 1.0_f64) ? 1_u64 : 0_u64;
+                  }
+               }
+            });
+         }
+      }
+
+      auto const NHits = std::accumulate(hits.begin(), hits.end(), 0_u64);
+      return 4.0_f64 * static_cast<float64>(NHits) / static_cast<float64>(NChunks * NPointsPerChunk);
+   };
+
+   auto const Pi1 = EstimatePi(1uz);
+   auto const Pi2 = EstimatePi(2uz);
+   auto const Pi3 = EstimatePi(3uz);
+   auto const Pi8 = EstimatePi(8uz);
+
+   ymLog(VG::UnitTest_Rng, "pi ~ {} (1 thread), {} (2), {} (3), {} (8)", Pi1, Pi2, Pi3, Pi8);
+
+   // neighbouring streams meet but don't overlap
+   PrngStreamSet const Short(0xfeed'face_u64, 1'000_u64);
+   auto first  = Short.getStream(0_u64);
+   auto second = Short.getStream(1_u64);
+   for (auto i = 0_u64; i < Short.getStreamLength(); ++i)
+   { // use up the first stream
+      (void)first.gen<uint64>();
+   }
+
+   return {
+      {"SameForAnyThreads", Pi1 == Pi2 && Pi1 == Pi3 && Pi1 == Pi8     },
+      {"Pi",                Pi1                                        },
+      {"Contiguous",        first.gen<uint64>() == second.gen<uint64>()},
+      {"MaxNStreams",       Short.getMaxNStreams()                     }
+   };
+}
+
+/** run
+ *
+ * @brief Checks Philox against the known answers of the Random123 reference.
+ *
+ * @ref <https://github.com/DEShawResearch/random123/blob/main/tests/kat_vectors>
+ *
+ * @returns DataShuttle -- Important values acquired during run of test case.
+ */
+auto ym::unit::TestSuite::PhiloxKnownAnswers::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   /** Kat_T
+    *
+    * @brief Counter and key in, block out.
+    */
+   struct Kat_T
+   {
+      Philox::Block_T _ctr;
+      Philox::Key_T   _key;
+      Philox::Block_T _expected;
+   };
+
+   constexpr auto Kats = std::array{
+      Kat_T{{0x0000'0000_u32, 0x0000'0000_u32, 0x0000'0000_u32, 0x0000'0000_u32}, {0x0000'0000_u32, 0x0000'0000_u32},
+            {0x6627'e8d5_u32, 0xe169'c58d_u32, 0xbc57'ac4c_u32, 0x9b00'dbd8_u32}},
+      Kat_T{{0xffff'ffff_u32, 0xffff'ffff_u32, 0xffff'ffff_u32, 0xffff'ffff_u32}, {0xffff'ffff_u32, 0xffff'ffff_u32},
+            {0x408f'276d_u32, 0x41c8'3b0e_u32, 0xa20b'c7c6_u32, 0x6d54'51fd_u32}},
+      Kat_T{{0x243f'6a88_u32, 0x85a3'08d3_u32, 0x1319'8a2e_u32, 0x0370'7344_u32}, {0xa409'3822_u32, 0x299f'31d0_u32},
+            {0xd16c'fe09_u32, 0x94fd'cceb_u32, 0x5001'e420_u32, 0x2412'6ea1_u32}}
+   };
+
+   static_assert(std::ranges::all_of(Kats, [](auto const & Kat) { return Philox::encrypt(Kat._ctr, Kat._key) == Kat._expected; }),
+      "Philox disagrees with the reference at compile time");
+
+   auto matches = true;
+   for (auto const & Kat : Kats)
+   { // at run time too
+      matches &= Philox::encrypt(Kat._ctr, Kat._key) == Kat._expected;
+   }
+
+   Philox zero(0_u64);
+   auto const SequenceMatches = zero.gen<uint64>() == 0xe169'c58d'6627'e8d5_u64 &&
+                                zero.gen<uint64>() == 0x9b00'dbd8'bc57'ac4c_u64;
+
+   return {
+      {"Matches",         matches        },
+      {"SequenceMatches", SequenceMatches}
+   };
+}
+
+/** run
+ *
+ * @brief Checks any value can be computed on its own and bulk fill matches gen().
+ *
+ * @returns DataShuttle -- Important values acquired during run of test case.
+ */
+auto ym::unit::TestSuite::PhiloxRandomAccess::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   auto atMatches    = true;
+   auto fillMatches  = true;
+   auto stateMatches = true;
+
+   for (auto const Start : {0_u64, 1_u64, 7_u64, 0x1'ffff'fffe_u64}) // last crosses into the high counter word
+   { // each starting position
+      for (auto const N : {0uz, 1uz, 2uz, 3uz, 63uz, 64uz, 65uz, 1'001uz})
+      { // sizes around the kernel widths
+         Philox bulk  (0xabcd_u64);
+         Philox single(0xabcd_u64);
+         bulk  .setPosition(Start);
+         single.setPosition(Start);
+
+         auto ints  = std::vector<uint64 >(N);
+         auto reals = std::vector<float64>(N);
+
+         bulk.fill(ints);
+         for (auto i = 0uz; i < N; ++i)
+         { // random access, then sequential
+            atMatches   &= bulk.at(Start + i) == ints[i];
+            fillMatches &= single.gen<uint64>() == ints[i];
+         }
+
+         bulk.fill(reals);
+         fillMatches &= std::ranges::all_of(reals, [&](float64 const Val) { return Val == single.gen<float64>(); });
+
+         stateMatches &= bulk.getPosition() == single.getPosition() && bulk.gen<uint64>() == single.gen<uint64>();
+      }
+   }
+
+   Philox jumper(0xabcd_u64);
+   Philox stepper(0xabcd_u64);
+   jumper.jump(12'345_u64);
+   for (auto i = 0_u64; i < 12'345_u64; ++i)
+   { // one at a time
+      (void)stepper.gen<uint64>();
+   }
+
+   return {
+      {"AtMatches",    atMatches                                    },
+      {"FillMatches",  fillMatches                                  },
+      {"StateMatches", stateMatches                                 },
+      {"JumpMatches",  jumper.gen<uint64>() == stepper.gen<uint64>()}
+   };
+}
+
+/** run
+ *
+ * @brief Measures the cost per value of Philox against Prng.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test case.
+ */
+auto ym::unit::TestSuite::PhiloxSpeed::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   constexpr auto NVals   = 4'096uz; // stays in cache
+   constexpr auto NRounds = 2'000uz;
+
+   auto vals = std::vector<uint64>(NVals);
+   auto sum  = 0_u64; // keeps the values alive
+
+   auto const PerVal_ns = [](Timer const & T) {
+      return static_cast<float64>(T.getElapsedTime().count()) / static_cast<float64>(NVals * NRounds);
+   };
+
+   auto const TimeFill = [&](auto & rand) {
+      Timer timer;
+      for (auto r = 0uz; r < NRounds; ++r)
+      { // bulk
+         rand.fill(vals);
+         sum += vals[r % NVals];
+      }
+      return PerVal_ns(timer);
+   };
+
+   auto const TimeGen = [&](auto & rand) {
+      Timer timer;
+      for (auto r = 0uz; r < NRounds; ++r)
+      { // one at a time
+         std::ranges::generate(vals, [&]() { return rand.template gen<uint64>(); });
+         sum += vals[r % NVals];
+      }
+      return PerVal_ns(timer);
+   };
+
+   Philox philox;
+   Prng   prng;
+
+   auto const PhiloxFill_ns = TimeFill(philox);
+   auto const PrngFill_ns   = TimeFill(prng  );
+   auto const PhiloxGen_ns  = TimeGen (philox);
+   auto const PrngGen_ns    = TimeGen (prng  );
+
+   ymLog(VG::UnitTest_Rng, "Philox fill() {:.3f} gen() {:.3f} ns/val, Prng fill() {:.3f} gen() {:.3f} ns/val (checksum {})",
+      PhiloxFill_ns, PhiloxGen_ns, PrngFill_ns, PrngGen_ns, sum);
+
+   return {
+      {"PhiloxFill_ns", PhiloxFill_ns},
+      {"PhiloxGen_ns",  PhiloxGen_ns },
+      {"PrngFill_ns",   PrngFill_ns  },
+      {"PrngGen_ns",    PrngGen_ns   }
+   };
+}
+
+/** run
+ *
+ * @brief Sanity checks on the entropy handed out - no repeats, balanced bits, and
+ *        distinct per-thread generators.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test case.
+ */
+auto ym::unit::TestSuite::TrngEntropy::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   constexpr auto NVals = 4uz * Trng::_s_BufferSize + 3uz; // crosses several refills
+
+   Trng trng;
+   auto vals = std::vector<uint64>(NVals);
+   std::ranges::generate(vals, [&]() { return trng.gen<uint64>(); });
+
+   auto nSetBits = 0_u64;
+   for (auto const Val : vals)
+   { // count bits
+      nSetBits += static_cast<uint64>(std::popcount(Val));
+   }
+
+   std::ranges::sort(vals);
+   auto const NoRepeats = std::ranges::adjacent_find(vals) == vals.end(); // 64 bit collisions won't happen
+
+   auto seeds = std::vector<uint64>(8uz);
+   {
+      auto threads = std::vector<std::jthread>();
+      for (auto t = 0uz; t < seeds.size(); ++t)
+      { // each grabs its own generator
+         threads.emplace_back([&seeds, t]() { seeds[t] = Trng::getThreadPrng().getSeed(); });
+      }
+   }
+
+   auto const SameThreadSame = &Trng::getThreadPrng() == &Trng::getThreadPrng();
+
+   std::ranges::sort(seeds);
+   auto const DistinctSeeds = std::ranges::adjacent_find(seeds) == seeds.end();
+
+   return {
+      {"NoRepeats",      NoRepeats                                                          },
+      {"OnesFrac",       static_cast<float64>(nSetBits) / static_cast<float64>(NVals * 64uz)},
+      {"DistinctSeeds",  DistinctSeeds                                                      },
+      {"SameThreadSame", SameThreadSame                                                     }
+   };
+}
+
+/** run
+ *
+ * @brief Measures the cost per value of Trng (refills included) against Prng.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test case.
+ */
+auto ym::unit::TestSuite::TrngSpeed::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   constexpr auto NVals = 1'000'000uz;
+
+   auto sum = 0_u64; // keeps the values alive
+
+   Trng trng;
+   Timer trngTimer;
+   for (auto i = 0uz; i < NVals; ++i)
+   { // one at a time
+      sum += trng.gen<uint64>();
+   }
+   auto const Trng_ns = static_cast<float64>(trngTimer.getElapsedTime().count()) / static_cast<float64>(NVals);
+
+   Prng prng;
+   Timer prngTimer;
+   for (auto i = 0uz; i < NVals; ++i)
+   { // one at a time
+      sum += prng.gen<uint64>();
+   }
+   auto const Prng_ns = static_cast<float64>(prngTimer.getElapsedTime().count()) / static_cast<float64>(NVals);
+
+   ymLog(VG::UnitTest_Rng, "Trng gen() {:.3f} ns/val, Prng gen() {:.3f} ns/val (checksum {})", Trng_ns, Prng_ns, sum);
+
+   return {
+      {"Trng_ns", Trng_ns},
+      {"Prng_ns", Prng_ns}
+   };
+}
+
+/** run
+ *
+ * @brief Checks that a fork() child doesn't hand out what its parent does.
+ *
+ * @note Both generators are used before the fork, so the child inherits a partly
+ *       spent entropy batch and a seeded thread Prng.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test case.
+ */
+auto ym::unit::TestSuite::TrngFork::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   Trng trng;
+   (void)trng.gen<uint64>();
+   (void)Trng::getThreadPrng().gen<uint64>();
+
+   auto fds = std::array<int, 2uz>{-1, -1};
+   auto const Piped = ::pipe(fds.data()) == 0;
+
+   auto const Pid = Piped ? ::fork() : -1;
+
+   if (Pid == 0)
+   { // child - report and leave
+      auto const Vals = std::array<uint64, 2uz>{trng.gen<uint64>(), Trng::getThreadPrng().gen<uint64>()};
+      auto const NWritten = ::write(fds[1], Vals.data(), sizeof(Vals));
+      ::_exit(NWritten == static_cast<ssize_t>(sizeof(Vals)) ? 0 : 1);
+   }
+
+   auto const Vals  = std::array<uint64, 2uz>{trng.gen<uint64>(), Trng::getThreadPrng().gen<uint64>()};
+   auto childVals   = std::array<uint64, 2uz>{};
+   auto       nRead = ssize_t(-1);
+
+   if (Pid > 0)
+   { // parent - collect
+      (void)::close(fds[1]);
+      nRead = ::read(fds[0], childVals.data(), sizeof(childVals));
+      (void)::waitpid(Pid, nullptr, 0);
+   }
+
+   for (auto const FD : fds) { if (FD >= 0) { (void)::close(FD); } }
+
+   ymLog(VG::UnitTest_Rng, "Parent {:#x} {:#x}, child {:#x} {:#x}", Vals[0], Vals[1], childVals[0], childVals[1]);
+
+   return {
+      {"Forked",      nRead == static_cast<ssize_t>(sizeof(childVals))},
+      {"TrngDiffers", Vals[0] != childVals[0]                         },
+      {"PrngDiffers", Vals[1] != childVals[1]                         }
+   };
+}
@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include "utdefs.h"
+#include "ymdefs.h"
 
 #include "testsuitebase.h"
 
@@ -23,8 +23,18 @@ public:
    explicit TestSuite(void);
    virtual ~TestSuite(void) = default;
 
-   YM_UT_TESTCASE(ZerosAndOnes);
-   YM_UT_TESTCASE(UniformBins );
+   YM_UT_TESTCASE(ZerosAndOnes      )
+   YM_UT_TESTCASE(UniformBins       )
+   YM_UT_TESTCASE(FillMatchesGen    )
+   YM_UT_TESTCASE(FillSpeed         )
+   YM_UT_TESTCASE(JumpAhead         )
+   YM_UT_TESTCASE(StreamSet         )
+   YM_UT_TESTCASE(PhiloxKnownAnswers)
+   YM_UT_TESTCASE(PhiloxRandomAccess)
+   YM_UT_TESTCASE(PhiloxSpeed       )
+   YM_UT_TESTCASE(TrngEntropy       )
+   YM_UT_TESTCASE(TrngSpeed         )
+   YM_UT_TESTCASE(TrngFork          )
 };
 
 } // ym::unit
@@ -4,16 +4,11 @@
 # @author  Forrest Jablonski
 #
 
-import os
+import math
+import statistics
 import sys
-import unittest
-
-import numpy as np
-from scipy.stats import binom as bn
 
 try:
-   # @note Grabs the first directory in the chain named unittests/.
-   sys.path.append(os.path.join(os.getcwd().split("unittests")[0], "unittests/"))
    import testsuitebase
 except:
    print("Cannot import testsuitebase - path set correctly?")
@@ -35,9 +30,9 @@ class TestSuite(testsuitebase.TestSuiteBase):
       """
       Acting constructor.
       """
-
-      super().setUpBaseClass(filepath="ym/common",
-                             filename="rng")
+      super().setUpBaseClass(
+         filepath="ym/common/",
+         filename="rng")
 
    @classmethod
    def tearDownClass(cls):
@@ -72,7 +67,10 @@ class TestSuite(testsuitebase.TestSuiteBase):
          nTrials    = set_bits.first
          kSuccesses = set_bits.second
          assumedProb = 0.5
-         probOfResultOrWorse = bn.cdf(kSuccesses, nTrials, assumedProb)
+         # binomial cdf through its normal approximation (nTrials >= 2^14)
+         mean = nTrials * assumedProb
+         std_ = math.sqrt(nTrials * assumedProb * (1.0 - assumedProb))
+         probOfResultOrWorse = 0.5 * (1.0 + math.erf((kSuccesses + 0.5 - mean) / (std_ * math.sqrt(2.0))))
          print(f"For {nTrials} trials, prob of {kSuccesses} or worse {(probOfResultOrWorse*100):0.2f}%")
 
    def test_UniformBins(self):
@@ -85,16 +83,158 @@ class TestSuite(testsuitebase.TestSuiteBase):
       results = self.run_test_case("UniformBins")
 
       for bin_name in ["u32", "u64", "f32", "f64"]:
-         bin_counts = np.array(results.get[std.vector[ym.uint64]](f"{bin_name}Bins"))
-         print(f"std of {bin_name} bins {bin_counts.std()}")
-         print(f"min of {bin_name} bins {bin_counts.min()}")
-         print(f"max of {bin_name} bins {bin_counts.max()}")
-         print(f"ave of {bin_name} bins {bin_counts.mean()}")
+         bin_counts = list(results.get[std.vector[ym.uint64]](f"{bin_name}Bins"))
+         print(f"std of {bin_name} bins {statistics.pstdev(bin_counts)}")
+         print(f"min of {bin_name} bins {min(bin_counts)}")
+         print(f"max of {bin_name} bins {max(bin_counts)}")
+         print(f"ave of {bin_name} bins {statistics.fmean(bin_counts)}")
+
+   def test_FillMatchesGen(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("FillMatchesGen")
+
+      self.assertTrue(results.get[bool]("SameU64"  ), "fill(uint64) differs from gen<uint64>()"  )
+      self.assertTrue(results.get[bool]("SameF64"  ), "fill(float64) differs from gen<float64>()")
+      self.assertTrue(results.get[bool]("SameState"), "fill() left the generator in another state")
+
+   def test_FillSpeed(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("FillSpeed")
+
+      fill = results.get["double"]("Fill_ns")
+      gen  = results.get["double"]("Gen_ns" )
+      print(f"fill(): {fill:.3f} ns/val, gen(): {gen:.3f} ns/val")
+
+      self.assertLess(fill, gen, "Bulk generation slower than one at a time")
+
+   def test_JumpAhead(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("JumpAhead")
+
+      self.assertTrue(results.get[bool]("Forwards" ), "jump(n) doesn't match n steps")
+      self.assertTrue(results.get[bool]("Backwards"), "jump(-n) doesn't undo jump(n)" )
+      print(f"jump(2^63 - 1): {results.get[ym.int64]('FarJump_ns')} ns")
+
+   def test_StreamSet(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("StreamSet")
+
+      pi = results.get["double"]("Pi")
+      print(f"pi ~ {pi}")
+
+      self.assertTrue(results.get[bool]("SameForAnyThreads"), "Result depends on the number of threads")
+      self.assertTrue(results.get[bool]("Contiguous"       ), "Streams don't line up end to start"     )
+      self.assertAlmostEqual(pi, 3.14159, delta=0.01, msg="Estimate of pi too far off")
+      self.assertEqual(results.get[ym.uint64]("MaxNStreams"), (2**64 - 1) // 1000, "Unexpected number of streams")
+
+   def test_PhiloxKnownAnswers(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("PhiloxKnownAnswers")
+
+      self.assertTrue(results.get[bool]("Matches"        ), "Philox blocks differ from Random123"    )
+      self.assertTrue(results.get[bool]("SequenceMatches"), "Philox words combined in the wrong order")
+
+   def test_PhiloxRandomAccess(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("PhiloxRandomAccess")
+
+      self.assertTrue(results.get[bool]("AtMatches"   ), "at(i) differs from value i of the sequence"   )
+      self.assertTrue(results.get[bool]("FillMatches" ), "fill() differs from gen()"                    )
+      self.assertTrue(results.get[bool]("StateMatches"), "fill() left the generator in another position")
+      self.assertTrue(results.get[bool]("JumpMatches" ), "jump(n) doesn't match n steps"                )
+
+   def test_PhiloxSpeed(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("PhiloxSpeed")
+
+      philoxFill = results.get["double"]("PhiloxFill_ns")
+      philoxGen  = results.get["double"]("PhiloxGen_ns" )
+      prngFill   = results.get["double"]("PrngFill_ns"  )
+      prngGen    = results.get["double"]("PrngGen_ns"   )
+      print(f"Philox fill(): {philoxFill:.3f} ns/val, gen(): {philoxGen:.3f} ns/val")
+      print(f"Prng   fill(): {prngFill:.3f} ns/val, gen(): {prngGen:.3f} ns/val")
+
+      self.assertLess(philoxFill, philoxGen, "Bulk Philox slower than one at a time")
+
+   def test_TrngEntropy(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("TrngEntropy")
+
+      self.assertTrue(results.get[bool]("NoRepeats"     ), "Trng repeated a value"                 )
+      self.assertTrue(results.get[bool]("DistinctSeeds" ), "Threads got the same seed"             )
+      self.assertTrue(results.get[bool]("SameThreadSame"), "Thread got a new generator on each call")
+      self.assertAlmostEqual(results.get["double"]("OnesFrac"), 0.5, delta=0.01, msg="Bits not balanced")
+
+   def test_TrngSpeed(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("TrngSpeed")
+
+      trng = results.get["double"]("Trng_ns")
+      prng = results.get["double"]("Prng_ns")
+      print(f"Trng gen(): {trng:.3f} ns/val, Prng gen(): {prng:.3f} ns/val")
+
+      self.assertLess(trng, 50.0, "Trng not amortizing its reads")
+
+   def test_TrngFork(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("TrngFork")
+
+      self.assertTrue(results.get[bool]("Forked"     ), "Could not fork a child"                 )
+      self.assertTrue(results.get[bool]("TrngDiffers"), "Child repeated the parent's entropy"    )
+      self.assertTrue(results.get[bool]("PrngDiffers"), "Child repeated the parent's thread Prng")
 
 # kick-off
 if __name__ == "__main__":
-   if os.path.basename(os.getcwd()) != "rng":
-      print("Needs to be run in the rng/ directory")
-      sys.exit(1)
-
-   unittest.main()
+   TestSuite.runSuite()
+else:
+   TestSuite.runSuite()
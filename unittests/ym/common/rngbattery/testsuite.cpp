@@ -0,0 +1,186 @@
+/**
+ * @file    testsuite.cpp
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#include "testsuite.h"
+
+#include "textlogger.h"
+#include "ymglobals.h"
+
+#include "rng.h"
+#include "rngbattery.h" // Structures under test
+
+#include <algorithm>
+#include <string>
+
+namespace
+{
+
+/** Weyl
+ *
+ * @brief Weyl sequence - perfectly equidistributed, perfectly predictable.
+ */
+struct Weyl
+{
+   ym::uint64 _state{0};
+
+   inline ym::uint64 operator () (void) { return _state += 0x9e37'79b9'7f4a'7c15ull; }
+};
+
+/** XorShift
+ *
+ * @brief Marsaglia's xorshift64 - linear over GF(2).
+ */
+struct XorShift
+{
+   ym::uint64 _state{88'172'645'463'325'252ull};
+
+   inline ym::uint64 operator () (void)
+   {
+      _state ^= _state << 13u;
+      _state ^= _state >>  7u;
+      _state ^= _state << 17u;
+      return _state;
+   }
+};
+
+/** RawLcg
+ *
+ * @brief The LCG under Prng without its output permutation - low bits on a lattice.
+ */
+struct RawLcg
+{
+   ym::uint64 _state{1};
+
+   inline ym::uint64 operator () (void) { return _state = (_state * 6364136223846793005ull) + 1442695040888963407ull; }
+};
+
+/** Biased
+ *
+ * @brief Good generator with the low bit set 5/8 of the time.
+ */
+struct Biased
+{
+   ym::Prng _prng{};
+
+   inline ym::uint64 operator () (void) { return _prng() | (_prng() & _prng() & 1ull); }
+};
+
+/** getResult
+ *
+ * @brief Finds the result of a test by name.
+ *
+ * @param Report -- Report of battery.
+ * @param Name   -- Name of test.
+ *
+ * @returns RngBattery::Result_T const & -- Result.
+ */
+ym::RngBattery::Result_T const & getResult(
+   ym::RngBattery::Report_T const & Report,
+   std::string              const & Name)
+{
+   return *std::ranges::find(Report._results, Name, &ym::RngBattery::Result_T::_name);
+}
+
+} // anonymous
+
+/** TestSuite
+ *
+ * @brief Constructor.
+ */
+ym::unit::TestSuite::TestSuite(void) :
+   TestSuiteBase("RngBattery")
+{
+   addTestCase<PValues       >();
+   addTestCase<GoodGenerators>();
+   addTestCase<WeakGenerators>();
+}
+
+/** run
+ *
+ * @brief Checks chi-square p-values against tabulated quantiles.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::PValues::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   return {
+      {"Dof1_0.05",    RngBattery::chiSquarePValue(3.841459_f64,    1.0_f64)},
+      {"Dof3_0.05",    RngBattery::chiSquarePValue(7.814728_f64,    3.0_f64)},
+      {"Dof32_0.01",   RngBattery::chiSquarePValue(53.485772_f64,  32.0_f64)},
+      {"Dof4095_0.99", RngBattery::chiSquarePValue(3885.7_f64,   4095.0_f64)},
+      {"Dof4095_Zero", RngBattery::chiSquarePValue(0.0_f64,      4095.0_f64)}
+   };
+}
+
+/** run
+ *
+ * @brief Runs the battery on the ym generators - all should pass.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::GoodGenerators::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   RngBattery const Battery(1_u64 << 20_u64);
+
+   Prng   prng  (1_u64);
+   Philox philox(1_u64);
+   Trng   trng;
+
+   auto const PrngReport   = Battery.run(prng  );
+   auto const PhiloxReport = Battery.run(philox);
+   auto const TrngReport   = Battery.run(trng  );
+
+   ymLog(VG::UnitTest_Rng, "\n{}", RngBattery::formatReport("Prng",   PrngReport  ));
+   ymLog(VG::UnitTest_Rng, "\n{}", RngBattery::formatReport("Philox", PhiloxReport));
+   ymLog(VG::UnitTest_Rng, "\n{}", RngBattery::formatReport("Trng",   TrngReport  ));
+
+   return {
+      {"Prng",          PrngReport  .passed()                                          },
+      {"Philox",        PhiloxReport.passed()                                          },
+      {"Trng",          TrngReport  .passed()                                          },
+      {"NTests",        static_cast<uint64>(PrngReport._results.size())                },
+      {"Throughput_ns", PrngReport._throughput_ns                                      },
+      {"ReportPassed",  RngBattery::formatReport("Prng", PrngReport).contains("PASSED")}
+   };
+}
+
+/** run
+ *
+ * @brief Runs the battery on known weak generators - each should fail the test aimed
+ *        at its weakness.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::WeakGenerators::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Rng);
+
+   RngBattery const Battery(1_u64 << 20_u64);
+
+   Weyl     weyl;
+   XorShift xorShift;
+   RawLcg   rawLcg;
+   Biased   biased;
+
+   auto const WeylReport     = Battery.run(weyl    );
+   auto const XorShiftReport = Battery.run(xorShift);
+   auto const RawLcgReport   = Battery.run(rawLcg  );
+   auto const BiasedReport   = Battery.run(biased  );
+
+   ymLog(VG::UnitTest_Rng, "\n{}", RngBattery::formatReport("RawLcg", RawLcgReport));
+
+   return {
+      {"WeylFailsSerial",         !getResult(WeylReport,     "Serial"          )._passed           },
+      {"XorShiftFailsMatrixRank", !getResult(XorShiftReport, "MatrixRank"      )._passed           },
+      {"RawLcgFailsBirthdays",    !getResult(RawLcgReport,   "BirthdaySpacings")._passed           },
+      {"BiasedFailsFrequency",    !getResult(BiasedReport,   "Frequency"       )._passed           },
+      {"ReportFailed",            RngBattery::formatReport("RawLcg", RawLcgReport).contains("FAIL")}
+   };
+}
@@ -0,0 +1,31 @@
+/**
+ * @file    testsuite.h
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#pragma once
+
+#include "ymdefs.h"
+
+#include "testsuitebase.h"
+
+namespace ym::unit
+{
+
+/** TestSuite
+ *
+ * @brief Test suite for RngBattery.
+ */
+class TestSuite : public TestSuiteBase
+{
+public:
+   explicit TestSuite(void);
+   virtual ~TestSuite(void) = default;
+
+   YM_UT_TESTCASE(PValues       )
+   YM_UT_TESTCASE(GoodGenerators)
+   YM_UT_TESTCASE(WeakGenerators)
+};
+
+} // ym::unit
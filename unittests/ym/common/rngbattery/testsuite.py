@@ -0,0 +1,105 @@
+##
+# @file    testsuite.py
+# @version 1.0.0
+# @author  Forrest Jablonski
+#
+
+import sys
+
+try:
+   import testsuitebase
+except:
+   print("Cannot import testsuitebase - path set correctly?")
+   sys.exit(1)
+
+try:
+   import cppyy
+except:
+   print("Cannot import cppyy - started the venv?")
+   sys.exit(1)
+
+class TestSuite(testsuitebase.TestSuiteBase):
+   """
+   Collection of all tests for RngBattery.
+   """
+
+   @classmethod
+   def setUpClass(cls):
+      """
+      Acting constructor.
+      """
+      super().setUpBaseClass(
+         filepath="ym/common/",
+         filename="rngbattery")
+
+   @classmethod
+   def tearDownClass(cls):
+      """
+      Acting destructor.
+      """
+      pass
+
+   def setUp(self):
+      """
+      Set up logic that is run before each test.
+      """
+      pass
+
+   def tearDown(self):
+      """
+      Tear down logic that is run after each test.
+      """
+      pass
+
+   def test_PValues(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("PValues")
+
+      self.assertAlmostEqual(results.get["double"]("Dof1_0.05"   ), 0.05, delta=1e-5, msg="Bad p-value for 1 dof"   )
+      self.assertAlmostEqual(results.get["double"]("Dof3_0.05"   ), 0.05, delta=1e-5, msg="Bad p-value for 3 dof"   )
+      self.assertAlmostEqual(results.get["double"]("Dof32_0.01"  ), 0.01, delta=1e-5, msg="Bad p-value for 32 dof"  )
+      self.assertAlmostEqual(results.get["double"]("Dof4095_0.99"), 0.99, delta=1e-3, msg="Bad p-value for 4095 dof")
+      self.assertEqual      (results.get["double"]("Dof4095_Zero"), 1.0,              msg="Bad p-value at 0"        )
+
+   def test_GoodGenerators(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("GoodGenerators")
+
+      print(f"Prng throughput {results.get['double']('Throughput_ns'):.3f} ns/val")
+
+      self.assertTrue(results.get[bool]("Prng"        ), "Prng failed the battery"      )
+      self.assertTrue(results.get[bool]("Philox"      ), "Philox failed the battery"    )
+      self.assertTrue(results.get[bool]("Trng"        ), "Trng failed the battery"      )
+      self.assertTrue(results.get[bool]("ReportPassed"), "Report doesn't say it passed")
+      self.assertEqual(results.get[ym.uint64]("NTests"), 5, "Unexpected number of tests")
+
+   def test_WeakGenerators(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("WeakGenerators")
+
+      self.assertTrue(results.get[bool]("WeylFailsSerial"        ), "Serial test missed a Weyl sequence"           )
+      self.assertTrue(results.get[bool]("XorShiftFailsMatrixRank"), "Matrix rank test missed xorshift's linearity"  )
+      self.assertTrue(results.get[bool]("RawLcgFailsBirthdays"   ), "Birthday spacings test missed the LCG lattice")
+      self.assertTrue(results.get[bool]("BiasedFailsFrequency"   ), "Frequency test missed a biased bit"           )
+      self.assertTrue(results.get[bool]("ReportFailed"           ), "Report doesn't say it failed"                 )
+
+# kick-off
+if __name__ == "__main__":
+   TestSuite.runSuite()
+else:
+   TestSuite.runSuite()
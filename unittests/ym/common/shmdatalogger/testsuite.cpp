@@ -0,0 +1,383 @@
+/**
+ * @file    testsuite.cpp
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#include "testsuite.h"
+
+#include "textlogger.h"
+#include "ymglobals.h"
+
+#include "shmdatalogger.h" // Structures under test
+#include "shmdatareader.h" // Structures under test
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/** TestSuite
+ *
+ * @brief Constructor.
+ */
+ym::unit::TestSuite::TestSuite(void) :
+   TestSuiteBase("ShmDataLogger")
+{
+   addTestCase<Snapshot        >();
+   addTestCase<Reset           >();
+   addTestCase<StalledWriter   >();
+   addTestCase<ConcurrentReader>();
+   addTestCase<CrashDump       >();
+}
+
+/** run
+ *
+ * @brief Takes a snapshot of a wrapped blackbox through the reader.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Snapshot::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_ShmData);
+
+   auto const SegmentName = "/ym_unittest_shmdatalogger_snapshot";
+   auto const MaxDepth    = 8uz;
+
+   auto columnsAsExpected = false;
+   auto rowsAsExpected    = false;
+   auto strAsExpected     = false;
+   auto unlinked          = false;
+
+   { // writer lifetime
+      ShmDataLogger blackbox(SegmentName, MaxDepth, 2uz);
+
+      auto a = 0_i32;
+      auto b = 0.5;
+      blackbox.track("a", &a);
+      blackbox.track("b", &b);
+
+      for (auto i = 0uz; i < 20uz; ++i)
+      { // wrap the buffer a couple of times
+         blackbox.acquire();
+         a++;
+         b += 1.0;
+      }
+
+      ShmDataReader reader;
+      (void)reader.open(SegmentName);
+
+      auto const Cols = reader.getColumns();
+      columnsAsExpected =
+         reader.isOpen()                                                  &&
+         Cols.size()               == 2uz                                 &&
+         std::strcmp(Cols[0]._name, "a") == 0                             &&
+         std::strcmp(Cols[1]._name, "b") == 0                             &&
+         Cols[0]._type             == DataLogger::DataType_T::Int32       &&
+         Cols[1]._type             == DataLogger::DataType_T::Float64     &&
+         Cols[1]._offset_bytes     == sizeof(int32)                       &&
+         reader.getRowSize_bytes() == sizeof(int32) + sizeof(float64)     &&
+         reader.getMaxDepth()      == MaxDepth;
+
+      auto rows = std::vector<byte>(MaxDepth * reader.getRowSize_bytes());
+      auto end  = 0_u64;
+      auto const NRows = reader.snapshot(rows, &end);
+
+      rowsAsExpected = NRows == MaxDepth && end == 20_u64;
+      for (auto r = 0uz; rowsAsExpected && r < NRows; ++r)
+      { // oldest to newest - rows 12 through 19
+         auto const * const Row_Ptr = rows.data() + (r * reader.getRowSize_bytes());
+         auto rowA = 0_i32;
+         auto rowB = 0.0;
+         std::memcpy(&rowA, Row_Ptr + Cols[0]._offset_bytes, sizeof(rowA));
+         std::memcpy(&rowB, Row_Ptr + Cols[1]._offset_bytes, sizeof(rowB));
+         rowsAsExpected = rowA == static_cast<int32>(12uz + r) && rowB == 12.5 + static_cast<float64>(r);
+      }
+
+      char buffer[32]{};
+      ShmDataReader::toStr(Cols[0], rows.data(), buffer);
+      strAsExpected = std::strcmp(buffer, "12") == 0;
+   }
+
+   { // segment should be gone with the writer
+      ShmDataReader reader;
+      unlinked = !reader.open(SegmentName);
+   }
+
+   return {
+      {"ColumnsAsExpected", columnsAsExpected},
+      {"RowsAsExpected",    rowsAsExpected   },
+      {"StrAsExpected",     strAsExpected    },
+      {"Unlinked",          unlinked         }
+   };
+}
+
+/** run
+ *
+ * @brief Verifies readers see resets through the epoch counter.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Reset::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_ShmData);
+
+   auto const SegmentName = "/ym_unittest_shmdatalogger_reset";
+
+   ShmDataLogger blackbox(SegmentName, 4uz);
+
+   auto a = 0_u16;
+   blackbox.track("a", &a);
+
+   blackbox.acquire(); a++;
+   blackbox.acquire(); a++;
+
+   ShmDataReader reader;
+   (void)reader.open(SegmentName);
+
+   auto rows = std::vector<byte>(4uz * reader.getRowSize_bytes());
+
+   auto const EpochBefore = reader.getEpoch();
+   auto const NRowsBefore = reader.snapshot(rows);
+
+   blackbox.reset();
+
+   auto const EpochAfter = reader.getEpoch();
+   auto const NRowsAfter = reader.snapshot(rows);
+
+   blackbox.acquire(); // a == 2
+
+   auto       end        = 0_u64;
+   auto const NRowsFinal = reader.snapshot(rows, &end);
+   auto       rowA       = 0_u16;
+   std::memcpy(&rowA, rows.data(), sizeof(rowA));
+
+   return {
+      {"EpochBumped",     EpochAfter == EpochBefore + 1_u64                },
+      {"RowsBeforeReset", NRowsBefore == 2uz                               },
+      {"RowsAfterReset",  NRowsAfter  == 0uz                               },
+      {"RowAfterReset",   NRowsFinal  == 1uz && end == 1_u64 && rowA == 2_u16}
+   };
+}
+
+/** run
+ *
+ * @brief Verifies snapshots give up on a writer stuck mid-row instead of hanging.
+ *
+ * @note The stuck writer is faked by making the sequence odd through a second mapping.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::StalledWriter::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_ShmData);
+
+   auto const SegmentName = "/ym_unittest_shmdatalogger_stalled";
+
+   ShmDataLogger blackbox(SegmentName, 4uz);
+
+   auto a = 0_u16;
+   blackbox.track("a", &a);
+   blackbox.acquire();
+
+   ShmDataReader reader;
+   (void)reader.open(SegmentName);
+
+   auto rows = std::vector<byte>(4uz * reader.getRowSize_bytes());
+
+   auto const FD      = ::shm_open(SegmentName, O_RDWR, 0);
+   auto *     map_Ptr = (FD >= 0) ?
+      ::mmap(nullptr, sizeof(ShmDataHeader_T), PROT_READ | PROT_WRITE, MAP_SHARED, FD, 0) : MAP_FAILED;
+   if (FD >= 0) { (void)::close(FD); }
+
+   if (map_Ptr == MAP_FAILED)
+   { // can't fake the stall
+      return {
+         {"Mapped", false}
+      };
+   }
+
+   auto * const header_Ptr = static_cast<ShmDataHeader_T *>(map_Ptr);
+
+   header_Ptr->_seq.fetch_add(1_u64); // writer "dies" mid-row
+   auto const NRowsStalled = reader.snapshot(rows);
+   auto const Stalled      = reader.isWriterStalled();
+
+   header_Ptr->_seq.fetch_add(1_u64); // and comes back
+   auto const NRowsResumed = reader.snapshot(rows);
+   auto const Resumed      = !reader.isWriterStalled();
+
+   (void)::munmap(map_Ptr, sizeof(ShmDataHeader_T));
+
+   return {
+      {"Mapped",    true                          },
+      {"GaveUp",    NRowsStalled == 0uz && Stalled},
+      {"Recovered", NRowsResumed == 1uz && Resumed}
+   };
+}
+
+/** run
+ *
+ * @brief Snapshots taken while the writer keeps acquiring.
+ *
+ * @note Each row holds its own index, so every snapshot must be a run of consecutive
+ *       indices ending just before the reported end.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::ConcurrentReader::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_ShmData);
+
+   auto const SegmentName = "/ym_unittest_shmdatalogger_concurrent";
+   auto const MaxDepth    = 16uz;
+   auto const NWanted     = 200'000uz; // snapshots to check
+   auto const Deadline    = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+   ShmDataLogger blackbox(SegmentName, MaxDepth);
+
+   auto id = 0_u64;
+   blackbox.track("id", &id);
+   blackbox.acquire(); id++; // publishes the segment
+
+   ShmDataReader reader;
+   (void)reader.open(SegmentName);
+
+   std::atomic<bool>  done      {false};
+   std::atomic<sizet> nSnapshots{0uz  };
+
+   auto inOrder = true;
+   auto gapFree = true;
+   auto nFull   = 0uz;
+
+   std::jthread readerThread([&]() {
+      auto rows = std::vector<byte>(MaxDepth * reader.getRowSize_bytes());
+      while (!done.load(std::memory_order_relaxed))
+      { // until the writer is done
+         auto       end   = 0_u64;
+         auto const NRows = reader.snapshot(rows, &end);
+
+         for (auto r = 0uz; r < NRows; ++r)
+         { // each row
+            auto rowId = 0_u64;
+            std::memcpy(&rowId, rows.data() + (r * sizeof(rowId)), sizeof(rowId));
+
+            auto prevId = 0_u64;
+            if (r > 0uz) { std::memcpy(&prevId, rows.data() + ((r - 1uz) * sizeof(prevId)), sizeof(prevId)); }
+
+            inOrder &= r == 0uz || rowId >  prevId;
+            gapFree &= r == 0uz || rowId == prevId + 1_u64;
+            gapFree &= rowId == end - NRows + r; // rows end just before end
+         }
+
+         if (NRows > 0uz) { nSnapshots.fetch_add(1uz, std::memory_order_relaxed); }
+         nFull += (NRows == MaxDepth) ? 1uz : 0uz;
+      }
+   });
+
+   while (nSnapshots.load(std::memory_order_relaxed) < NWanted && std::chrono::steady_clock::now() < Deadline)
+   { // hot loop - until the reader has checked enough
+      for (auto i = 0uz; i < 1'000uz; ++i)
+      { // batch
+         blackbox.acquire();
+         id++;
+      }
+   }
+
+   done = true;
+   readerThread.join();
+
+   ymLog(VG::UnitTest_ShmData, "{} snapshots ({} full depth)", nSnapshots.load(), nFull);
+
+   return {
+      {"RowsInOrder", inOrder                               },
+      {"GapFree",     gapFree                               },
+      {"SawRows",     nSnapshots.load() > 0uz               },
+      {"NSnapshots",  static_cast<uint64>(nSnapshots.load())}
+   };
+}
+
+/** run
+ *
+ * @brief Arms a crash dump on a fresh blackbox, then reads it back through the reader.
+ *
+ * @note Arming readies the logger - the segment must still be laid out before it is
+ *       mapped, or the header lands on top of the rows.
+ *
+ * @note The crash dump is invoked directly - we don't actually want to die.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::CrashDump::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_ShmData);
+
+   auto const     SegmentName = "/ym_unittest_shmdatalogger_crashdump";
+   str    const   Filename    = "logs/shmdata_crash.bin";
+   constexpr auto MaxDepth    = 4uz;
+   constexpr auto NAcquires   = 6uz;
+
+   ShmDataLogger blackbox(SegmentName, MaxDepth);
+
+   auto a = 0_i32;
+   auto b = 0.5;
+   blackbox.track("a", &a);
+   blackbox.track("b", &b);
+
+   auto const Armed = blackbox.armCrashDump(Filename);
+
+   for (auto i = 0uz; i < NAcquires; ++i)
+   { // force a rollover
+      blackbox.acquire();
+      a++;
+      b += 1.0;
+   }
+
+   ShmDataReader reader;
+   (void)reader.open(SegmentName);
+
+   auto const Cols = reader.getColumns();
+   auto const ColumnsAsExpected =
+      reader.isOpen()                                              &&
+      Cols.size()               == 2uz                             &&
+      std::strcmp(Cols[0]._name, "a") == 0                         &&
+      std::strcmp(Cols[1]._name, "b") == 0                         &&
+      reader.getRowSize_bytes() == sizeof(int32) + sizeof(float64) &&
+      reader.getMaxDepth()      == MaxDepth;
+
+   auto rows = std::vector<byte>(MaxDepth * (sizeof(int32) + sizeof(float64)));
+   auto end  = 0_u64;
+   auto const NRows = ColumnsAsExpected ? reader.snapshot(rows, &end) : 0uz;
+
+   auto rowsAsExpected = NRows == MaxDepth && end == NAcquires;
+   for (auto r = 0uz; rowsAsExpected && r < NRows; ++r)
+   { // oldest to newest - rows 2 through 5
+      auto const * const Row_Ptr = rows.data() + (r * reader.getRowSize_bytes());
+      auto rowA = 0_i32;
+      auto rowB = 0.0;
+      std::memcpy(&rowA, Row_Ptr + Cols[0]._offset_bytes, sizeof(rowA));
+      std::memcpy(&rowB, Row_Ptr + Cols[1]._offset_bytes, sizeof(rowB));
+      rowsAsExpected = rowA == static_cast<int32>(2uz + r) && rowB == 2.5 + static_cast<float64>(r);
+   }
+
+   auto const Dumped = blackbox.crashDump();
+   blackbox.disarmCrashDump();
+
+   std::error_code ec;
+   auto const Size_bytes         = std::filesystem::file_size(Filename.get(), ec);
+   auto const ExpectedSize_bytes = sizeof("a,b\n") - 1uz + MaxDepth * (sizeof(a) + sizeof(b));
+
+   return {
+      {"Armed",             Armed                                 },
+      {"ColumnsAsExpected", ColumnsAsExpected                     },
+      {"RowsAsExpected",    rowsAsExpected                        },
+      {"Dumped",            Dumped                                },
+      {"SizeAsExpected",    !ec && Size_bytes == ExpectedSize_bytes}
+   };
+}
@@ -0,0 +1,33 @@
+/**
+ * @file    testsuite.h
+ * @version 1.0.0
+ * @author  Forrest Jablonski
+ */
+
+#pragma once
+
+#include "ymdefs.h"
+
+#include "testsuitebase.h"
+
+namespace ym::unit
+{
+
+/** TestSuite
+ *
+ * @brief Test suite for ShmDataLogger and ShmDataReader.
+ */
+class TestSuite : public TestSuiteBase
+{
+public:
+   explicit TestSuite(void);
+   virtual ~TestSuite(void) = default;
+
+   YM_UT_TESTCASE(Snapshot        )
+   YM_UT_TESTCASE(Reset           )
+   YM_UT_TESTCASE(StalledWriter   )
+   YM_UT_TESTCASE(ConcurrentReader)
+   YM_UT_TESTCASE(CrashDump       )
+};
+
+} // ym::unit
@@ -0,0 +1,128 @@
+##
+# @file    testsuite.py
+# @version 1.0.0
+# @author  Forrest Jablonski
+#
+
+import sys
+
+try:
+   import testsuitebase
+except:
+   print("Cannot import testsuitebase - path set correctly?")
+   sys.exit(1)
+
+try:
+   import cppyy
+except:
+   print("Cannot import cppyy - started the venv?")
+   sys.exit(1)
+
+class TestSuite(testsuitebase.TestSuiteBase):
+   """
+   Collection of all tests for ShmDataLogger.
+   """
+   @classmethod
+   def setUpClass(cls):
+      """
+      Acting constructor.
+      """
+      super().setUpBaseClass(
+         filepath="ym/common",
+         filename="shmdatalogger")
+
+   @classmethod
+   def tearDownClass(cls):
+      """
+      Acting destructor.
+      """
+      super().tearDownBaseClass()
+
+   def setUp(self):
+      """
+      Set up logic that is run before each test.
+      """
+      pass
+
+   def tearDown(self):
+      """
+      Tear down logic that is run after each test.
+      """
+      pass
+
+   def test_Snapshot(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Snapshot")
+
+      self.assertTrue(results.get[bool]("ColumnsAsExpected"), "Column meta data not published correctly")
+      self.assertTrue(results.get[bool]("RowsAsExpected"   ), "Snapshot rows not as expected")
+      self.assertTrue(results.get[bool]("StrAsExpected"    ), "Value not stringified correctly")
+      self.assertTrue(results.get[bool]("Unlinked"         ), "Segment outlived the writer")
+
+   def test_Reset(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Reset")
+
+      self.assertTrue(results.get[bool]("EpochBumped"    ), "Reset not published through epoch")
+      self.assertTrue(results.get[bool]("RowsBeforeReset"), "Wrong number of rows before reset")
+      self.assertTrue(results.get[bool]("RowsAfterReset" ), "Rows survived the reset")
+      self.assertTrue(results.get[bool]("RowAfterReset"  ), "Row after reset not as expected")
+
+   def test_StalledWriter(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("StalledWriter")
+
+      self.assertTrue(results.get[bool]("Mapped"   ), "Could not map the segment a second time")
+      self.assertTrue(results.get[bool]("GaveUp"   ), "Snapshot did not give up on a stuck writer")
+      self.assertTrue(results.get[bool]("Recovered"), "Snapshot did not recover once the writer moved on")
+
+   def test_ConcurrentReader(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("ConcurrentReader")
+
+      self.assertTrue(results.get[bool]("RowsInOrder"), "Snapshot rows not strictly increasing")
+      self.assertTrue(results.get[bool]("GapFree"    ), "Snapshot rows skipped or misplaced")
+      self.assertTrue(results.get[bool]("SawRows"    ), "Reader never got a snapshot")
+
+      print(f"{results.get[ym.uint64]('NSnapshots')} snapshots checked")
+
+   def test_CrashDump(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("CrashDump")
+
+      self.assertTrue(results.get[bool]("Armed"            ), "Crash dump not armed")
+      self.assertTrue(results.get[bool]("ColumnsAsExpected"), "Arming clobbered the column meta data")
+      self.assertTrue(results.get[bool]("RowsAsExpected"   ), "Rows not published through the seqlock")
+      self.assertTrue(results.get[bool]("Dumped"           ), "Crash dump failed")
+      self.assertTrue(results.get[bool]("SizeAsExpected"   ), "Crash dump size not as expected")
+
+# kick-off
+if __name__ == "__main__":
+   TestSuite.runSuite()
+else:
+   TestSuite.runSuite()
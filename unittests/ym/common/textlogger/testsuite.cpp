@@ -11,6 +11,11 @@
 
 #include "textlogger.h" // Structures under test
 
+#include "latencyhistogram.h"
+#include "timer.h"
+
+#include <memory>
+
 /** TestSuite
  *
  * @brief Constructor.
@@ -20,6 +25,7 @@ ym::unit::TestSuite::TestSuite(void) :
 {
    addTestCase<InteractiveInspection>();
    addTestCase<OpenAndClose         >();
+   addTestCase<PrintLatency         >();
 }
 
 /** run
@@ -59,3 +65,40 @@ auto ym::unit::TestSuite::OpenAndClose::run([[maybe_unused]] DataShuttle const &
       {"IsClosed", IsClosed}
    };
 }
+
+/** run
+ *
+ * @brief Benchmarks the latency of printf() (time until it returns to the caller).
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::PrintLatency::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_TextLogger);
+
+   constexpr auto NPrints = 100'000uz;
+
+   TextLogger t("logs/textlogger_latency.txt");
+   auto const IsOpen = t.open();
+   t.enable(VG::UnitTest_TextLogger);
+
+   auto hist = std::make_unique<LatencyHistogram>();
+
+   for (auto i = 0uz; i < NPrints; ++i)
+   { // one timed print each
+      TscTimer timer;
+      t.printf(VG::UnitTest_TextLogger, "Print {} of {}", i, NPrints);
+      hist->record(timer.getElapsedTime());
+   }
+
+   t.close();
+
+   ymLog(VG::UnitTest_TextLogger, "printf() latency (ns)\n{}", hist->getPercentileTable());
+
+   return {
+      {"IsOpen", IsOpen                                                    },
+      {"Saved",  hist->save("logs/textlogger_latency.hist")                },
+      {"P50_ns", static_cast<float64>(hist->getValueAtPercentile(50.0_f64))},
+      {"P99_ns", static_cast<float64>(hist->getValueAtPercentile(99.0_f64))}
+   };
+}
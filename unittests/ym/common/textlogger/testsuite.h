@@ -27,6 +27,7 @@ public:
 
    YM_UT_TESTCASE(InteractiveInspection)
    YM_UT_TESTCASE(OpenAndClose         )
+   YM_UT_TESTCASE(PrintLatency         )
 };
 
 } // ym::unit
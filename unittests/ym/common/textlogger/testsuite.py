@@ -83,6 +83,22 @@ class TestSuite(testsuitebase.TestSuiteBase):
       isClosed = results.get[bool]("IsClosed")
       self.assertTrue(isClosed, "text logger failed to close")
 
+   def test_PrintLatency(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("PrintLatency")
+
+      self.assertTrue(results.get[bool]("IsOpen"), "text logger failed to open")
+      self.assertTrue(results.get[bool]("Saved" ), "latency histogram not saved")
+
+      p50 = results.get["double"]("P50_ns")
+      p99 = results.get["double"]("P99_ns")
+      print(f"printf() latency: p50 {p50:.0f} ns, p99 {p99:.0f} ns")
+
 # kick-off
 if __name__ == "__main__":
    TestSuite.runSuite()
@@ -4,42 +4,334 @@
  * @author  Forrest Jablonski
  */
 
-#include "ymdefs.h"
 #include "testsuite.h"
 
-#include "threadsafeproxy.h"
-
 #include "textlogger.h"
-#include "ymerror.h"
+#include "timer.h"
+#include "ymglobals.h"
+
+#include "threadsafeproxy.h" // Structures under test
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+using namespace ym;
+
+/** Pair_T
+ *
+ * @brief Two values that are only ever changed together.
+ */
+struct Pair_T
+{
+   int64 _a{0_i64};
+   int64 _b{0_i64};
+
+   void bump        (void)       { ++_a; ++_b;      }
+   bool isConsistent(void) const { return _a == _b; }
+};
+
+/** Gauge_T
+ *
+ * @brief Counts readers inside a read lock at the same time.
+ */
+struct Gauge_T
+{
+   mutable std::atomic<int32> _nInside{0_i32};
+
+   /** waitForOthers
+    *
+    * @brief Waits (up to a second) until N readers are inside.
+    *
+    * @note Readers never leave the count, so a late reader sees the ones before it.
+    *
+    * @param N -- # of readers.
+    *
+    * @returns bool -- If all N were inside at once.
+    */
+   bool waitForOthers(int32 const N) const
+   {
+      ++_nInside;
+
+      auto const Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+      while (_nInside.load() < N && std::chrono::steady_clock::now() < Deadline)
+      { // others may be on their way
+         std::this_thread::yield();
+      }
+
+      return _nInside.load() >= N;
+   }
+};
+
+/** Config_T
+ *
+ * @brief Read-mostly configuration - all fields are equal after every write.
+ */
+struct Config_T
+{
+   uint64  _version{0_u64};
+   uint64  _period {0_u64};
+   float64 _gain   {0.0  };
+   uint64  _check  {0_u64};
+
+   static Config_T make(uint64 const V) { return {V, V, static_cast<float64>(V), V}; }
+
+   bool isConsistent(void) const
+   {
+      return _version == _period && static_cast<float64>(_version) == _gain && _version == _check;
+   }
+};
+
+} // anonymous
 
 /** TestSuite
  *
  * @brief Constructor.
  */
-ym::unit::TestSuite::TestSuite(void)
-   : TestSuiteBase("ThreadSafeProxy")
+ym::unit::TestSuite::TestSuite(void) :
+   TestSuiteBase("ThreadSafeProxy")
+{
+   addTestCase<Writes     >();
+   addTestCase<SharedReads>();
+   addTestCase<SeqLock    >();
+   addTestCase<SeqLockUndo>();
+   addTestCase<ReadCost   >();
+}
+
+/** run
+ *
+ * @brief Writers and readers going through the proxy at the same time.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Writes::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_ThreadSafeProxy);
+
+   constexpr auto NThreads = 4uz;
+   constexpr auto NBumps   = 100'000uz;
+
+   Pair_T pair;
+   ThreadSafeProxy tsp(&pair);
+
+   tsp->_a = 7;
+   auto const Assigned = pair._a == 7_i64;
+   tsp->_a = 0;
+
+   std::atomic<bool> torn{false};
+   {
+      std::vector<std::jthread> pool;
+      for (auto t = 0uz; t < NThreads; ++t)
+      { // writers and readers
+         pool.emplace_back([&tsp]() {
+            for (auto i = 0uz; i < NBumps; ++i) { tsp->bump(); }
+         });
+         pool.emplace_back([&tsp, &torn]() {
+            for (auto i = 0uz; i < NBumps; ++i) { if (!std::as_const(tsp)->isConsistent()) { torn = true; } }
+         });
+      }
+   }
+
+   return {
+      {"Assigned", Assigned                                         },
+      {"Counted",  pair._a == static_cast<int64>(NThreads * NBumps)},
+      {"Torn",     torn.load()                                      }
+   };
+}
+
+/** run
+ *
+ * @brief Checks that readers hold the lock at the same time.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::SharedReads::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
 {
-   addTestCase<InteractiveInspection>();
+   auto const SE = ymLogPushEnable(VG::UnitTest_ThreadSafeProxy);
+
+   constexpr auto NReaders = 3_i32;
+
+   Gauge_T gauge;
+   ThreadSafeProxy const Tsp(&gauge);
+
+   std::atomic<int32> nOverlapped{0_i32};
+   {
+      std::vector<std::jthread> pool;
+      for (auto t = 0_i32; t < NReaders; ++t)
+      { // readers
+         pool.emplace_back([&Tsp, &nOverlapped]() {
+            if (Tsp->waitForOthers(NReaders)) { ++nOverlapped; }
+         });
+      }
+   }
+
+   return {
+      {"Shared", nOverlapped.load() == NReaders}
+   };
 }
 
 /** run
  *
- * @brief TODO.
+ * @brief Readers racing writers through a SeqLockProxy.
  *
  * @returns DataShuttle -- Important values acquired during run of test.
  */
-auto ym::unit::TestSuite::InteractiveInspection::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+auto ym::unit::TestSuite::SeqLock::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
 {
    auto const SE = ymLogPushEnable(VG::UnitTest_ThreadSafeProxy);
 
-   struct A { int _i; };
+   constexpr auto NReaders = 3uz;
+   constexpr auto NWrites  = 50'000_u64;
+
+   SeqLockProxy<Config_T> config(Config_T::make(0_u64));
+
+   auto const Initial = config.load().isConsistent() && config->_version == 0_u64;
+
+   std::atomic<bool> torn      {false};
+   std::atomic<bool> backwards {false};
+   std::atomic<bool> done      {false};
+   auto              counted = false;
+   {
+      std::vector<std::jthread> pool;
+      for (auto t = 0uz; t < NReaders; ++t)
+      { // readers
+         pool.emplace_back([&]() {
+            auto prev = 0_u64;
+            while (!done.load())
+            { // until writers finish
+               auto const Val = config.load();
+               if (!Val.isConsistent())   { torn      = true; }
+               if ( Val._version < prev)  { backwards = true; }
+               prev = Val._version;
+            }
+         });
+      }
+
+      {
+         std::vector<std::jthread> writers;
+         for (auto t = 0uz; t < 2uz; ++t)
+         { // writers - each write adds one
+            writers.emplace_back([&config]() {
+               for (auto i = 0_u64; i < NWrites; ++i)
+               { // alternate the two ways of writing
+                  if (i % 2_u64) { config.update([](Config_T & c) { c = Config_T::make(c._version + 1_u64); }); }
+                  else           { config.update([](Config_T & c) { c._version++; c._period++; c._gain += 1.0; c._check++; }); }
+               }
+            });
+         }
+      }
+
+      counted = config.load()._version == 2_u64 * NWrites;
+      done    = true;
+   }
+
+   config.store(Config_T::make(42_u64));
+   auto const Stored = config->_gain == 42.0;
+
+   return {
+      {"Initial",   Initial         },
+      {"Torn",      torn.load()     },
+      {"Backwards", backwards.load()},
+      {"Counted",   counted         },
+      {"Stored",    Stored          }
+   };
+}
+
+/** run
+ *
+ * @brief An update that throws leaves the value alone and doesn't lock out other writers.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::SeqLockUndo::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_ThreadSafeProxy);
+
+   SeqLockProxy<Config_T> config(Config_T::make(5_u64));
+
+   auto threw = false;
+   try
+   {
+      config.update([](Config_T & c) { c._version = 99_u64; throw std::runtime_error("Changed my mind"); });
+   }
+   catch (std::runtime_error const & E)
+   {
+      ymLog(VG::UnitTest_ThreadSafeProxy, "--> {}", E.what());
+      threw = true;
+   }
+
+   auto const Val       = config.load(); // would spin forever if the write side were still held
+   auto const Unchanged = Val.isConsistent() && Val._version == 5_u64;
+
+   std::jthread([&config]() { config.update([](Config_T & c) { c = Config_T::make(c._version + 1_u64); }); }).join();
+
+   return {
+      {"Threw",     threw                    },
+      {"Unchanged", Unchanged                },
+      {"Updated",   config->_version == 6_u64}
+   };
+}
+
+/** run
+ *
+ * @brief Measures the cost of a read with several readers, per kind of proxy.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::ReadCost::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_ThreadSafeProxy);
+
+   constexpr auto NReaders = 4uz;
+   constexpr auto NReads   = 1'000'000uz;
+
+   // ns per read, with all readers going at once
+   auto const TimeReads = [](auto const & Read) {
+      std::atomic<uint64> checksum{0_u64};
+
+      Timer timer;
+      {
+         std::vector<std::jthread> pool;
+         for (auto t = 0uz; t < NReaders; ++t)
+         { // readers
+            pool.emplace_back([&Read, &checksum]() {
+               auto sum = 0_u64;
+               for (auto i = 0uz; i < NReads; ++i) { sum += Read(); }
+               checksum += sum;
+            });
+         }
+      }
+      auto const Elapsed_ns = static_cast<float64>(timer.getElapsedTime().count());
+
+      return std::pair(Elapsed_ns / static_cast<float64>(NReaders * NReads), checksum.load());
+   };
+
+   auto config = Config_T::make(3_u64);
+
+   ThreadSafeProxy<Config_T, std::mutex> const Exclusive(&config);
+   ThreadSafeProxy<Config_T            > const Shared   (&config);
+   SeqLockProxy   <Config_T            > const Seq      (config);
+
+   auto const [Exclusive_ns, ExclusiveSum] = TimeReads([&]() { return Exclusive->_period; });
+   auto const [Shared_ns,    SharedSum   ] = TimeReads([&]() { return Shared   ->_period; });
+   auto const [Seq_ns,       SeqSum      ] = TimeReads([&]() { return Seq      ->_period; });
 
-   A a{._i = 9};
+   ymLog(VG::UnitTest_ThreadSafeProxy, "read: mutex {:.1f} ns, shared_mutex {:.1f} ns, seqlock {:.1f} ns",
+      Exclusive_ns, Shared_ns, Seq_ns);
 
-   ThreadSafeProxy tsp(&a);
-   tsp->_i = 7;
+   auto const Expected = 3_u64 * NReaders * NReads;
 
    return {
-      {"i", a._i}
+      {"Checksum",     ExclusiveSum == Expected && SharedSum == Expected && SeqSum == Expected},
+      {"Exclusive_ns", Exclusive_ns                                                           },
+      {"Shared_ns",    Shared_ns                                                              },
+      {"Seq_ns",       Seq_ns                                                                 }
    };
 }
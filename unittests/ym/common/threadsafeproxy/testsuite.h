@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include "utdefs.h"
+#include "ymdefs.h"
 
 #include "testsuitebase.h"
 
@@ -23,7 +23,11 @@ public:
    explicit TestSuite(void);
    virtual ~TestSuite(void) = default;
 
-   YM_UT_TESTCASE(InteractiveInspection)
+   YM_UT_TESTCASE(Writes     )
+   YM_UT_TESTCASE(SharedReads)
+   YM_UT_TESTCASE(SeqLock    )
+   YM_UT_TESTCASE(SeqLockUndo)
+   YM_UT_TESTCASE(ReadCost   )
 };
 
 } // ym::unit
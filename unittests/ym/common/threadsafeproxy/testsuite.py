@@ -4,13 +4,9 @@
 # @author  Forrest Jablonski
 #
 
-import os
 import sys
-import unittest
 
 try:
-   # @note Grabs the first directory in the chain named unittests/.
-   sys.path.append(os.path.join(os.getcwd().split("unittests")[0], "unittests/"))
    import testsuitebase
 except:
    print("Cannot import testsuitebase - path set correctly?")
@@ -26,22 +22,21 @@ class TestSuite(testsuitebase.TestSuiteBase):
    """
    Collection of all tests for ThreadSafeProxy.
    """
-
    @classmethod
    def setUpClass(cls):
       """
       Acting constructor.
       """
-
-      super().setUpBaseClass(filepath="ym/common",
-                             filename="threadsafeproxy")
+      super().setUpBaseClass(
+         filepath="ym/common",
+         filename="threadsafeproxy")
 
    @classmethod
    def tearDownClass(cls):
       """
       Acting destructor.
       """
-      pass
+      super().tearDownBaseClass()
 
    def setUp(self):
       """
@@ -55,21 +50,76 @@ class TestSuite(testsuitebase.TestSuiteBase):
       """
       pass
 
-   def test_InteractiveInspection(self):
+   def test_Writes(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Writes")
+
+      self.assertTrue (results.get[bool]("Assigned"), "Write through proxy lost")
+      self.assertTrue (results.get[bool]("Counted" ), "Concurrent writes lost")
+      self.assertFalse(results.get[bool]("Torn"    ), "Reader saw a half written value")
+
+   def test_SharedReads(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("SharedReads")
+
+      self.assertTrue(results.get[bool]("Shared"), "Readers did not share the lock")
+
+   def test_SeqLock(self):
       """
       Analyzes results from test case.
       """
       from cppyy.gbl import std # type:ignore
       from cppyy.gbl import ym  # type:ignore
-      
-      # uncomment to run test
-      # results = self.run_test_case("InteractiveInspection")
-      pass
+
+      results = self.run_test_case("SeqLock")
+
+      self.assertTrue (results.get[bool]("Initial"  ), "Initial value not as expected")
+      self.assertFalse(results.get[bool]("Torn"     ), "Reader saw a half written value")
+      self.assertFalse(results.get[bool]("Backwards"), "Reader saw an older value after a newer one")
+      self.assertTrue (results.get[bool]("Counted"  ), "Concurrent updates lost")
+      self.assertTrue (results.get[bool]("Stored"   ), "Stored value not read back")
+
+   def test_SeqLockUndo(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("SeqLockUndo")
+
+      self.assertTrue(results.get[bool]("Threw"    ), "Update did not throw")
+      self.assertTrue(results.get[bool]("Unchanged"), "Throwing update changed the value")
+      self.assertTrue(results.get[bool]("Updated"  ), "Writers locked out after a throwing update")
+
+   def test_ReadCost(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("ReadCost")
+
+      self.assertTrue(results.get[bool]("Checksum"), "Reads returned wrong values")
+
+      exclusive = results.get["double"]("Exclusive_ns")
+      shared    = results.get["double"]("Shared_ns"   )
+      seq       = results.get["double"]("Seq_ns"      )
+      print(f"read: mutex {exclusive:.1f} ns, shared_mutex {shared:.1f} ns, seqlock {seq:.1f} ns")
 
 # kick-off
 if __name__ == "__main__":
-   if os.path.basename(os.getcwd()) != "threadsafeproxy":
-      print("Needs to be run in the threadsafeproxy/ directory")
-      sys.exit(1)
-
-   unittest.main()
+   TestSuite.runSuite()
+else:
+   TestSuite.runSuite()
@@ -11,6 +11,13 @@
 
 #include "timer.h" // Structures under test
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <latch>
+#include <thread>
+#include <vector>
+
 /** TestSuite
  *
  * @brief Constructor.
@@ -20,6 +27,10 @@ ym::unit::TestSuite::TestSuite(void) :
 {
    addTestCase<InteractiveInspection>();
    addTestCase<VerifyTimer          >();
+   addTestCase<ReadCost             >();
+   addTestCase<Drift                >();
+   addTestCase<VirtualTime          >();
+   addTestCase<VirtualBystander     >();
 }
 
 /** run
@@ -48,3 +59,189 @@ auto ym::unit::TestSuite::VerifyTimer::run([[maybe_unused]] DataShuttle const &
       {"True", true}
    };
 }
+
+/** run
+ *
+ * @brief Benchmarks the cost of reading the TSC clock against the steady clock.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::ReadCost::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Timer);
+
+   constexpr auto NReads = 1'000'000uz;
+
+   auto const TimeReads = []<typename Clock_T>(Clock_T) {
+      auto sum = 0_i64; // keeps the reads alive
+
+      Timer timer;
+      for (auto i = 0uz; i < NReads; ++i)
+      { // back to back
+         sum += Clock_T::now().time_since_epoch().count();
+      }
+      auto const Elapsed_ns = static_cast<float64>(timer.getElapsedTime().count());
+
+      ymLog(VG::UnitTest_Timer, "Checksum {}", sum);
+      return Elapsed_ns / static_cast<float64>(NReads);
+   };
+
+   (void)TscClock::getCalibration(); // calibrate outside the measurement
+
+   auto const Tsc_ns    = TimeReads(TscClock());
+   auto const Steady_ns = TimeReads(std::chrono::steady_clock());
+
+   ymLog(VG::UnitTest_Timer, "TscClock::now() {:.1f} ns, steady_clock::now() {:.1f} ns", Tsc_ns, Steady_ns);
+
+   return {
+      {"TscReliable", TscClock::isTscReliable()},
+      {"Tsc_ns",      Tsc_ns                   },
+      {"Steady_ns",   Steady_ns                }
+   };
+}
+
+/** run
+ *
+ * @brief Measures how far the TSC clock drifts from the steady clock.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::Drift::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Timer);
+
+   auto const Steady0 = std::chrono::steady_clock::now();
+   auto const Tsc0    = TscClock::now();
+
+   std::this_thread::sleep_for(std::chrono::milliseconds(250));
+
+   auto const Steady1 = std::chrono::steady_clock::now();
+   auto const Tsc1    = TscClock::now();
+
+   auto const Steady_ns = std::chrono::duration<float64, std::nano>(Steady1 - Steady0).count();
+   auto const Tsc_ns    = std::chrono::duration<float64, std::nano>(Tsc1    - Tsc0   ).count();
+
+   auto const Offset = std::chrono::duration<float64, std::nano>(
+      TscClock::now().time_since_epoch() - std::chrono::steady_clock::now().time_since_epoch()).count();
+
+   return {
+      {"Drift_ppm", ((Tsc_ns - Steady_ns) / Steady_ns) * 1.0e6_f64},
+      {"Offset_ns", Offset                                        }
+   };
+}
+
+/** run
+ *
+ * @brief Runs periodic threads for a minute of virtual time.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::VirtualTime::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Timer);
+
+   using namespace std::chrono_literals;
+
+   constexpr auto Periods = std::array{1ms, 7ms, 100ms};
+   constexpr auto End     = ActiveClock::duration(60s);
+
+   VirtualClock virtualClock;
+   ClockSource::setActive(&virtualClock);
+
+   auto counts = std::array<uint64, Periods.size()>{};
+   auto joined = std::latch(static_cast<std::ptrdiff_t>(Periods.size()));
+
+   SteadyTimer realTimer;
+
+   auto threads = std::vector<std::jthread>();
+
+   { // we participate until every thread has, so time can't start early
+      ClockSource::Participant const Participant;
+
+      for (auto i = 0uz; i < Periods.size(); ++i)
+      { // one periodic task per period
+         threads.emplace_back([&, i]() {
+            ClockSource::Participant const Participant;
+            joined.count_down();
+
+            auto next = ActiveClock::now();
+            while ((next + Periods[i]).time_since_epoch() <= End)
+            { // until the end of the simulation
+               next += Periods[i];
+               ActiveClock::sleepUntil(next);
+               ++counts[i];
+            }
+         });
+      }
+
+      joined.wait();
+   }
+
+   threads.clear(); // joins
+
+   auto const Real_ms    = std::chrono::duration<float64, std::milli>(realTimer.getElapsedTime()).count();
+   auto const Virtual_ms = std::chrono::duration<float64, std::milli>(ActiveClock::now().time_since_epoch()).count();
+
+   ActiveTimer activeTimer;
+   virtualClock.advanceBy(1s);
+   auto const Advanced_ms = std::chrono::duration<float64, std::milli>(activeTimer.getElapsedTime()).count();
+
+   ClockSource::setActive(nullptr);
+
+   ymLog(VG::UnitTest_Timer, "Simulated {} ms in {:.1f} ms", Virtual_ms, Real_ms);
+
+   return {
+      {"Count1ms",    counts[0]  },
+      {"Count7ms",    counts[1]  },
+      {"Count100ms",  counts[2]  },
+      {"Virtual_ms",  Virtual_ms },
+      {"Real_ms",     Real_ms    },
+      {"Advanced_ms", Advanced_ms}
+   };
+}
+
+/** run
+ *
+ * @brief A thread that sleeps without joining must not move time under a running participant.
+ *
+ * @returns DataShuttle -- Important values acquired during run of test.
+ */
+auto ym::unit::TestSuite::VirtualBystander::run([[maybe_unused]] DataShuttle const & InData) -> DataShuttle
+{
+   auto const SE = ymLogPushEnable(VG::UnitTest_Timer);
+
+   using namespace std::chrono_literals;
+
+   VirtualClock virtualClock;
+   ClockSource::setActive(&virtualClock);
+
+   auto heldStill = false;
+   auto jumped    = false;
+   auto woke      = std::atomic<bool>(false);
+   {
+      ClockSource::Participant const Participant; // running until it sleeps below
+
+      auto asleep    = std::atomic<bool>(false);
+      auto bystander = std::jthread([&asleep, &woke]() {
+         asleep = true;
+         ActiveClock::sleepFor(10ms);
+         woke = ActiveClock::now().time_since_epoch() >= 10ms;
+      });
+
+      while (!asleep.load()) { std::this_thread::yield(); }
+      std::this_thread::sleep_for(20ms); // real time - the bystander is surely asleep by now
+
+      heldStill = ActiveClock::now().time_since_epoch() == 0ns;
+
+      ActiveClock::sleepUntil(ActiveClock::time_point(30ms)); // passes the bystander's deadline on the way
+      jumped = ActiveClock::now().time_since_epoch() == 30ms;
+   }
+
+   ClockSource::setActive(nullptr);
+
+   return {
+      {"HeldStill", heldStill  },
+      {"Jumped",    jumped     },
+      {"Woke",      woke.load()}
+   };
+}
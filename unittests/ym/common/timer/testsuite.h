@@ -27,6 +27,10 @@ public:
 
    YM_UT_TESTCASE(InteractiveInspection)
    YM_UT_TESTCASE(VerifyTimer          )
+   YM_UT_TESTCASE(ReadCost             )
+   YM_UT_TESTCASE(Drift                )
+   YM_UT_TESTCASE(VirtualTime          )
+   YM_UT_TESTCASE(VirtualBystander     )
 };
 
 } // ym::unit
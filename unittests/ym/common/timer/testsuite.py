@@ -73,6 +73,68 @@ class TestSuite(testsuitebase.TestSuiteBase):
       cond = results.get[bool]("True")
       self.assertTrue(cond, "todo should be true")
 
+   def test_ReadCost(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("ReadCost")
+
+      reliable = results.get[bool]("TscReliable")
+      tsc      = results.get["double"]("Tsc_ns"   )
+      steady   = results.get["double"]("Steady_ns")
+      print(f"TscClock::now(): {tsc:.1f} ns (tsc {'used' if reliable else 'not used'}), steady_clock::now(): {steady:.1f} ns")
+
+   def test_Drift(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("Drift")
+
+      drift  = results.get["double"]("Drift_ppm")
+      offset = results.get["double"]("Offset_ns")
+      print(f"TscClock drift: {drift:.2f} ppm, offset from steady_clock: {offset:.0f} ns")
+
+      self.assertLess(abs(drift), 1000.0, "TscClock drifts too far from steady_clock")
+
+   def test_VirtualTime(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("VirtualTime")
+
+      real = results.get["double"]("Real_ms")
+      print(f"Simulated 60 s in {real:.1f} ms")
+
+      self.assertEqual(results.get[ym.uint64]("Count1ms"  ), 60000, "1 ms task missed ticks"  )
+      self.assertEqual(results.get[ym.uint64]("Count7ms"  ),  8571, "7 ms task missed ticks"  )
+      self.assertEqual(results.get[ym.uint64]("Count100ms"),   600, "100 ms task missed ticks")
+
+      self.assertEqual(results.get["double"]("Virtual_ms" ), 60000.0, "Virtual time overshot the last deadline")
+      self.assertEqual(results.get["double"]("Advanced_ms"),  1000.0, "ActiveTimer didn't follow the virtual clock")
+      self.assertLess(real, 60000.0, "Virtual time wasn't faster than real time")
+
+   def test_VirtualBystander(self):
+      """
+      Analyzes results from test case.
+      """
+      from cppyy.gbl import std # type:ignore
+      from cppyy.gbl import ym  # type:ignore
+
+      results = self.run_test_case("VirtualBystander")
+
+      self.assertTrue(results.get[bool]("HeldStill"), "Sleeping non-participant moved time under a participant")
+      self.assertTrue(results.get[bool]("Jumped"   ), "Time didn't jump once the participant slept")
+      self.assertTrue(results.get[bool]("Woke"     ), "Non-participant woke before its deadline")
+
 # kick-off
 if __name__ == "__main__":
    TestSuite.runSuite()
@@ -60,3 +60,79 @@ def open_into_dir(
    if dirname:
       os.makedirs(dirname, exist_ok=True)
    return open(fullfilename, *args, **kwargs)
+
+def load_datalogger_dump(
+      filename: str,
+      binary_format: str = None) -> tuple:
+   """
+   Loads a DataLogger dump.
+
+   Args:
+      filename:      Name of dump file.
+      binary_format: Struct format of one row (eg "=qid") if the dump is binary. Rows are
+                     packed so use a "=" or "<" prefix. None if the dump is text.
+
+   Returns:
+      (list, list): Column names and rows (each row a list of values).
+   """
+
+   import struct
+
+   with open(filename, "rb") as f:
+      names = f.readline().decode().strip().split(",")
+      if binary_format:
+         row_struct = struct.Struct(binary_format)
+         rows = [list(r) for r in row_struct.iter_unpack(f.read())]
+      else:
+         rows = [line.decode().strip().split(",") for line in f if line.strip()]
+   return names, rows
+
+def merge_datalogger_dumps(
+      filenames: list,
+      outfilename: str,
+      binary_formats: dict = None,
+      timestamp_name: str = "timestamp_ns") -> int:
+   """
+   Merges DataLogger dumps onto one timeline using their timestamp columns.
+
+   The output is a csv with the timestamp as the first column followed by the columns of
+   every dump (prefixed with the name of the dump file). Each row only fills in the
+   columns of the dump it came from.
+
+   Args:
+      filenames:      Names of dump files. Each must have been tracking timestamps.
+      outfilename:    Name of merged csv file.
+      binary_formats: Maps binary dump file names to their row struct format (see
+                      load_datalogger_dump()). Files not in the map are read as text.
+      timestamp_name: Name of timestamp column.
+
+   Returns:
+      Number of rows written.
+   """
+
+   import heapq
+
+   binary_formats = binary_formats or {}
+
+   header  = [timestamp_name]
+   streams = []
+   for filename in filenames:
+      names, rows = load_datalogger_dump(filename, binary_formats.get(filename))
+      if timestamp_name not in names:
+         raise ValueError(f"'{filename}' has no '{timestamp_name}' column")
+      ts_idx  = names.index(timestamp_name)
+      col_idx = len(header)
+      prefix  = os.path.splitext(os.path.basename(filename))[0]
+      header += [f"{prefix}.{n}" for n in names if n != timestamp_name]
+      streams.append([(int(r[ts_idx]), col_idx, [v for i, v in enumerate(r) if i != ts_idx]) for r in rows])
+
+   n_rows = 0
+   with open_into_dir(outfilename, mode="w") as f:
+      f.write(",".join(header) + "\n")
+      for ts, col_idx, vals in heapq.merge(*streams, key=lambda e: e[0]):
+         row = [""] * len(header)
+         row[0] = str(ts)
+         row[col_idx:col_idx + len(vals)] = [str(v) for v in vals]
+         f.write(",".join(row) + "\n")
+         n_rows += 1
+   return n_rows